@@ -62,6 +62,12 @@ GL_APICALL void GL_APIENTRY glCoverageModulationCHROMIUM(GLenum components);
 #define GL_MEMORY_SIZE_ANGLE 0x93AD
 #endif /* GL_ANGLE_memory_size */
 
+#ifndef GL_ANGLE_gpu_profile
+#define GL_ANGLE_gpu_profile 1
+#define GL_GPU_PROFILE_RENDER_PASS_TIME_ANGLE 0x93AE
+#define GL_GPU_PROFILE_INTERNAL_TIME_ANGLE 0x93AF
+#endif /* GL_ANGLE_gpu_profile */
+
 // needed by NV_path_rendering (and thus CHROMIUM_path_rendering)
 // but CHROMIUM_path_rendering only needs MatrixLoadfEXT, MatrixLoadIdentityEXT
 #ifndef GL_EXT_direct_state_access
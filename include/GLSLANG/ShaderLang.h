@@ -26,7 +26,7 @@
 
 // Version number for shader translation API.
 // It is incremented every time the API changes.
-#define ANGLE_SH_VERSION 217
+#define ANGLE_SH_VERSION 220
 
 enum ShShaderSpec
 {
@@ -318,6 +318,17 @@ const ShCompileOptions SH_METAL_EMULATE_LINEAR_DEPTH_RANGE_MAP = UINT64_C(1) <<
 // implemented for the Vulkan backend.
 const ShCompileOptions SH_ADD_BRESENHAM_LINE_RASTER_EMULATION = UINT64_C(1) << 50;
 
+// Write the function definitions of the translated shader on several threads.  The output is
+// identical to the single-threaded output.  Currently only implemented for the GLSL and ESSL
+// outputs.
+const ShCompileOptions SH_PARALLEL_FUNCTION_OUTPUT = UINT64_C(1) << 51;
+
+// Propagate constants and copies stored to local variables, fold the resulting constant
+// expressions and remove stores to local variables that are never read.  This makes the translated
+// shader smaller for drivers with slow shader compilers.  Currently only implemented for the GLSL
+// and ESSL outputs.
+const ShCompileOptions SH_OPTIMIZE_LOCAL_VARIABLES = UINT64_C(1) << 52;
+
 // Defines alternate strategies for implementing array index clamping.
 enum ShArrayIndexClampingStrategy
 {
@@ -422,6 +433,11 @@ struct ShBuiltInResources
     // turned on.
     int MaxFunctionParameters;
 
+    // The maximum number of threads, including the calling one, that write function definitions
+    // when SH_PARALLEL_FUNCTION_OUTPUT is turned on.  The threads are created for every compile,
+    // so callers that already compile several shaders at once should keep this small.
+    int MaxFunctionOutputThreads;
+
     // GLES 3.1 constants
 
     // texture gather offset constraints.
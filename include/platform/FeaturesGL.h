@@ -355,6 +355,14 @@ struct FeaturesGL : FeatureSetBase
         "Mac incorrectly executes both sides of && and || expressions when they should "
         "short-circuit.",
         &members, "http://anglebug.com/482"};
+
+    // Some drivers spend most of the link time compiling the translated shaders.  Propagating
+    // constants and copies of local variables and removing dead stores in the translator makes the
+    // translated shaders smaller.  Off by default until it has been measured on more drivers.
+    Feature optimizeShaderLocalVariables = {
+        "optimize_shader_local_variables", FeatureCategory::OpenGLWorkarounds,
+        "Propagate constants and copies of local variables and remove dead stores in shaders",
+        &members};
 };
 
 inline FeaturesGL::FeaturesGL()  = default;
@@ -115,6 +115,12 @@ struct FeaturesVk : FeatureSetBase
         "supports_shader_stencil_export", FeatureCategory::VulkanFeatures,
         "VkDevice supports the VK_EXT_shader_stencil_export extension", &members};
 
+    // Whether the VkDevice supports the VK_KHR_descriptor_update_template extension, which is used
+    // to write the descriptor sets of programs with a single call from a tightly packed array.
+    Feature supportsDescriptorUpdateTemplate = {
+        "supports_descriptor_update_template", FeatureCategory::VulkanFeatures,
+        "VkDevice supports the VK_KHR_descriptor_update_template extension", &members};
+
     // Where VK_EXT_transform_feedback is not support, an emulation path is used.
     // http://anglebug.com/3205
     Feature emulateTransformFeedback = {
@@ -208,6 +214,26 @@ struct FeaturesVk : FeatureSetBase
         "supports_swapchain_colorspace", FeatureCategory::VulkanFeatures,
         "VkDevice supports the VK_EXT_swapchain_colorspace extension", &members,
         "http://anglebug.com/2514"};
+
+    // vkQueueSubmit can take a long time on some drivers.  Hand the submissions and presents to a
+    // dedicated thread so the GL thread doesn't wait for them.
+    Feature asyncCommandQueue = {
+        "async_command_queue", FeatureCategory::VulkanFeatures,
+        "Submit command buffers and present from a dedicated thread", &members};
+
+    // The pipelines of internal operations such as index conversion are otherwise compiled on
+    // their first use, which shows up as a hitch.  Compile the common ones on a worker thread when
+    // the first context is created, into the renderer's pipeline cache.
+    Feature warmUpUtilsPipelines = {
+        "warm_up_utils_pipelines", FeatureCategory::VulkanFeatures,
+        "Compile the common internal utility pipelines on a worker thread, once per display",
+        &members};
+
+    // Running glslang is the most expensive part of linking a program.  Cache the SPIR-V of each
+    // shader stage, so that linking the same shader into several programs only runs it once.
+    Feature cacheShaderSpirv = {
+        "cache_shader_spirv", FeatureCategory::VulkanFeatures,
+        "Reuse the SPIR-V generated for shaders linked into several programs", &members};
 };
 
 inline FeaturesVk::FeaturesVk()  = default;
@@ -36,6 +36,7 @@
 namespace angle
 {
 struct FeaturesD3D;
+struct FeaturesGL;
 struct FeaturesVk;
 struct FeaturesMtl;
 using TraceEventHandle = uint64_t;
@@ -231,6 +232,10 @@ using OverrideFeaturesMtlFunc = void (*)(PlatformMethods *platform,
 inline void DefaultOverrideFeaturesMtl(PlatformMethods *platform, angle::FeaturesMtl *featuresMetal)
 {}
 
+using OverrideFeaturesGLFunc = void (*)(PlatformMethods *platform,
+                                        angle::FeaturesGL *featuresGL);
+inline void DefaultOverrideFeaturesGL(PlatformMethods *platform, angle::FeaturesGL *featuresGL) {}
+
 // Callback on a successful program link with the program binary. Can be used to store
 // shaders to disk. Keys are a 160-bit SHA-1 hash.
 using ProgramKeyType   = std::array<uint8_t, 20>;
@@ -261,7 +266,8 @@ inline void DefaultCacheProgram(PlatformMethods *platform,
     OP(overrideWorkaroundsD3D, OverrideWorkaroundsD3D)           \
     OP(overrideFeaturesVk, OverrideFeaturesVk)                   \
     OP(overrideFeaturesMtl, OverrideFeaturesMtl)                 \
-    OP(cacheProgram, CacheProgram)
+    OP(cacheProgram, CacheProgram)                               \
+    OP(overrideFeaturesGL, OverrideFeaturesGL)
 
 #define ANGLE_PLATFORM_METHOD_DEF(Name, CapsName) CapsName##Func Name = Default##CapsName;
 
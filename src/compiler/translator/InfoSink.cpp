@@ -6,12 +6,51 @@
 
 #include "compiler/translator/InfoSink.h"
 
+#include <stdio.h>
+#include <cmath>
+
 #include "compiler/translator/ImmutableString.h"
 #include "compiler/translator/Types.h"
 
 namespace sh
 {
 
+namespace
+{
+
+// Integral floats up to this magnitude are converted to an integer to be written.
+constexpr float kMaxIntegralFloatToConvert = 1e18f;
+
+// Formats a float with snprintf, which writes the same characters as a string stream with the
+// equivalent flags.  Unlike the stream, which is imbued with the classic locale, snprintf uses the
+// decimal separator of the process's locale, so it is replaced with a '.'.
+void AppendFormattedFloat(const char *format, float f, TPersistString *sink)
+{
+    char buffer[64];
+    int length = snprintf(buffer, sizeof(buffer), format, static_cast<double>(f));
+    ASSERT(length > 0 && static_cast<size_t>(length) < sizeof(buffer));
+
+    // The rest of the output is made of digits, signs and the letters of the exponent, inf and
+    // nan.  The separator may be more than one byte long.
+    bool previousIsSeparator = false;
+    for (int index = 0; index < length; ++index)
+    {
+        const char c = buffer[index];
+        if ((c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || c == '-' || c == '+')
+        {
+            sink->append(1, c);
+            previousIsSeparator = false;
+        }
+        else if (!previousIsSeparator)
+        {
+            sink->append(1, '.');
+            previousIsSeparator = true;
+        }
+    }
+}
+
+}  // anonymous namespace
+
 void TInfoSinkBase::prefix(Severity severity)
 {
     switch (severity)
@@ -28,6 +67,38 @@ void TInfoSinkBase::prefix(Severity severity)
     }
 }
 
+TInfoSinkBase &TInfoSinkBase::operator<<(float f)
+{
+    // Make sure that at least one decimal point is written. If a number
+    // does not have a fractional part, the default precision format does
+    // not write the decimal portion which gets interpreted as integer by
+    // the compiler.
+    if (fractionalPart(f) == 0.0f)
+    {
+        // Same as a stream with std::fixed, std::showpoint and a precision of 1.  The common case
+        // of a reasonably small number is written as an integer, which is exact.
+        if (std::fabs(f) < kMaxIntegralFloatToConvert)
+        {
+            if (std::signbit(f))
+            {
+                sink.append(1, '-');
+            }
+            appendInteger(static_cast<uint64_t>(std::fabs(f)));
+            sink.append(".0");
+        }
+        else
+        {
+            AppendFormattedFloat("%.1f", f, &sink);
+        }
+    }
+    else
+    {
+        // Same as a stream with the default floatfield and a precision of 8.
+        AppendFormattedFloat("%.8g", f, &sink);
+    }
+    return *this;
+}
+
 TInfoSinkBase &TInfoSinkBase::operator<<(const ImmutableString &str)
 {
     sink.append(str.data());
@@ -69,14 +140,12 @@ TInfoSinkBase &TInfoSinkBase::operator<<(const TType &type)
 
 void TInfoSinkBase::location(int file, int line)
 {
-    TPersistStringStream stream = sh::InitializeStream<TPersistStringStream>();
+    *this << file;
     if (line)
-        stream << file << ":" << line;
+        *this << ":" << line;
     else
-        stream << file << ":? ";
-    stream << ": ";
-
-    sink.append(stream.str());
+        sink.append(":? ");
+    sink.append(": ");
 }
 
 }  // namespace sh
@@ -9,6 +9,8 @@
 
 #include <math.h>
 #include <stdlib.h>
+#include <limits>
+#include <type_traits>
 #include "compiler/translator/Common.h"
 #include "compiler/translator/Severity.h"
 
@@ -72,29 +74,18 @@ class TInfoSinkBase
 
     TInfoSinkBase &operator<<(const TType &type);
 
+    // Integers are written without going through a string stream, which is expensive to create.
+    TInfoSinkBase &operator<<(short i) { return appendInteger(i); }
+    TInfoSinkBase &operator<<(unsigned short i) { return appendInteger(i); }
+    TInfoSinkBase &operator<<(int i) { return appendInteger(i); }
+    TInfoSinkBase &operator<<(unsigned int i) { return appendInteger(i); }
+    TInfoSinkBase &operator<<(long i) { return appendInteger(i); }
+    TInfoSinkBase &operator<<(unsigned long i) { return appendInteger(i); }
+    TInfoSinkBase &operator<<(long long i) { return appendInteger(i); }
+    TInfoSinkBase &operator<<(unsigned long long i) { return appendInteger(i); }
+
     // Make sure floats are written with correct precision.
-    TInfoSinkBase &operator<<(float f)
-    {
-        // Make sure that at least one decimal point is written. If a number
-        // does not have a fractional part, the default precision format does
-        // not write the decimal portion which gets interpreted as integer by
-        // the compiler.
-        TPersistStringStream stream = sh::InitializeStream<TPersistStringStream>();
-        if (fractionalPart(f) == 0.0f)
-        {
-            stream.precision(1);
-            stream << std::showpoint << std::fixed << f;
-        }
-        else
-        {
-            stream.unsetf(std::ios::fixed);
-            stream.unsetf(std::ios::scientific);
-            stream.precision(8);
-            stream << f;
-        }
-        sink.append(stream.str());
-        return *this;
-    }
+    TInfoSinkBase &operator<<(float f);
     // Write boolean values as their names instead of integral value.
     TInfoSinkBase &operator<<(bool b)
     {
@@ -113,6 +104,37 @@ class TInfoSinkBase
     void location(int file, int line);
 
   private:
+    template <typename T>
+    TInfoSinkBase &appendInteger(T value)
+    {
+        using UnsignedT = typename std::make_unsigned<T>::type;
+
+        // Negating in the unsigned type is well defined for the minimum value too.
+        const bool isNegative = value < static_cast<T>(0);
+        UnsignedT magnitude   = static_cast<UnsignedT>(value);
+        if (isNegative)
+        {
+            magnitude = static_cast<UnsignedT>(0) - magnitude;
+        }
+
+        // The digits are written backwards from the end of the buffer.
+        char buffer[std::numeric_limits<UnsignedT>::digits10 + 2];
+        char *end   = buffer + sizeof(buffer);
+        char *begin = end;
+        do
+        {
+            *--begin  = static_cast<char>('0' + magnitude % 10);
+            magnitude = static_cast<UnsignedT>(magnitude / 10);
+        } while (magnitude != 0);
+        if (isNegative)
+        {
+            *--begin = '-';
+        }
+
+        sink.append(begin, end);
+        return *this;
+    }
+
     TPersistString sink;
 };
 
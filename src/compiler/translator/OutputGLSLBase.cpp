@@ -10,9 +10,13 @@
 #include "common/debug.h"
 #include "common/mathutil.h"
 #include "compiler/translator/Compiler.h"
+#include "compiler/translator/PoolAlloc.h"
 #include "compiler/translator/util.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cfloat>
+#include <thread>
 
 namespace sh
 {
@@ -99,9 +103,131 @@ TOutputGLSLBase::TOutputGLSLBase(TInfoSinkBase &objSink,
       mShaderType(shaderType),
       mShaderVersion(shaderVersion),
       mOutput(output),
-      mCompileOptions(compileOptions)
+      mCompileOptions(compileOptions),
+      mDeferredFunctionDefinitions(nullptr)
 {}
 
+void TOutputGLSLBase::writeTreeInParallel(TIntermBlock *root,
+                                          int maxThreadCount,
+                                          const FunctionOutputFactory &createFunctionOutput)
+{
+    // Write the global scope, leaving out the function definitions.
+    std::vector<DeferredFunctionDefinition> functionDefinitions;
+    mDeferredFunctionDefinitions = &functionDefinitions;
+    mDeclaredStructsSnapshot.reset();
+    root->traverse(this);
+    mDeferredFunctionDefinitions = nullptr;
+    mDeclaredStructsSnapshot.reset();
+
+    // Each thread writes whole function definitions with an output of its own.  The pool allocator
+    // is per thread, so the allocations made while writing stay on the thread that made them.
+    std::atomic<size_t> nextFunctionDefinition(0);
+    auto writeFunctionDefinitions = [&](NameMap *nameMap) {
+        size_t index = 0;
+        while ((index = nextFunctionDefinition++) < functionDefinitions.size())
+        {
+            DeferredFunctionDefinition &functionDefinition = functionDefinitions[index];
+
+            std::unique_ptr<TOutputGLSLBase> functionOutput =
+                createFunctionOutput(functionDefinition.output, *nameMap);
+            functionOutput->mDeclaredStructs = *functionDefinition.declaredStructs;
+            functionDefinition.node->traverse(functionOutput.get());
+        }
+    };
+
+    size_t threadCount = std::min<size_t>({static_cast<size_t>(std::max(maxThreadCount, 1)),
+                                           std::max(std::thread::hardware_concurrency(), 1u),
+                                           functionDefinitions.size()});
+
+    // Hashed names are deterministic, so the names hashed by the other threads can be merged into
+    // the name map afterwards in any order.
+    std::vector<NameMap> threadNameMaps(threadCount > 0 ? threadCount - 1 : 0);
+    std::vector<std::thread> threads;
+    for (NameMap &threadNameMap : threadNameMaps)
+    {
+        threads.emplace_back([&writeFunctionDefinitions, &threadNameMap]() {
+            angle::PoolAllocator allocator;
+            allocator.push();
+            SetGlobalPoolAllocator(&allocator);
+
+            writeFunctionDefinitions(&threadNameMap);
+
+            SetGlobalPoolAllocator(nullptr);
+            allocator.popAll();
+        });
+    }
+    writeFunctionDefinitions(&mNameMap);
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    for (const NameMap &threadNameMap : threadNameMaps)
+    {
+        mNameMap.insert(threadNameMap.begin(), threadNameMap.end());
+    }
+
+    // Put the function definitions back in their place.
+    TInfoSinkBase &out = objSink();
+    const TPersistString &globalOutput = out.str();
+
+    TPersistString treeOutput;
+    size_t treeOutputSize = globalOutput.size();
+    for (const DeferredFunctionDefinition &functionDefinition : functionDefinitions)
+    {
+        treeOutputSize += functionDefinition.output.str().size();
+    }
+    treeOutput.reserve(treeOutputSize);
+
+    size_t globalOutputOffset = 0;
+    for (const DeferredFunctionDefinition &functionDefinition : functionDefinitions)
+    {
+        treeOutput.append(globalOutput, globalOutputOffset,
+                          functionDefinition.outputOffset - globalOutputOffset);
+        treeOutput.append(functionDefinition.output.str());
+        globalOutputOffset = functionDefinition.outputOffset;
+    }
+    treeOutput.append(globalOutput, globalOutputOffset, TPersistString::npos);
+
+    out.erase();
+    out << treeOutput;
+}
+
+bool TOutputGLSLBase::canDeferFunctionDefinition(const TFunction *function) const
+{
+    // A struct that is first declared in the prototype is visible to the rest of the shader, so
+    // the prototype has to be written in order.
+    const TType &returnType = function->getReturnType();
+    if (returnType.getBasicType() == EbtStruct && !structDeclared(returnType.getStruct()))
+    {
+        return false;
+    }
+    for (size_t paramIndex = 0; paramIndex < function->getParamCount(); ++paramIndex)
+    {
+        const TType &paramType = function->getParam(paramIndex)->getType();
+        if (paramType.getBasicType() == EbtStruct && !structDeclared(paramType.getStruct()))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void TOutputGLSLBase::deferFunctionDefinition(TIntermFunctionDefinition *node)
+{
+    // The snapshot is shared by the function definitions until another struct is declared.
+    if (!mDeclaredStructsSnapshot || mDeclaredStructsSnapshot->size() != mDeclaredStructs.size())
+    {
+        mDeclaredStructsSnapshot = std::make_shared<const std::set<int>>(mDeclaredStructs);
+    }
+
+    DeferredFunctionDefinition functionDefinition;
+    functionDefinition.node            = node;
+    functionDefinition.outputOffset    = objSink().str().size();
+    functionDefinition.declaredStructs = mDeclaredStructsSnapshot;
+    mDeferredFunctionDefinitions->push_back(std::move(functionDefinition));
+}
+
 void TOutputGLSLBase::writeInvariantQualifier(const TType &type)
 {
     if (!sh::RemoveInvariant(mShaderType, mShaderVersion, mOutput, mCompileOptions))
@@ -944,6 +1070,13 @@ bool TOutputGLSLBase::visitBlock(Visit visit, TIntermBlock *node)
 
 bool TOutputGLSLBase::visitFunctionDefinition(Visit visit, TIntermFunctionDefinition *node)
 {
+    if (mDeferredFunctionDefinitions != nullptr &&
+        canDeferFunctionDefinition(node->getFunction()))
+    {
+        deferFunctionDefinition(node);
+        return false;
+    }
+
     TIntermFunctionPrototype *prototype = node->getFunctionPrototype();
     prototype->traverse(this);
     visitCodeBlock(node->getBody());
@@ -7,7 +7,10 @@
 #ifndef COMPILER_TRANSLATOR_OUTPUTGLSLBASE_H_
 #define COMPILER_TRANSLATOR_OUTPUTGLSLBASE_H_
 
+#include <functional>
+#include <memory>
 #include <set>
+#include <vector>
 
 #include "compiler/translator/HashNames.h"
 #include "compiler/translator/InfoSink.h"
@@ -31,6 +34,17 @@ class TOutputGLSLBase : public TIntermTraverser
 
     ShShaderOutput getShaderOutput() const { return mOutput; }
 
+    // Creates an output of the same type and with the same parameters as this one, but which writes
+    // to |objSink| and |nameMap|.
+    using FunctionOutputFactory =
+        std::function<std::unique_ptr<TOutputGLSLBase>(TInfoSinkBase &objSink, NameMap &nameMap)>;
+
+    // Writes |root| the same as root->traverse(this), but writes the function definitions on up to
+    // |maxThreadCount| threads with outputs created by |createFunctionOutput|.
+    void writeTreeInParallel(TIntermBlock *root,
+                             int maxThreadCount,
+                             const FunctionOutputFactory &createFunctionOutput);
+
     // Return the original name if hash function pointer is NULL;
     // otherwise return the hashed name. Has special handling for internal names and built-ins,
     // which are not hashed.
@@ -84,6 +98,19 @@ class TOutputGLSLBase : public TIntermTraverser
     bool structDeclared(const TStructure *structure) const;
 
   private:
+    struct DeferredFunctionDefinition
+    {
+        TIntermFunctionDefinition *node;
+        // Where the function definition is placed in the output of the global scope.
+        size_t outputOffset;
+        // The structs declared before the function definition.
+        std::shared_ptr<const std::set<int>> declaredStructs;
+        TInfoSinkBase output;
+    };
+
+    bool canDeferFunctionDefinition(const TFunction *function) const;
+    void deferFunctionDefinition(TIntermFunctionDefinition *node);
+
     void declareInterfaceBlockLayout(const TInterfaceBlock *interfaceBlock);
     void declareInterfaceBlock(const TInterfaceBlock *interfaceBlock);
 
@@ -111,6 +138,11 @@ class TOutputGLSLBase : public TIntermTraverser
     ShShaderOutput mOutput;
 
     ShCompileOptions mCompileOptions;
+
+    // Set while writing the tree in parallel.  The function definitions are collected here instead
+    // of being written.
+    std::vector<DeferredFunctionDefinition> *mDeferredFunctionDefinitions;
+    std::shared_ptr<const std::set<int>> mDeclaredStructsSnapshot;
 };
 
 void WriteGeometryShaderLayoutQualifiers(TInfoSinkBase &out,
@@ -200,6 +200,8 @@ void InitBuiltInResources(ShBuiltInResources *resources)
     resources->MaxCallStackDepth       = 256;
     resources->MaxFunctionParameters   = 1024;
 
+    resources->MaxFunctionOutputThreads = 4;
+
     // ES 3.1 Revision 4, 7.2 Built-in Constants
 
     // ES 3.1, Revision 4, 8.13 Texture minification
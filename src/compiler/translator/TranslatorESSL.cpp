@@ -10,6 +10,7 @@
 #include "compiler/translator/BuiltInFunctionEmulatorGLSL.h"
 #include "compiler/translator/OutputESSL.h"
 #include "compiler/translator/tree_ops/EmulatePrecision.h"
+#include "compiler/translator/tree_ops/OptimizeLocalVariables.h"
 #include "compiler/translator/tree_ops/RecordConstantPrecision.h"
 
 namespace sh
@@ -61,6 +62,14 @@ bool TranslatorESSL::translate(TIntermBlock *root,
         emulatePrecision.writeEmulationHelpers(sink, shaderVer, SH_ESSL_OUTPUT);
     }
 
+    if ((compileOptions & SH_OPTIMIZE_LOCAL_VARIABLES) != 0)
+    {
+        if (!OptimizeLocalVariables(this, root, &getSymbolTable()))
+        {
+            return false;
+        }
+    }
+
     if (!RecordConstantPrecision(this, root, &getSymbolTable()))
     {
         return false;
@@ -107,7 +116,22 @@ bool TranslatorESSL::translate(TIntermBlock *root,
                            &getSymbolTable(), getShaderType(), shaderVer, precisionEmulation,
                            compileOptions);
 
-    root->traverse(&outputESSL);
+    if ((compileOptions & SH_PARALLEL_FUNCTION_OUTPUT) != 0)
+    {
+        outputESSL.writeTreeInParallel(
+            root, getResources().MaxFunctionOutputThreads,
+            [this, shaderVer, precisionEmulation, compileOptions](TInfoSinkBase &functionSink,
+                                                                  NameMap &functionNameMap) {
+                return std::unique_ptr<TOutputGLSLBase>(new TOutputESSL(
+                    functionSink, getArrayIndexClampingStrategy(), getHashFunction(),
+                    functionNameMap, &getSymbolTable(), getShaderType(), shaderVer,
+                    precisionEmulation, compileOptions));
+            });
+    }
+    else
+    {
+        root->traverse(&outputESSL);
+    }
 
     return true;
 }
@@ -12,6 +12,7 @@
 #include "compiler/translator/OutputGLSL.h"
 #include "compiler/translator/VersionGLSL.h"
 #include "compiler/translator/tree_ops/EmulatePrecision.h"
+#include "compiler/translator/tree_ops/OptimizeLocalVariables.h"
 #include "compiler/translator/tree_ops/RewriteTexelFetchOffset.h"
 #include "compiler/translator/tree_ops/RewriteUnaryMinusOperatorFloat.h"
 
@@ -123,6 +124,14 @@ bool TranslatorGLSL::translate(TIntermBlock *root,
         emulatePrecision.writeEmulationHelpers(sink, getShaderVersion(), getOutputType());
     }
 
+    if ((compileOptions & SH_OPTIMIZE_LOCAL_VARIABLES) != 0)
+    {
+        if (!OptimizeLocalVariables(this, root, &getSymbolTable()))
+        {
+            return false;
+        }
+    }
+
     // Write emulated built-in functions if needed.
     if (!getBuiltInFunctionEmulator().isOutputEmpty())
     {
@@ -220,7 +229,21 @@ bool TranslatorGLSL::translate(TIntermBlock *root,
                            &getSymbolTable(), getShaderType(), getShaderVersion(), getOutputType(),
                            compileOptions);
 
-    root->traverse(&outputGLSL);
+    if ((compileOptions & SH_PARALLEL_FUNCTION_OUTPUT) != 0)
+    {
+        outputGLSL.writeTreeInParallel(
+            root, getResources().MaxFunctionOutputThreads,
+            [this, compileOptions](TInfoSinkBase &functionSink, NameMap &functionNameMap) {
+                return std::unique_ptr<TOutputGLSLBase>(new TOutputGLSL(
+                    functionSink, getArrayIndexClampingStrategy(), getHashFunction(),
+                    functionNameMap, &getSymbolTable(), getShaderType(), getShaderVersion(),
+                    getOutputType(), compileOptions));
+            });
+    }
+    else
+    {
+        root->traverse(&outputGLSL);
+    }
 
     return true;
 }
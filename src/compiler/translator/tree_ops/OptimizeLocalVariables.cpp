@@ -0,0 +1,729 @@
+//
+// Copyright 2020 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// OptimizeLocalVariables.cpp:
+//  Propagate constants and copies stored to local variables into the statements that read them,
+//  fold the resulting constant expressions and remove stores that are never read.
+//
+
+#include "compiler/translator/tree_ops/OptimizeLocalVariables.h"
+
+#include <array>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "compiler/translator/Diagnostics.h"
+#include "compiler/translator/InfoSink.h"
+#include "compiler/translator/Symbol.h"
+#include "compiler/translator/tree_ops/FoldExpressions.h"
+#include "compiler/translator/tree_ops/PruneEmptyCases.h"
+#include "compiler/translator/tree_ops/RemoveUnreferencedVariables.h"
+#include "compiler/translator/tree_util/IntermTraverse.h"
+
+namespace sh
+{
+
+namespace
+{
+
+// Propagating a value may expose another store that can be removed or another value that can be
+// propagated. Real world shaders settle within a few iterations.
+constexpr int kMaxIterations = 8;
+
+// The value of a local variable at some point of a function: either a constant, or the value of
+// another variable that hasn't been written since it was copied.
+struct KnownValue
+{
+    const TConstantUnion *constant;
+    const TVariable *copySource;
+};
+
+using KnownValues = std::unordered_map<const TVariable *, KnownValue>;
+using VariableSet = std::unordered_set<const TVariable *>;
+using NameCounts =
+    std::unordered_map<ImmutableString, int, ImmutableString::FowlerNollVoHash<sizeof(size_t)>>;
+
+bool HasOptimizableType(const TVariable &variable)
+{
+    const TType &type = variable.getType();
+    return variable.symbolType() != SymbolType::Empty && !type.isArray() &&
+           type.getStruct() == nullptr && type.getInterfaceBlock() == nullptr &&
+           !IsOpaqueType(type.getBasicType());
+}
+
+bool IsLocalVariable(const TVariable &variable)
+{
+    return variable.getType().getQualifier() == EvqTemporary && HasOptimizableType(variable);
+}
+
+// Variables that can't be written by function calls, so that their value can be copied.
+bool IsCopySource(const TVariable &variable)
+{
+    switch (variable.getType().getQualifier())
+    {
+        case EvqTemporary:
+        case EvqIn:
+        case EvqConstReadOnly:
+        case EvqUniform:
+            return HasOptimizableType(variable);
+        default:
+            return false;
+    }
+}
+
+bool IsDeclaredHere(TIntermSymbol *symbol, TIntermNode *parent)
+{
+    if (parent->getAsDeclarationNode() != nullptr)
+    {
+        return true;
+    }
+    TIntermBinary *parentBinary = parent->getAsBinaryNode();
+    return parentBinary != nullptr && parentBinary->getOp() == EOpInitialize &&
+           parentBinary->getLeft() == symbol;
+}
+
+// Declarations and expressions are executed from start to end. Other statements either contain
+// nested blocks or branch.
+bool IsStraightLineStatement(TIntermNode *statement)
+{
+    return statement->getAsDeclarationNode() != nullptr || statement->getAsTyped() != nullptr;
+}
+
+// The blocks directly nested in a statement. Unused entries are nullptr.
+using NestedBlocks = std::array<TIntermBlock *, 2>;
+
+NestedBlocks GetNestedBlocks(TIntermNode *statement)
+{
+    if (TIntermBlock *block = statement->getAsBlock())
+    {
+        return {{block, nullptr}};
+    }
+    if (TIntermIfElse *ifElse = statement->getAsIfElseNode())
+    {
+        return {{ifElse->getTrueBlock(), ifElse->getFalseBlock()}};
+    }
+    if (TIntermLoop *loop = statement->getAsLoopNode())
+    {
+        return {{loop->getBody(), nullptr}};
+    }
+    if (TIntermSwitch *switchNode = statement->getAsSwitchNode())
+    {
+        return {{switchNode->getStatementList(), nullptr}};
+    }
+    return {{nullptr, nullptr}};
+}
+
+// Returns the assignment or initialization in |statement| that stores to a local variable as a
+// whole, if any.
+TIntermBinary *GetLocalVariableStore(TIntermNode *statement)
+{
+    TIntermBinary *store            = statement->getAsBinaryNode();
+    TIntermDeclaration *declaration = statement->getAsDeclarationNode();
+    if (declaration != nullptr)
+    {
+        store = declaration->getSequence()->empty()
+                    ? nullptr
+                    : declaration->getSequence()->front()->getAsBinaryNode();
+    }
+    if (store == nullptr || (store->getOp() != EOpAssign && store->getOp() != EOpInitialize))
+    {
+        return nullptr;
+    }
+    TIntermSymbol *symbol = store->getLeft()->getAsSymbolNode();
+    if (symbol == nullptr || !IsLocalVariable(symbol->variable()))
+    {
+        return nullptr;
+    }
+    return store;
+}
+
+const TVariable &GetStoredVariable(TIntermBinary *store)
+{
+    return store->getLeft()->getAsSymbolNode()->variable();
+}
+
+// Returns the local variable that |statement| declares without an initializer, if any.
+const TVariable *GetUninitializedLocalVariable(TIntermNode *statement)
+{
+    TIntermDeclaration *declaration = statement->getAsDeclarationNode();
+    if (declaration == nullptr || declaration->getSequence()->empty())
+    {
+        return nullptr;
+    }
+    TIntermSymbol *symbol = declaration->getSequence()->front()->getAsSymbolNode();
+    if (symbol == nullptr || !IsLocalVariable(symbol->variable()))
+    {
+        return nullptr;
+    }
+    return &symbol->variable();
+}
+
+void ForgetVariable(const TVariable *variable, KnownValues *knownValues)
+{
+    for (auto iter = knownValues->begin(); iter != knownValues->end();)
+    {
+        if (iter->first == variable || iter->second.copySource == variable)
+        {
+            iter = knownValues->erase(iter);
+        }
+        else
+        {
+            ++iter;
+        }
+    }
+}
+
+void ForgetVariables(const VariableSet &variables, KnownValues *knownValues)
+{
+    for (auto iter = knownValues->begin(); iter != knownValues->end();)
+    {
+        if (variables.count(iter->first) > 0 ||
+            (iter->second.copySource != nullptr && variables.count(iter->second.copySource) > 0))
+        {
+            iter = knownValues->erase(iter);
+        }
+        else
+        {
+            ++iter;
+        }
+    }
+}
+
+class CollectVariableAccessesTraverser : public TLValueTrackingTraverser
+{
+  public:
+    CollectVariableAccessesTraverser(TSymbolTable *symbolTable)
+        : TLValueTrackingTraverser(true, false, false, symbolTable)
+    {}
+
+    const std::unordered_map<const TVariable *, unsigned int> &getReferenceCounts() const
+    {
+        return mReferenceCounts;
+    }
+    const VariableSet &getWrittenVariables() const { return mWrittenVariables; }
+
+    void collect(TIntermNode *node)
+    {
+        mReferenceCounts.clear();
+        mWrittenVariables.clear();
+        node->traverse(this);
+    }
+
+    void visitSymbol(TIntermSymbol *node) override
+    {
+        const TVariable *variable = &node->variable();
+        ++mReferenceCounts[variable];
+
+        TIntermNode *parent = getParentNode();
+        if (isLValueRequiredHere() || (parent != nullptr && IsDeclaredHere(node, parent)))
+        {
+            mWrittenVariables.insert(variable);
+        }
+    }
+
+  private:
+    std::unordered_map<const TVariable *, unsigned int> mReferenceCounts;
+    VariableSet mWrittenVariables;
+};
+
+// Counts the variable and struct names declared in a function body, to find out whether a name
+// refers to the same variable everywhere in the function.
+class CollectDeclaredNamesTraverser : public TIntermTraverser
+{
+  public:
+    CollectDeclaredNamesTraverser(NameCounts *declaredNames)
+        : TIntermTraverser(true, false, false), mDeclaredNames(declaredNames)
+    {}
+
+    void visitSymbol(TIntermSymbol *node) override
+    {
+        TIntermNode *parent = getParentNode();
+        if (parent == nullptr || !IsDeclaredHere(node, parent))
+        {
+            return;
+        }
+        if (node->variable().symbolType() != SymbolType::Empty)
+        {
+            ++(*mDeclaredNames)[node->getName()];
+        }
+        if (node->getType().isStructSpecifier())
+        {
+            ++(*mDeclaredNames)[node->getType().getStruct()->name()];
+        }
+    }
+
+  private:
+    NameCounts *mDeclaredNames;
+};
+
+// Replaces the reads of variables with known values in one statement at a time. Nested blocks are
+// skipped, since the values known in them depend on the surrounding control flow. The replacements
+// only affect symbol nodes, so they can all be applied to the tree at once in the end.
+class ReplaceKnownValuesTraverser : public TLValueTrackingTraverser
+{
+  public:
+    ReplaceKnownValuesTraverser(TSymbolTable *symbolTable)
+        : TLValueTrackingTraverser(true, false, false, symbolTable),
+          mKnownValues(nullptr),
+          mDidReplace(false)
+    {}
+
+    bool didReplace() const { return mDidReplace; }
+
+    void replaceReads(TIntermNode *statement, const KnownValues &knownValues)
+    {
+        if (knownValues.empty())
+        {
+            return;
+        }
+        mKnownValues = &knownValues;
+        statement->traverse(this);
+    }
+
+    void visitSymbol(TIntermSymbol *node) override
+    {
+        TIntermNode *parent = getParentNode();
+        if (isLValueRequiredHere() || parent == nullptr || IsDeclaredHere(node, parent))
+        {
+            return;
+        }
+        // Keep dynamic indexing on variables, so that a constant never ends up indexed out of
+        // range and index clamping still applies.
+        TIntermBinary *parentBinary = parent->getAsBinaryNode();
+        if (parentBinary != nullptr && parentBinary->getOp() == EOpIndexIndirect)
+        {
+            return;
+        }
+
+        const TVariable *variable = &node->variable();
+        auto knownValue           = mKnownValues->find(variable);
+        if (knownValue == mKnownValues->end())
+        {
+            return;
+        }
+
+        if (knownValue->second.constant != nullptr)
+        {
+            TType constantType(variable->getType());
+            constantType.setQualifier(EvqConst);
+            queueReplacement(new TIntermConstantUnion(knownValue->second.constant, constantType),
+                             OriginalNode::IS_DROPPED);
+        }
+        else
+        {
+            queueReplacement(new TIntermSymbol(knownValue->second.copySource),
+                             OriginalNode::IS_DROPPED);
+        }
+        mDidReplace = true;
+    }
+
+    bool visitBlock(Visit visit, TIntermBlock *node) override { return false; }
+
+  private:
+    const KnownValues *mKnownValues;
+    bool mDidReplace;
+};
+
+class PropagateLocalValues : angle::NonCopyable
+{
+  public:
+    PropagateLocalValues(TSymbolTable *symbolTable)
+        : mFunctionDefinition(nullptr),
+          mAccesses(symbolTable),
+          mReplaceReads(symbolTable),
+          mDeclaredNamesCollected(false)
+    {}
+
+    bool didReplace() const { return mReplaceReads.didReplace(); }
+
+    void propagateInFunction(TIntermFunctionDefinition *functionDefinition)
+    {
+        mFunctionDefinition     = functionDefinition;
+        mDeclaredNamesCollected = false;
+
+        KnownValues knownValues;
+        propagateInBlock(functionDefinition->getBody(), &knownValues, nullptr);
+    }
+
+    bool updateTree(TCompiler *compiler, TIntermBlock *root)
+    {
+        return mReplaceReads.updateTree(compiler, root);
+    }
+
+  private:
+    void propagateInBlock(TIntermBlock *block,
+                          KnownValues *knownValues,
+                          const KnownValues *caseEntryValues)
+    {
+        for (TIntermNode *statement : *block->getSequence())
+        {
+            if (statement->getAsCaseNode() != nullptr)
+            {
+                // Nothing that the switch statement writes is known on entry, so the values known
+                // on entry are also known when falling through from the previous case.
+                ASSERT(caseEntryValues != nullptr);
+                *knownValues = *caseEntryValues;
+            }
+            else if (IsStraightLineStatement(statement))
+            {
+                propagateInStatement(statement, knownValues);
+            }
+            else
+            {
+                propagateInControlFlow(statement, knownValues);
+            }
+        }
+    }
+
+    void propagateInStatement(TIntermNode *statement, KnownValues *knownValues)
+    {
+        TIntermBinary *store = GetLocalVariableStore(statement);
+        if (store == nullptr)
+        {
+            if (!knownValues->empty())
+            {
+                // The variables that the statement writes may be read after they are written, and
+                // so may the copies of them.
+                mAccesses.collect(statement);
+                ForgetVariables(mAccesses.getWrittenVariables(), knownValues);
+                mReplaceReads.replaceReads(statement, *knownValues);
+            }
+            return;
+        }
+
+        // The stored value is evaluated before the store, so only the variables written by the
+        // stored value itself, and the copies of them, need to be forgotten first. Constants and
+        // symbols don't write anything.
+        TIntermTyped *value = store->getRight();
+        bool isSimpleValue =
+            value->getAsConstantUnion() != nullptr || value->getAsSymbolNode() != nullptr;
+        if (!knownValues->empty())
+        {
+            if (!isSimpleValue)
+            {
+                mAccesses.collect(value);
+                ForgetVariables(mAccesses.getWrittenVariables(), knownValues);
+            }
+            mReplaceReads.replaceReads(statement, *knownValues);
+        }
+
+        const TVariable &variable = GetStoredVariable(store);
+        KnownValue storedValue    = {nullptr, nullptr};
+        if (isSimpleValue)
+        {
+            storedValue = getStoredValue(value, *knownValues);
+        }
+        ForgetVariable(&variable, knownValues);
+
+        if (storedValue.constant != nullptr ||
+            (storedValue.copySource != nullptr && canCopy(*storedValue.copySource, variable)))
+        {
+            (*knownValues)[&variable] = storedValue;
+        }
+    }
+
+    void propagateInControlFlow(TIntermNode *statement, KnownValues *knownValues)
+    {
+        if (!knownValues->empty())
+        {
+            // Conditions and loop expressions may be evaluated after the nested blocks, so nothing
+            // written in the statement is known in any part of it or after it.
+            mAccesses.collect(statement);
+            ForgetVariables(mAccesses.getWrittenVariables(), knownValues);
+            mReplaceReads.replaceReads(statement, *knownValues);
+        }
+
+        if (TIntermSwitch *switchNode = statement->getAsSwitchNode())
+        {
+            KnownValues caseValues = *knownValues;
+            propagateInBlock(switchNode->getStatementList(), &caseValues, knownValues);
+            return;
+        }
+        for (TIntermBlock *nestedBlock : GetNestedBlocks(statement))
+        {
+            if (nestedBlock != nullptr)
+            {
+                KnownValues nestedValues = *knownValues;
+                propagateInBlock(nestedBlock, &nestedValues, nullptr);
+            }
+        }
+    }
+
+    // Gets the constant or symbol that is stored, after its read has been replaced.
+    KnownValue getStoredValue(TIntermTyped *value, const KnownValues &knownValues) const
+    {
+        if (TIntermConstantUnion *constant = value->getAsConstantUnion())
+        {
+            return {constant->getConstantValue(), nullptr};
+        }
+        const TVariable *source = &value->getAsSymbolNode()->variable();
+        auto knownValue         = knownValues.find(source);
+        if (knownValue != knownValues.end())
+        {
+            return knownValue->second;
+        }
+        return {nullptr, source};
+    }
+
+    bool canCopy(const TVariable &source, const TVariable &destination)
+    {
+        if (!IsCopySource(source) || &source == &destination ||
+            source.getType() != destination.getType() ||
+            source.getType().getPrecision() != destination.getType().getPrecision())
+        {
+            return false;
+        }
+
+        // The source is read wherever the destination is read, so its name must not be hidden
+        // by another declaration anywhere in the function.
+        if (!mDeclaredNamesCollected)
+        {
+            mDeclaredNames.clear();
+            const TFunction *function = mFunctionDefinition->getFunction();
+            for (size_t paramIndex = 0; paramIndex < function->getParamCount(); ++paramIndex)
+            {
+                ++mDeclaredNames[function->getParam(paramIndex)->name()];
+            }
+            CollectDeclaredNamesTraverser collectDeclaredNames(&mDeclaredNames);
+            mFunctionDefinition->getBody()->traverse(&collectDeclaredNames);
+            mDeclaredNamesCollected = true;
+        }
+        auto declaredName = mDeclaredNames.find(source.name());
+        int declaredCount = declaredName == mDeclaredNames.end() ? 0 : declaredName->second;
+        return declaredCount == (source.getType().getQualifier() == EvqUniform ? 0 : 1);
+    }
+
+    TIntermFunctionDefinition *mFunctionDefinition;
+    CollectVariableAccessesTraverser mAccesses;
+    ReplaceKnownValuesTraverser mReplaceReads;
+    NameCounts mDeclaredNames;
+    bool mDeclaredNamesCollected;
+};
+
+// Removes the stores to local variables that are never read in the function, and the stores that
+// are overwritten later in the same block before they are read.
+class RemoveDeadStoresTraverser : public TIntermTraverser
+{
+  public:
+    RemoveDeadStoresTraverser(TSymbolTable *symbolTable)
+        : TIntermTraverser(true, false, false, symbolTable),
+          mAccesses(symbolTable),
+          mDidRemove(false)
+    {}
+
+    bool didRemove() const { return mDidRemove; }
+
+    bool visitFunctionDefinition(Visit visit, TIntermFunctionDefinition *node) override
+    {
+        mStoreCounts.clear();
+        countStores(node->getBody());
+        if (mStoreCounts.empty())
+        {
+            return false;
+        }
+
+        // Variables that are only referenced by the statements storing to them are never read.
+        mAccesses.collect(node->getBody());
+        mUnreadVariables.clear();
+        for (const auto &storeCount : mStoreCounts)
+        {
+            auto referenceCount = mAccesses.getReferenceCounts().find(storeCount.first);
+            ASSERT(referenceCount != mAccesses.getReferenceCounts().end());
+            if (referenceCount->second == storeCount.second)
+            {
+                mUnreadVariables.insert(storeCount.first);
+            }
+        }
+
+        removeStores(node->getBody());
+        return false;
+    }
+
+  private:
+    void countStores(TIntermBlock *block)
+    {
+        for (TIntermNode *statement : *block->getSequence())
+        {
+            TIntermBinary *store = GetLocalVariableStore(statement);
+            if (store != nullptr)
+            {
+                ++mStoreCounts[&GetStoredVariable(store)];
+            }
+            else if (const TVariable *variable = GetUninitializedLocalVariable(statement))
+            {
+                ++mStoreCounts[variable];
+            }
+            for (TIntermBlock *nestedBlock : GetNestedBlocks(statement))
+            {
+                if (nestedBlock != nullptr)
+                {
+                    countStores(nestedBlock);
+                }
+            }
+        }
+    }
+
+    void removeStores(TIntermBlock *block)
+    {
+        // The last store to each local variable in the block that hasn't been read yet.
+        std::unordered_map<const TVariable *, TIntermNode *> unreadStores;
+
+        for (TIntermNode *statement : *block->getSequence())
+        {
+            for (TIntermBlock *nestedBlock : GetNestedBlocks(statement))
+            {
+                if (nestedBlock != nullptr)
+                {
+                    removeStores(nestedBlock);
+                }
+            }
+            if (!IsStraightLineStatement(statement))
+            {
+                unreadStores.clear();
+                continue;
+            }
+
+            TIntermBinary *store      = GetLocalVariableStore(statement);
+            const TVariable *variable = store != nullptr ? &GetStoredVariable(store) : nullptr;
+
+            if (!unreadStores.empty())
+            {
+                mAccesses.collect(statement);
+                for (const auto &referenceCount : mAccesses.getReferenceCounts())
+                {
+                    // The stored variable is referenced once as the destination of the store.
+                    if (referenceCount.first != variable || referenceCount.second > 1)
+                    {
+                        unreadStores.erase(referenceCount.first);
+                    }
+                }
+            }
+
+            if (variable == nullptr)
+            {
+                continue;
+            }
+            if (mUnreadVariables.count(variable) > 0)
+            {
+                // Declarations of unread variables are left to RemoveUnreferencedVariables.
+                if (statement->getAsDeclarationNode() == nullptr)
+                {
+                    removeUnreadStore(block, store);
+                }
+                continue;
+            }
+
+            auto overwrittenStore = unreadStores.find(variable);
+            if (overwrittenStore != unreadStores.end())
+            {
+                removeOverwrittenStore(block, overwrittenStore->second);
+            }
+            if (store->getRight()->hasSideEffects())
+            {
+                unreadStores.erase(variable);
+            }
+            else
+            {
+                unreadStores[variable] = statement;
+            }
+        }
+    }
+
+    void removeUnreadStore(TIntermBlock *block, TIntermBinary *store)
+    {
+        TIntermTyped *value = store->getRight();
+        if (value->hasSideEffects())
+        {
+            queueReplacementWithParent(block, store, value, OriginalNode::IS_DROPPED);
+        }
+        else
+        {
+            mMultiReplacements.emplace_back(block, store, TIntermSequence());
+        }
+        mDidRemove = true;
+    }
+
+    void removeOverwrittenStore(TIntermBlock *block, TIntermNode *statement)
+    {
+        if (TIntermDeclaration *declaration = statement->getAsDeclarationNode())
+        {
+            // Keep the declaration but drop its initializer.
+            TIntermBinary *initializer = declaration->getSequence()->front()->getAsBinaryNode();
+            queueReplacementWithParent(declaration, initializer, initializer->getLeft(),
+                                       OriginalNode::IS_DROPPED);
+        }
+        else
+        {
+            mMultiReplacements.emplace_back(block, statement, TIntermSequence());
+        }
+        mDidRemove = true;
+    }
+
+    CollectVariableAccessesTraverser mAccesses;
+    std::unordered_map<const TVariable *, unsigned int> mStoreCounts;
+    VariableSet mUnreadVariables;
+    bool mDidRemove;
+};
+
+}  // anonymous namespace
+
+bool OptimizeLocalVariables(TCompiler *compiler, TIntermBlock *root, TSymbolTable *symbolTable)
+{
+    // Warnings about folded expressions, like division by zero, have already been given when the
+    // original constant expressions were folded, so they are kept out of the info log.
+    TInfoSinkBase foldingInfoSink;
+    TDiagnostics foldingDiagnostics(foldingInfoSink);
+
+    bool didChange = false;
+    for (int iteration = 0; iteration < kMaxIterations; ++iteration)
+    {
+        PropagateLocalValues propagateLocalValues(symbolTable);
+        for (TIntermNode *node : *root->getSequence())
+        {
+            TIntermFunctionDefinition *functionDefinition = node->getAsFunctionDefinition();
+            if (functionDefinition != nullptr)
+            {
+                propagateLocalValues.propagateInFunction(functionDefinition);
+            }
+        }
+
+        bool didReplace = propagateLocalValues.didReplace();
+        if (!propagateLocalValues.updateTree(compiler, root))
+        {
+            return false;
+        }
+        if (didReplace && !FoldExpressions(compiler, root, &foldingDiagnostics))
+        {
+            return false;
+        }
+
+        RemoveDeadStoresTraverser removeDeadStores(symbolTable);
+        root->traverse(&removeDeadStores);
+        if (!removeDeadStores.updateTree(compiler, root))
+        {
+            return false;
+        }
+
+        if (!didReplace && !removeDeadStores.didRemove())
+        {
+            break;
+        }
+        didChange = true;
+    }
+
+    if (!didChange)
+    {
+        return true;
+    }
+
+    // Removing stores may leave variables unreferenced and the final case of a switch empty.
+    if (!RemoveUnreferencedVariables(compiler, root, symbolTable))
+    {
+        return false;
+    }
+    return PruneEmptyCases(compiler, root);
+}
+
+}  // namespace sh
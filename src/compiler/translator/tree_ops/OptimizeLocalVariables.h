@@ -0,0 +1,31 @@
+//
+// Copyright 2020 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// OptimizeLocalVariables.h:
+//  Propagate constants and copies stored to local variables into the statements that read them,
+//  fold the resulting constant expressions and remove stores that are never read. Values are
+//  only tracked through straight-line code: anything written inside a nested block, loop or
+//  switch is forgotten after it. Requires SeparateDeclarations to have been run.
+//
+
+#ifndef COMPILER_TRANSLATOR_TREEOPS_OPTIMIZELOCALVARIABLES_H_
+#define COMPILER_TRANSLATOR_TREEOPS_OPTIMIZELOCALVARIABLES_H_
+
+#include "common/angleutils.h"
+
+namespace sh
+{
+
+class TCompiler;
+class TIntermBlock;
+class TSymbolTable;
+
+ANGLE_NO_DISCARD bool OptimizeLocalVariables(TCompiler *compiler,
+                                             TIntermBlock *root,
+                                             TSymbolTable *symbolTable);
+
+}  // namespace sh
+
+#endif  // COMPILER_TRANSLATOR_TREEOPS_OPTIMIZELOCALVARIABLES_H_
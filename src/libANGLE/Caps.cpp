@@ -899,6 +899,7 @@ const ExtensionInfoMap &GetExtensionInfoMap()
         map["GL_OES_point_sprite"] = enableableExtension(&Extensions::pointSprite);
         map["GL_OES_draw_texture"] = enableableExtension(&Extensions::drawTexture);
         map["GL_ANGLE_memory_size"] = enableableExtension(&Extensions::memorySize);
+        map["GL_ANGLE_gpu_profile"] = enableableExtension(&Extensions::gpuProfile);
         // clang-format on
 
 #if defined(ANGLE_ENABLE_ASSERTS)
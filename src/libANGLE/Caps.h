@@ -527,6 +527,9 @@ struct Extensions
     // GL_ANGLE_memory_size
     bool memorySize = false;
 
+    // GL_ANGLE_gpu_profile
+    bool gpuProfile = false;
+
     // GL_ANGLE_texture_multisample
     bool textureMultisample = false;
 
@@ -797,7 +797,10 @@ void Context::deleteProgram(ShaderProgramID program)
 
 void Context::deleteTexture(TextureID texture)
 {
-    if (mState.mTextureManager->getTexture(texture))
+    // Bindings and attachments hold references, so a texture that only the texture manager
+    // references is not bound anywhere and doesn't need to be detached.
+    Texture *textureObject = mState.mTextureManager->getTexture(texture);
+    if (textureObject && textureObject->getRefCount() > 1)
     {
         detachTexture(texture);
     }
@@ -1937,6 +1940,12 @@ void Context::getInteger64vImpl(GLenum pname, GLint64 *params)
             *params = mImplementation->getTimestamp();
             break;
 
+        // GL_ANGLE_gpu_profile
+        case GL_GPU_PROFILE_RENDER_PASS_TIME_ANGLE:
+        case GL_GPU_PROFILE_INTERNAL_TIME_ANGLE:
+            ANGLE_CONTEXT_TRY(mImplementation->getGpuProfileTime(this, pname, params));
+            break;
+
         case GL_MAX_SHADER_STORAGE_BLOCK_SIZE:
             *params = mState.mCaps.maxShaderStorageBlockSize;
             break;
@@ -2833,6 +2842,21 @@ void Context::detachTexture(TextureID texture)
     mState.detachTexture(this, mZeroTextures, texture);
 }
 
+void Context::detachTextures(const std::vector<TextureID> &sortedTextures)
+{
+    for (auto &imageBinding : mImageObserverBindings)
+    {
+        const Texture *tex = static_cast<const Texture *>(imageBinding.getSubject());
+        if (tex && std::binary_search(sortedTextures.begin(), sortedTextures.end(), tex->id(),
+                                      [](TextureID a, TextureID b) { return a.value < b.value; }))
+        {
+            imageBinding.reset();
+        }
+    }
+
+    mState.detachTextures(this, mZeroTextures, sortedTextures);
+}
+
 void Context::detachBuffer(Buffer *buffer)
 {
     // Simple pass-through to State's detachBuffer method, since
@@ -6052,11 +6076,39 @@ void Context::deleteRenderbuffers(GLsizei n, const RenderbufferID *renderbuffers
 
 void Context::deleteTextures(GLsizei n, const TextureID *textures)
 {
+    if (n == 1)
+    {
+        if (textures[0].value != 0)
+        {
+            deleteTexture(textures[0]);
+        }
+        return;
+    }
+
+    // Detach all the bound textures in a single pass over the bindings rather than walking every
+    // binding once per texture.
+    std::vector<TextureID> boundTextures;
+    for (int i = 0; i < n; i++)
+    {
+        Texture *textureObject = mState.mTextureManager->getTexture(textures[i]);
+        if (textures[i].value != 0 && textureObject && textureObject->getRefCount() > 1)
+        {
+            boundTextures.push_back(textures[i]);
+        }
+    }
+
+    if (!boundTextures.empty())
+    {
+        std::sort(boundTextures.begin(), boundTextures.end(),
+                  [](TextureID a, TextureID b) { return a.value < b.value; });
+        detachTextures(boundTextures);
+    }
+
     for (int i = 0; i < n; i++)
     {
         if (textures[i].value != 0)
         {
-            deleteTexture(textures[i]);
+            mState.mTextureManager->deleteObject(this, textures[i]);
         }
     }
 }
@@ -6579,7 +6631,7 @@ void Context::setUniform1iImpl(Program *program, GLint location, GLsizei count,
 
 void Context::onSamplerUniformChange(size_t textureUnitIndex)
 {
-    mState.onActiveTextureChange(this, textureUnitIndex);
+    mState.onSamplerUniformChange(this, textureUnitIndex);
     mStateCache.onActiveTextureChange(this);
 }
 
@@ -8167,6 +8219,15 @@ bool Context::getQueryParameterInfo(GLenum pname, GLenum *type, unsigned int *nu
             *type      = GL_INT;
             *numParams = 1;
             return true;
+        case GL_GPU_PROFILE_RENDER_PASS_TIME_ANGLE:
+        case GL_GPU_PROFILE_INTERNAL_TIME_ANGLE:
+            if (!getExtensions().gpuProfile)
+            {
+                return false;
+            }
+            *type      = GL_INT_64_ANGLEX;
+            *numParams = 1;
+            return true;
         case GL_COVERAGE_MODULATION_CHROMIUM:
             if (!getExtensions().framebufferMixedSamples)
             {
@@ -598,6 +598,7 @@ class Context final : public egl::LabeledObject, angle::NonCopyable, public angl
 
     void detachBuffer(Buffer *buffer);
     void detachTexture(TextureID texture);
+    void detachTextures(const std::vector<TextureID> &sortedTextures);
     void detachFramebuffer(FramebufferID framebuffer);
     void detachRenderbuffer(RenderbufferID renderbuffer);
     void detachVertexArray(VertexArrayID vertexArray);
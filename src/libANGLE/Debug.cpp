@@ -11,6 +11,7 @@
 #include "common/debug.h"
 
 #include <algorithm>
+#include <cstring>
 #include <tuple>
 
 namespace
@@ -72,10 +73,70 @@ const char *GLMessageTypeToString(GLenum type)
             return "other message";
     }
 }
+
+constexpr GLenum kGLMessageSources[] = {
+    GL_DEBUG_SOURCE_API,         GL_DEBUG_SOURCE_WINDOW_SYSTEM, GL_DEBUG_SOURCE_SHADER_COMPILER,
+    GL_DEBUG_SOURCE_THIRD_PARTY, GL_DEBUG_SOURCE_APPLICATION,   GL_DEBUG_SOURCE_OTHER,
+};
+
+constexpr GLenum kGLMessageTypes[] = {
+    GL_DEBUG_TYPE_ERROR,
+    GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR,
+    GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR,
+    GL_DEBUG_TYPE_PORTABILITY,
+    GL_DEBUG_TYPE_PERFORMANCE,
+    GL_DEBUG_TYPE_OTHER,
+    GL_DEBUG_TYPE_MARKER,
+    GL_DEBUG_TYPE_PUSH_GROUP,
+    GL_DEBUG_TYPE_POP_GROUP,
+};
+
+constexpr GLenum kGLMessageSeverities[] = {
+    GL_DEBUG_SEVERITY_HIGH,
+    GL_DEBUG_SEVERITY_MEDIUM,
+    GL_DEBUG_SEVERITY_LOW,
+    GL_DEBUG_SEVERITY_NOTIFICATION,
+};
+
+template <size_t N>
+size_t GetGLMessageEnumIndex(const GLenum (&values)[N], GLenum value)
+{
+    for (size_t index = 0; index < N; ++index)
+    {
+        if (values[index] == value)
+        {
+            return index;
+        }
+    }
+    return N;
+}
+
+// Returns the index of the (source, type, severity) combination in the enabled message table, or
+// the size of the table if any of the enums are unknown.
+size_t GetGLMessageKindIndex(GLenum source, GLenum type, GLenum severity)
+{
+    constexpr size_t kSourceCount   = ArraySize(kGLMessageSources);
+    constexpr size_t kTypeCount     = ArraySize(kGLMessageTypes);
+    constexpr size_t kSeverityCount = ArraySize(kGLMessageSeverities);
+    constexpr size_t kInvalidIndex  = kSourceCount * kTypeCount * kSeverityCount;
+
+    size_t sourceIndex = GetGLMessageEnumIndex(kGLMessageSources, source);
+    size_t typeIndex   = GetGLMessageEnumIndex(kGLMessageTypes, type);
+    size_t severityIdx = GetGLMessageEnumIndex(kGLMessageSeverities, severity);
+    if (sourceIndex == kSourceCount || typeIndex == kTypeCount || severityIdx == kSeverityCount)
+    {
+        return kInvalidIndex;
+    }
+
+    return (sourceIndex * kTypeCount + typeIndex) * kSeverityCount + severityIdx;
+}
 }  // namespace
 
 namespace gl
 {
+static_assert(ArraySize(kGLMessageSources) == 6, "Update Debug::kMessageSourceCount");
+static_assert(ArraySize(kGLMessageTypes) == 9, "Update Debug::kMessageTypeCount");
+static_assert(ArraySize(kGLMessageSeverities) == 4, "Update Debug::kMessageSeverityCount");
 
 Debug::Control::Control() {}
 
@@ -94,17 +155,34 @@ Debug::Debug(bool initialDebugState)
       mCallbackFunction(nullptr),
       mCallbackUserParam(nullptr),
       mMessages(),
+      mMessagesFront(0),
+      mMessagesCount(0),
+      mMessageArena(),
+      mMessageArenaFront(0),
+      mMessageArenaBack(0),
       mMaxLoggedMessages(0),
       mOutputSynchronous(false),
       mGroups()
 {
     pushDefaultGroup();
+    updateEnabledMessages();
 }
 
 Debug::~Debug() {}
 
 void Debug::setMaxLoggedMessages(GLuint maxLoggedMessages)
 {
+    // Keep the oldest messages that still fit, in order, at the start of the new ring.
+    std::vector<MessageHeader> messages(maxLoggedMessages);
+    size_t keptCount = std::min<size_t>(mMessagesCount, maxLoggedMessages);
+    for (size_t index = 0; index < keptCount; ++index)
+    {
+        messages[index] = mMessages[(mMessagesFront + index) % mMessages.size()];
+    }
+
+    mMessages.swap(messages);
+    mMessagesFront     = 0;
+    mMessagesCount     = keptCount;
     mMaxLoggedMessages = maxLoggedMessages;
 }
 
@@ -151,8 +229,7 @@ void Debug::insertMessage(GLenum source,
                           const std::string &message,
                           gl::LogSeverity logSeverity) const
 {
-    std::string messageCopy(message);
-    insertMessage(source, type, id, severity, std::move(messageCopy), logSeverity);
+    insertMessageImpl(source, type, id, severity, message.c_str(), message.length(), logSeverity);
 }
 
 void Debug::insertMessage(GLenum source,
@@ -161,29 +238,50 @@ void Debug::insertMessage(GLenum source,
                           GLenum severity,
                           std::string &&message,
                           gl::LogSeverity logSeverity) const
+{
+    insertMessageImpl(source, type, id, severity, message.c_str(), message.length(), logSeverity);
+}
+
+void Debug::insertMessage(GLenum source,
+                          GLenum type,
+                          GLuint id,
+                          GLenum severity,
+                          const char *message,
+                          gl::LogSeverity logSeverity) const
+{
+    insertMessageImpl(source, type, id, severity, message, strlen(message), logSeverity);
+}
+
+void Debug::insertMessageImpl(GLenum source,
+                              GLenum type,
+                              GLuint id,
+                              GLenum severity,
+                              const char *message,
+                              size_t messageLength,
+                              gl::LogSeverity logSeverity) const
 {
     {
-        // output all messages to the debug log
+        // output all messages to the debug log.  The log streams are lazy, so the message is only
+        // formatted if the platform accepts messages of this severity.
         const char *messageTypeString = GLMessageTypeToString(type);
         const char *severityString    = GLSeverityToString(severity);
-        std::ostringstream messageStream;
-        messageStream << "GL " << messageTypeString << ": " << severityString << ": " << message;
         switch (logSeverity)
         {
             case gl::LOG_FATAL:
-                FATAL() << messageStream.str();
+                FATAL() << "GL " << messageTypeString << ": " << severityString << ": " << message;
                 break;
             case gl::LOG_ERR:
-                ERR() << messageStream.str();
+                ERR() << "GL " << messageTypeString << ": " << severityString << ": " << message;
                 break;
             case gl::LOG_WARN:
-                WARN() << messageStream.str();
+                WARN() << "GL " << messageTypeString << ": " << severityString << ": " << message;
                 break;
             case gl::LOG_INFO:
-                INFO() << messageStream.str();
+                INFO() << "GL " << messageTypeString << ": " << severityString << ": " << message;
                 break;
             case gl::LOG_EVENT:
-                ANGLE_LOG(EVENT) << messageStream.str();
+                ANGLE_LOG(EVENT) << "GL " << messageTypeString << ": " << severityString << ": "
+                                 << message;
                 break;
         }
     }
@@ -197,25 +295,80 @@ void Debug::insertMessage(GLenum source,
     {
         // TODO(geofflang) Check the synchronous flag and potentially flush messages from another
         // thread.
-        mCallbackFunction(source, type, id, severity, static_cast<GLsizei>(message.length()),
-                          message.c_str(), mCallbackUserParam);
+        mCallbackFunction(source, type, id, severity, static_cast<GLsizei>(messageLength), message,
+                          mCallbackUserParam);
     }
     else
     {
-        if (mMessages.size() >= mMaxLoggedMessages)
+        if (mMessagesCount >= mMaxLoggedMessages)
         {
             // Drop messages over the limit
             return;
         }
 
-        Message m;
-        m.source   = source;
-        m.type     = type;
-        m.id       = id;
-        m.severity = severity;
-        m.message  = std::move(message);
+        if (messageLength > 0)
+        {
+            reserveMessageArena(messageLength);
+            memcpy(mMessageArena.data() + mMessageArenaBack, message, messageLength);
+        }
+
+        MessageHeader &m = mMessages[(mMessagesFront + mMessagesCount) % mMessages.size()];
+        m.source         = source;
+        m.type           = type;
+        m.id             = id;
+        m.severity       = severity;
+        m.offset         = mMessageArenaBack;
+        m.length         = messageLength;
+
+        mMessageArenaBack += messageLength;
+        mMessagesCount++;
+    }
+}
+
+void Debug::reserveMessageArena(size_t length) const
+{
+    if (mMessageArenaBack + length <= mMessageArena.size())
+    {
+        return;
+    }
+
+    // Slide the pending messages to the start of the arena before considering growing it.
+    if (mMessageArenaFront > 0)
+    {
+        size_t pendingBytes = mMessageArenaBack - mMessageArenaFront;
+        memmove(mMessageArena.data(), mMessageArena.data() + mMessageArenaFront, pendingBytes);
+        for (size_t index = 0; index < mMessagesCount; ++index)
+        {
+            mMessages[(mMessagesFront + index) % mMessages.size()].offset -= mMessageArenaFront;
+        }
+        mMessageArenaBack  = pendingBytes;
+        mMessageArenaFront = 0;
+    }
+
+    if (mMessageArenaBack + length > mMessageArena.size())
+    {
+        mMessageArena.resize(std::max(mMessageArenaBack + length, mMessageArena.size() * 2));
+    }
+}
+
+const Debug::MessageHeader &Debug::getFrontMessage() const
+{
+    ASSERT(mMessagesCount > 0);
+    return mMessages[mMessagesFront];
+}
+
+void Debug::popFrontMessage()
+{
+    const MessageHeader &m = getFrontMessage();
+    mMessageArenaFront     = m.offset + m.length;
+
+    mMessagesFront = (mMessagesFront + 1) % mMessages.size();
+    mMessagesCount--;
 
-        mMessages.push_back(std::move(m));
+    if (mMessagesCount == 0)
+    {
+        mMessageArenaFront = 0;
+        mMessageArenaBack  = 0;
     }
 }
 
@@ -230,20 +383,20 @@ size_t Debug::getMessages(GLuint count,
 {
     size_t messageCount       = 0;
     size_t messageStringIndex = 0;
-    while (messageCount <= count && !mMessages.empty())
+    while (messageCount <= count && mMessagesCount > 0)
     {
-        const Message &m = mMessages.front();
+        const MessageHeader &m = getFrontMessage();
 
         if (messageLog != nullptr)
         {
             // Check that this message can fit in the message buffer
-            if (messageStringIndex + m.message.length() + 1 > static_cast<size_t>(bufSize))
+            if (messageStringIndex + m.length + 1 > static_cast<size_t>(bufSize))
             {
                 break;
             }
 
-            std::copy(m.message.begin(), m.message.end(), messageLog + messageStringIndex);
-            messageStringIndex += m.message.length();
+            memcpy(messageLog + messageStringIndex, mMessageArena.data() + m.offset, m.length);
+            messageStringIndex += m.length;
 
             messageLog[messageStringIndex] = '\0';
             messageStringIndex += 1;
@@ -271,10 +424,10 @@ size_t Debug::getMessages(GLuint count,
 
         if (lengths != nullptr)
         {
-            lengths[messageCount] = static_cast<GLsizei>(m.message.length());
+            lengths[messageCount] = static_cast<GLsizei>(m.length);
         }
 
-        mMessages.pop_front();
+        popFrontMessage();
 
         messageCount++;
     }
@@ -284,12 +437,12 @@ size_t Debug::getMessages(GLuint count,
 
 size_t Debug::getNextMessageLength() const
 {
-    return mMessages.empty() ? 0 : mMessages.front().message.length();
+    return mMessagesCount == 0 ? 0 : getFrontMessage().length;
 }
 
 size_t Debug::getMessageCount() const
 {
-    return mMessages.size();
+    return mMessagesCount;
 }
 
 void Debug::setMessageControl(GLenum source,
@@ -307,12 +460,14 @@ void Debug::setMessageControl(GLenum source,
 
     auto &controls = mGroups.back().controls;
     controls.push_back(std::move(c));
+
+    updateEnabledMessages();
 }
 
 void Debug::pushGroup(GLenum source, GLuint id, std::string &&message)
 {
-    insertMessage(source, GL_DEBUG_TYPE_PUSH_GROUP, id, GL_DEBUG_SEVERITY_NOTIFICATION,
-                  std::string(message), gl::LOG_INFO);
+    insertMessage(source, GL_DEBUG_TYPE_PUSH_GROUP, id, GL_DEBUG_SEVERITY_NOTIFICATION, message,
+                  gl::LOG_INFO);
 
     Group g;
     g.source  = source;
@@ -326,9 +481,15 @@ void Debug::popGroup()
     // Make sure the default group is not about to be popped
     ASSERT(mGroups.size() > 1);
 
-    Group g = mGroups.back();
+    Group g = std::move(mGroups.back());
     mGroups.pop_back();
 
+    // The new group starts without controls, so only popping one that had some changes the result.
+    if (!g.controls.empty())
+    {
+        updateEnabledMessages();
+    }
+
     insertMessage(g.source, GL_DEBUG_TYPE_POP_GROUP, g.id, GL_DEBUG_SEVERITY_NOTIFICATION,
                   g.message, gl::LOG_INFO);
 }
@@ -345,6 +506,20 @@ bool Debug::isMessageEnabled(GLenum source, GLenum type, GLuint id, GLenum sever
         return false;
     }
 
+    size_t kindIndex = GetGLMessageKindIndex(source, type, severity);
+    if (kindIndex >= kMessageKindCount || mIdControlledMessages.test(kindIndex))
+    {
+        return isMessageEnabledByControls(source, type, id, severity);
+    }
+
+    return mEnabledMessages.test(kindIndex);
+}
+
+bool Debug::isMessageEnabledByControls(GLenum source,
+                                       GLenum type,
+                                       GLuint id,
+                                       GLenum severity) const
+{
     for (auto groupIter = mGroups.rbegin(); groupIter != mGroups.rend(); groupIter++)
     {
         const auto &controls = groupIter->controls;
@@ -380,6 +555,56 @@ bool Debug::isMessageEnabled(GLenum source, GLenum type, GLuint id, GLenum sever
     return true;
 }
 
+void Debug::updateEnabledMessages()
+{
+    mEnabledMessages.reset();
+    mIdControlledMessages.reset();
+
+    for (GLenum source : kGLMessageSources)
+    {
+        for (GLenum type : kGLMessageTypes)
+        {
+            for (GLenum severity : kGLMessageSeverities)
+            {
+                size_t kindIndex = GetGLMessageKindIndex(source, type, severity);
+                bool enabled     = true;
+                bool resolved    = false;
+
+                for (auto groupIter = mGroups.rbegin(); !resolved && groupIter != mGroups.rend();
+                     groupIter++)
+                {
+                    const auto &controls = groupIter->controls;
+                    for (auto controlIter = controls.rbegin(); controlIter != controls.rend();
+                         controlIter++)
+                    {
+                        const auto &control = *controlIter;
+                        if ((control.source != GL_DONT_CARE && control.source != source) ||
+                            (control.type != GL_DONT_CARE && control.type != type) ||
+                            (control.severity != GL_DONT_CARE && control.severity != severity))
+                        {
+                            continue;
+                        }
+
+                        // The result now depends on the message id; defer to the full walk.
+                        if (!control.ids.empty())
+                        {
+                            mIdControlledMessages.set(kindIndex);
+                        }
+                        else
+                        {
+                            enabled = control.enabled;
+                        }
+                        resolved = true;
+                        break;
+                    }
+                }
+
+                mEnabledMessages.set(kindIndex, enabled);
+            }
+        }
+    }
+}
+
 void Debug::pushDefaultGroup()
 {
     Group g;
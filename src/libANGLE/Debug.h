@@ -14,7 +14,7 @@
 #include "common/angleutils.h"
 #include "libANGLE/AttributeMap.h"
 
-#include <deque>
+#include <bitset>
 #include <string>
 #include <vector>
 
@@ -60,6 +60,12 @@ class Debug : angle::NonCopyable
                        GLenum severity,
                        std::string &&message,
                        gl::LogSeverity logSeverity) const;
+    void insertMessage(GLenum source,
+                       GLenum type,
+                       GLuint id,
+                       GLenum severity,
+                       const char *message,
+                       gl::LogSeverity logSeverity) const;
 
     void setMessageControl(GLenum source,
                            GLenum type,
@@ -82,19 +88,37 @@ class Debug : angle::NonCopyable
     size_t getGroupStackDepth() const;
 
   private:
+    void insertMessageImpl(GLenum source,
+                           GLenum type,
+                           GLuint id,
+                           GLenum severity,
+                           const char *message,
+                           size_t messageLength,
+                           gl::LogSeverity logSeverity) const;
+
     bool isMessageEnabled(GLenum source, GLenum type, GLuint id, GLenum severity) const;
+    bool isMessageEnabledByControls(GLenum source, GLenum type, GLuint id, GLenum severity) const;
+    void updateEnabledMessages();
 
     void pushDefaultGroup();
 
-    struct Message
+    // Logged messages are kept in a fixed-capacity ring of headers that index into a FIFO byte
+    // arena.  The arena only grows until it can hold the largest backlog the application lets
+    // accumulate; after that, inserting and draining messages does not allocate.
+    struct MessageHeader
     {
         GLenum source;
         GLenum type;
         GLuint id;
         GLenum severity;
-        std::string message;
+        size_t offset;
+        size_t length;
     };
 
+    const MessageHeader &getFrontMessage() const;
+    void popFrontMessage();
+    void reserveMessageArena(size_t length) const;
+
     struct Control
     {
         Control();
@@ -124,10 +148,26 @@ class Debug : angle::NonCopyable
     bool mOutputEnabled;
     GLDEBUGPROCKHR mCallbackFunction;
     const void *mCallbackUserParam;
-    mutable std::deque<Message> mMessages;
+    mutable std::vector<MessageHeader> mMessages;
+    mutable size_t mMessagesFront;
+    mutable size_t mMessagesCount;
+    mutable std::vector<char> mMessageArena;
+    mutable size_t mMessageArenaFront;
+    mutable size_t mMessageArenaBack;
     GLuint mMaxLoggedMessages;
     bool mOutputSynchronous;
     std::vector<Group> mGroups;
+
+    // Result of the message controls for every (source, type, severity) combination, recomputed
+    // whenever the controls change.  Combinations that are affected by an id-specific control are
+    // flagged in mIdControlledMessages and fall back to walking the controls.
+    static constexpr size_t kMessageSourceCount   = 6;
+    static constexpr size_t kMessageTypeCount     = 9;
+    static constexpr size_t kMessageSeverityCount = 4;
+    static constexpr size_t kMessageKindCount =
+        kMessageSourceCount * kMessageTypeCount * kMessageSeverityCount;
+    std::bitset<kMessageKindCount> mEnabledMessages;
+    std::bitset<kMessageKindCount> mIdControlledMessages;
 };
 }  // namespace gl
 
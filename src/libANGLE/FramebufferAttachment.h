@@ -220,7 +220,7 @@ class FramebufferAttachmentObject : public angle::Subject
                                             GLsizei samples,
                                             rx::FramebufferAttachmentRenderTarget **rtOut) const;
 
-    angle::Result initializeContents(const Context *context, const ImageIndex &imageIndex);
+    virtual angle::Result initializeContents(const Context *context, const ImageIndex &imageIndex);
 
   protected:
     virtual rx::FramebufferAttachmentObjectImpl *getAttachmentImpl() const = 0;
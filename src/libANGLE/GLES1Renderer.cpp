@@ -24,12 +24,33 @@
 namespace
 {
 #include "libANGLE/GLES1Shaders.inc"
+
+void AddConstantDefinition(std::ostream &stream, const char *name, bool value)
+{
+    stream << "const bool " << name << " = " << (value ? "true" : "false") << ";\n";
+}
+
+template <size_t N>
+void AddConstantArrayDefinition(std::ostream &stream, const char *name, const bool (&values)[N])
+{
+    stream << "const bool " << name << "[" << N << "] = bool[" << N << "](";
+    for (size_t i = 0; i < N; i++)
+    {
+        stream << (i > 0 ? ", " : "") << (values[i] ? "true" : "false");
+    }
+    stream << ");\n";
+}
 }  // anonymous namespace
 
 namespace gl
 {
 
-GLES1Renderer::GLES1Renderer() : mRendererProgramInitialized(false) {}
+GLES1Renderer::GLES1Renderer()
+    : mRendererProgramInitialized(false),
+      mShaderPrograms(nullptr),
+      mUniformBuffers(),
+      mCurrentProgramState(nullptr)
+{}
 
 void GLES1Renderer::onDestroy(Context *context, State *state)
 {
@@ -37,7 +58,23 @@ void GLES1Renderer::onDestroy(Context *context, State *state)
     {
         (void)state->setProgram(context, 0);
 
-        mShaderPrograms->deleteProgram(context, {mProgramState.program});
+        // The programs that are still compiling don't exist yet, and the others own their
+        // fragment shader until the link is resolved.
+        for (auto &programState : mProgramStates)
+        {
+            if (programState.second->program.value != 0)
+            {
+                mShaderPrograms->deleteProgram(context, programState.second->program);
+            }
+            if (programState.second->fragmentShader.value != 0)
+            {
+                mShaderPrograms->deleteShader(context, programState.second->fragmentShader);
+            }
+        }
+        mShaderPrograms->deleteShader(context, mVertexShader);
+        mProgramStates.clear();
+        mCurrentProgramState = nullptr;
+
         mShaderPrograms->release(context);
         mShaderPrograms             = nullptr;
         mRendererProgramInitialized = false;
@@ -52,47 +89,64 @@ angle::Result GLES1Renderer::prepareForDraw(PrimitiveMode mode, Context *context
 
     GLES1State &gles1State = glState->gles1();
 
-    Program *programObject = getProgram(mProgramState.program);
+    // The uniforms of every program have to catch up with the state that changed.  The ones that
+    // aren't used by this draw are updated when they are used next.
+    if (gles1State.mDirtyBits.any())
+    {
+        for (auto &programState : mProgramStates)
+        {
+            programState.second->dirtyBits |= gles1State.mDirtyBits;
+        }
+    }
+
+    if (gles1State.isDirty(GLES1State::DIRTY_GLES1_FEATURE_ENABLE) ||
+        gles1State.isDirty(GLES1State::DIRTY_GLES1_TEXTURE_UNIT_ENABLE) ||
+        gles1State.isDirty(GLES1State::DIRTY_GLES1_FOG) ||
+        gles1State.isDirty(GLES1State::DIRTY_GLES1_CLIP_PLANES))
+    {
+        mProgramKey = GetProgramKey(*glState);
+    }
+
+    GLES1ProgramState *programState = nullptr;
+    ANGLE_TRY(getProgramState(context, &programState));
+    if (programState != mCurrentProgramState)
+    {
+        ANGLE_TRY(useProgram(context, glState, programState));
+    }
+
+    Program *programObject = getProgram(programState->program);
 
     GLES1UniformBuffers &uniformBuffers = mUniformBuffers;
+    GLES1State::DirtyBits &dirtyBits    = programState->dirtyBits;
 
-    // If anything is dirty in gles1 or the common parts of gles1/2, just redo these parts
-    // completely for now.
+    // Only the uniforms of the state that changed since they were last set in this program are
+    // set again.
 
     // Feature enables
+    if (dirtyBits.test(GLES1State::DIRTY_GLES1_FEATURE_ENABLE))
     {
-        setUniform1i(context, programObject, mProgramState.enableAlphaTestLoc,
+        setUniform1i(context, programObject, programState->enableAlphaTestLoc,
                      glState->getEnableFeature(GL_ALPHA_TEST));
-        setUniform1i(context, programObject, mProgramState.enableLightingLoc,
+        setUniform1i(context, programObject, programState->enableLightingLoc,
                      glState->getEnableFeature(GL_LIGHTING));
-        setUniform1i(context, programObject, mProgramState.enableRescaleNormalLoc,
+        setUniform1i(context, programObject, programState->enableRescaleNormalLoc,
                      glState->getEnableFeature(GL_RESCALE_NORMAL));
-        setUniform1i(context, programObject, mProgramState.enableNormalizeLoc,
+        setUniform1i(context, programObject, programState->enableNormalizeLoc,
                      glState->getEnableFeature(GL_NORMALIZE));
-        setUniform1i(context, programObject, mProgramState.enableColorMaterialLoc,
+        setUniform1i(context, programObject, programState->enableColorMaterialLoc,
                      glState->getEnableFeature(GL_COLOR_MATERIAL));
-        setUniform1i(context, programObject, mProgramState.fogEnableLoc,
+        setUniform1i(context, programObject, programState->fogEnableLoc,
                      glState->getEnableFeature(GL_FOG));
-
-        bool enableClipPlanes = false;
-        for (int i = 0; i < kClipPlaneCount; i++)
-        {
-            uniformBuffers.clipPlaneEnables[i] = glState->getEnableFeature(GL_CLIP_PLANE0 + i);
-            enableClipPlanes = enableClipPlanes || uniformBuffers.clipPlaneEnables[i];
-        }
-
-        setUniform1i(context, programObject, mProgramState.enableClipPlanesLoc, enableClipPlanes);
+        setUniform1i(context, programObject, programState->pointSpriteEnabledLoc,
+                     glState->getEnableFeature(GL_POINT_SPRITE_OES));
     }
 
-    // Texture unit enables and format info
+    // Texture unit enables
+    if (dirtyBits.test(GLES1State::DIRTY_GLES1_TEXTURE_UNIT_ENABLE))
     {
         std::array<GLint, kTexUnitCount> &tex2DEnables   = uniformBuffers.tex2DEnables;
         std::array<GLint, kTexUnitCount> &texCubeEnables = uniformBuffers.texCubeEnables;
 
-        std::vector<int> tex2DFormats = {GL_RGBA, GL_RGBA, GL_RGBA, GL_RGBA};
-
-        Vec4Uniform *cropRectBuffer = uniformBuffers.texCropRects.data();
-
         for (int i = 0; i < kTexUnitCount; i++)
         {
             // GL_OES_cube_map allows only one of TEXTURE_2D / TEXTURE_CUBE_MAP
@@ -116,11 +170,28 @@ angle::Result GLES1Renderer::prepareForDraw(PrimitiveMode mode, Context *context
             texCubeEnables[i] = gles1State.isTextureTargetEnabled(i, TextureType::CubeMap);
             tex2DEnables[i] =
                 !texCubeEnables[i] && (gles1State.isTextureTargetEnabled(i, TextureType::_2D));
+        }
+
+        setUniform1iv(context, programObject, programState->enableTexture2DLoc, kTexUnitCount,
+                      tex2DEnables.data());
+        setUniform1iv(context, programObject, programState->enableTextureCubeMapLoc,
+                      kTexUnitCount, texCubeEnables.data());
+    }
+
+    // Texture format info.  It depends on the bound textures, which aren't tracked by the GLES1
+    // dirty bits, so it is compared with the values in the program instead.
+    {
+        std::array<GLint, kTexUnitCount> &textureFormats = uniformBuffers.textureFormats;
+        Vec4Uniform *cropRectBuffer                      = uniformBuffers.texCropRects.data();
+
+        for (int i = 0; i < kTexUnitCount; i++)
+        {
+            textureFormats[i] = GL_RGBA;
 
             Texture *curr2DTexture = glState->getSamplerTexture(i, TextureType::_2D);
             if (curr2DTexture)
             {
-                tex2DFormats[i] = gl::GetUnsizedFormat(
+                textureFormats[i] = gl::GetUnsizedFormat(
                     curr2DTexture->getFormat(TextureTarget::_2D, 0).info->internalFormat);
 
                 const gl::Rectangle &cropRect = curr2DTexture->getCrop();
@@ -140,21 +211,30 @@ angle::Result GLES1Renderer::prepareForDraw(PrimitiveMode mode, Context *context
             }
         }
 
-        setUniform1iv(context, programObject, mProgramState.enableTexture2DLoc, kTexUnitCount,
-                      tex2DEnables.data());
-        setUniform1iv(context, programObject, mProgramState.enableTextureCubeMapLoc, kTexUnitCount,
-                      texCubeEnables.data());
-
-        setUniform1iv(context, programObject, mProgramState.textureFormatLoc, kTexUnitCount,
-                      tex2DFormats.data());
+        if (!programState->areUntrackedUniformsSet ||
+            programState->textureFormats != textureFormats)
+        {
+            setUniform1iv(context, programObject, programState->textureFormatLoc, kTexUnitCount,
+                          textureFormats.data());
+            programState->textureFormats = textureFormats;
+        }
 
-        setUniform4fv(programObject, mProgramState.drawTextureNormalizedCropRectLoc, kTexUnitCount,
-                      reinterpret_cast<GLfloat *>(cropRectBuffer));
+        if (!programState->areUntrackedUniformsSet ||
+            memcmp(programState->texCropRects.data(), cropRectBuffer,
+                   sizeof(programState->texCropRects)) != 0)
+        {
+            setUniform4fv(programObject, programState->drawTextureNormalizedCropRectLoc,
+                          kTexUnitCount, reinterpret_cast<GLfloat *>(cropRectBuffer));
+            memcpy(programState->texCropRects.data(), cropRectBuffer,
+                   sizeof(programState->texCropRects));
+        }
     }
 
-    // Client state / current vector enables
+    // Client state / current vector enables.  The current point size is part of the point
+    // parameters.
     if (gles1State.isDirty(GLES1State::DIRTY_GLES1_CLIENT_STATE_ENABLE) ||
-        gles1State.isDirty(GLES1State::DIRTY_GLES1_CURRENT_VECTOR))
+        gles1State.isDirty(GLES1State::DIRTY_GLES1_CURRENT_VECTOR) ||
+        gles1State.isDirty(GLES1State::DIRTY_GLES1_POINT_PARAMETERS))
     {
         if (!gles1State.isClientStateEnabled(ClientVertexArrayType::Normal))
         {
@@ -187,17 +267,17 @@ angle::Result GLES1Renderer::prepareForDraw(PrimitiveMode mode, Context *context
     }
 
     // Matrices
-    if (gles1State.isDirty(GLES1State::DIRTY_GLES1_MATRICES))
+    if (dirtyBits.test(GLES1State::DIRTY_GLES1_MATRICES))
     {
         angle::Mat4 proj = gles1State.mProjectionMatrices.back();
-        setUniformMatrix4fv(programObject, mProgramState.projMatrixLoc, 1, GL_FALSE, proj.data());
+        setUniformMatrix4fv(programObject, programState->projMatrixLoc, 1, GL_FALSE, proj.data());
 
         angle::Mat4 modelview = gles1State.mModelviewMatrices.back();
-        setUniformMatrix4fv(programObject, mProgramState.modelviewMatrixLoc, 1, GL_FALSE,
+        setUniformMatrix4fv(programObject, programState->modelviewMatrixLoc, 1, GL_FALSE,
                             modelview.data());
 
         angle::Mat4 modelviewInvTr = modelview.transpose().inverse();
-        setUniformMatrix4fv(programObject, mProgramState.modelviewInvTrLoc, 1, GL_FALSE,
+        setUniformMatrix4fv(programObject, programState->modelviewInvTrLoc, 1, GL_FALSE,
                             modelviewInvTr.data());
 
         Mat4Uniform *textureMatrixBuffer = uniformBuffers.textureMatrices.data();
@@ -208,11 +288,11 @@ angle::Result GLES1Renderer::prepareForDraw(PrimitiveMode mode, Context *context
             memcpy(textureMatrixBuffer + i, textureMatrix.data(), sizeof(Mat4Uniform));
         }
 
-        setUniformMatrix4fv(programObject, mProgramState.textureMatrixLoc, kTexUnitCount, GL_FALSE,
+        setUniformMatrix4fv(programObject, programState->textureMatrixLoc, kTexUnitCount, GL_FALSE,
                             reinterpret_cast<float *>(uniformBuffers.textureMatrices.data()));
     }
 
-    if (gles1State.isDirty(GLES1State::DIRTY_GLES1_TEXTURE_ENVIRONMENT))
+    if (dirtyBits.test(GLES1State::DIRTY_GLES1_TEXTURE_ENVIRONMENT))
     {
         for (int i = 0; i < kTexUnitCount; i++)
         {
@@ -247,88 +327,88 @@ angle::Result GLES1Renderer::prepareForDraw(PrimitiveMode mode, Context *context
             uniformBuffers.pointSpriteCoordReplaces[i] = env.pointSpriteCoordReplace;
         }
 
-        setUniform1iv(context, programObject, mProgramState.textureEnvModeLoc, kTexUnitCount,
+        setUniform1iv(context, programObject, programState->textureEnvModeLoc, kTexUnitCount,
                       uniformBuffers.texEnvModes.data());
-        setUniform1iv(context, programObject, mProgramState.combineRgbLoc, kTexUnitCount,
+        setUniform1iv(context, programObject, programState->combineRgbLoc, kTexUnitCount,
                       uniformBuffers.texCombineRgbs.data());
-        setUniform1iv(context, programObject, mProgramState.combineAlphaLoc, kTexUnitCount,
+        setUniform1iv(context, programObject, programState->combineAlphaLoc, kTexUnitCount,
                       uniformBuffers.texCombineAlphas.data());
 
-        setUniform1iv(context, programObject, mProgramState.src0rgbLoc, kTexUnitCount,
+        setUniform1iv(context, programObject, programState->src0rgbLoc, kTexUnitCount,
                       uniformBuffers.texCombineSrc0Rgbs.data());
-        setUniform1iv(context, programObject, mProgramState.src0alphaLoc, kTexUnitCount,
+        setUniform1iv(context, programObject, programState->src0alphaLoc, kTexUnitCount,
                       uniformBuffers.texCombineSrc0Alphas.data());
-        setUniform1iv(context, programObject, mProgramState.src1rgbLoc, kTexUnitCount,
+        setUniform1iv(context, programObject, programState->src1rgbLoc, kTexUnitCount,
                       uniformBuffers.texCombineSrc1Rgbs.data());
-        setUniform1iv(context, programObject, mProgramState.src1alphaLoc, kTexUnitCount,
+        setUniform1iv(context, programObject, programState->src1alphaLoc, kTexUnitCount,
                       uniformBuffers.texCombineSrc1Alphas.data());
-        setUniform1iv(context, programObject, mProgramState.src2rgbLoc, kTexUnitCount,
+        setUniform1iv(context, programObject, programState->src2rgbLoc, kTexUnitCount,
                       uniformBuffers.texCombineSrc2Rgbs.data());
-        setUniform1iv(context, programObject, mProgramState.src2alphaLoc, kTexUnitCount,
+        setUniform1iv(context, programObject, programState->src2alphaLoc, kTexUnitCount,
                       uniformBuffers.texCombineSrc2Alphas.data());
 
-        setUniform1iv(context, programObject, mProgramState.op0rgbLoc, kTexUnitCount,
+        setUniform1iv(context, programObject, programState->op0rgbLoc, kTexUnitCount,
                       uniformBuffers.texCombineOp0Rgbs.data());
-        setUniform1iv(context, programObject, mProgramState.op0alphaLoc, kTexUnitCount,
+        setUniform1iv(context, programObject, programState->op0alphaLoc, kTexUnitCount,
                       uniformBuffers.texCombineOp0Alphas.data());
-        setUniform1iv(context, programObject, mProgramState.op1rgbLoc, kTexUnitCount,
+        setUniform1iv(context, programObject, programState->op1rgbLoc, kTexUnitCount,
                       uniformBuffers.texCombineOp1Rgbs.data());
-        setUniform1iv(context, programObject, mProgramState.op1alphaLoc, kTexUnitCount,
+        setUniform1iv(context, programObject, programState->op1alphaLoc, kTexUnitCount,
                       uniformBuffers.texCombineOp1Alphas.data());
-        setUniform1iv(context, programObject, mProgramState.op2rgbLoc, kTexUnitCount,
+        setUniform1iv(context, programObject, programState->op2rgbLoc, kTexUnitCount,
                       uniformBuffers.texCombineOp2Rgbs.data());
-        setUniform1iv(context, programObject, mProgramState.op2alphaLoc, kTexUnitCount,
+        setUniform1iv(context, programObject, programState->op2alphaLoc, kTexUnitCount,
                       uniformBuffers.texCombineOp2Alphas.data());
 
-        setUniform4fv(programObject, mProgramState.textureEnvColorLoc, kTexUnitCount,
+        setUniform4fv(programObject, programState->textureEnvColorLoc, kTexUnitCount,
                       reinterpret_cast<float *>(uniformBuffers.texEnvColors.data()));
-        setUniform1fv(programObject, mProgramState.rgbScaleLoc, kTexUnitCount,
+        setUniform1fv(programObject, programState->rgbScaleLoc, kTexUnitCount,
                       uniformBuffers.texEnvRgbScales.data());
-        setUniform1fv(programObject, mProgramState.alphaScaleLoc, kTexUnitCount,
+        setUniform1fv(programObject, programState->alphaScaleLoc, kTexUnitCount,
                       uniformBuffers.texEnvAlphaScales.data());
 
-        setUniform1iv(context, programObject, mProgramState.pointSpriteCoordReplaceLoc,
+        setUniform1iv(context, programObject, programState->pointSpriteCoordReplaceLoc,
                       kTexUnitCount, uniformBuffers.pointSpriteCoordReplaces.data());
     }
 
     // Alpha test
-    if (gles1State.isDirty(GLES1State::DIRTY_GLES1_ALPHA_TEST))
+    if (dirtyBits.test(GLES1State::DIRTY_GLES1_ALPHA_TEST))
     {
-        setUniform1i(context, programObject, mProgramState.alphaFuncLoc,
+        setUniform1i(context, programObject, programState->alphaFuncLoc,
                      ToGLenum(gles1State.mAlphaTestFunc));
-        setUniform1f(programObject, mProgramState.alphaTestRefLoc, gles1State.mAlphaTestRef);
+        setUniform1f(programObject, programState->alphaTestRefLoc, gles1State.mAlphaTestRef);
     }
 
     // Shading, materials, and lighting
-    if (gles1State.isDirty(GLES1State::DIRTY_GLES1_SHADE_MODEL))
+    if (dirtyBits.test(GLES1State::DIRTY_GLES1_SHADE_MODEL))
     {
-        setUniform1i(context, programObject, mProgramState.shadeModelFlatLoc,
+        setUniform1i(context, programObject, programState->shadeModelFlatLoc,
                      gles1State.mShadeModel == ShadingModel::Flat);
     }
 
-    if (gles1State.isDirty(GLES1State::DIRTY_GLES1_MATERIAL))
+    if (dirtyBits.test(GLES1State::DIRTY_GLES1_MATERIAL))
     {
         const auto &material = gles1State.mMaterial;
 
-        setUniform4fv(programObject, mProgramState.materialAmbientLoc, 1, material.ambient.data());
-        setUniform4fv(programObject, mProgramState.materialDiffuseLoc, 1, material.diffuse.data());
-        setUniform4fv(programObject, mProgramState.materialSpecularLoc, 1,
+        setUniform4fv(programObject, programState->materialAmbientLoc, 1, material.ambient.data());
+        setUniform4fv(programObject, programState->materialDiffuseLoc, 1, material.diffuse.data());
+        setUniform4fv(programObject, programState->materialSpecularLoc, 1,
                       material.specular.data());
-        setUniform4fv(programObject, mProgramState.materialEmissiveLoc, 1,
+        setUniform4fv(programObject, programState->materialEmissiveLoc, 1,
                       material.emissive.data());
-        setUniform1f(programObject, mProgramState.materialSpecularExponentLoc,
+        setUniform1f(programObject, programState->materialSpecularExponentLoc,
                      material.specularExponent);
     }
 
-    if (gles1State.isDirty(GLES1State::DIRTY_GLES1_LIGHTS))
+    if (dirtyBits.test(GLES1State::DIRTY_GLES1_LIGHTS))
     {
         const auto &lightModel = gles1State.mLightModel;
 
-        setUniform4fv(programObject, mProgramState.lightModelSceneAmbientLoc, 1,
+        setUniform4fv(programObject, programState->lightModelSceneAmbientLoc, 1,
                       lightModel.color.data());
 
         // TODO (lfy@google.com): Implement two-sided lighting model
-        // gl->uniform1i(mProgramState.lightModelTwoSidedLoc, lightModel.twoSided);
+        // gl->uniform1i(programState->lightModelTwoSidedLoc, lightModel.twoSided);
 
         for (int i = 0; i < kLightCount; i++)
         {
@@ -351,42 +431,42 @@ angle::Result GLES1Renderer::prepareForDraw(PrimitiveMode mode, Context *context
             uniformBuffers.attenuationQuadratics[i] = light.attenuationQuadratic;
         }
 
-        setUniform1iv(context, programObject, mProgramState.lightEnablesLoc, kLightCount,
+        setUniform1iv(context, programObject, programState->lightEnablesLoc, kLightCount,
                       uniformBuffers.lightEnables.data());
-        setUniform4fv(programObject, mProgramState.lightAmbientsLoc, kLightCount,
+        setUniform4fv(programObject, programState->lightAmbientsLoc, kLightCount,
                       reinterpret_cast<float *>(uniformBuffers.lightAmbients.data()));
-        setUniform4fv(programObject, mProgramState.lightDiffusesLoc, kLightCount,
+        setUniform4fv(programObject, programState->lightDiffusesLoc, kLightCount,
                       reinterpret_cast<float *>(uniformBuffers.lightDiffuses.data()));
-        setUniform4fv(programObject, mProgramState.lightSpecularsLoc, kLightCount,
+        setUniform4fv(programObject, programState->lightSpecularsLoc, kLightCount,
                       reinterpret_cast<float *>(uniformBuffers.lightSpeculars.data()));
-        setUniform4fv(programObject, mProgramState.lightPositionsLoc, kLightCount,
+        setUniform4fv(programObject, programState->lightPositionsLoc, kLightCount,
                       reinterpret_cast<float *>(uniformBuffers.lightPositions.data()));
-        setUniform3fv(programObject, mProgramState.lightDirectionsLoc, kLightCount,
+        setUniform3fv(programObject, programState->lightDirectionsLoc, kLightCount,
                       reinterpret_cast<float *>(uniformBuffers.lightDirections.data()));
-        setUniform1fv(programObject, mProgramState.lightSpotlightExponentsLoc, kLightCount,
+        setUniform1fv(programObject, programState->lightSpotlightExponentsLoc, kLightCount,
                       reinterpret_cast<float *>(uniformBuffers.spotlightExponents.data()));
-        setUniform1fv(programObject, mProgramState.lightSpotlightCutoffAnglesLoc, kLightCount,
+        setUniform1fv(programObject, programState->lightSpotlightCutoffAnglesLoc, kLightCount,
                       reinterpret_cast<float *>(uniformBuffers.spotlightCutoffAngles.data()));
-        setUniform1fv(programObject, mProgramState.lightAttenuationConstsLoc, kLightCount,
+        setUniform1fv(programObject, programState->lightAttenuationConstsLoc, kLightCount,
                       reinterpret_cast<float *>(uniformBuffers.attenuationConsts.data()));
-        setUniform1fv(programObject, mProgramState.lightAttenuationLinearsLoc, kLightCount,
+        setUniform1fv(programObject, programState->lightAttenuationLinearsLoc, kLightCount,
                       reinterpret_cast<float *>(uniformBuffers.attenuationLinears.data()));
-        setUniform1fv(programObject, mProgramState.lightAttenuationQuadraticsLoc, kLightCount,
+        setUniform1fv(programObject, programState->lightAttenuationQuadraticsLoc, kLightCount,
                       reinterpret_cast<float *>(uniformBuffers.attenuationQuadratics.data()));
     }
 
-    if (gles1State.isDirty(GLES1State::DIRTY_GLES1_FOG))
+    if (dirtyBits.test(GLES1State::DIRTY_GLES1_FOG))
     {
         const FogParameters &fog = gles1State.fogParameters();
-        setUniform1i(context, programObject, mProgramState.fogModeLoc, ToGLenum(fog.mode));
-        setUniform1f(programObject, mProgramState.fogDensityLoc, fog.density);
-        setUniform1f(programObject, mProgramState.fogStartLoc, fog.start);
-        setUniform1f(programObject, mProgramState.fogEndLoc, fog.end);
-        setUniform4fv(programObject, mProgramState.fogColorLoc, 1, fog.color.data());
+        setUniform1i(context, programObject, programState->fogModeLoc, ToGLenum(fog.mode));
+        setUniform1f(programObject, programState->fogDensityLoc, fog.density);
+        setUniform1f(programObject, programState->fogStartLoc, fog.start);
+        setUniform1f(programObject, programState->fogEndLoc, fog.end);
+        setUniform4fv(programObject, programState->fogColorLoc, 1, fog.color.data());
     }
 
     // Clip planes
-    if (gles1State.isDirty(GLES1State::DIRTY_GLES1_CLIP_PLANES))
+    if (dirtyBits.test(GLES1State::DIRTY_GLES1_CLIP_PLANES))
     {
         bool enableClipPlanes = false;
         for (int i = 0; i < kClipPlaneCount; i++)
@@ -397,35 +477,46 @@ angle::Result GLES1Renderer::prepareForDraw(PrimitiveMode mode, Context *context
                 i, reinterpret_cast<float *>(uniformBuffers.clipPlanes.data() + i));
         }
 
-        setUniform1i(context, programObject, mProgramState.enableClipPlanesLoc, enableClipPlanes);
-        setUniform1iv(context, programObject, mProgramState.clipPlaneEnablesLoc, kClipPlaneCount,
+        setUniform1i(context, programObject, programState->enableClipPlanesLoc, enableClipPlanes);
+        setUniform1iv(context, programObject, programState->clipPlaneEnablesLoc, kClipPlaneCount,
                       uniformBuffers.clipPlaneEnables.data());
-        setUniform4fv(programObject, mProgramState.clipPlanesLoc, kClipPlaneCount,
+        setUniform4fv(programObject, programState->clipPlanesLoc, kClipPlaneCount,
                       reinterpret_cast<float *>(uniformBuffers.clipPlanes.data()));
     }
 
     // Point rasterization
+    if (dirtyBits.test(GLES1State::DIRTY_GLES1_POINT_PARAMETERS))
     {
         const PointParameters &pointParams = gles1State.mPointParameters;
 
-        setUniform1i(context, programObject, mProgramState.pointRasterizationLoc,
-                     mode == PrimitiveMode::Points);
-        setUniform1i(context, programObject, mProgramState.pointSpriteEnabledLoc,
-                     glState->getEnableFeature(GL_POINT_SPRITE_OES));
-        setUniform1f(programObject, mProgramState.pointSizeMinLoc, pointParams.pointSizeMin);
-        setUniform1f(programObject, mProgramState.pointSizeMaxLoc, pointParams.pointSizeMax);
-        setUniform3fv(programObject, mProgramState.pointDistanceAttenuationLoc, 1,
+        setUniform1f(programObject, programState->pointSizeMinLoc, pointParams.pointSizeMin);
+        setUniform1f(programObject, programState->pointSizeMaxLoc, pointParams.pointSizeMax);
+        setUniform3fv(programObject, programState->pointDistanceAttenuationLoc, 1,
                       pointParams.pointDistanceAttenuation.data());
     }
 
+    const bool pointRasterization = mode == PrimitiveMode::Points;
+    if (!programState->areUntrackedUniformsSet ||
+        programState->pointRasterization != pointRasterization)
+    {
+        setUniform1i(context, programObject, programState->pointRasterizationLoc,
+                     pointRasterization);
+        programState->pointRasterization = pointRasterization;
+    }
+
     // Draw texture
+    if (mDrawTextureEnabled || programState->drawTextureEnabled)
     {
-        setUniform1i(context, programObject, mProgramState.enableDrawTextureLoc,
+        setUniform1i(context, programObject, programState->enableDrawTextureLoc,
                      mDrawTextureEnabled ? 1 : 0);
-        setUniform4fv(programObject, mProgramState.drawTextureCoordsLoc, 1, mDrawTextureCoords);
-        setUniform2fv(programObject, mProgramState.drawTextureDimsLoc, 1, mDrawTextureDims);
+        setUniform4fv(programObject, programState->drawTextureCoordsLoc, 1, mDrawTextureCoords);
+        setUniform2fv(programObject, programState->drawTextureDimsLoc, 1, mDrawTextureDims);
+        programState->drawTextureEnabled = mDrawTextureEnabled;
     }
 
+    programState->dirtyBits.reset();
+    programState->areUntrackedUniformsSet = true;
+
     gles1State.clearDirty();
     // None of those are changes in sampler, so there is no need to set the GL_PROGRAM dirty.
     // Otherwise, put the dirtying here.
@@ -531,6 +622,13 @@ angle::Result GLES1Renderer::compileShader(Context *context,
 
     *shaderOut = shader;
 
+    return angle::Result::Continue;
+}
+
+angle::Result GLES1Renderer::checkShaderCompiled(Context *context, ShaderProgramID shader)
+{
+    Shader *shaderObject = getShader(shader);
+
     if (!shaderObject->isCompiled())
     {
         GLint infoLogLength = shaderObject->getInfoLogLength();
@@ -546,10 +644,8 @@ angle::Result GLES1Renderer::compileShader(Context *context,
 }
 
 angle::Result GLES1Renderer::linkProgram(Context *context,
-                                         State *glState,
                                          ShaderProgramID vertexShader,
                                          ShaderProgramID fragmentShader,
-                                         const std::unordered_map<GLint, std::string> &attribLocs,
                                          ShaderProgramID *programOut)
 {
     ShaderProgramID program = mShaderPrograms->createProgram(context->getImplementation());
@@ -562,17 +658,29 @@ angle::Result GLES1Renderer::linkProgram(Context *context,
     programObject->attachShader(getShader(vertexShader));
     programObject->attachShader(getShader(fragmentShader));
 
-    for (auto it : attribLocs)
+    programObject->bindAttributeLocation(kVertexAttribIndex, "pos");
+    programObject->bindAttributeLocation(kNormalAttribIndex, "normal");
+    programObject->bindAttributeLocation(kColorAttribIndex, "color");
+    programObject->bindAttributeLocation(kPointSizeAttribIndex, "pointsize");
+
+    for (int i = 0; i < kTexUnitCount; i++)
     {
-        GLint index             = it.first;
-        const std::string &name = it.second;
-        programObject->bindAttributeLocation(index, name.c_str());
+        std::stringstream ss;
+        ss << "texcoord" << i;
+        programObject->bindAttributeLocation(kTextureCoordAttribIndexBase + i, ss.str().c_str());
     }
 
-    ANGLE_TRY(programObject->link(context));
-    programObject->resolveLink(context);
+    // The link is resolved by resolveProgramLink.
+    return programObject->link(context);
+}
 
-    ANGLE_TRY(glState->onProgramExecutableChange(context, programObject));
+angle::Result GLES1Renderer::resolveProgramLink(Context *context,
+                                                ShaderProgramID vertexShader,
+                                                ShaderProgramID fragmentShader,
+                                                ShaderProgramID program)
+{
+    Program *programObject = getProgram(program);
+    programObject->resolveLink(context);
 
     if (!programObject->isLinked())
     {
@@ -600,47 +708,131 @@ angle::Result GLES1Renderer::initializeRendererProgram(Context *context, State *
 
     mShaderPrograms = new ShaderProgramManager();
 
-    ShaderProgramID vertexShader;
+    ANGLE_TRY(compileShader(context, ShaderType::Vertex, kGLES1DrawVShader, &mVertexShader));
+    ANGLE_TRY(checkShaderCompiled(context, mVertexShader));
+
+    // The generic program is linked right away, so there is always a program to draw with.
+    ProgramKey genericKey;
+    genericKey.set(kFeatureGeneric);
+
+    std::unique_ptr<GLES1ProgramState> programState(new GLES1ProgramState());
+
     ShaderProgramID fragmentShader;
+    ANGLE_TRY(compileShader(context, ShaderType::Fragment,
+                            GetFragmentShaderSource(genericKey).c_str(), &fragmentShader));
+    ANGLE_TRY(checkShaderCompiled(context, fragmentShader));
 
-    ANGLE_TRY(compileShader(context, ShaderType::Vertex, kGLES1DrawVShader, &vertexShader));
+    ANGLE_TRY(linkProgram(context, mVertexShader, fragmentShader, &programState->program));
+    ANGLE_TRY(resolveProgramLink(context, mVertexShader, fragmentShader, programState->program));
+    mShaderPrograms->deleteShader(context, fragmentShader);
 
-    std::stringstream fragmentStream;
-    fragmentStream << kGLES1DrawFShaderHeader;
-    fragmentStream << kGLES1DrawFShaderUniformDefs;
-    fragmentStream << kGLES1DrawFShaderFunctions;
-    fragmentStream << kGLES1DrawFShaderMultitexturing;
-    fragmentStream << kGLES1DrawFShaderMain;
+    programState->linkStatus = ProgramLinkStatus::Linked;
+    initializeUniformLocations(programState.get());
 
-    ANGLE_TRY(compileShader(context, ShaderType::Fragment, fragmentStream.str().c_str(),
-                            &fragmentShader));
+    mProgramStates[genericKey.bits()] = std::move(programState);
 
-    std::unordered_map<GLint, std::string> attribLocs;
+    mRendererProgramInitialized = true;
+    return angle::Result::Continue;
+}
 
-    attribLocs[(GLint)kVertexAttribIndex]    = "pos";
-    attribLocs[(GLint)kNormalAttribIndex]    = "normal";
-    attribLocs[(GLint)kColorAttribIndex]     = "color";
-    attribLocs[(GLint)kPointSizeAttribIndex] = "pointsize";
+angle::Result GLES1Renderer::getProgramState(Context *context, GLES1ProgramState **programStateOut)
+{
+    ProgramKey genericKey;
+    genericKey.set(kFeatureGeneric);
+    *programStateOut = mProgramStates[genericKey.bits()].get();
 
-    for (int i = 0; i < kTexUnitCount; i++)
+    auto iter = mProgramStates.find(mProgramKey.bits());
+    if (iter == mProgramStates.end())
     {
-        std::stringstream ss;
-        ss << "texcoord" << i;
-        attribLocs[kTextureCoordAttribIndexBase + i] = ss.str();
+        // The generic program is always in the map, and doesn't count toward the cap.
+        size_t specializedProgramCount = mProgramStates.size() - 1;
+        if (specializedProgramCount >= kMaxSpecializedProgramCount)
+        {
+            return angle::Result::Continue;
+        }
+
+        std::unique_ptr<GLES1ProgramState> programState(new GLES1ProgramState());
+        programState->linkStatus = ProgramLinkStatus::Compiling;
+        ANGLE_TRY(compileShader(context, ShaderType::Fragment,
+                                GetFragmentShaderSource(mProgramKey).c_str(),
+                                &programState->fragmentShader));
+
+        iter = mProgramStates.emplace(mProgramKey.bits(), std::move(programState)).first;
     }
 
-    ANGLE_TRY(linkProgram(context, glState, vertexShader, fragmentShader, attribLocs,
-                          &mProgramState.program));
+    GLES1ProgramState *programState = iter->second.get();
+    ANGLE_TRY(updateSpecializedProgram(context, programState));
 
-    mShaderPrograms->deleteShader(context, vertexShader);
-    mShaderPrograms->deleteShader(context, fragmentShader);
+    if (programState->linkStatus == ProgramLinkStatus::Linked)
+    {
+        *programStateOut = programState;
+    }
+
+    return angle::Result::Continue;
+}
 
-    Program *programObject = getProgram(mProgramState.program);
+angle::Result GLES1Renderer::updateSpecializedProgram(Context *context,
+                                                      GLES1ProgramState *programState)
+{
+    // Each step is taken once the previous one is done, without waiting for it.  They are all
+    // taken at once if the context doesn't compile in parallel.
+    if (programState->linkStatus == ProgramLinkStatus::Compiling)
+    {
+        if (!getShader(programState->fragmentShader)->isCompleted())
+        {
+            return angle::Result::Continue;
+        }
 
-    mProgramState.projMatrixLoc      = programObject->getUniformLocation("projection");
-    mProgramState.modelviewMatrixLoc = programObject->getUniformLocation("modelview");
-    mProgramState.textureMatrixLoc   = programObject->getUniformLocation("texture_matrix");
-    mProgramState.modelviewInvTrLoc  = programObject->getUniformLocation("modelview_invtr");
+        ANGLE_TRY(linkProgram(context, mVertexShader, programState->fragmentShader,
+                              &programState->program));
+        programState->linkStatus = ProgramLinkStatus::Linking;
+    }
+
+    if (programState->linkStatus == ProgramLinkStatus::Linking)
+    {
+        if (getProgram(programState->program)->isLinking())
+        {
+            return angle::Result::Continue;
+        }
+
+        // A program that fails to compile or link is not retried, and the generic program keeps
+        // being used for its features.
+        Program *programObject = getProgram(programState->program);
+        programObject->resolveLink(context);
+        if (programObject->isLinked())
+        {
+            ANGLE_TRY(resolveProgramLink(context, mVertexShader, programState->fragmentShader,
+                                         programState->program));
+            initializeUniformLocations(programState);
+            programState->linkStatus = ProgramLinkStatus::Linked;
+        }
+        else
+        {
+            WARN() << "Internal GLES 1 specialized program link failed.";
+            programState->linkStatus = ProgramLinkStatus::Failed;
+        }
+
+        mShaderPrograms->deleteShader(context, programState->fragmentShader);
+        programState->fragmentShader = {0};
+    }
+
+    return angle::Result::Continue;
+}
+
+void GLES1Renderer::initializeUniformLocations(GLES1ProgramState *programState)
+{
+    Program *programObject = getProgram(programState->program);
+
+    // All the uniforms are set when the program is first used.
+    programState->dirtyBits.set();
+    programState->areSamplerUniformsSet   = false;
+    programState->areUntrackedUniformsSet = false;
+    programState->drawTextureEnabled      = false;
+
+    programState->projMatrixLoc      = programObject->getUniformLocation("projection");
+    programState->modelviewMatrixLoc = programObject->getUniformLocation("modelview");
+    programState->textureMatrixLoc   = programObject->getUniformLocation("texture_matrix");
+    programState->modelviewInvTrLoc  = programObject->getUniformLocation("modelview_invtr");
 
     for (int i = 0; i < kTexUnitCount; i++)
     {
@@ -650,115 +842,207 @@ angle::Result GLES1Renderer::initializeRendererProgram(Context *context, State *
         ss2d << "tex_sampler" << i;
         sscube << "tex_cube_sampler" << i;
 
-        mProgramState.tex2DSamplerLocs[i] = programObject->getUniformLocation(ss2d.str().c_str());
-        mProgramState.texCubeSamplerLocs[i] =
+        programState->tex2DSamplerLocs[i] = programObject->getUniformLocation(ss2d.str().c_str());
+        programState->texCubeSamplerLocs[i] =
             programObject->getUniformLocation(sscube.str().c_str());
     }
 
-    mProgramState.enableTexture2DLoc = programObject->getUniformLocation("enable_texture_2d");
-    mProgramState.enableTextureCubeMapLoc =
+    programState->enableTexture2DLoc = programObject->getUniformLocation("enable_texture_2d");
+    programState->enableTextureCubeMapLoc =
         programObject->getUniformLocation("enable_texture_cube_map");
 
-    mProgramState.textureFormatLoc   = programObject->getUniformLocation("texture_format");
-    mProgramState.textureEnvModeLoc  = programObject->getUniformLocation("texture_env_mode");
-    mProgramState.combineRgbLoc      = programObject->getUniformLocation("combine_rgb");
-    mProgramState.combineAlphaLoc    = programObject->getUniformLocation("combine_alpha");
-    mProgramState.src0rgbLoc         = programObject->getUniformLocation("src0_rgb");
-    mProgramState.src0alphaLoc       = programObject->getUniformLocation("src0_alpha");
-    mProgramState.src1rgbLoc         = programObject->getUniformLocation("src1_rgb");
-    mProgramState.src1alphaLoc       = programObject->getUniformLocation("src1_alpha");
-    mProgramState.src2rgbLoc         = programObject->getUniformLocation("src2_rgb");
-    mProgramState.src2alphaLoc       = programObject->getUniformLocation("src2_alpha");
-    mProgramState.op0rgbLoc          = programObject->getUniformLocation("op0_rgb");
-    mProgramState.op0alphaLoc        = programObject->getUniformLocation("op0_alpha");
-    mProgramState.op1rgbLoc          = programObject->getUniformLocation("op1_rgb");
-    mProgramState.op1alphaLoc        = programObject->getUniformLocation("op1_alpha");
-    mProgramState.op2rgbLoc          = programObject->getUniformLocation("op2_rgb");
-    mProgramState.op2alphaLoc        = programObject->getUniformLocation("op2_alpha");
-    mProgramState.textureEnvColorLoc = programObject->getUniformLocation("texture_env_color");
-    mProgramState.rgbScaleLoc        = programObject->getUniformLocation("texture_env_rgb_scale");
-    mProgramState.alphaScaleLoc      = programObject->getUniformLocation("texture_env_alpha_scale");
-    mProgramState.pointSpriteCoordReplaceLoc =
+    programState->textureFormatLoc   = programObject->getUniformLocation("texture_format");
+    programState->textureEnvModeLoc  = programObject->getUniformLocation("texture_env_mode");
+    programState->combineRgbLoc      = programObject->getUniformLocation("combine_rgb");
+    programState->combineAlphaLoc    = programObject->getUniformLocation("combine_alpha");
+    programState->src0rgbLoc         = programObject->getUniformLocation("src0_rgb");
+    programState->src0alphaLoc       = programObject->getUniformLocation("src0_alpha");
+    programState->src1rgbLoc         = programObject->getUniformLocation("src1_rgb");
+    programState->src1alphaLoc       = programObject->getUniformLocation("src1_alpha");
+    programState->src2rgbLoc         = programObject->getUniformLocation("src2_rgb");
+    programState->src2alphaLoc       = programObject->getUniformLocation("src2_alpha");
+    programState->op0rgbLoc          = programObject->getUniformLocation("op0_rgb");
+    programState->op0alphaLoc        = programObject->getUniformLocation("op0_alpha");
+    programState->op1rgbLoc          = programObject->getUniformLocation("op1_rgb");
+    programState->op1alphaLoc        = programObject->getUniformLocation("op1_alpha");
+    programState->op2rgbLoc          = programObject->getUniformLocation("op2_rgb");
+    programState->op2alphaLoc        = programObject->getUniformLocation("op2_alpha");
+    programState->textureEnvColorLoc = programObject->getUniformLocation("texture_env_color");
+    programState->rgbScaleLoc        = programObject->getUniformLocation("texture_env_rgb_scale");
+    programState->alphaScaleLoc      = programObject->getUniformLocation("texture_env_alpha_scale");
+    programState->pointSpriteCoordReplaceLoc =
         programObject->getUniformLocation("point_sprite_coord_replace");
 
-    mProgramState.enableAlphaTestLoc = programObject->getUniformLocation("enable_alpha_test");
-    mProgramState.alphaFuncLoc       = programObject->getUniformLocation("alpha_func");
-    mProgramState.alphaTestRefLoc    = programObject->getUniformLocation("alpha_test_ref");
+    programState->enableAlphaTestLoc = programObject->getUniformLocation("enable_alpha_test");
+    programState->alphaFuncLoc       = programObject->getUniformLocation("alpha_func");
+    programState->alphaTestRefLoc    = programObject->getUniformLocation("alpha_test_ref");
 
-    mProgramState.shadeModelFlatLoc = programObject->getUniformLocation("shade_model_flat");
-    mProgramState.enableLightingLoc = programObject->getUniformLocation("enable_lighting");
-    mProgramState.enableRescaleNormalLoc =
+    programState->shadeModelFlatLoc = programObject->getUniformLocation("shade_model_flat");
+    programState->enableLightingLoc = programObject->getUniformLocation("enable_lighting");
+    programState->enableRescaleNormalLoc =
         programObject->getUniformLocation("enable_rescale_normal");
-    mProgramState.enableNormalizeLoc = programObject->getUniformLocation("enable_normalize");
-    mProgramState.enableColorMaterialLoc =
+    programState->enableNormalizeLoc = programObject->getUniformLocation("enable_normalize");
+    programState->enableColorMaterialLoc =
         programObject->getUniformLocation("enable_color_material");
 
-    mProgramState.materialAmbientLoc  = programObject->getUniformLocation("material_ambient");
-    mProgramState.materialDiffuseLoc  = programObject->getUniformLocation("material_diffuse");
-    mProgramState.materialSpecularLoc = programObject->getUniformLocation("material_specular");
-    mProgramState.materialEmissiveLoc = programObject->getUniformLocation("material_emissive");
-    mProgramState.materialSpecularExponentLoc =
+    programState->materialAmbientLoc  = programObject->getUniformLocation("material_ambient");
+    programState->materialDiffuseLoc  = programObject->getUniformLocation("material_diffuse");
+    programState->materialSpecularLoc = programObject->getUniformLocation("material_specular");
+    programState->materialEmissiveLoc = programObject->getUniformLocation("material_emissive");
+    programState->materialSpecularExponentLoc =
         programObject->getUniformLocation("material_specular_exponent");
 
-    mProgramState.lightModelSceneAmbientLoc =
+    programState->lightModelSceneAmbientLoc =
         programObject->getUniformLocation("light_model_scene_ambient");
-    mProgramState.lightModelTwoSidedLoc =
+    programState->lightModelTwoSidedLoc =
         programObject->getUniformLocation("light_model_two_sided");
 
-    mProgramState.lightEnablesLoc    = programObject->getUniformLocation("light_enables");
-    mProgramState.lightAmbientsLoc   = programObject->getUniformLocation("light_ambients");
-    mProgramState.lightDiffusesLoc   = programObject->getUniformLocation("light_diffuses");
-    mProgramState.lightSpecularsLoc  = programObject->getUniformLocation("light_speculars");
-    mProgramState.lightPositionsLoc  = programObject->getUniformLocation("light_positions");
-    mProgramState.lightDirectionsLoc = programObject->getUniformLocation("light_directions");
-    mProgramState.lightSpotlightExponentsLoc =
+    programState->lightEnablesLoc    = programObject->getUniformLocation("light_enables");
+    programState->lightAmbientsLoc   = programObject->getUniformLocation("light_ambients");
+    programState->lightDiffusesLoc   = programObject->getUniformLocation("light_diffuses");
+    programState->lightSpecularsLoc  = programObject->getUniformLocation("light_speculars");
+    programState->lightPositionsLoc  = programObject->getUniformLocation("light_positions");
+    programState->lightDirectionsLoc = programObject->getUniformLocation("light_directions");
+    programState->lightSpotlightExponentsLoc =
         programObject->getUniformLocation("light_spotlight_exponents");
-    mProgramState.lightSpotlightCutoffAnglesLoc =
+    programState->lightSpotlightCutoffAnglesLoc =
         programObject->getUniformLocation("light_spotlight_cutoff_angles");
-    mProgramState.lightAttenuationConstsLoc =
+    programState->lightAttenuationConstsLoc =
         programObject->getUniformLocation("light_attenuation_consts");
-    mProgramState.lightAttenuationLinearsLoc =
+    programState->lightAttenuationLinearsLoc =
         programObject->getUniformLocation("light_attenuation_linears");
-    mProgramState.lightAttenuationQuadraticsLoc =
+    programState->lightAttenuationQuadraticsLoc =
         programObject->getUniformLocation("light_attenuation_quadratics");
 
-    mProgramState.fogEnableLoc  = programObject->getUniformLocation("enable_fog");
-    mProgramState.fogModeLoc    = programObject->getUniformLocation("fog_mode");
-    mProgramState.fogDensityLoc = programObject->getUniformLocation("fog_density");
-    mProgramState.fogStartLoc   = programObject->getUniformLocation("fog_start");
-    mProgramState.fogEndLoc     = programObject->getUniformLocation("fog_end");
-    mProgramState.fogColorLoc   = programObject->getUniformLocation("fog_color");
-
-    mProgramState.enableClipPlanesLoc = programObject->getUniformLocation("enable_clip_planes");
-    mProgramState.clipPlaneEnablesLoc = programObject->getUniformLocation("clip_plane_enables");
-    mProgramState.clipPlanesLoc       = programObject->getUniformLocation("clip_planes");
-
-    mProgramState.pointRasterizationLoc = programObject->getUniformLocation("point_rasterization");
-    mProgramState.pointSizeMinLoc       = programObject->getUniformLocation("point_size_min");
-    mProgramState.pointSizeMaxLoc       = programObject->getUniformLocation("point_size_max");
-    mProgramState.pointDistanceAttenuationLoc =
+    programState->fogEnableLoc  = programObject->getUniformLocation("enable_fog");
+    programState->fogModeLoc    = programObject->getUniformLocation("fog_mode");
+    programState->fogDensityLoc = programObject->getUniformLocation("fog_density");
+    programState->fogStartLoc   = programObject->getUniformLocation("fog_start");
+    programState->fogEndLoc     = programObject->getUniformLocation("fog_end");
+    programState->fogColorLoc   = programObject->getUniformLocation("fog_color");
+
+    programState->enableClipPlanesLoc = programObject->getUniformLocation("enable_clip_planes");
+    programState->clipPlaneEnablesLoc = programObject->getUniformLocation("clip_plane_enables");
+    programState->clipPlanesLoc       = programObject->getUniformLocation("clip_planes");
+
+    programState->pointRasterizationLoc = programObject->getUniformLocation("point_rasterization");
+    programState->pointSizeMinLoc       = programObject->getUniformLocation("point_size_min");
+    programState->pointSizeMaxLoc       = programObject->getUniformLocation("point_size_max");
+    programState->pointDistanceAttenuationLoc =
         programObject->getUniformLocation("point_distance_attenuation");
-    mProgramState.pointSpriteEnabledLoc = programObject->getUniformLocation("point_sprite_enabled");
+    programState->pointSpriteEnabledLoc = programObject->getUniformLocation("point_sprite_enabled");
 
-    mProgramState.enableDrawTextureLoc = programObject->getUniformLocation("enable_draw_texture");
-    mProgramState.drawTextureCoordsLoc = programObject->getUniformLocation("draw_texture_coords");
-    mProgramState.drawTextureDimsLoc   = programObject->getUniformLocation("draw_texture_dims");
-    mProgramState.drawTextureNormalizedCropRectLoc =
+    programState->enableDrawTextureLoc = programObject->getUniformLocation("enable_draw_texture");
+    programState->drawTextureCoordsLoc = programObject->getUniformLocation("draw_texture_coords");
+    programState->drawTextureDimsLoc   = programObject->getUniformLocation("draw_texture_dims");
+    programState->drawTextureNormalizedCropRectLoc =
         programObject->getUniformLocation("draw_texture_normalized_crop_rect");
 
+}
+
+angle::Result GLES1Renderer::useProgram(Context *context,
+                                        State *glState,
+                                        GLES1ProgramState *programState)
+{
+    Program *programObject = getProgram(programState->program);
+
+    // All the programs share the vertex shader, so the attributes don't change.
     ANGLE_TRY(glState->setProgram(context, programObject));
+    context->getStateCache().onProgramExecutableChange(context);
+    mCurrentProgramState = programState;
+
+    if (!programState->areSamplerUniformsSet)
+    {
+        for (int i = 0; i < kTexUnitCount; i++)
+        {
+            setUniform1i(context, programObject, programState->tex2DSamplerLocs[i], i);
+            setUniform1i(context, programObject, programState->texCubeSamplerLocs[i],
+                         i + kTexUnitCount);
+        }
+        programState->areSamplerUniformsSet = true;
+
+        glState->setObjectDirty(GL_PROGRAM);
+    }
+
+    return angle::Result::Continue;
+}
+
+// static
+GLES1Renderer::ProgramKey GLES1Renderer::GetProgramKey(const State &glState)
+{
+    const GLES1State &gles1State = glState.gles1();
+
+    ProgramKey key;
+    key.set(kFeatureAlphaTest, gles1State.mAlphaTestEnabled);
+    key.set(kFeatureLighting, gles1State.mLightingEnabled);
+
+    if (gles1State.mFogEnabled)
+    {
+        key.set(kFeatureFog);
+        key.set(kFeatureFogExp, gles1State.mFog.mode == FogMode::Exp);
+        key.set(kFeatureFogExp2, gles1State.mFog.mode == FogMode::Exp2);
+    }
+
+    for (const ClipPlaneParameters &clipPlane : gles1State.mClipPlanes)
+    {
+        if (clipPlane.enabled)
+        {
+            key.set(kFeatureClipPlanes);
+        }
+    }
 
     for (int i = 0; i < kTexUnitCount; i++)
     {
-        setUniform1i(context, programObject, mProgramState.tex2DSamplerLocs[i], i);
-        setUniform1i(context, programObject, mProgramState.texCubeSamplerLocs[i],
-                     i + kTexUnitCount);
+        // Cube map texturing takes precedence, see prepareForDraw.
+        const bool texCubeEnabled = gles1State.isTextureTargetEnabled(i, TextureType::CubeMap);
+        key.set(kFeatureTextureCubeMap + i, texCubeEnabled);
+        key.set(kFeatureTexture2D + i,
+                !texCubeEnabled && gles1State.isTextureTargetEnabled(i, TextureType::_2D));
+    }
+
+    return key;
+}
+
+// static
+std::string GLES1Renderer::GetFragmentShaderSource(ProgramKey key)
+{
+    std::stringstream fragmentStream;
+    fragmentStream << kGLES1DrawFShaderHeader;
+
+    if (key.test(kFeatureGeneric))
+    {
+        fragmentStream << kGLES1DrawFShaderFeatureUniformDefs;
     }
+    else
+    {
+        bool tex2DEnables[kTexUnitCount];
+        bool texCubeEnables[kTexUnitCount];
+        for (int i = 0; i < kTexUnitCount; i++)
+        {
+            tex2DEnables[i]   = key.test(kFeatureTexture2D + i);
+            texCubeEnables[i] = key.test(kFeatureTextureCubeMap + i);
+        }
 
-    glState->setObjectDirty(GL_PROGRAM);
+        const char *fogMode = key.test(kFeatureFogExp)
+                                  ? "kExp"
+                                  : (key.test(kFeatureFogExp2) ? "kExp2" : "kLinear");
+
+        fragmentStream << "\n";
+        AddConstantArrayDefinition(fragmentStream, "enable_texture_2d", tex2DEnables);
+        AddConstantArrayDefinition(fragmentStream, "enable_texture_cube_map", texCubeEnables);
+        AddConstantDefinition(fragmentStream, "enable_alpha_test", key.test(kFeatureAlphaTest));
+        AddConstantDefinition(fragmentStream, "enable_lighting", key.test(kFeatureLighting));
+        AddConstantDefinition(fragmentStream, "enable_fog", key.test(kFeatureFog));
+        fragmentStream << "const int fog_mode = " << fogMode << ";\n";
+        AddConstantDefinition(fragmentStream, "enable_clip_planes", key.test(kFeatureClipPlanes));
+    }
 
-    mRendererProgramInitialized = true;
-    return angle::Result::Continue;
+    fragmentStream << kGLES1DrawFShaderUniformDefs;
+    fragmentStream << kGLES1DrawFShaderFunctions;
+    fragmentStream << kGLES1DrawFShaderMultitexturing;
+    fragmentStream << kGLES1DrawFShaderMain;
+
+    return fragmentStream.str();
 }
 
 void GLES1Renderer::setUniform1i(Context *context, Program *programObject, GLint loc, GLint value)
@@ -12,6 +12,8 @@
 
 #include "angle_gl.h"
 #include "common/angleutils.h"
+#include "common/bitset_utils.h"
+#include "libANGLE/GLES1State.h"
 #include "libANGLE/angletypes.h"
 
 #include <memory>
@@ -21,7 +23,6 @@
 namespace gl
 {
 class Context;
-class GLES1State;
 class Program;
 class State;
 class Shader;
@@ -55,6 +56,33 @@ class GLES1Renderer final : angle::NonCopyable
     using Vec4Uniform = float[4];
     using Vec3Uniform = float[3];
 
+    // The fixed-function features that the programs are specialized with.  Their uniforms are
+    // replaced with constants in the fragment shader, so the paths of the disabled features are
+    // compiled out.
+    enum ProgramFeature
+    {
+        kFeatureAlphaTest = 0,
+        kFeatureLighting,
+        kFeatureFog,
+        // Linear fog if neither is set.  Only set if fog is enabled.
+        kFeatureFogExp,
+        kFeatureFogExp2,
+        kFeatureClipPlanes,
+        // One bit per texture unit.  Only one of the two is set for a unit.
+        kFeatureTexture2D,
+        kFeatureTextureCubeMap = kFeatureTexture2D + kTexUnitCount,
+        // The generic program, which reads all of the above from uniforms.  It is used while the
+        // specialized programs are compiled and linked.
+        kFeatureGeneric = kFeatureTextureCubeMap + kTexUnitCount,
+        kFeatureCount,
+    };
+    using ProgramKey = angle::BitSet32<kFeatureCount>;
+
+    struct GLES1ProgramState;
+
+    static ProgramKey GetProgramKey(const State &glState);
+    static std::string GetFragmentShaderSource(ProgramKey key);
+
     Shader *getShader(ShaderProgramID handle) const;
     Program *getProgram(ShaderProgramID handle) const;
 
@@ -62,14 +90,25 @@ class GLES1Renderer final : angle::NonCopyable
                                 ShaderType shaderType,
                                 const char *src,
                                 ShaderProgramID *shaderOut);
+    angle::Result checkShaderCompiled(Context *context, ShaderProgramID shader);
     angle::Result linkProgram(Context *context,
-                              State *glState,
                               ShaderProgramID vshader,
                               ShaderProgramID fshader,
-                              const std::unordered_map<GLint, std::string> &attribLocs,
                               ShaderProgramID *programOut);
+    angle::Result resolveProgramLink(Context *context,
+                                     ShaderProgramID vshader,
+                                     ShaderProgramID fshader,
+                                     ShaderProgramID program);
     angle::Result initializeRendererProgram(Context *context, State *glState);
 
+    // Returns the program specialized with the current features, or the generic program until the
+    // specialized one is linked.  The specialized programs are compiled and linked in the
+    // background if the context's worker threads allow it.
+    angle::Result getProgramState(Context *context, GLES1ProgramState **programStateOut);
+    angle::Result updateSpecializedProgram(Context *context, GLES1ProgramState *programState);
+    void initializeUniformLocations(GLES1ProgramState *programState);
+    angle::Result useProgram(Context *context, State *glState, GLES1ProgramState *programState);
+
     void setUniform1i(Context *context, Program *programObject, GLint loc, GLint value);
     void setUniform1iv(Context *context,
                        Program *programObject,
@@ -98,12 +137,40 @@ class GLES1Renderer final : angle::NonCopyable
     static constexpr int kPointSizeAttribIndex        = 3;
     static constexpr int kTextureCoordAttribIndexBase = 4;
 
+    // Past this many specialized programs, the generic program is used for new feature sets.
+    static constexpr size_t kMaxSpecializedProgramCount = 64;
+
     bool mRendererProgramInitialized;
     ShaderProgramManager *mShaderPrograms;
 
+    enum class ProgramLinkStatus
+    {
+        Compiling,
+        Linking,
+        Linked,
+        Failed,
+    };
+
     struct GLES1ProgramState
     {
         ShaderProgramID program;
+        ProgramLinkStatus linkStatus;
+
+        // Kept until the link is resolved.
+        ShaderProgramID fragmentShader;
+
+        // The state that changed since the uniforms were last set in this program.  The uniforms
+        // are set when the program is next used.
+        GLES1State::DirtyBits dirtyBits;
+
+        // The uniforms that don't depend on GLES1 state with dirty bits are compared with their
+        // value in the program instead.
+        bool areSamplerUniformsSet;
+        bool areUntrackedUniformsSet;
+        std::array<GLint, kTexUnitCount> textureFormats;
+        std::array<Vec4Uniform, kTexUnitCount> texCropRects;
+        bool pointRasterization;
+        bool drawTextureEnabled;
 
         GLint projMatrixLoc;
         GLint modelviewMatrixLoc;
@@ -203,6 +270,7 @@ class GLES1Renderer final : angle::NonCopyable
         std::array<Mat4Uniform, kTexUnitCount> textureMatrices;
         std::array<GLint, kTexUnitCount> tex2DEnables;
         std::array<GLint, kTexUnitCount> texCubeEnables;
+        std::array<GLint, kTexUnitCount> textureFormats;
 
         std::array<GLint, kTexUnitCount> texEnvModes;
         std::array<GLint, kTexUnitCount> texCombineRgbs;
@@ -247,7 +315,13 @@ class GLES1Renderer final : angle::NonCopyable
     };
 
     GLES1UniformBuffers mUniformBuffers;
-    GLES1ProgramState mProgramState;
+
+    // The generic program is linked when the renderer is initialized.  The vertex shader is shared
+    // by all programs.
+    ShaderProgramID mVertexShader;
+    std::unordered_map<uint32_t, std::unique_ptr<GLES1ProgramState>> mProgramStates;
+    ProgramKey mProgramKey;
+    GLES1ProgramState *mCurrentProgramState;
 
     bool mDrawTextureEnabled      = false;
     GLfloat mDrawTextureCoords[4] = {0.0f, 0.0f, 0.0f, 0.0f};
@@ -193,4 +193,65 @@ TEST(HandleAllocatorTest, ReserveAfterReleaseBug)
     allocator.allocate();
 }
 
+// Tests that churning through many handles keeps them dense and never hands out a live handle.
+TEST(HandleAllocatorTest, Churn)
+{
+    constexpr GLuint kHandleCount = 40000;
+    gl::HandleAllocator allocator;
+
+    std::vector<GLuint> handles;
+    for (GLuint count = 0; count < kHandleCount; count++)
+    {
+        handles.push_back(allocator.allocate());
+    }
+
+    for (int iteration = 0; iteration < 4; ++iteration)
+    {
+        // Release every other handle and allocate them again.
+        for (size_t index = iteration % 2; index < handles.size(); index += 2)
+        {
+            allocator.release(handles[index]);
+        }
+
+        std::set<GLuint> liveHandles;
+        for (size_t index = 1 - iteration % 2; index < handles.size(); index += 2)
+        {
+            liveHandles.insert(handles[index]);
+        }
+
+        for (size_t index = iteration % 2; index < handles.size(); index += 2)
+        {
+            GLuint handle = allocator.allocate();
+            EXPECT_LE(handle, kHandleCount);
+            EXPECT_EQ(0u, liveHandles.count(handle));
+            liveHandles.insert(handle);
+            handles[index] = handle;
+        }
+    }
+
+    // All released handles were reused, so the next one is fresh.
+    EXPECT_EQ(kHandleCount + 1, allocator.allocate());
+}
+
+// Tests reserving a handle that is in the released list.
+TEST(HandleAllocatorTest, ReserveReleased)
+{
+    gl::HandleAllocator allocator;
+
+    for (GLuint count = 1; count <= 4; count++)
+    {
+        EXPECT_EQ(count, allocator.allocate());
+    }
+
+    allocator.release(1);
+    allocator.release(2);
+    allocator.release(3);
+    allocator.reserve(2);
+
+    // Released handles are still reused lowest first.
+    EXPECT_EQ(1u, allocator.allocate());
+    EXPECT_EQ(3u, allocator.allocate());
+    EXPECT_EQ(5u, allocator.allocate());
+}
+
 }  // anonymous namespace
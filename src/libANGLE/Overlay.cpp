@@ -27,6 +27,9 @@ constexpr std::pair<const char *, WidgetId> kWidgetNames[] = {
     {"VulkanValidationMessageCount", WidgetId::VulkanValidationMessageCount},
     {"VulkanCommandGraphSize", WidgetId::VulkanCommandGraphSize},
     {"VulkanSecondaryCommandBufferPoolWaste", WidgetId::VulkanSecondaryCommandBufferPoolWaste},
+    {"VulkanRenderPassStoreBytesSaved", WidgetId::VulkanRenderPassStoreBytesSaved},
+    {"VulkanRenderPassGpuTime", WidgetId::VulkanRenderPassGpuTime},
+    {"VulkanInternalGpuTime", WidgetId::VulkanInternalGpuTime},
 };
 }  // namespace
 
@@ -210,6 +210,21 @@ class AppendWidgetDataHelper
                                                             TextWidgetData *textWidget,
                                                             GraphWidgetData *graphWidget,
                                                             OverlayWidgetCounts *widgetCounts);
+    static void AppendVulkanRenderPassStoreBytesSaved(const overlay::Widget *widget,
+                                                      const gl::Extents &imageExtent,
+                                                      TextWidgetData *textWidget,
+                                                      GraphWidgetData *graphWidget,
+                                                      OverlayWidgetCounts *widgetCounts);
+    static void AppendVulkanRenderPassGpuTime(const overlay::Widget *widget,
+                                              const gl::Extents &imageExtent,
+                                              TextWidgetData *textWidget,
+                                              GraphWidgetData *graphWidget,
+                                              OverlayWidgetCounts *widgetCounts);
+    static void AppendVulkanInternalGpuTime(const overlay::Widget *widget,
+                                            const gl::Extents &imageExtent,
+                                            TextWidgetData *textWidget,
+                                            GraphWidgetData *graphWidget,
+                                            OverlayWidgetCounts *widgetCounts);
 
   private:
     static std::ostream &OutputPerSecond(std::ostream &out, const overlay::PerSecond *perSecond);
@@ -366,6 +381,88 @@ void AppendWidgetDataHelper::AppendVulkanSecondaryCommandBufferPoolWaste(
     }
 }
 
+void AppendWidgetDataHelper::AppendVulkanRenderPassStoreBytesSaved(
+    const overlay::Widget *widget,
+    const gl::Extents &imageExtent,
+    TextWidgetData *textWidget,
+    GraphWidgetData *graphWidget,
+    OverlayWidgetCounts *widgetCounts)
+{
+    const overlay::RunningGraph *storeBytesSaved =
+        static_cast<const overlay::RunningGraph *>(widget);
+
+    const size_t maxValue     = *std::max_element(storeBytesSaved->runningValues.begin(),
+                                              storeBytesSaved->runningValues.end());
+    const int32_t graphHeight = std::abs(widget->coords[3] - widget->coords[1]);
+    const float graphScale    = static_cast<float>(graphHeight) / std::max<size_t>(maxValue, 1);
+
+    AppendGraphCommon(widget, imageExtent, storeBytesSaved->runningValues,
+                      storeBytesSaved->lastValueIndex + 1, graphScale, graphWidget, widgetCounts);
+
+    if ((*widgetCounts)[WidgetInternalType::Text] <
+        kWidgetInternalTypeMaxWidgets[WidgetInternalType::Text])
+    {
+        std::ostringstream text;
+        text << "Store Bytes Saved (Max: " << maxValue / 1024 << " KB)";
+        AppendTextCommon(&storeBytesSaved->description, imageExtent, text.str(), textWidget,
+                         widgetCounts);
+    }
+}
+
+void AppendWidgetDataHelper::AppendVulkanRenderPassGpuTime(const overlay::Widget *widget,
+                                                           const gl::Extents &imageExtent,
+                                                           TextWidgetData *textWidget,
+                                                           GraphWidgetData *graphWidget,
+                                                           OverlayWidgetCounts *widgetCounts)
+{
+    const overlay::RunningGraph *renderPassGpuTime =
+        static_cast<const overlay::RunningGraph *>(widget);
+
+    const size_t maxValue     = *std::max_element(renderPassGpuTime->runningValues.begin(),
+                                              renderPassGpuTime->runningValues.end());
+    const int32_t graphHeight = std::abs(widget->coords[3] - widget->coords[1]);
+    const float graphScale    = static_cast<float>(graphHeight) / std::max<size_t>(maxValue, 1);
+
+    AppendGraphCommon(widget, imageExtent, renderPassGpuTime->runningValues,
+                      renderPassGpuTime->lastValueIndex + 1, graphScale, graphWidget, widgetCounts);
+
+    if ((*widgetCounts)[WidgetInternalType::Text] <
+        kWidgetInternalTypeMaxWidgets[WidgetInternalType::Text])
+    {
+        std::ostringstream text;
+        text << "Render Pass GPU Time (Max: " << maxValue << " us)";
+        AppendTextCommon(&renderPassGpuTime->description, imageExtent, text.str(), textWidget,
+                         widgetCounts);
+    }
+}
+
+void AppendWidgetDataHelper::AppendVulkanInternalGpuTime(const overlay::Widget *widget,
+                                                         const gl::Extents &imageExtent,
+                                                         TextWidgetData *textWidget,
+                                                         GraphWidgetData *graphWidget,
+                                                         OverlayWidgetCounts *widgetCounts)
+{
+    const overlay::RunningGraph *internalGpuTime =
+        static_cast<const overlay::RunningGraph *>(widget);
+
+    const size_t maxValue     = *std::max_element(internalGpuTime->runningValues.begin(),
+                                              internalGpuTime->runningValues.end());
+    const int32_t graphHeight = std::abs(widget->coords[3] - widget->coords[1]);
+    const float graphScale    = static_cast<float>(graphHeight) / std::max<size_t>(maxValue, 1);
+
+    AppendGraphCommon(widget, imageExtent, internalGpuTime->runningValues,
+                      internalGpuTime->lastValueIndex + 1, graphScale, graphWidget, widgetCounts);
+
+    if ((*widgetCounts)[WidgetInternalType::Text] <
+        kWidgetInternalTypeMaxWidgets[WidgetInternalType::Text])
+    {
+        std::ostringstream text;
+        text << "Internal GPU Time (Max: " << maxValue << " us)";
+        AppendTextCommon(&internalGpuTime->description, imageExtent, text.str(), textWidget,
+                         widgetCounts);
+    }
+}
+
 std::ostream &AppendWidgetDataHelper::OutputPerSecond(std::ostream &out,
                                                       const overlay::PerSecond *perSecond)
 {
@@ -395,6 +492,12 @@ constexpr angle::PackedEnumMap<WidgetId, AppendWidgetDataFunc> kWidgetIdToAppend
      overlay_impl::AppendWidgetDataHelper::AppendVulkanCommandGraphSize},
     {WidgetId::VulkanSecondaryCommandBufferPoolWaste,
      overlay_impl::AppendWidgetDataHelper::AppendVulkanSecondaryCommandBufferPoolWaste},
+    {WidgetId::VulkanRenderPassStoreBytesSaved,
+     overlay_impl::AppendWidgetDataHelper::AppendVulkanRenderPassStoreBytesSaved},
+    {WidgetId::VulkanRenderPassGpuTime,
+     overlay_impl::AppendWidgetDataHelper::AppendVulkanRenderPassGpuTime},
+    {WidgetId::VulkanInternalGpuTime,
+     overlay_impl::AppendWidgetDataHelper::AppendVulkanInternalGpuTime},
 };
 }
 
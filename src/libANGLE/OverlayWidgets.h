@@ -61,6 +61,12 @@ enum class WidgetId
     VulkanCommandGraphSize,
     // Secondary Command Buffer pool memory waste (RunningHistogram).
     VulkanSecondaryCommandBufferPoolWaste,
+    // Bytes of attachment stores dropped because nothing reads them (RunningGraph).
+    VulkanRenderPassStoreBytesSaved,
+    // GPU time of render passes in microseconds, as measured by timestamp queries (RunningGraph).
+    VulkanRenderPassGpuTime,
+    // GPU time of ANGLE's internal operations in microseconds (RunningGraph).
+    VulkanInternalGpuTime,
 
     InvalidEnum,
     EnumCount = InvalidEnum,
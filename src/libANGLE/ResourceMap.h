@@ -4,8 +4,8 @@
 // found in the LICENSE file.
 //
 // ResourceMap:
-//   An optimized resource map which packs the first set of allocated objects into a
-//   flat array, and then falls back to an unordered map for the higher handle values.
+//   An optimized resource map which packs the allocated objects into a flat array, and then
+//   falls back to an unordered map for handle values that would make the array too sparse.
 //
 
 #ifndef LIBANGLE_RESOURCE_MAP_H_
@@ -84,6 +84,10 @@ class ResourceMap final : angle::NonCopyable
 
     GLuint nextNonNullResource(size_t flatIndex) const;
 
+    // Returns true if the flat array may grow to cover |handle|.
+    bool shouldGrowFlatResources(GLuint handle, size_t *newSizeOut) const;
+    void growFlatResources(size_t newSize);
+
     // constexpr methods cannot contain reinterpret_cast, so we need a static method.
     static ResourceType *InvalidPointer();
     static constexpr intptr_t kInvalidPointer = static_cast<intptr_t>(-1);
@@ -91,15 +95,24 @@ class ResourceMap final : angle::NonCopyable
     // Start with 32 maximum elements in the map, which can grow.
     static constexpr size_t kInitialFlatResourcesSize = 0x20;
 
-    // Experimental testing suggests that 16k is a reasonable upper limit.
+    // Experimental testing suggests that 16k is a reasonable upper limit for an unconditional
+    // flat array.
     static constexpr size_t kFlatResourcesLimit = 0x4000;
 
+    // Beyond kFlatResourcesLimit, the flat array keeps growing as long as it stays at least this
+    // dense.  Handles from HandleAllocator are dense, so apps that churn through tens of thousands
+    // of objects never hit the hash map, while sparse app-chosen names don't waste memory.
+    static constexpr size_t kFlatResourcesMaxSparseness = 4;
+
     // Size of one map element.
     static constexpr size_t kElementSize = sizeof(ResourceType *);
 
     size_t mFlatResourcesSize;
     ResourceType **mFlatResources;
 
+    // Number of assigned (including reserved) slots in mFlatResources.
+    size_t mFlatResourcesCount;
+
     // A map of GL objects indexed by object ID.
     HashMap mHashedResources;
 };
@@ -107,7 +120,8 @@ class ResourceMap final : angle::NonCopyable
 template <typename ResourceType, typename IDType>
 ResourceMap<ResourceType, IDType>::ResourceMap()
     : mFlatResourcesSize(kInitialFlatResourcesSize),
-      mFlatResources(new ResourceType *[kInitialFlatResourcesSize])
+      mFlatResources(new ResourceType *[kInitialFlatResourcesSize]),
+      mFlatResourcesCount(0)
 {
     memset(mFlatResources, kInvalidPointer, mFlatResourcesSize * kElementSize);
 }
@@ -143,6 +157,8 @@ bool ResourceMap<ResourceType, IDType>::erase(IDType id, ResourceType **resource
         }
         *resourceOut = value;
         value        = InvalidPointer();
+        ASSERT(mFlatResourcesCount > 0);
+        mFlatResourcesCount--;
     }
     else
     {
@@ -161,32 +177,73 @@ template <typename ResourceType, typename IDType>
 void ResourceMap<ResourceType, IDType>::assign(IDType id, ResourceType *resource)
 {
     GLuint handle = GetIDValue(id);
-    if (handle < kFlatResourcesLimit)
+    if (handle >= mFlatResourcesSize)
     {
-        if (handle >= mFlatResourcesSize)
+        size_t newSize = 0;
+        if (!shouldGrowFlatResources(handle, &newSize))
         {
-            // Use power-of-two.
-            size_t newSize = mFlatResourcesSize;
-            while (newSize <= handle)
-            {
-                newSize *= 2;
-            }
-
-            ResourceType **oldResources = mFlatResources;
-
-            mFlatResources = new ResourceType *[newSize];
-            memset(&mFlatResources[mFlatResourcesSize], kInvalidPointer,
-                   (newSize - mFlatResourcesSize) * kElementSize);
-            memcpy(mFlatResources, oldResources, mFlatResourcesSize * kElementSize);
-            mFlatResourcesSize = newSize;
-            delete[] oldResources;
+            mHashedResources[handle] = resource;
+            return;
         }
-        ASSERT(mFlatResourcesSize > handle);
-        mFlatResources[handle] = resource;
+        growFlatResources(newSize);
     }
-    else
+
+    ASSERT(mFlatResourcesSize > handle);
+    if (mFlatResources[handle] == InvalidPointer())
     {
-        mHashedResources[handle] = resource;
+        mFlatResourcesCount++;
+    }
+    mFlatResources[handle] = resource;
+}
+
+template <typename ResourceType, typename IDType>
+bool ResourceMap<ResourceType, IDType>::shouldGrowFlatResources(GLuint handle,
+                                                                size_t *newSizeOut) const
+{
+    // Use power-of-two.
+    size_t newSize = mFlatResourcesSize;
+    while (newSize <= handle)
+    {
+        newSize *= 2;
+    }
+    *newSizeOut = newSize;
+
+    if (newSize <= kFlatResourcesLimit)
+    {
+        return true;
+    }
+
+    size_t resourceCount = mFlatResourcesCount + mHashedResources.size() + 1;
+    return newSize <= resourceCount * kFlatResourcesMaxSparseness;
+}
+
+template <typename ResourceType, typename IDType>
+void ResourceMap<ResourceType, IDType>::growFlatResources(size_t newSize)
+{
+    ASSERT(newSize > mFlatResourcesSize);
+    ResourceType **oldResources = mFlatResources;
+
+    mFlatResources = new ResourceType *[newSize];
+    memset(&mFlatResources[mFlatResourcesSize], kInvalidPointer,
+           (newSize - mFlatResourcesSize) * kElementSize);
+    memcpy(mFlatResources, oldResources, mFlatResourcesSize * kElementSize);
+    mFlatResourcesSize = newSize;
+    delete[] oldResources;
+
+    // Queries look at the flat array only for handles in its range, so move any hashed resources
+    // that are now covered by it.
+    for (auto iter = mHashedResources.begin(); iter != mHashedResources.end();)
+    {
+        if (iter->first < mFlatResourcesSize)
+        {
+            mFlatResources[iter->first] = iter->second;
+            mFlatResourcesCount++;
+            iter = mHashedResources.erase(iter);
+        }
+        else
+        {
+            ++iter;
+        }
     }
 }
 
@@ -229,7 +286,8 @@ template <typename ResourceType, typename IDType>
 void ResourceMap<ResourceType, IDType>::clear()
 {
     memset(mFlatResources, kInvalidPointer, kInitialFlatResourcesSize * kElementSize);
-    mFlatResourcesSize = kInitialFlatResourcesSize;
+    mFlatResourcesSize  = kInitialFlatResourcesSize;
+    mFlatResourcesCount = 0;
     mHashedResources.clear();
 }
 
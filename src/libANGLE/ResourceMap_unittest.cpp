@@ -133,4 +133,72 @@ TEST(ResourceMapTest, QueryUnassigned)
     ASSERT_FALSE(resourceMap.contains(100));
     ASSERT_EQ(nullptr, resourceMap.query(100));
 }
+
+// Tests that many densely allocated handles grow the map past its initial flat limit.
+TEST(ResourceMapTest, DenseGrowth)
+{
+    constexpr size_t kSize = 50000;
+
+    ResourceMap<size_t, GLuint> resourceMap;
+    std::vector<size_t> objects(kSize);
+
+    for (size_t index = 0; index < kSize; ++index)
+    {
+        objects[index] = index;
+        resourceMap.assign(static_cast<GLuint>(index + 1), &objects[index]);
+    }
+
+    for (size_t index = 0; index < kSize; ++index)
+    {
+        ASSERT_EQ(&objects[index], resourceMap.query(static_cast<GLuint>(index + 1)));
+    }
+
+    size_t iteratedCount = 0;
+    for (const auto &indexAndResource : resourceMap)
+    {
+        ASSERT_EQ(indexAndResource.first, *indexAndResource.second + 1);
+        iteratedCount++;
+    }
+    EXPECT_EQ(kSize, iteratedCount);
+
+    for (size_t index = 0; index < kSize; ++index)
+    {
+        size_t *found = nullptr;
+        ASSERT_TRUE(resourceMap.erase(static_cast<GLuint>(index + 1), &found));
+        ASSERT_EQ(&objects[index], found);
+    }
+
+    ASSERT_TRUE(resourceMap.empty());
+}
+
+// Tests that sparse handles are still found once the flat array grows over them.
+TEST(ResourceMapTest, SparseThenDense)
+{
+    constexpr GLuint kSparseHandle = 40000;
+    constexpr size_t kDenseCount   = 30000;
+
+    ResourceMap<size_t, GLuint> resourceMap;
+    size_t sparseObject = kSparseHandle;
+    resourceMap.assign(kSparseHandle, &sparseObject);
+
+    std::vector<size_t> objects(kDenseCount);
+    for (size_t index = 0; index < kDenseCount; ++index)
+    {
+        objects[index] = index;
+        resourceMap.assign(static_cast<GLuint>(index + 1), &objects[index]);
+        ASSERT_EQ(&sparseObject, resourceMap.query(kSparseHandle));
+    }
+
+    // A very large handle stays hashed and doesn't disturb the rest.
+    constexpr GLuint kHugeHandle = 0x7FFFFFFF;
+    size_t hugeObject            = kHugeHandle;
+    resourceMap.assign(kHugeHandle, &hugeObject);
+    EXPECT_EQ(&hugeObject, resourceMap.query(kHugeHandle));
+    EXPECT_EQ(&sparseObject, resourceMap.query(kSparseHandle));
+    EXPECT_EQ(&objects[0], resourceMap.query(1));
+
+    resourceMap.clear();
+    ASSERT_TRUE(resourceMap.empty());
+}
+
 }  // anonymous namespace
@@ -568,6 +568,7 @@ ANGLE_INLINE void State::updateActiveTextureState(const Context *context,
     }
 
     mDirtyBits.set(DIRTY_BIT_TEXTURE_BINDINGS);
+    mDirtyActiveTextureUnits.set(textureIndex);
 }
 
 ANGLE_INLINE void State::updateActiveTexture(const Context *context,
@@ -582,6 +583,7 @@ ANGLE_INLINE void State::updateActiveTexture(const Context *context,
     {
         mActiveTexturesCache[textureIndex] = nullptr;
         mDirtyBits.set(DIRTY_BIT_TEXTURE_BINDINGS);
+        mDirtyActiveTextureUnits.set(textureIndex);
         return;
     }
 
@@ -984,20 +986,25 @@ void State::setEnableFeature(GLenum feature, bool enabled)
     }
 
     // GLES1 emulation. Need to separate from main switch due to conflict enum between
-    // GL_CLIP_DISTANCE0_EXT & GL_CLIP_PLANE0
+    // GL_CLIP_DISTANCE0_EXT & GL_CLIP_PLANE0.  The dirty bits let the GLES1 renderer update only
+    // the uniforms of the features that changed.
     switch (feature)
     {
         case GL_ALPHA_TEST:
             mGLES1State.mAlphaTestEnabled = enabled;
+            mGLES1State.setDirty(GLES1State::DIRTY_GLES1_FEATURE_ENABLE);
             break;
         case GL_TEXTURE_2D:
             mGLES1State.mTexUnitEnables[mActiveSampler].set(TextureType::_2D, enabled);
+            mGLES1State.setDirty(GLES1State::DIRTY_GLES1_TEXTURE_UNIT_ENABLE);
             break;
         case GL_TEXTURE_CUBE_MAP:
             mGLES1State.mTexUnitEnables[mActiveSampler].set(TextureType::CubeMap, enabled);
+            mGLES1State.setDirty(GLES1State::DIRTY_GLES1_TEXTURE_UNIT_ENABLE);
             break;
         case GL_LIGHTING:
             mGLES1State.mLightingEnabled = enabled;
+            mGLES1State.setDirty(GLES1State::DIRTY_GLES1_FEATURE_ENABLE);
             break;
         case GL_LIGHT0:
         case GL_LIGHT1:
@@ -1008,15 +1015,19 @@ void State::setEnableFeature(GLenum feature, bool enabled)
         case GL_LIGHT6:
         case GL_LIGHT7:
             mGLES1State.mLights[feature - GL_LIGHT0].enabled = enabled;
+            mGLES1State.setDirty(GLES1State::DIRTY_GLES1_LIGHTS);
             break;
         case GL_NORMALIZE:
             mGLES1State.mNormalizeEnabled = enabled;
+            mGLES1State.setDirty(GLES1State::DIRTY_GLES1_FEATURE_ENABLE);
             break;
         case GL_RESCALE_NORMAL:
             mGLES1State.mRescaleNormalEnabled = enabled;
+            mGLES1State.setDirty(GLES1State::DIRTY_GLES1_FEATURE_ENABLE);
             break;
         case GL_COLOR_MATERIAL:
             mGLES1State.mColorMaterialEnabled = enabled;
+            mGLES1State.setDirty(GLES1State::DIRTY_GLES1_FEATURE_ENABLE);
             break;
         case GL_CLIP_PLANE0:
         case GL_CLIP_PLANE1:
@@ -1025,21 +1036,27 @@ void State::setEnableFeature(GLenum feature, bool enabled)
         case GL_CLIP_PLANE4:
         case GL_CLIP_PLANE5:
             mGLES1State.mClipPlanes[feature - GL_CLIP_PLANE0].enabled = enabled;
+            mGLES1State.setDirty(GLES1State::DIRTY_GLES1_CLIP_PLANES);
             break;
         case GL_FOG:
             mGLES1State.mFogEnabled = enabled;
+            mGLES1State.setDirty(GLES1State::DIRTY_GLES1_FEATURE_ENABLE);
             break;
         case GL_POINT_SMOOTH:
             mGLES1State.mPointSmoothEnabled = enabled;
+            mGLES1State.setDirty(GLES1State::DIRTY_GLES1_FEATURE_ENABLE);
             break;
         case GL_LINE_SMOOTH:
             mGLES1State.mLineSmoothEnabled = enabled;
+            mGLES1State.setDirty(GLES1State::DIRTY_GLES1_FEATURE_ENABLE);
             break;
         case GL_POINT_SPRITE_OES:
             mGLES1State.mPointSpriteEnabled = enabled;
+            mGLES1State.setDirty(GLES1State::DIRTY_GLES1_FEATURE_ENABLE);
             break;
         case GL_COLOR_LOGIC_OP:
             mGLES1State.mLogicOpEnabled = enabled;
+            mGLES1State.setDirty(GLES1State::DIRTY_GLES1_FEATURE_ENABLE);
             break;
         default:
             UNREACHABLE();
@@ -1236,6 +1253,34 @@ TextureID State::getSamplerTextureId(unsigned int sampler, TextureType type) con
 }
 
 void State::detachTexture(const Context *context, const TextureMap &zeroTextures, TextureID texture)
+{
+    detachTextureBindings(context, zeroTextures,
+                          [texture](TextureID bound) { return bound == texture; });
+    detachTextureFromFramebuffers(context, texture);
+}
+
+void State::detachTextures(const Context *context,
+                           const TextureMap &zeroTextures,
+                           const std::vector<TextureID> &sortedTextures)
+{
+    ASSERT(std::is_sorted(sortedTextures.begin(), sortedTextures.end(),
+                          [](TextureID a, TextureID b) { return a.value < b.value; }));
+
+    detachTextureBindings(context, zeroTextures, [&sortedTextures](TextureID bound) {
+        return std::binary_search(sortedTextures.begin(), sortedTextures.end(), bound,
+                                  [](TextureID a, TextureID b) { return a.value < b.value; });
+    });
+
+    for (TextureID texture : sortedTextures)
+    {
+        detachTextureFromFramebuffers(context, texture);
+    }
+}
+
+template <typename IsDetachedFunc>
+void State::detachTextureBindings(const Context *context,
+                                  const TextureMap &zeroTextures,
+                                  IsDetachedFunc isDetached)
 {
     // Textures have a detach method on State rather than a simple
     // removeBinding, because the zero/null texture objects are managed
@@ -1253,7 +1298,7 @@ void State::detachTexture(const Context *context, const TextureMap &zeroTextures
         for (size_t bindingIndex = 0; bindingIndex < textureVector.size(); ++bindingIndex)
         {
             BindingPointer<Texture> &binding = textureVector[bindingIndex];
-            if (binding.id() == texture)
+            if (binding.get() && isDetached(binding.id()))
             {
                 // Zero textures are the "default" textures instead of NULL
                 Texture *zeroTexture = zeroTextures[type].get();
@@ -1269,7 +1314,7 @@ void State::detachTexture(const Context *context, const TextureMap &zeroTextures
 
     for (auto &bindingImageUnit : mImageUnits)
     {
-        if (bindingImageUnit.texture.id() == texture)
+        if (bindingImageUnit.texture.get() && isDetached(bindingImageUnit.texture.id()))
         {
             bindingImageUnit.texture.set(context, nullptr);
             bindingImageUnit.level   = 0;
@@ -1277,10 +1322,12 @@ void State::detachTexture(const Context *context, const TextureMap &zeroTextures
             bindingImageUnit.layer   = 0;
             bindingImageUnit.access  = GL_READ_ONLY;
             bindingImageUnit.format  = GL_R32UI;
-            break;
         }
     }
+}
 
+void State::detachTextureFromFramebuffers(const Context *context, TextureID texture)
+{
     // [OpenGL ES 2.0.24] section 4.4 page 112:
     // If a texture object is deleted while its image is attached to the currently bound
     // framebuffer, then it is as if Texture2DAttachment had been called, with a texture of 0, for
@@ -1311,12 +1358,14 @@ void State::initializeZeroTextures(const Context *context, const TextureMap &zer
 void State::invalidateTexture(TextureType type)
 {
     mDirtyBits.set(DIRTY_BIT_TEXTURE_BINDINGS);
+    mDirtyActiveTextureUnits.set();
 }
 
 void State::setSamplerBinding(const Context *context, GLuint textureUnit, Sampler *sampler)
 {
     mSamplers[textureUnit].set(context, sampler);
     mDirtyBits.set(DIRTY_BIT_SAMPLER_BINDINGS);
+    mDirtyActiveTextureUnits.set(textureUnit);
     // This is overly conservative as it assumes the sampler has never been bound.
     setSamplerDirty(textureUnit);
     onActiveTextureChange(context, textureUnit);
@@ -2967,6 +3016,15 @@ void State::onActiveTextureChange(const Context *context, size_t textureUnit)
     }
 }
 
+void State::onSamplerUniformChange(const Context *context, size_t textureUnit)
+{
+    // The unit may have stopped being used by the program, so it's flagged even if inactive for
+    // backends to drop it.
+    mDirtyBits.set(DIRTY_BIT_TEXTURE_BINDINGS);
+    mDirtyActiveTextureUnits.set(textureUnit);
+    onActiveTextureChange(context, textureUnit);
+}
+
 void State::onActiveTextureStateChange(const Context *context, size_t textureUnit)
 {
     if (mProgram)
@@ -236,6 +236,11 @@ class State : angle::NonCopyable
 
     TextureID getSamplerTextureId(unsigned int sampler, TextureType type) const;
     void detachTexture(const Context *context, const TextureMap &zeroTextures, TextureID texture);
+    // Same as detachTexture for several textures, with one pass over the texture bindings.
+    // |sortedTextures| must be sorted by id.
+    void detachTextures(const Context *context,
+                        const TextureMap &zeroTextures,
+                        const std::vector<TextureID> &sortedTextures);
     void initializeZeroTextures(const Context *context, const TextureMap &zeroTextures);
 
     void invalidateTexture(TextureType type);
@@ -594,12 +599,24 @@ class State : angle::NonCopyable
 
     using DirtyBits = angle::BitSet<DIRTY_BIT_MAX>;
     const DirtyBits &getDirtyBits() const { return mDirtyBits; }
-    void clearDirtyBits() { mDirtyBits.reset(); }
-    void clearDirtyBits(const DirtyBits &bitset) { mDirtyBits &= ~bitset; }
+    void clearDirtyBits()
+    {
+        mDirtyBits.reset();
+        mDirtyActiveTextureUnits.reset();
+    }
+    void clearDirtyBits(const DirtyBits &bitset)
+    {
+        mDirtyBits &= ~bitset;
+        if (bitset.test(DIRTY_BIT_TEXTURE_BINDINGS) || bitset.test(DIRTY_BIT_SAMPLER_BINDINGS))
+        {
+            mDirtyActiveTextureUnits.reset();
+        }
+    }
     void setAllDirtyBits()
     {
         mDirtyBits.set();
         mDirtyCurrentValues.set();
+        mDirtyActiveTextureUnits.set();
     }
 
     using DirtyObjects = angle::BitSet<DIRTY_OBJECT_MAX>;
@@ -638,11 +655,18 @@ class State : angle::NonCopyable
 
     const ImageUnit &getImageUnit(size_t unit) const { return mImageUnits[unit]; }
     const ActiveTexturePointerArray &getActiveTexturesCache() const { return mActiveTexturesCache; }
+
+    // Texture units whose texture or sampler binding changed since the last time
+    // DIRTY_BIT_TEXTURE_BINDINGS or DIRTY_BIT_SAMPLER_BINDINGS was synced.
+    const ActiveTextureMask &getDirtyActiveTextureUnits() const { return mDirtyActiveTextureUnits; }
     ComponentTypeMask getCurrentValuesTypeMask() const { return mCurrentValuesTypeMask; }
 
     // "onActiveTextureChange" is called when a texture binding changes.
     void onActiveTextureChange(const Context *context, size_t textureUnit);
 
+    // "onSamplerUniformChange" is called when a sampler uniform moves to or from a texture unit.
+    void onSamplerUniformChange(const Context *context, size_t textureUnit);
+
     // "onActiveTextureStateChange" calls when the Texture itself changed but the binding did not.
     void onActiveTextureStateChange(const Context *context, size_t textureUnit);
 
@@ -691,6 +715,11 @@ class State : angle::NonCopyable
     friend class Context;
 
     void unsetActiveTextures(ActiveTextureMask textureMask);
+    template <typename IsDetachedFunc>
+    void detachTextureBindings(const Context *context,
+                               const TextureMap &zeroTextures,
+                               IsDetachedFunc isDetached);
+    void detachTextureFromFramebuffers(const Context *context, TextureID texture);
     void updateActiveTexture(const Context *context, size_t textureIndex, Texture *texture);
     void updateActiveTextureState(const Context *context,
                                   size_t textureIndex,
@@ -904,6 +933,7 @@ class State : angle::NonCopyable
     mutable AttributesMask mDirtyCurrentValues;
     ActiveTextureMask mDirtyTextures;
     ActiveTextureMask mDirtySamplers;
+    ActiveTextureMask mDirtyActiveTextureUnits;
     ImageUnitMask mDirtyImages;
 
     // The Overlay object, used by the backend to render the overlay.
@@ -16,6 +16,7 @@
 #include "libANGLE/State.h"
 #include "libANGLE/Surface.h"
 #include "libANGLE/formatutils.h"
+#include "libANGLE/renderer/ContextImpl.h"
 #include "libANGLE/renderer/GLImplFactory.h"
 #include "libANGLE/renderer/TextureImpl.h"
 
@@ -48,6 +49,49 @@ InitState DetermineInitState(const Context *context, const uint8_t *pixels)
                ? InitState::MayNeedInit
                : InitState::Initialized;
 }
+
+int GetInitTileSize(int extent)
+{
+    return std::max(1, (extent + kInitTileGridSize - 1) / kInitTileGridSize);
+}
+
+// The grid tiles that overlap an image. Small images leave the last rows and columns unused.
+InitTileMask GetInitTilesInImage(const Extents &size)
+{
+    int tileWidth  = GetInitTileSize(size.width);
+    int tileHeight = GetInitTileSize(size.height);
+    int columns    = std::min(kInitTileGridSize, (size.width + tileWidth - 1) / tileWidth);
+    int rows       = std::min(kInitTileGridSize, (size.height + tileHeight - 1) / tileHeight);
+
+    InitTileMask tiles;
+    for (int row = 0; row < rows; ++row)
+    {
+        for (int column = 0; column < columns; ++column)
+        {
+            tiles.set(row * kInitTileGridSize + column);
+        }
+    }
+    return tiles;
+}
+
+Box GetInitTileArea(const Extents &size, size_t tile)
+{
+    int tileWidth  = GetInitTileSize(size.width);
+    int tileHeight = GetInitTileSize(size.height);
+    int x          = static_cast<int>(tile % kInitTileGridSize) * tileWidth;
+    int y          = static_cast<int>(tile / kInitTileGridSize) * tileHeight;
+    return Box(x, y, 0, std::min(tileWidth, size.width - x), std::min(tileHeight, size.height - y),
+               size.depth);
+}
+
+// Tiles are cleared by uploading zeros, which needs a format that can be specified with
+// glTexSubImage.
+bool CanTrackInitializedTiles(TextureType type, const ImageDesc &desc)
+{
+    const InternalFormat &formatInfo = *desc.format.info;
+    return type != TextureType::External && desc.samples == 0 && !formatInfo.compressed &&
+           formatInfo.depthBits == 0 && formatInfo.stencilBits == 0;
+}
 }  // namespace
 
 bool IsMipmapFiltered(const SamplerState &samplerState)
@@ -622,7 +666,9 @@ Texture::Texture(rx::GLImplFactory *factory, TextureID id, TextureType type)
       mImplObserver(this, rx::kTextureImageImplObserverMessageIndex),
       mLabel(),
       mBoundSurface(nullptr),
-      mBoundStream(nullptr)
+      mBoundStream(nullptr),
+      mCompletenessCacheNextEntry(0),
+      mCompletenessCacheVersion(1)
 {
     mImplObserver.bind(mTexture);
 
@@ -1712,26 +1758,41 @@ bool Texture::isSamplerComplete(const Context *context, const Sampler *optionalS
     const auto &samplerState =
         optionalSampler ? optionalSampler->getSamplerState() : mState.mSamplerState;
     const auto &contextState = context->getState();
+    ContextID contextID      = contextState.getContextID();
+    uint32_t samplerKey      = samplerState.getCompletenessKey();
 
-    if (contextState.getContextID() != mCompletenessCache.context ||
-        !mCompletenessCache.samplerState.sameCompleteness(samplerState))
+    for (const SamplerCompletenessCacheEntry &entry : mCompletenessCache)
     {
-        mCompletenessCache.context      = context->getState().getContextID();
-        mCompletenessCache.samplerState = samplerState;
-        mCompletenessCache.samplerComplete =
-            mState.computeSamplerCompleteness(samplerState, contextState);
+        if (entry.textureVersion == mCompletenessCacheVersion && entry.context == contextID &&
+            entry.samplerKey == samplerKey)
+        {
+            return entry.samplerComplete;
+        }
     }
 
-    return mCompletenessCache.samplerComplete;
+    SamplerCompletenessCacheEntry &entry = mCompletenessCache[mCompletenessCacheNextEntry];
+    mCompletenessCacheNextEntry = (mCompletenessCacheNextEntry + 1) % mCompletenessCache.size();
+
+    entry.context         = contextID;
+    entry.samplerKey      = samplerKey;
+    entry.textureVersion  = mCompletenessCacheVersion;
+    entry.samplerComplete = mState.computeSamplerCompleteness(samplerState, contextState);
+
+    return entry.samplerComplete;
 }
 
-Texture::SamplerCompletenessCache::SamplerCompletenessCache()
-    : context(0), samplerState(), samplerComplete(false)
+Texture::SamplerCompletenessCacheEntry::SamplerCompletenessCacheEntry()
+    : context(0), samplerKey(0), textureVersion(0), samplerComplete(false)
 {}
 
 void Texture::invalidateCompletenessCache() const
 {
-    mCompletenessCache.context = 0;
+    // Version 0 is never current, so default-constructed entries can't match.
+    if (++mCompletenessCacheVersion == 0)
+    {
+        mCompletenessCache.fill(SamplerCompletenessCacheEntry());
+        mCompletenessCacheVersion = 1;
+    }
 }
 
 angle::Result Texture::ensureInitialized(const Context *context)
@@ -1755,8 +1816,9 @@ angle::Result Texture::ensureInitialized(const Context *context)
         {
             ASSERT(mState.mInitState == InitState::MayNeedInit);
             ANGLE_TRY(initializeContents(context, index));
-            desc.initState = InitState::Initialized;
-            anyDirty       = true;
+            desc.initState        = InitState::Initialized;
+            desc.initializedTiles = InitTileMask();
+            anyDirty              = true;
         }
     }
     if (anyDirty)
@@ -1802,12 +1864,53 @@ void Texture::setInitState(const ImageIndex &imageIndex, InitState initState)
     }
     else
     {
-        ImageDesc newDesc = mState.getImageDesc(imageIndex);
-        newDesc.initState = initState;
+        ImageDesc newDesc        = mState.getImageDesc(imageIndex);
+        newDesc.initState        = initState;
+        newDesc.initializedTiles = InitTileMask();
         mState.setImageDesc(imageIndex.getTarget(), imageIndex.getLevelIndex(), newDesc);
     }
 }
 
+angle::Result Texture::initializeContents(const Context *context, const ImageIndex &imageIndex)
+{
+    // Levels that were partially written can only have their remaining tiles cleared.
+    const GLint levelIndex = imageIndex.getLevelIndex();
+    if (imageIndex.isEntireLevelCubeMap())
+    {
+        bool anyFaceHasTiles = false;
+        for (TextureTarget cubeFaceTarget : AllCubeFaceTextureTargets())
+        {
+            anyFaceHasTiles |=
+                mState.getImageDesc(cubeFaceTarget, levelIndex).initializedTiles.any();
+        }
+
+        if (anyFaceHasTiles)
+        {
+            for (TextureTarget cubeFaceTarget : AllCubeFaceTextureTargets())
+            {
+                if (mState.getImageDesc(cubeFaceTarget, levelIndex).initState ==
+                    InitState::MayNeedInit)
+                {
+                    ANGLE_TRY(initializeContents(
+                        context, ImageIndex::MakeCubeMapFace(cubeFaceTarget, levelIndex)));
+                }
+            }
+            return angle::Result::Continue;
+        }
+    }
+    else
+    {
+        const ImageDesc &desc = mState.getImageDesc(imageIndex.getTarget(), levelIndex);
+        if (desc.initializedTiles.any())
+        {
+            return initializeTiles(context, imageIndex.getTarget(), levelIndex, desc,
+                                   GetInitTilesInImage(desc.size) & ~desc.initializedTiles);
+        }
+    }
+
+    return FramebufferAttachmentObject::initializeContents(context, imageIndex);
+}
+
 angle::Result Texture::ensureSubImageInitialized(const Context *context,
                                                  TextureTarget target,
                                                  size_t level,
@@ -1819,22 +1922,111 @@ angle::Result Texture::ensureSubImageInitialized(const Context *context,
     }
 
     // Pre-initialize the texture contents if necessary.
-    // TODO(jmadill): Check if area overlaps the entire texture.
     ImageIndex imageIndex =
         ImageIndex::MakeFromTarget(target, static_cast<GLint>(level), area.depth);
     const auto &desc = mState.getImageDesc(imageIndex);
-    if (desc.initState == InitState::MayNeedInit)
+    if (desc.initState != InitState::MayNeedInit || area.width == 0 || area.height == 0 ||
+        area.depth == 0)
+    {
+        return angle::Result::Continue;
+    }
+
+    ASSERT(mState.mInitState == InitState::MayNeedInit);
+    bool coversAllLayers  = area.z == 0 && area.depth == desc.size.depth;
+    bool coversWholeImage = coversAllLayers && area.x == 0 && area.y == 0 &&
+                            area.width == desc.size.width && area.height == desc.size.height;
+    if (coversWholeImage)
+    {
+        setInitState(imageIndex, InitState::Initialized);
+        return angle::Result::Continue;
+    }
+
+    if (!coversAllLayers || !CanTrackInitializedTiles(mState.mType, desc))
     {
-        ASSERT(mState.mInitState == InitState::MayNeedInit);
-        bool coversWholeImage = area.x == 0 && area.y == 0 && area.z == 0 &&
-                                area.width == desc.size.width && area.height == desc.size.height &&
-                                area.depth == desc.size.depth;
-        if (!coversWholeImage)
+        ANGLE_TRY(initializeContents(context, imageIndex));
+        setInitState(imageIndex, InitState::Initialized);
+        return angle::Result::Continue;
+    }
+
+    // Only clear the tiles this upload overlaps without covering them. Clearing the untouched
+    // tiles is deferred until the image is used, and skipped if later uploads cover them.
+    int tileWidth   = GetInitTileSize(desc.size.width);
+    int tileHeight  = GetInitTileSize(desc.size.height);
+    int firstColumn = area.x / tileWidth;
+    int lastColumn  = (area.x + area.width - 1) / tileWidth;
+    int firstRow    = area.y / tileHeight;
+    int lastRow     = (area.y + area.height - 1) / tileHeight;
+
+    InitTileMask touchedTiles;
+    InitTileMask partiallyTouchedTiles;
+    for (int row = firstRow; row <= lastRow; ++row)
+    {
+        for (int column = firstColumn; column <= lastColumn; ++column)
         {
-            ANGLE_TRY(initializeContents(context, imageIndex));
+            size_t tile  = static_cast<size_t>(row * kInitTileGridSize + column);
+            Box tileArea = GetInitTileArea(desc.size, tile);
+            touchedTiles.set(tile);
+            if (area.x > tileArea.x || area.y > tileArea.y ||
+                area.x + area.width < tileArea.x + tileArea.width ||
+                area.y + area.height < tileArea.y + tileArea.height)
+            {
+                partiallyTouchedTiles.set(tile);
+            }
         }
+    }
+
+    partiallyTouchedTiles &= ~desc.initializedTiles;
+    if (partiallyTouchedTiles.any())
+    {
+        ANGLE_TRY(initializeTiles(context, target, level, desc, partiallyTouchedTiles));
+    }
+
+    InitTileMask initializedTiles = desc.initializedTiles | touchedTiles;
+    if (initializedTiles == GetInitTilesInImage(desc.size))
+    {
         setInitState(imageIndex, InitState::Initialized);
     }
+    else
+    {
+        ImageDesc newDesc        = desc;
+        newDesc.initializedTiles = initializedTiles;
+        mState.setImageDesc(target, level, newDesc);
+    }
+
+    return angle::Result::Continue;
+}
+
+angle::Result Texture::initializeTiles(const Context *context,
+                                       TextureTarget target,
+                                       size_t level,
+                                       const ImageDesc &desc,
+                                       const InitTileMask &tiles)
+{
+    const InternalFormat &formatInfo = *desc.format.info;
+
+    PixelUnpackState unpackState;
+    unpackState.alignment = 1;
+
+    ImageIndex imageIndex =
+        ImageIndex::MakeFromTarget(target, static_cast<GLint>(level), desc.size.depth);
+
+    for (size_t tile : tiles)
+    {
+        Box tileArea = GetInitTileArea(desc.size, tile);
+
+        angle::CheckedNumeric<size_t> tileBytes = formatInfo.pixelBytes;
+        tileBytes *= tileArea.width;
+        tileBytes *= tileArea.height;
+        tileBytes *= tileArea.depth;
+
+        angle::MemoryBuffer *zeroBuffer = nullptr;
+        ANGLE_CHECK_GL_ALLOC(context->getImplementation(),
+                             tileBytes.IsValid() &&
+                                 context->getZeroFilledBuffer(tileBytes.ValueOrDie(), &zeroBuffer));
+
+        ANGLE_TRY(mTexture->setSubImage(context, imageIndex, tileArea, formatInfo.format,
+                                        formatInfo.type, unpackState, nullptr, zeroBuffer->data()));
+    }
 
     return angle::Result::Continue;
 }
@@ -9,6 +9,7 @@
 #ifndef LIBANGLE_TEXTURE_H_
 #define LIBANGLE_TEXTURE_H_
 
+#include <array>
 #include <map>
 #include <vector>
 
@@ -50,6 +51,11 @@ class Texture;
 
 bool IsMipmapFiltered(const SamplerState &samplerState);
 
+// For robust resource init, the parts of a level that were written are tracked on a coarse grid so
+// partial uploads don't have to clear the whole level first.
+constexpr int kInitTileGridSize = 8;
+using InitTileMask              = angle::BitSet<kInitTileGridSize * kInitTileGridSize>;
+
 struct ImageDesc final
 {
     ImageDesc();
@@ -72,6 +78,9 @@ struct ImageDesc final
 
     // Needed for robust resource initialization.
     InitState initState;
+
+    // While initState is MayNeedInit, the grid tiles that were already written in full.
+    InitTileMask initializedTiles;
 };
 
 struct SwizzleState final
@@ -451,6 +460,7 @@ class Texture final : public RefCountObject<TextureID>,
     InitState initState(const ImageIndex &imageIndex) const override;
     InitState initState() const { return mState.mInitState; }
     void setInitState(const ImageIndex &imageIndex, InitState initState) override;
+    angle::Result initializeContents(const Context *context, const ImageIndex &imageIndex) override;
 
     enum DirtyBitType
     {
@@ -515,6 +525,11 @@ class Texture final : public RefCountObject<TextureID>,
                                             TextureTarget target,
                                             size_t level,
                                             const gl::Box &area);
+    angle::Result initializeTiles(const Context *context,
+                                  TextureTarget target,
+                                  size_t level,
+                                  const ImageDesc &desc,
+                                  const InitTileMask &tiles);
 
     angle::Result handleMipmapGenerationHint(Context *context, int level);
 
@@ -530,22 +545,32 @@ class Texture final : public RefCountObject<TextureID>,
     egl::Surface *mBoundSurface;
     egl::Stream *mBoundStream;
 
-    struct SamplerCompletenessCache
+    struct SamplerCompletenessCacheEntry
     {
-        SamplerCompletenessCache();
+        SamplerCompletenessCacheEntry();
 
         // Context used to generate this cache entry
         ContextID context;
 
         // All values that affect sampler completeness that are not stored within
-        // the texture itself
-        SamplerState samplerState;
+        // the texture itself, see SamplerState::getCompletenessKey
+        uint32_t samplerKey;
+
+        // Value of mCompletenessCacheVersion when the entry was generated
+        uint32_t textureVersion;
 
         // Result of the sampler completeness with the above parameters
         bool samplerComplete;
     };
 
-    mutable SamplerCompletenessCache mCompletenessCache;
+    // A texture is often sampled with a few different samplers, or from a few contexts, so keep
+    // several results around.  Changing the texture bumps mCompletenessCacheVersion, which makes
+    // all entries stale at once.
+    static constexpr size_t kSamplerCompletenessCacheSize = 4;
+    mutable std::array<SamplerCompletenessCacheEntry, kSamplerCompletenessCacheSize>
+        mCompletenessCache;
+    mutable size_t mCompletenessCacheNextEntry;
+    mutable uint32_t mCompletenessCacheVersion;
 };
 
 inline bool operator==(const TextureState &a, const TextureState &b)
@@ -288,6 +288,9 @@ class SamplerState final
         return mCompleteness.packed == samplerState.mCompleteness.packed;
     }
 
+    // Packs all of the state that affects texture completeness, for use as a cache key.
+    uint32_t getCompletenessKey() const { return mCompleteness.packed; }
+
   private:
     void updateWrapTCompareMode();
 
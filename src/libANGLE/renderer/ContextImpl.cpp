@@ -114,6 +114,14 @@ void ContextImpl::invalidateTexture(gl::TextureType target)
     UNREACHABLE();
 }
 
+angle::Result ContextImpl::getGpuProfileTime(const gl::Context *context,
+                                             GLenum pname,
+                                             GLint64 *timeOut)
+{
+    UNREACHABLE();
+    return angle::Result::Stop;
+}
+
 angle::Result ContextImpl::onUnMakeCurrent(const gl::Context *context)
 {
     return angle::Result::Continue;
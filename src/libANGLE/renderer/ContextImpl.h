@@ -162,6 +162,11 @@ class ContextImpl : public GLImplFactory
     // GL_ANGLE_texture_storage_external
     virtual void invalidateTexture(gl::TextureType target);
 
+    // GL_ANGLE_gpu_profile
+    virtual angle::Result getGpuProfileTime(const gl::Context *context,
+                                            GLenum pname,
+                                            GLint64 *timeOut);
+
     // State sync with dirty bits.
     virtual angle::Result syncState(const gl::Context *context,
                                     const gl::State::DirtyBits &dirtyBits,
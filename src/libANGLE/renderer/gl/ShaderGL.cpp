@@ -343,6 +343,11 @@ std::shared_ptr<WaitableCompileEvent> ShaderGL::compile(const gl::Context *conte
         additionalOptions |= SH_UNFOLD_SHORT_CIRCUIT;
     }
 
+    if (features.optimizeShaderLocalVariables.enabled)
+    {
+        additionalOptions |= SH_OPTIMIZE_LOCAL_VARIABLES;
+    }
+
     options |= additionalOptions;
 
     auto workerThreadPool = context->getWorkerThreadPool();
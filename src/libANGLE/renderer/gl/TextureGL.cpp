@@ -293,6 +293,33 @@ angle::Result TextureGL::setSubImage(const gl::Context *context,
                                      const gl::PixelUnpackState &unpack,
                                      gl::Buffer *unpackBuffer,
                                      const uint8_t *pixels)
+{
+    // Robust resource init uploads zeroes with its own unpack state and no unpack buffer, while
+    // the native state is synced to the application's.  Apply the given state for this upload and
+    // restore the application's afterwards, like initializeContents.  For regular uploads both
+    // are already current, so this doesn't make any GL calls.
+    StateManagerGL *stateManager = GetStateManagerGL(context);
+    stateManager->setPixelUnpackState(unpack);
+    stateManager->setPixelUnpackBuffer(unpackBuffer);
+
+    angle::Result result =
+        setSubImageHelper(context, index, area, format, type, unpack, unpackBuffer, pixels);
+
+    const gl::State &glState = context->getState();
+    stateManager->setPixelUnpackState(glState.getUnpackState());
+    stateManager->setPixelUnpackBuffer(glState.getTargetBuffer(gl::BufferBinding::PixelUnpack));
+
+    return result;
+}
+
+angle::Result TextureGL::setSubImageHelper(const gl::Context *context,
+                                           const gl::ImageIndex &index,
+                                           const gl::Box &area,
+                                           GLenum format,
+                                           GLenum type,
+                                           const gl::PixelUnpackState &unpack,
+                                           gl::Buffer *unpackBuffer,
+                                           const uint8_t *pixels)
 {
     ASSERT(TextureTargetToType(index.getTarget()) == getType());
 
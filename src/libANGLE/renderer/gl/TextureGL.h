@@ -215,6 +215,14 @@ class TextureGL : public TextureImpl
                                  GLenum format,
                                  GLenum type,
                                  const uint8_t *pixels);
+    angle::Result setSubImageHelper(const gl::Context *context,
+                                    const gl::ImageIndex &index,
+                                    const gl::Box &area,
+                                    GLenum format,
+                                    GLenum type,
+                                    const gl::PixelUnpackState &unpack,
+                                    gl::Buffer *unpackBuffer,
+                                    const uint8_t *pixels);
     // This changes the current pixel unpack state that will have to be reapplied.
     angle::Result reserveTexImageToBeFilled(const gl::Context *context,
                                             gl::TextureTarget target,
@@ -25,6 +25,7 @@
 #include "libANGLE/renderer/gl/formatutilsgl.h"
 #include "platform/FeaturesGL.h"
 #include "platform/FrontendFeatures.h"
+#include "platform/Platform.h"
 
 #include <EGL/eglext.h>
 #include <algorithm>
@@ -1583,6 +1584,11 @@ void InitializeFeatures(const FunctionsGL *functions, angle::FeaturesGL *feature
     ANGLE_FEATURE_CONDITION(features, rgbDXT1TexturesSampleZeroAlpha, IsApple())
 
     ANGLE_FEATURE_CONDITION(features, unfoldShortCircuits, IsApple())
+
+    ANGLE_FEATURE_CONDITION(features, optimizeShaderLocalVariables, false)
+
+    angle::PlatformMethods *platform = ANGLEPlatformCurrent();
+    platform->overrideFeaturesGL(platform, features);
 }
 
 void InitializeFrontendFeatures(const FunctionsGL *functions, angle::FrontendFeatures *features)
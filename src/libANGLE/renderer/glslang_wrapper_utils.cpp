@@ -22,6 +22,7 @@ ANGLE_REENABLE_EXTRA_SEMI_WARNING
 
 #include <array>
 #include <numeric>
+#include <unordered_map>
 
 #include "common/FixedVector.h"
 #include "common/string_utils.h"
@@ -59,6 +60,20 @@ constexpr char kVersionDefine[]             = "#version 450 core\n";
 constexpr char kLineRasterDefine[]          = "#define ANGLE_ENABLE_LINE_SEGMENT_RASTERIZATION\n";
 constexpr char kXfbEmuMacro[]               = "ANGLE_ENABLE_XFB_EMULATION";
 constexpr char kXfbEmuDefine[]              = "#define ANGLE_ENABLE_XFB_EMULATION\n";
+constexpr char kSetLayoutBegin[]            = "set = ";
+constexpr char kBindingLayoutBegin[]        = ", binding = ";
+
+// Keep at most this much SPIR-V around for programs linked later.
+constexpr size_t kSpirvCacheMaxSize = 4 * 1024 * 1024;
+
+// The few SPIR-V constants needed to patch the decorations, from the SPIR-V specification.
+constexpr uint32_t kSpirvHeaderWordCount   = 5;
+constexpr uint32_t kSpirvOpCodeMask        = 0xFFFF;
+constexpr uint32_t kSpirvWordCountShift    = 16;
+constexpr uint32_t kSpirvOpDecorate        = 71;
+constexpr uint32_t kSpirvOpFunction        = 54;
+constexpr uint32_t kSpirvDecorationBinding = 33;
+constexpr uint32_t kSpirvDecorationDescSet = 34;
 
 template <size_t N>
 constexpr size_t ConstStrLen(const char (&)[N])
@@ -387,6 +402,135 @@ std::string IntermediateShaderSource::getShaderSource()
     return shaderSource;
 }
 
+// A descriptor set and binding pair assigned by GlslangGetShaderSource.
+struct ResourceBinding
+{
+    uint32_t descriptorSet;
+    uint32_t binding;
+};
+
+// Parses the decimal number at |cur|.  Returns the position after it, or |cur| if there is no
+// number.
+size_t ParseUnsigned(const std::string &source, size_t cur, uint32_t *valueOut)
+{
+    *valueOut = 0;
+    while (cur < source.length() && source[cur] >= '0' && source[cur] <= '9')
+    {
+        *valueOut = *valueOut * 10 + static_cast<uint32_t>(source[cur] - '0');
+        ++cur;
+    }
+    return cur;
+}
+
+// Replaces the "set = N, binding = M" layout qualifiers generated by GlslangGetShaderSource with
+// "set = 0, binding = i", where i is the index of the qualifier in the source.  The actual
+// numbers are returned in |bindingsOut|, indexed by i.  The result only depends on the shader
+// and on the varyings and resources that are active in the program, so it is the same for all
+// the programs that link a shader with compatible ones.
+void ExtractResourceBindings(const std::string &source,
+                             std::string *canonicalSourceOut,
+                             std::vector<ResourceBinding> *bindingsOut)
+{
+    canonicalSourceOut->clear();
+    canonicalSourceOut->reserve(source.length());
+
+    size_t cur = 0;
+    while (cur < source.length())
+    {
+        size_t setBegin = source.find(kSetLayoutBegin, cur);
+        if (setBegin == std::string::npos)
+        {
+            break;
+        }
+
+        const size_t setNumberBegin = setBegin + ConstStrLen(kSetLayoutBegin);
+
+        // Only the qualifiers generated by ANGLE are considered, which always start a layout
+        // argument.  User identifiers are prefixed, so they can't be mistaken for one.
+        ResourceBinding binding   = {};
+        size_t setNumberEnd       = ParseUnsigned(source, setNumberBegin, &binding.descriptorSet);
+        size_t bindingNumberBegin = setNumberEnd + ConstStrLen(kBindingLayoutBegin);
+        size_t bindingNumberEnd   = bindingNumberBegin;
+        if (setBegin > 0 && (source[setBegin - 1] == '(' || source[setBegin - 1] == ' ') &&
+            setNumberEnd > setNumberBegin &&
+            source.compare(setNumberEnd, ConstStrLen(kBindingLayoutBegin), kBindingLayoutBegin) ==
+                0)
+        {
+            bindingNumberEnd = ParseUnsigned(source, bindingNumberBegin, &binding.binding);
+        }
+
+        if (bindingNumberEnd == bindingNumberBegin)
+        {
+            canonicalSourceOut->append(source, cur, setNumberBegin - cur);
+            cur = setNumberBegin;
+            continue;
+        }
+
+        canonicalSourceOut->append(source, cur, setBegin - cur);
+        *canonicalSourceOut += kSetLayoutBegin;
+        *canonicalSourceOut += "0";
+        *canonicalSourceOut += kBindingLayoutBegin;
+        *canonicalSourceOut += Str(static_cast<int>(bindingsOut->size()));
+
+        bindingsOut->push_back(binding);
+        cur = bindingNumberEnd;
+    }
+
+    canonicalSourceOut->append(source, cur, std::string::npos);
+}
+
+// Rewrites the Binding and DescriptorSet decorations of SPIR-V generated from a source returned
+// by ExtractResourceBindings with the actual numbers.
+void PatchResourceBindings(const std::vector<ResourceBinding> &bindings,
+                           std::vector<uint32_t> *spirv)
+{
+    if (bindings.empty())
+    {
+        return;
+    }
+
+    // The DescriptorSet decoration of a variable may come before its Binding decoration, which
+    // identifies the resource, so the decorations are patched in two passes.
+    std::unordered_map<uint32_t, uint32_t> idToBindingIndex;
+    for (uint32_t decoration : {kSpirvDecorationBinding, kSpirvDecorationDescSet})
+    {
+        size_t cur = kSpirvHeaderWordCount;
+        while (cur < spirv->size())
+        {
+            const uint32_t opCode    = (*spirv)[cur] & kSpirvOpCodeMask;
+            const uint32_t wordCount = (*spirv)[cur] >> kSpirvWordCountShift;
+            ASSERT(wordCount > 0);
+
+            // Decorations all precede the function definitions.
+            if (opCode == kSpirvOpFunction)
+            {
+                break;
+            }
+
+            // OpDecorate %target Decoration literal
+            if (opCode == kSpirvOpDecorate && wordCount == 4 && (*spirv)[cur + 2] == decoration)
+            {
+                const uint32_t id = (*spirv)[cur + 1];
+                uint32_t &literal = (*spirv)[cur + 3];
+
+                if (decoration == kSpirvDecorationBinding)
+                {
+                    ASSERT(literal < bindings.size());
+                    idToBindingIndex[id] = literal;
+                    literal              = bindings[literal].binding;
+                }
+                else
+                {
+                    ASSERT(idToBindingIndex.count(id) == 1);
+                    literal = bindings[idToBindingIndex[id]].descriptorSet;
+                }
+            }
+
+            cur += wordCount;
+        }
+    }
+}
+
 std::string GetMappedSamplerNameOld(const std::string &originalName)
 {
     std::string samplerName = gl::ParseResourceName(originalName, nullptr);
@@ -1006,8 +1150,89 @@ angle::Result GetShaderSpirvCode(GlslangErrorCallback callback,
 
     return angle::Result::Continue;
 }
+
+angle::Result GetCachedShaderSpirvCode(GlslangErrorCallback callback,
+                                       const gl::Caps &glCaps,
+                                       GlslangSpirvCache *spirvCache,
+                                       const gl::ShaderMap<std::string> &shaderSources,
+                                       gl::ShaderMap<std::vector<uint32_t>> *shaderCodeOut)
+{
+    for (const gl::ShaderType shaderType : gl::AllShaderTypes())
+    {
+        if (shaderSources[shaderType].empty())
+        {
+            continue;
+        }
+
+        std::string canonicalSource;
+        std::vector<ResourceBinding> bindings;
+        ExtractResourceBindings(shaderSources[shaderType], &canonicalSource, &bindings);
+
+        std::vector<uint32_t> &code = (*shaderCodeOut)[shaderType];
+        if (!spirvCache->get(shaderType, canonicalSource, &code))
+        {
+            // The stages are compiled separately, as the cached code of one stage may be used
+            // with any other.
+            gl::ShaderMap<std::string> stageSource;
+            gl::ShaderMap<std::vector<uint32_t>> stageCode;
+            stageSource[shaderType] = canonicalSource;
+            ANGLE_TRY(GetShaderSpirvCode(callback, glCaps, stageSource, &stageCode));
+
+            code = std::move(stageCode[shaderType]);
+            spirvCache->put(shaderType, canonicalSource, code);
+        }
+
+        PatchResourceBindings(bindings, &code);
+    }
+
+    return angle::Result::Continue;
+}
+
+std::string GetSpirvCacheKey(gl::ShaderType shaderType, const std::string &source)
+{
+    // The same source results in different code for each stage.
+    return Str(static_cast<int>(shaderType)) + ":" + source;
+}
 }  // anonymous namespace
 
+// GlslangSpirvCache implementation.
+GlslangSpirvCache::GlslangSpirvCache() : mEntries(kSpirvCacheMaxSize) {}
+
+GlslangSpirvCache::~GlslangSpirvCache() = default;
+
+bool GlslangSpirvCache::get(gl::ShaderType shaderType,
+                            const std::string &source,
+                            std::vector<uint32_t> *spirvOut)
+{
+    std::lock_guard<decltype(mMutex)> lock(mMutex);
+
+    const std::vector<uint32_t> *spirv = nullptr;
+    if (!mEntries.get(GetSpirvCacheKey(shaderType, source), &spirv))
+    {
+        return false;
+    }
+
+    *spirvOut = *spirv;
+    return true;
+}
+
+void GlslangSpirvCache::put(gl::ShaderType shaderType,
+                            const std::string &source,
+                            const std::vector<uint32_t> &spirv)
+{
+    std::string key = GetSpirvCacheKey(shaderType, source);
+    size_t size     = key.length() + spirv.size() * sizeof(uint32_t);
+
+    std::lock_guard<decltype(mMutex)> lock(mMutex);
+    mEntries.put(key, std::vector<uint32_t>(spirv), size);
+}
+
+size_t GlslangSpirvCache::getEntryCount() const
+{
+    std::lock_guard<decltype(mMutex)> lock(mMutex);
+    return mEntries.entryCount();
+}
+
 void GlslangInitialize()
 {
     int result = ShInitialize();
@@ -1125,6 +1350,7 @@ void GlslangGetShaderSource(const GlslangSourceOptions &options,
 
 angle::Result GlslangGetShaderSpirvCode(GlslangErrorCallback callback,
                                         const gl::Caps &glCaps,
+                                        GlslangSpirvCache *spirvCache,
                                         bool enableLineRasterEmulation,
                                         bool enableXfbEmulation,
                                         const gl::ShaderMap<std::string> &shaderSources,
@@ -1158,10 +1384,20 @@ angle::Result GlslangGetShaderSpirvCode(GlslangErrorCallback callback,
                                 GlslangError::InvalidShader);
         }
 
+        if (spirvCache)
+        {
+            return GetCachedShaderSpirvCode(callback, glCaps, spirvCache, patchedSources,
+                                            shaderCodeOut);
+        }
         return GetShaderSpirvCode(callback, glCaps, patchedSources, shaderCodeOut);
     }
     else
     {
+        if (spirvCache)
+        {
+            return GetCachedShaderSpirvCode(callback, glCaps, spirvCache, shaderSources,
+                                            shaderCodeOut);
+        }
         return GetShaderSpirvCode(callback, glCaps, shaderSources, shaderCodeOut);
     }
 }
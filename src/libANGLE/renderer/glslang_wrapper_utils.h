@@ -10,7 +10,9 @@
 #define LIBANGLE_RENDERER_GLSLANG_WRAPPER_UTILS_H_
 
 #include <functional>
+#include <mutex>
 
+#include "libANGLE/SizedMRUCache.h"
 #include "libANGLE/renderer/ProgramImpl.h"
 
 namespace rx
@@ -37,6 +39,28 @@ struct GlslangSourceOptions
 
 using GlslangErrorCallback = std::function<angle::Result(GlslangError)>;
 
+// Caches the SPIR-V generated for each shader stage, so that linking the same shader into several
+// programs runs glslang only once.  The descriptor set and binding numbers assigned by
+// GlslangGetShaderSource are not part of the key; they are patched into the cached SPIR-V
+// instead.  Can be used from multiple threads.
+class GlslangSpirvCache final : angle::NonCopyable
+{
+  public:
+    GlslangSpirvCache();
+    ~GlslangSpirvCache();
+
+    bool get(gl::ShaderType shaderType, const std::string &source, std::vector<uint32_t> *spirvOut);
+    void put(gl::ShaderType shaderType,
+             const std::string &source,
+             const std::vector<uint32_t> &spirv);
+
+    size_t getEntryCount() const;
+
+  private:
+    mutable std::mutex mMutex;
+    angle::SizedMRUCache<std::string, std::vector<uint32_t>> mEntries;
+};
+
 void GlslangInitialize();
 void GlslangRelease();
 
@@ -51,8 +75,10 @@ void GlslangGetShaderSource(const GlslangSourceOptions &options,
                             const gl::ProgramLinkedResources &resources,
                             gl::ShaderMap<std::string> *shaderSourcesOut);
 
+// |spirvCache| is optional.
 angle::Result GlslangGetShaderSpirvCode(GlslangErrorCallback callback,
                                         const gl::Caps &glCaps,
+                                        GlslangSpirvCache *spirvCache,
                                         bool enableLineRasterEmulation,
                                         bool enableXfbEmulation,
                                         const gl::ShaderMap<std::string> &shaderSources,
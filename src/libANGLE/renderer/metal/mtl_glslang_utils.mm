@@ -1192,7 +1192,8 @@ angle::Result GlslangGetShaderSpirvCode(ErrorHandler *context,
     // Normal version without XFB emulation
     ANGLE_TRY(rx::GlslangGetShaderSpirvCode(
         [context](GlslangError error) { return HandleError(context, error); }, glCaps,
-        enableLineRasterEmulation, /* enableXfbEmulation */ false, shaderSources, shaderCodeOut));
+        /* spirvCache */ nullptr, enableLineRasterEmulation, /* enableXfbEmulation */ false,
+        shaderSources, shaderCodeOut));
 
     // Metal doesn't allow vertex shader to write to both buffers and stage output. So need a
     // special version with only XFB emulation.
@@ -1204,8 +1205,8 @@ angle::Result GlslangGetShaderSpirvCode(ErrorHandler *context,
 
         ANGLE_TRY(rx::GlslangGetShaderSpirvCode(
             [context](GlslangError error) { return HandleError(context, error); }, glCaps,
-            enableLineRasterEmulation, /* enableXfbEmulation */ true, vsOnlySrcMap,
-            &vsOnlyCodeMap));
+            /* spirvCache */ nullptr, enableLineRasterEmulation, /* enableXfbEmulation */ true,
+            vsOnlySrcMap, &vsOnlyCodeMap));
         *xfbOnlyShaderCodeOut = std::move(vsOnlyCodeMap[gl::ShaderType::Vertex]);
     }
 
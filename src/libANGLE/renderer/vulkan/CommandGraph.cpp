@@ -12,6 +12,7 @@
 #include <iostream>
 
 #include "libANGLE/Overlay.h"
+#include "libANGLE/histogram_macros.h"
 #include "libANGLE/renderer/vulkan/ContextVk.h"
 #include "libANGLE/renderer/vulkan/RenderTargetVk.h"
 #include "libANGLE/renderer/vulkan/RendererVk.h"
@@ -92,6 +93,8 @@ const char *GetResourceTypeName(CommandGraphResourceType resourceType,
             }
         case CommandGraphResourceType::Dispatcher:
             return "Dispatcher";
+        case CommandGraphResourceType::LayoutTransition:
+            return "LayoutTransition";
         case CommandGraphResourceType::EmulatedQuery:
             switch (function)
             {
@@ -238,6 +241,60 @@ float CalculateSecondaryCommandBufferPoolWaste(const std::vector<CommandGraphNod
 
 }  // anonymous namespace
 
+// PipelineBarrier implementation.
+PipelineBarrier::PipelineBarrier()
+    : mSrcStageMask(0), mDstStageMask(0), mMemoryBarrierSrcAccess(0), mMemoryBarrierDstAccess(0)
+{}
+
+PipelineBarrier::~PipelineBarrier() = default;
+
+void PipelineBarrier::execute(PrimaryCommandBuffer *primaryCommandBuffer)
+{
+    if (isEmpty())
+    {
+        return;
+    }
+
+    ASSERT((mMemoryBarrierDstAccess == 0) == (mMemoryBarrierSrcAccess == 0));
+
+    VkMemoryBarrier memoryBarrier = {};
+    uint32_t memoryBarrierCount   = 0;
+    if (mMemoryBarrierSrcAccess != 0)
+    {
+        memoryBarrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        memoryBarrier.srcAccessMask = mMemoryBarrierSrcAccess;
+        memoryBarrier.dstAccessMask = mMemoryBarrierDstAccess;
+        memoryBarrierCount          = 1;
+    }
+
+    primaryCommandBuffer->pipelineBarrier(
+        mSrcStageMask, mDstStageMask, 0, memoryBarrierCount, &memoryBarrier, 0, nullptr,
+        static_cast<uint32_t>(mImageMemoryBarriers.size()), mImageMemoryBarriers.data());
+
+    mSrcStageMask           = 0;
+    mDstStageMask           = 0;
+    mMemoryBarrierSrcAccess = 0;
+    mMemoryBarrierDstAccess = 0;
+    mImageMemoryBarriers.clear();
+}
+
+std::string PipelineBarrier::dumpForDiagnostics() const
+{
+    std::ostringstream out;
+    out << "Pipeline Barrier Stages: 0x" << std::hex << mSrcStageMask << " &rarr; 0x" << std::hex
+        << mDstStageMask;
+    if (mMemoryBarrierSrcAccess != 0 || mMemoryBarrierDstAccess != 0)
+    {
+        out << ", Memory Src: 0x" << std::hex << mMemoryBarrierSrcAccess << " &rarr; Dst: 0x"
+            << std::hex << mMemoryBarrierDstAccess;
+    }
+    if (!mImageMemoryBarriers.empty())
+    {
+        out << ", Images: " << std::dec << mImageMemoryBarriers.size();
+    }
+    return out.str();
+}
+
 // CommandGraphResource implementation.
 CommandGraphResource::CommandGraphResource(CommandGraphResourceType resourceType)
     : mCurrentWritingNode(nullptr), mResourceType(resourceType)
@@ -378,9 +435,6 @@ CommandGraphNode::CommandGraphNode(CommandGraphNodeFunction function,
       mFenceSyncEvent(VK_NULL_HANDLE),
       mHasChildren(false),
       mVisitedState(VisitedState::Unvisited),
-      mGlobalMemoryBarrierSrcAccess(0),
-      mGlobalMemoryBarrierDstAccess(0),
-      mGlobalMemoryBarrierStages(0),
       mRenderPassOwner(nullptr)
 {}
 
@@ -456,6 +510,63 @@ void CommandGraphNode::storeRenderPassInfo(const Framebuffer &framebuffer,
     std::copy(clearValues.begin(), clearValues.end(), mRenderPassClearValues.begin());
 }
 
+bool CommandGraphNode::canExtendRenderPassRenderArea() const
+{
+    for (size_t attachmentIndex = 0; attachmentIndex < mRenderPassDesc.attachmentCount();
+         ++attachmentIndex)
+    {
+        const PackedAttachmentOpsDesc &ops = mRenderPassAttachmentOps[attachmentIndex];
+        if (ops.loadOp != VK_ATTACHMENT_LOAD_OP_LOAD ||
+            ops.stencilLoadOp != VK_ATTACHMENT_LOAD_OP_LOAD ||
+            ops.storeOp != VK_ATTACHMENT_STORE_OP_STORE ||
+            ops.stencilStoreOp != VK_ATTACHMENT_STORE_OP_STORE)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void CommandGraphNode::extendRenderPassRenderArea(const gl::Rectangle &renderArea)
+{
+    ASSERT(canExtendRenderPassRenderArea());
+
+    int x0 = std::min(mRenderPassRenderArea.x0(), renderArea.x0());
+    int y0 = std::min(mRenderPassRenderArea.y0(), renderArea.y0());
+    int x1 = std::max(mRenderPassRenderArea.x1(), renderArea.x1());
+    int y1 = std::max(mRenderPassRenderArea.y1(), renderArea.y1());
+
+    mRenderPassRenderArea = gl::Rectangle(x0, y0, x1 - x0, y1 - y0);
+}
+
+VkImageAspectFlags CommandGraphNode::dropRenderPassAttachmentStore(size_t attachmentIndex,
+                                                                   VkImageAspectFlags aspectFlags)
+{
+    ASSERT(attachmentIndex < mRenderPassDesc.attachmentCount());
+
+    PackedAttachmentOpsDesc &ops      = mRenderPassAttachmentOps[attachmentIndex];
+    VkImageAspectFlags droppedAspects = 0;
+
+    // Color and depth share the storeOp.
+    VkImageAspectFlags colorOrDepthAspects =
+        aspectFlags & (VK_IMAGE_ASPECT_COLOR_BIT | VK_IMAGE_ASPECT_DEPTH_BIT);
+    if (colorOrDepthAspects != 0 && ops.storeOp == VK_ATTACHMENT_STORE_OP_STORE)
+    {
+        ops.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        droppedAspects |= colorOrDepthAspects;
+    }
+
+    if ((aspectFlags & VK_IMAGE_ASPECT_STENCIL_BIT) != 0 &&
+        ops.stencilStoreOp == VK_ATTACHMENT_STORE_OP_STORE)
+    {
+        ops.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        droppedAspects |= VK_IMAGE_ASPECT_STENCIL_BIT;
+    }
+
+    return droppedAspects;
+}
+
 // static
 void CommandGraphNode::SetHappensBeforeDependencies(CommandGraphNode **beforeNodes,
                                                     size_t beforeNodesCount,
@@ -550,23 +661,13 @@ void CommandGraphNode::visitParents(std::vector<CommandGraphNode *> *stack)
     mVisitedState = VisitedState::Ready;
 }
 
-angle::Result CommandGraphNode::visitAndExecute(vk::Context *context,
+angle::Result CommandGraphNode::visitAndExecute(ContextVk *context,
                                                 Serial serial,
                                                 RenderPassCache *renderPassCache,
                                                 PrimaryCommandBuffer *primaryCommandBuffer)
 {
-    // Record the deferred pipeline barrier if necessary.
-    ASSERT((mGlobalMemoryBarrierDstAccess == 0) == (mGlobalMemoryBarrierSrcAccess == 0));
-    if (mGlobalMemoryBarrierSrcAccess)
-    {
-        VkMemoryBarrier memoryBarrier = {};
-        memoryBarrier.sType           = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
-        memoryBarrier.srcAccessMask   = mGlobalMemoryBarrierSrcAccess;
-        memoryBarrier.dstAccessMask   = mGlobalMemoryBarrierDstAccess;
-
-        primaryCommandBuffer->memoryBarrier(mGlobalMemoryBarrierStages, mGlobalMemoryBarrierStages,
-                                            &memoryBarrier);
-    }
+    // Record the deferred memory barriers and layout transitions with a single pipeline barrier.
+    mPipelineBarrier.execute(primaryCommandBuffer);
 
     switch (mFunction)
     {
@@ -603,9 +704,14 @@ angle::Result CommandGraphNode::visitAndExecute(vk::Context *context,
                     static_cast<uint32_t>(mRenderPassDesc.attachmentCount());
                 beginInfo.pClearValues = mRenderPassClearValues.data();
 
+                GpuProfiler &gpuProfiler = context->getGpuProfiler();
+                ANGLE_TRY(gpuProfiler.beginRenderPass(context, serial, primaryCommandBuffer));
+
                 primaryCommandBuffer->beginRenderPass(beginInfo, kRenderPassContents);
                 ExecuteCommands(primaryCommandBuffer, &mInsideRenderPassCommands);
                 primaryCommandBuffer->endRenderPass();
+
+                gpuProfiler.endRenderPass(primaryCommandBuffer);
             }
             break;
 
@@ -725,6 +831,18 @@ angle::Result CommandGraphNode::visitAndExecute(vk::Context *context,
     return angle::Result::Continue;
 }
 
+uint32_t CommandGraphNode::getPipelineBarrierCount() const
+{
+    uint32_t count = hasPipelineBarrier() ? 1 : 0;
+    count += mOutsideRenderPassCommands.getPipelineBarrierCount();
+    count += mInsideRenderPassCommands.getPipelineBarrierCount();
+    if (mFunction == CommandGraphNodeFunction::HostAvailabilityOperation)
+    {
+        ++count;
+    }
+    return count;
+}
+
 const std::vector<CommandGraphNode *> &CommandGraphNode::getParentsForDiagnostics() const
 {
     return mParents;
@@ -747,14 +865,10 @@ bool CommandGraphNode::hasDiagnosticID() const
 std::string CommandGraphNode::dumpCommandsForDiagnostics(const char *separator) const
 {
     std::string result;
-    if (mGlobalMemoryBarrierSrcAccess != 0 || mGlobalMemoryBarrierDstAccess != 0)
+    if (!mPipelineBarrier.isEmpty())
     {
         result += separator;
-
-        std::ostringstream out;
-        out << "Memory Barrier Src: 0x" << std::hex << mGlobalMemoryBarrierSrcAccess
-            << " &rarr; Dst: 0x" << std::hex << mGlobalMemoryBarrierDstAccess;
-        result += out.str();
+        result += mPipelineBarrier.dumpForDiagnostics();
     }
     if (mOutsideRenderPassCommands.valid())
     {
@@ -865,6 +979,9 @@ bool SharedGarbage::destroyIfComplete(VkDevice device, Serial completedSerial)
 CommandGraph::CommandGraph(bool enableGraphDiagnostics, angle::PoolAllocator *poolAllocator)
     : mEnableGraphDiagnostics(enableGraphDiagnostics),
       mPoolAllocator(poolAllocator),
+      mSubmittedRenderPassCount(0),
+      mRenderPassStoreBytesSaved(0),
+      mTotalRenderPassStoreBytesSaved(0),
       mLastBarrierIndex(kInvalidNodeIndex)
 {
     // Push so that allocations made from here will be recycled in clear() below.
@@ -925,6 +1042,19 @@ angle::Result CommandGraph::submitCommands(ContextVk *context,
     ASSERT(!mNodes.empty());
 
     updateOverlay(context);
+    mRenderPassStoreBytesSaved = 0;
+
+    uint32_t pipelineBarrierCount = 0;
+    for (const CommandGraphNode *node : mNodes)
+    {
+        if (node->hasRenderPass())
+        {
+            ++mSubmittedRenderPassCount;
+        }
+        pipelineBarrierCount += node->getPipelineBarrierCount();
+    }
+    ANGLE_HISTOGRAM_COUNTS_10000("GPU.ANGLE.VulkanPipelineBarriersPerSubmit",
+                                 static_cast<int>(pipelineBarrierCount));
 
     size_t previousBarrierIndex       = 0;
     CommandGraphNode *previousBarrier = getLastBarrierNode(&previousBarrierIndex);
@@ -956,6 +1086,10 @@ angle::Result CommandGraph::submitCommands(ContextVk *context,
     ANGLE_TRY(context->traceGpuEvent(primaryCommandBuffer, TRACE_EVENT_PHASE_BEGIN,
                                      "Primary Command Buffer"));
 
+    // The profiler's queries written in the nodes' command buffers are reset before any of them
+    // executes.
+    context->getGpuProfiler().resetScopeQueries(context, primaryCommandBuffer);
+
     for (CommandGraphNode *topLevelNode : mNodes)
     {
         // Only process commands that don't have child commands. The others will be pulled in
@@ -989,6 +1123,9 @@ angle::Result CommandGraph::submitCommands(ContextVk *context,
         }
     }
 
+    // Query results are copied once all the nodes that write them have executed.
+    context->recordQueryResultCopies(primaryCommandBuffer);
+
     ANGLE_TRY(context->traceGpuEvent(primaryCommandBuffer, TRACE_EVENT_PHASE_END,
                                      "Primary Command Buffer"));
 
@@ -1126,6 +1263,7 @@ void CommandGraph::dumpGraphDotFile(std::ostream &out) const
     int dispatcherIDCounter  = 1;
     int fenceIDCounter       = 1;
     int xfbIDCounter         = 1;
+    int transitionIDCounter  = 1;
 
     out << "digraph {" << std::endl;
 
@@ -1207,6 +1345,9 @@ void CommandGraph::dumpGraphDotFile(std::ostream &out) const
                     case CommandGraphResourceType::EmulatedQuery:
                         id = xfbIDCounter++;
                         break;
+                    case CommandGraphResourceType::LayoutTransition:
+                        id = transitionIDCounter++;
+                        break;
                     default:
                         UNREACHABLE();
                         break;
@@ -1245,6 +1386,9 @@ void CommandGraph::updateOverlay(ContextVk *contextVk) const
     overlay->getRunningHistogramWidget(gl::WidgetId::VulkanSecondaryCommandBufferPoolWaste)
         ->set(CalculateSecondaryCommandBufferPoolWaste(mNodes));
     overlay->getRunningHistogramWidget(gl::WidgetId::VulkanSecondaryCommandBufferPoolWaste)->next();
+
+    overlay->getRunningGraphWidget(gl::WidgetId::VulkanRenderPassStoreBytesSaved)
+        ->add(mRenderPassStoreBytesSaved);
 }
 
 CommandGraphNode *CommandGraph::getLastBarrierNode(size_t *indexOut)
@@ -34,6 +34,7 @@ enum class CommandGraphResourceType
     Image,
     Query,
     Dispatcher,
+    LayoutTransition,
     // Transform feedback queries could be handled entirely on the CPU (if not using
     // VK_EXT_transform_feedback), but still need to generate a command graph barrier node.
     EmulatedQuery,
@@ -77,6 +78,56 @@ class RenderPassOwner
     CommandBuffer *mRenderPassCommandBuffer = nullptr;
 };
 
+// Accumulates the barriers that must execute before a node's commands, so they are recorded with
+// a single vkCmdPipelineBarrier.  The stage masks of all the barriers are merged, which can
+// over-synchronize slightly, but costs much less than one barrier per resource.
+class PipelineBarrier : angle::NonCopyable
+{
+  public:
+    PipelineBarrier();
+    ~PipelineBarrier();
+
+    bool isEmpty() const { return mSrcStageMask == 0 && mDstStageMask == 0; }
+
+    void mergeExecutionBarrier(VkPipelineStageFlags srcStageMask,
+                               VkPipelineStageFlags dstStageMask)
+    {
+        mSrcStageMask |= srcStageMask;
+        mDstStageMask |= dstStageMask;
+    }
+
+    void mergeMemoryBarrier(VkPipelineStageFlags srcStageMask,
+                            VkPipelineStageFlags dstStageMask,
+                            VkFlags srcAccess,
+                            VkFlags dstAccess)
+    {
+        mergeExecutionBarrier(srcStageMask, dstStageMask);
+        mMemoryBarrierSrcAccess |= srcAccess;
+        mMemoryBarrierDstAccess |= dstAccess;
+    }
+
+    void mergeImageBarrier(VkPipelineStageFlags srcStageMask,
+                           VkPipelineStageFlags dstStageMask,
+                           const VkImageMemoryBarrier &imageMemoryBarrier)
+    {
+        ASSERT(imageMemoryBarrier.pNext == nullptr);
+        mergeExecutionBarrier(srcStageMask, dstStageMask);
+        mImageMemoryBarriers.push_back(imageMemoryBarrier);
+    }
+
+    // Records everything merged so far and resets the barrier.
+    void execute(PrimaryCommandBuffer *primaryCommandBuffer);
+
+    std::string dumpForDiagnostics() const;
+
+  private:
+    VkPipelineStageFlags mSrcStageMask;
+    VkPipelineStageFlags mDstStageMask;
+    VkFlags mMemoryBarrierSrcAccess;
+    VkFlags mMemoryBarrierDstAccess;
+    std::vector<VkImageMemoryBarrier> mImageMemoryBarriers;
+};
+
 // Only used internally in the command graph. Kept in the header for better inlining performance.
 class CommandGraphNode final : angle::NonCopyable
 {
@@ -145,6 +196,11 @@ class CommandGraphNode final : angle::NonCopyable
         mRenderPassAttachmentOps[attachmentIndex].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
     }
 
+    // Drops the store of the attachment's aspects in |aspectFlags|, for when the attachment is
+    // known to be overwritten before it's read again.  Returns the aspects that were being stored.
+    VkImageAspectFlags dropRenderPassAttachmentStore(size_t attachmentIndex,
+                                                     VkImageAspectFlags aspectFlags);
+
     // Dependency commands order node execution in the command graph.
     // Once a node has commands that must happen after it, recording is stopped and the node is
     // frozen forever.
@@ -170,7 +226,7 @@ class CommandGraphNode final : angle::NonCopyable
     // Commands for traversing the node on a flush operation.
     VisitedState visitedState() const;
     void visitParents(std::vector<CommandGraphNode *> *stack);
-    angle::Result visitAndExecute(Context *context,
+    angle::Result visitAndExecute(ContextVk *context,
                                   Serial serial,
                                   RenderPassCache *renderPassCache,
                                   PrimaryCommandBuffer *primaryCommandBuffer);
@@ -187,6 +243,13 @@ class CommandGraphNode final : angle::NonCopyable
 
     const gl::Rectangle &getRenderPassRenderArea() const { return mRenderPassRenderArea; }
 
+    // The render area can only grow if every attachment is loaded and stored, as the contents
+    // outside the original render area then go through the render pass unchanged.
+    bool canExtendRenderPassRenderArea() const;
+    void extendRenderPassRenderArea(const gl::Rectangle &renderArea);
+
+    bool hasRenderPass() const { return mInsideRenderPassCommands.valid(); }
+
     CommandGraphNodeFunction getFunction() const { return mFunction; }
 
     void setQueryPool(const QueryPool *queryPool, uint32_t queryIndex);
@@ -200,11 +263,18 @@ class CommandGraphNode final : angle::NonCopyable
                                              VkFlags dstAccess,
                                              VkPipelineStageFlags stages)
     {
-        mGlobalMemoryBarrierSrcAccess |= srcAccess;
-        mGlobalMemoryBarrierDstAccess |= dstAccess;
-        mGlobalMemoryBarrierStages |= stages;
+        mPipelineBarrier.mergeMemoryBarrier(stages, stages, srcAccess, dstAccess);
     }
 
+    // The barrier recorded before the node's commands.  Image layout transitions can be added to
+    // it as long as nothing already recorded in the node depends on the old layout.
+    PipelineBarrier *getPipelineBarrier() { return &mPipelineBarrier; }
+    bool hasPipelineBarrier() const { return !mPipelineBarrier.isEmpty(); }
+
+    // The deferred pipeline barrier, plus every barrier recorded in the node's commands, such as
+    // the ones from ImageHelper::changeLayout.
+    uint32_t getPipelineBarrierCount() const;
+
     // This can only be set for RenderPass nodes. Each RenderPass node can have at most one owner.
     void setRenderPassOwner(RenderPassOwner *owner)
     {
@@ -262,10 +332,8 @@ class CommandGraphNode final : angle::NonCopyable
     CommandGraphResourceType mResourceType;
     uintptr_t mResourceID;
 
-    // For global memory barriers.
-    VkFlags mGlobalMemoryBarrierSrcAccess;
-    VkFlags mGlobalMemoryBarrierDstAccess;
-    VkPipelineStageFlags mGlobalMemoryBarrierStages;
+    // For global memory barriers and batched image layout transitions.
+    PipelineBarrier mPipelineBarrier;
 
     // Render pass command buffer notifications.
     RenderPassOwner *mRenderPassOwner;
@@ -415,8 +483,9 @@ class CommandGraphResource : angle::NonCopyable
     // Checks if we're in a RenderPass without children.
     bool hasStartedRenderPass() const;
 
-    // Checks if we're in a RenderPass that encompasses renderArea, returning true if so. Updates
-    // serial internally. Returns the started command buffer in commandBufferOut.
+    // Checks if we're in a RenderPass that encompasses renderArea or can be extended to do so,
+    // returning true if so. Updates serial internally. Returns the started command buffer in
+    // commandBufferOut.
     bool appendToStartedRenderPass(CommandGraph *graph,
                                    const gl::Rectangle &renderArea,
                                    CommandBuffer **commandBufferOut);
@@ -437,24 +506,35 @@ class CommandGraphResource : angle::NonCopyable
     // Accessor for RenderPass RenderArea.
     const gl::Rectangle &getRenderPassRenderArea() const;
 
+    // Checks if the started RenderPass can grow its RenderArea instead of being restarted.
+    bool canExtendRenderPassRenderArea() const;
+
+    // Returns the node that last wrote to this resource if nothing has read from the resource
+    // since, or nullptr otherwise.
+    CommandGraphNode *getUnreadWritingNode();
+
     // Called when 'this' object changes, but we'd like to start a new command buffer later.
     void finishCurrentCommands(ContextVk *contextVk);
 
     // Store a deferred memory barrier. Will be recorded into a primary command buffer at submit.
     void addGlobalMemoryBarrier(VkFlags srcAccess, VkFlags dstAccess, VkPipelineStageFlags stages);
 
+    // Returns the barrier recorded before the current writing node's commands, to which image
+    // layout transitions can be added.
+    PipelineBarrier *getPipelineBarrier();
+
   protected:
     explicit CommandGraphResource(CommandGraphResourceType resourceType);
 
-    // Current resource lifetime.
-    SharedResourceUse mUse;
-
-  private:
     // Returns true if this node has a current writing node with no children.
     ANGLE_INLINE bool hasChildlessWritingNode() const;
 
     void startNewCommands(ContextVk *contextVk);
 
+    // Current resource lifetime.
+    SharedResourceUse mUse;
+
+  private:
     void onWriteImpl(ContextVk *contextVk, CommandGraphNode *writingNode);
 
     std::vector<CommandGraphNode *> mCurrentReadingNodes;
@@ -528,6 +608,22 @@ class CommandGraph final : angle::NonCopyable
     void onResourceUse(const SharedResourceUse &resourceUse);
     void releaseResourceUses();
 
+    // Number of render passes submitted through this graph.  Used by tests that check how many
+    // render passes a frame uses.
+    uint64_t getSubmittedRenderPassCountForTesting() const { return mSubmittedRenderPassCount; }
+
+    // Called when attachment stores are dropped because their contents are never read.  The
+    // number of bytes not written to memory is reported through the overlay.
+    void onRenderPassStoreDropped(size_t bytes)
+    {
+        mRenderPassStoreBytesSaved += bytes;
+        mTotalRenderPassStoreBytesSaved += bytes;
+    }
+    uint64_t getRenderPassStoreBytesSavedForTesting() const
+    {
+        return mTotalRenderPassStoreBytesSaved;
+    }
+
   private:
     CommandGraphNode *allocateBarrierNode(CommandGraphNodeFunction function,
                                           CommandGraphResourceType resourceType,
@@ -543,6 +639,9 @@ class CommandGraph final : angle::NonCopyable
     std::vector<CommandGraphNode *> mNodes;
     bool mEnableGraphDiagnostics;
     angle::PoolAllocator *mPoolAllocator;
+    uint64_t mSubmittedRenderPassCount;
+    size_t mRenderPassStoreBytesSaved;
+    uint64_t mTotalRenderPassStoreBytesSaved;
 
     // A set of nodes (eventually) exist that act as barriers to guarantee submission order.  For
     // example, a glMemoryBarrier() calls would lead to such a barrier or beginning and ending a
@@ -612,6 +711,12 @@ ANGLE_INLINE void CommandGraphResource::updateCurrentAccessNodes()
     }
 }
 
+ANGLE_INLINE CommandGraphNode *CommandGraphResource::getUnreadWritingNode()
+{
+    updateCurrentAccessNodes();
+    return mCurrentReadingNodes.empty() ? mCurrentWritingNode : nullptr;
+}
+
 ANGLE_INLINE void CommandGraphResource::onGraphAccess(CommandGraph *commandGraph)
 {
     updateCurrentAccessNodes();
@@ -631,11 +736,19 @@ ANGLE_INLINE bool CommandGraphResource::appendToStartedRenderPass(CommandGraph *
         // Store reference to usage in graph.
         graph->onResourceUse(mUse);
 
-        if (mCurrentWritingNode->getRenderPassRenderArea().encloses(renderArea))
+        // Grow the render area rather than restarting the render pass when possible, for example
+        // when a scissored draw is followed by an unscissored one.
+        if (!mCurrentWritingNode->getRenderPassRenderArea().encloses(renderArea))
         {
-            *commandBufferOut = mCurrentWritingNode->getInsideRenderPassCommands();
-            return true;
+            if (!mCurrentWritingNode->canExtendRenderPassRenderArea())
+            {
+                return false;
+            }
+            mCurrentWritingNode->extendRenderPassRenderArea(renderArea);
         }
+
+        *commandBufferOut = mCurrentWritingNode->getInsideRenderPassCommands();
+        return true;
     }
 
     return false;
@@ -694,6 +807,12 @@ ANGLE_INLINE const gl::Rectangle &CommandGraphResource::getRenderPassRenderArea(
     return mCurrentWritingNode->getRenderPassRenderArea();
 }
 
+ANGLE_INLINE bool CommandGraphResource::canExtendRenderPassRenderArea() const
+{
+    ASSERT(hasStartedRenderPass());
+    return mCurrentWritingNode->canExtendRenderPassRenderArea();
+}
+
 ANGLE_INLINE void CommandGraphResource::addGlobalMemoryBarrier(VkFlags srcAccess,
                                                                VkFlags dstAccess,
                                                                VkPipelineStageFlags stages)
@@ -702,6 +821,12 @@ ANGLE_INLINE void CommandGraphResource::addGlobalMemoryBarrier(VkFlags srcAccess
     mCurrentWritingNode->addGlobalMemoryBarrier(srcAccess, dstAccess, stages);
 }
 
+ANGLE_INLINE PipelineBarrier *CommandGraphResource::getPipelineBarrier()
+{
+    ASSERT(mCurrentWritingNode);
+    return mCurrentWritingNode->getPipelineBarrier();
+}
+
 ANGLE_INLINE bool CommandGraphResource::hasChildlessWritingNode() const
 {
     // Note: currently, we don't have a resource that can issue both generic and special
@@ -0,0 +1,283 @@
+//
+// Copyright 2020 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// CommandProcessor.cpp:
+//    Implements the class methods for CommandProcessor.
+//
+
+#include "libANGLE/renderer/vulkan/CommandProcessor.h"
+
+#include "common/debug.h"
+#include "libANGLE/trace.h"
+
+namespace rx
+{
+namespace vk
+{
+// QueueOperation implementation.
+QueueOperation::QueueOperation()
+    : mIsPresent(false),
+      mFence(VK_NULL_HANDLE),
+      mHasPresentRegion(false),
+      mPresentRegion{},
+      mPresentResultOut(nullptr)
+{}
+
+QueueOperation::~QueueOperation() = default;
+
+QueueOperation::QueueOperation(QueueOperation &&other) : QueueOperation()
+{
+    *this = std::move(other);
+}
+
+QueueOperation &QueueOperation::operator=(QueueOperation &&other)
+{
+    std::swap(mIsPresent, other.mIsPresent);
+    std::swap(mWaitSemaphores, other.mWaitSemaphores);
+    std::swap(mWaitSemaphoreStageMasks, other.mWaitSemaphoreStageMasks);
+    std::swap(mCommandBuffers, other.mCommandBuffers);
+    std::swap(mSignalSemaphores, other.mSignalSemaphores);
+    std::swap(mFence, other.mFence);
+    std::swap(mSwapchains, other.mSwapchains);
+    std::swap(mImageIndices, other.mImageIndices);
+    std::swap(mHasPresentRegion, other.mHasPresentRegion);
+    std::swap(mPresentRegion, other.mPresentRegion);
+    std::swap(mPresentRects, other.mPresentRects);
+    std::swap(mPresentResultOut, other.mPresentResultOut);
+    return *this;
+}
+
+void QueueOperation::initSubmit(const VkSubmitInfo &submitInfo, VkFence fence)
+{
+    ASSERT(submitInfo.pNext == nullptr);
+
+    mIsPresent = false;
+    mWaitSemaphores.assign(submitInfo.pWaitSemaphores,
+                           submitInfo.pWaitSemaphores + submitInfo.waitSemaphoreCount);
+    mWaitSemaphoreStageMasks.assign(submitInfo.pWaitDstStageMask,
+                                    submitInfo.pWaitDstStageMask + submitInfo.waitSemaphoreCount);
+    mCommandBuffers.assign(submitInfo.pCommandBuffers,
+                           submitInfo.pCommandBuffers + submitInfo.commandBufferCount);
+    mSignalSemaphores.assign(submitInfo.pSignalSemaphores,
+                             submitInfo.pSignalSemaphores + submitInfo.signalSemaphoreCount);
+    mFence = fence;
+}
+
+void QueueOperation::initPresent(const VkPresentInfoKHR &presentInfo, VkResult *resultOut)
+{
+    mIsPresent = true;
+    mWaitSemaphores.assign(presentInfo.pWaitSemaphores,
+                           presentInfo.pWaitSemaphores + presentInfo.waitSemaphoreCount);
+    mSwapchains.assign(presentInfo.pSwapchains,
+                       presentInfo.pSwapchains + presentInfo.swapchainCount);
+    mImageIndices.assign(presentInfo.pImageIndices,
+                         presentInfo.pImageIndices + presentInfo.swapchainCount);
+    mPresentResultOut = resultOut;
+
+    // The only extension chained to the present info is VK_KHR_incremental_present's, with a
+    // single region since ANGLE presents one swapchain at a time.
+    const VkPresentRegionsKHR *presentRegions =
+        reinterpret_cast<const VkPresentRegionsKHR *>(presentInfo.pNext);
+    mHasPresentRegion = presentRegions != nullptr;
+    if (mHasPresentRegion)
+    {
+        ASSERT(presentRegions->sType == VK_STRUCTURE_TYPE_PRESENT_REGIONS_KHR);
+        ASSERT(presentRegions->pNext == nullptr && presentRegions->swapchainCount == 1);
+
+        const VkPresentRegionKHR &region = presentRegions->pRegions[0];
+        mPresentRects.assign(region.pRectangles, region.pRectangles + region.rectangleCount);
+        mPresentRegion = region;
+    }
+}
+
+VkResult QueueOperation::execute(VkQueue queue)
+{
+    if (!mIsPresent)
+    {
+        ANGLE_TRACE_EVENT0("gpu.angle", "vkQueueSubmit");
+
+        VkSubmitInfo submitInfo         = {};
+        submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.waitSemaphoreCount   = static_cast<uint32_t>(mWaitSemaphores.size());
+        submitInfo.pWaitSemaphores      = mWaitSemaphores.data();
+        submitInfo.pWaitDstStageMask    = mWaitSemaphoreStageMasks.data();
+        submitInfo.commandBufferCount   = static_cast<uint32_t>(mCommandBuffers.size());
+        submitInfo.pCommandBuffers      = mCommandBuffers.data();
+        submitInfo.signalSemaphoreCount = static_cast<uint32_t>(mSignalSemaphores.size());
+        submitInfo.pSignalSemaphores    = mSignalSemaphores.data();
+
+        return vkQueueSubmit(queue, 1, &submitInfo, mFence);
+    }
+
+    ANGLE_TRACE_EVENT0("gpu.angle", "vkQueuePresentKHR");
+
+    VkPresentInfoKHR presentInfo   = {};
+    presentInfo.sType              = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+    presentInfo.waitSemaphoreCount = static_cast<uint32_t>(mWaitSemaphores.size());
+    presentInfo.pWaitSemaphores    = mWaitSemaphores.data();
+    presentInfo.swapchainCount     = static_cast<uint32_t>(mSwapchains.size());
+    presentInfo.pSwapchains        = mSwapchains.data();
+    presentInfo.pImageIndices      = mImageIndices.data();
+    presentInfo.pResults           = nullptr;
+
+    VkPresentRegionsKHR presentRegions = {};
+    if (mHasPresentRegion)
+    {
+        mPresentRegion.pRectangles = mPresentRects.data();
+
+        presentRegions.sType          = VK_STRUCTURE_TYPE_PRESENT_REGIONS_KHR;
+        presentRegions.pNext          = nullptr;
+        presentRegions.swapchainCount = 1;
+        presentRegions.pRegions       = &mPresentRegion;
+
+        presentInfo.pNext = &presentRegions;
+    }
+
+    return vkQueuePresentKHR(queue, &presentInfo);
+}
+
+// CommandProcessor implementation.
+CommandProcessor::CommandProcessor()
+    : mQueue(VK_NULL_HANDLE),
+      mQueueMutex(nullptr),
+      mEnqueuedCount(0),
+      mProcessedCount(0),
+      mStopRequested(false),
+      mSubmitError(VK_SUCCESS)
+{}
+
+CommandProcessor::~CommandProcessor()
+{
+    ASSERT(!isRunning());
+}
+
+void CommandProcessor::start(VkQueue queue, std::mutex *queueMutex)
+{
+    ASSERT(!isRunning());
+
+    mQueue         = queue;
+    mQueueMutex    = queueMutex;
+    mStopRequested = false;
+    mThread        = std::thread(&CommandProcessor::processQueueOperations, this);
+}
+
+void CommandProcessor::stop()
+{
+    if (!isRunning())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopRequested = true;
+    }
+    mWorkAvailable.notify_one();
+    mThread.join();
+
+    ASSERT(mPendingOperations.empty());
+}
+
+VkResult CommandProcessor::enqueueSubmit(const VkSubmitInfo &submitInfo, VkFence fence)
+{
+    ASSERT(isRunning());
+
+    QueueOperation operation;
+    operation.initSubmit(submitInfo, fence);
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mPendingOperations.push_back(std::move(operation));
+        ++mEnqueuedCount;
+    }
+    mWorkAvailable.notify_one();
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    return getAndClearSubmitError();
+}
+
+VkResult CommandProcessor::enqueuePresentAndWait(const VkPresentInfoKHR &presentInfo)
+{
+    ASSERT(isRunning());
+
+    VkResult presentResult = VK_SUCCESS;
+
+    QueueOperation operation;
+    operation.initPresent(presentInfo, &presentResult);
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    mPendingOperations.push_back(std::move(operation));
+    uint64_t presentCount = ++mEnqueuedCount;
+    mWorkAvailable.notify_one();
+
+    {
+        ANGLE_TRACE_EVENT0("gpu.angle", "CommandProcessor::enqueuePresentAndWait");
+        mWorkProcessed.wait(lock, [this, presentCount] { return mProcessedCount >= presentCount; });
+    }
+
+    // A failed submission before the present is more important to report than the present's own
+    // result, which is usually a recoverable OUT_OF_DATE or SUBOPTIMAL.
+    VkResult submitError = getAndClearSubmitError();
+    return submitError != VK_SUCCESS ? submitError : presentResult;
+}
+
+VkResult CommandProcessor::waitForIdle()
+{
+    ANGLE_TRACE_EVENT0("gpu.angle", "CommandProcessor::waitForIdle");
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    mWorkProcessed.wait(lock, [this] { return mProcessedCount == mEnqueuedCount; });
+
+    return getAndClearSubmitError();
+}
+
+VkResult CommandProcessor::getAndClearSubmitError()
+{
+    VkResult error = mSubmitError;
+    mSubmitError   = VK_SUCCESS;
+    return error;
+}
+
+void CommandProcessor::processQueueOperations()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+
+    while (true)
+    {
+        mWorkAvailable.wait(lock, [this] { return mStopRequested || !mPendingOperations.empty(); });
+
+        // Drain everything that was queued before stopping, so no fence is left unsubmitted.
+        if (mPendingOperations.empty())
+        {
+            ASSERT(mStopRequested);
+            break;
+        }
+
+        QueueOperation operation = std::move(mPendingOperations.front());
+        mPendingOperations.pop_front();
+
+        VkResult result;
+        lock.unlock();
+        {
+            std::lock_guard<std::mutex> queueLock(*mQueueMutex);
+            result = operation.execute(mQueue);
+        }
+        lock.lock();
+
+        if (operation.isPresent())
+        {
+            *operation.getPresentResultOut() = result;
+        }
+        else if (result != VK_SUCCESS && mSubmitError == VK_SUCCESS)
+        {
+            mSubmitError = result;
+        }
+
+        ++mProcessedCount;
+        mWorkProcessed.notify_all();
+    }
+}
+}  // namespace vk
+}  // namespace rx
@@ -0,0 +1,111 @@
+//
+// Copyright 2020 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// CommandProcessor.h:
+//    A thread that hands queue submissions and presents to the VkQueue on behalf of the contexts,
+//    used when the asyncCommandQueue feature is enabled.
+//
+
+#ifndef LIBANGLE_RENDERER_VULKAN_COMMANDPROCESSOR_H_
+#define LIBANGLE_RENDERER_VULKAN_COMMANDPROCESSOR_H_
+
+#include <vulkan/vulkan.h>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "common/angleutils.h"
+
+namespace rx
+{
+namespace vk
+{
+// A vkQueueSubmit or vkQueuePresentKHR call recorded by the GL thread.  The submission thread
+// runs it later, so it owns copies of everything the Vk*Info structs point to.
+class QueueOperation final : angle::NonCopyable
+{
+  public:
+    QueueOperation();
+    ~QueueOperation();
+    QueueOperation(QueueOperation &&other);
+    QueueOperation &operator=(QueueOperation &&other);
+
+    void initSubmit(const VkSubmitInfo &submitInfo, VkFence fence);
+    // |resultOut| is written by the submission thread once the present has run.
+    void initPresent(const VkPresentInfoKHR &presentInfo, VkResult *resultOut);
+
+    VkResult execute(VkQueue queue);
+
+    bool isPresent() const { return mIsPresent; }
+    VkResult *getPresentResultOut() const { return mPresentResultOut; }
+
+  private:
+    bool mIsPresent;
+
+    std::vector<VkSemaphore> mWaitSemaphores;
+    std::vector<VkPipelineStageFlags> mWaitSemaphoreStageMasks;
+    std::vector<VkCommandBuffer> mCommandBuffers;
+    std::vector<VkSemaphore> mSignalSemaphores;
+    VkFence mFence;
+
+    std::vector<VkSwapchainKHR> mSwapchains;
+    std::vector<uint32_t> mImageIndices;
+    bool mHasPresentRegion;
+    VkPresentRegionKHR mPresentRegion;
+    std::vector<VkRectLayerKHR> mPresentRects;
+    VkResult *mPresentResultOut;
+};
+
+class CommandProcessor final : angle::NonCopyable
+{
+  public:
+    CommandProcessor();
+    ~CommandProcessor();
+
+    // |queueMutex| is held around every call into the queue.
+    void start(VkQueue queue, std::mutex *queueMutex);
+    void stop();
+
+    bool isRunning() const { return mThread.joinable(); }
+
+    // Queues a submission without waiting for it.  The fence, command buffers and semaphores must
+    // outlive the submission, which they do as long as they are only recycled after the fence has
+    // signaled.  Returns an error from a previous submission, if any.
+    VkResult enqueueSubmit(const VkSubmitInfo &submitInfo, VkFence fence);
+
+    // Queues a present after all pending submissions and waits for it.  The swapchain must not be
+    // used by the caller while the present is pending, so the wait can't be avoided.
+    VkResult enqueuePresentAndWait(const VkPresentInfoKHR &presentInfo);
+
+    // Blocks until every queued operation has been handed to the queue.  Returns an error from a
+    // previous submission, if any.
+    VkResult waitForIdle();
+
+  private:
+    void processQueueOperations();
+    VkResult getAndClearSubmitError();
+
+    VkQueue mQueue;
+    std::mutex *mQueueMutex;
+    std::thread mThread;
+
+    // Protects everything below.
+    std::mutex mMutex;
+    std::condition_variable mWorkAvailable;
+    std::condition_variable mWorkProcessed;
+    std::deque<QueueOperation> mPendingOperations;
+    uint64_t mEnqueuedCount;
+    uint64_t mProcessedCount;
+    bool mStopRequested;
+
+    // The first failed vkQueueSubmit since the last time the GL thread looked.
+    VkResult mSubmitError;
+};
+}  // namespace vk
+}  // namespace rx
+
+#endif  // LIBANGLE_RENDERER_VULKAN_COMMANDPROCESSOR_H_
@@ -239,15 +239,8 @@ void CommandQueue::destroy(VkDevice device)
 
 angle::Result CommandQueue::init(vk::Context *context)
 {
-    RendererVk *renderer = context->getRenderer();
-
-    // Initialize the command pool now that we know the queue family index.
-    uint32_t queueFamilyIndex = renderer->getQueueFamilyIndex();
-    if (!renderer->getFeatures().transientCommandBuffer.enabled)
-    {
-        ANGLE_TRY(mPrimaryCommandPool.init(context, queueFamilyIndex));
-    }
-
+    // The primary command pool is created on first use.  Short-lived contexts that never submit
+    // any work don't pay for the pool and its preallocated command buffers.
     return angle::Result::Continue;
 }
 
@@ -352,6 +345,10 @@ angle::Result CommandQueue::allocatePrimaryCommandBuffer(vk::Context *context,
 
     if (ANGLE_LIKELY(!renderer->getFeatures().transientCommandBuffer.enabled))
     {
+        if (ANGLE_UNLIKELY(!mPrimaryCommandPool.valid()))
+        {
+            ANGLE_TRY(mPrimaryCommandPool.init(context, renderer->getQueueFamilyIndex()));
+        }
         return mPrimaryCommandPool.allocate(context, commandBufferOut);
     }
 
@@ -527,6 +524,7 @@ ContextVk::ContextVk(const gl::State &state, gl::ErrorSet *errorSet, RendererVk
       mIsAnyHostVisibleBufferWritten(false),
       mEmulateSeamfulCubeMapSampling(false),
       mUseOldRewriteStructSamplers(false),
+      mUpdateAllActiveTextures(true),
       mPoolAllocator(kDefaultPoolAllocatorPageSize, 1),
       mCommandGraph(kEnableCommandGraphDiagnostics, &mPoolAllocator),
       mGpuEventsEnabled(false),
@@ -620,6 +618,7 @@ void ContextVk::onDestroy(const gl::Context *context)
     }
 
     ASSERT(mCurrentGarbage.empty());
+    releaseSharedPipelines(getLastSubmittedQueueSerial());
 
     mCommandQueue.destroy(device);
 
@@ -627,10 +626,10 @@ void ContextVk::onDestroy(const gl::Context *context)
 
     mUtils.destroy(device);
 
-    mRenderPassCache.destroy(device);
     mSubmitFence.reset(device);
     mShaderLibrary.destroy(device);
     mGpuEventQueryPool.destroy(device);
+    mGpuProfiler.destroy(device);
     mCommandPool.destroy(device);
 
     for (vk::CommandPool &pool : mCommandPoolFreeList)
@@ -722,6 +721,14 @@ angle::Result ContextVk::initialize()
         ANGLE_TRY(synchronizeCpuGpuTime());
     }
 
+    ANGLE_TRY(mGpuProfiler.init(this));
+
+    if (mRenderer->getFeatures().warmUpUtilsPipelines.enabled &&
+        mRenderer->beginUtilsPipelinesWarmUp())
+    {
+        ANGLE_TRY(mUtils.warmUpPipelines(this));
+    }
+
     mEmulateSeamfulCubeMapSampling = shouldEmulateSeamfulCubeMapSampling();
 
     mUseOldRewriteStructSamplers = shouldUseOldRewriteStructSamplers();
@@ -1202,6 +1209,7 @@ angle::Result ContextVk::submitFrame(const VkSubmitInfo &submitInfo,
     ANGLE_TRY(ensureSubmitFenceInitialized());
     ANGLE_TRY(mCommandQueue.submitFrame(this, submitInfo, mSubmitFence, &mCurrentGarbage,
                                         &mCommandPool, std::move(commandBuffer)));
+    releaseSharedPipelines(getLastSubmittedQueueSerial());
 
     // we need to explicitly notify every other Context using this VkQueue that their current
     // command buffer is no longer valid.
@@ -1216,6 +1224,8 @@ angle::Result ContextVk::submitFrame(const VkSubmitInfo &submitInfo,
         ANGLE_TRY(checkCompletedGpuEvents());
     }
 
+    ANGLE_TRY(mGpuProfiler.checkCompletedQueries(this));
+
     return angle::Result::Continue;
 }
 
@@ -1227,7 +1237,7 @@ angle::Result ContextVk::flushCommandGraph(vk::PrimaryCommandBuffer *commandBatc
     }
     mIsAnyHostVisibleBufferWritten = false;
 
-    return mCommandGraph.submitCommands(this, getCurrentQueueSerial(), &mRenderPassCache,
+    return mCommandGraph.submitCommands(this, getCurrentQueueSerial(), &getRenderPassCache(),
                                         commandBatch);
 }
 
@@ -1577,12 +1587,23 @@ void ContextVk::clearAllGarbage()
     mCommandQueue.clearAllGarbage(device);
 }
 
+void ContextVk::releaseSharedPipelines(Serial serial)
+{
+    SharedGraphicsPipelineCache &sharedPipelines = mRenderer->getSharedGraphicsPipelineCache();
+    for (const vk::SharedGraphicsPipelineKey *key : mSharedPipelinesToRelease)
+    {
+        sharedPipelines.releasePipeline(mRenderer, getDevice(), *key, serial);
+    }
+    mSharedPipelinesToRelease.clear();
+}
+
 void ContextVk::handleDeviceLost()
 {
     mCommandGraph.clear();
 
     mCommandQueue.handleDeviceLost(mRenderer);
     clearAllGarbage();
+    releaseSharedPipelines(getLastSubmittedQueueSerial());
 
     mRenderer->notifyDeviceLost();
 }
@@ -1600,7 +1621,7 @@ angle::Result ContextVk::drawArrays(const gl::Context *context,
         uint32_t numIndices;
         ANGLE_TRY(setupLineLoopDraw(context, mode, first, count, gl::DrawElementsType::InvalidEnum,
                                     nullptr, &commandBuffer, &numIndices));
-        vk::LineLoopHelper::Draw(numIndices, commandBuffer);
+        vk::LineLoopHelper::Draw(numIndices, static_cast<uint32_t>(first), commandBuffer);
     }
     else
     {
@@ -1666,7 +1687,7 @@ angle::Result ContextVk::drawElements(const gl::Context *context,
         uint32_t indexCount;
         ANGLE_TRY(
             setupLineLoopDraw(context, mode, 0, count, type, indices, &commandBuffer, &indexCount));
-        vk::LineLoopHelper::Draw(indexCount, commandBuffer);
+        vk::LineLoopHelper::Draw(indexCount, 0, commandBuffer);
     }
     else
     {
@@ -2203,6 +2224,7 @@ angle::Result ContextVk::syncState(const gl::Context *context,
                 break;
             case gl::State::DIRTY_BIT_PROGRAM_EXECUTABLE:
             {
+                mUpdateAllActiveTextures = true;
                 invalidateCurrentTextures();
                 invalidateCurrentShaderResources();
                 if (glState.getProgram()->isCompute())
@@ -2224,10 +2246,10 @@ angle::Result ContextVk::syncState(const gl::Context *context,
                 break;
             }
             case gl::State::DIRTY_BIT_TEXTURE_BINDINGS:
-                invalidateCurrentTextures();
+                invalidateCurrentTextureUnits(glState.getDirtyActiveTextureUnits());
                 break;
             case gl::State::DIRTY_BIT_SAMPLER_BINDINGS:
-                invalidateCurrentTextures();
+                invalidateCurrentTextureUnits(glState.getDirtyActiveTextureUnits());
                 break;
             case gl::State::DIRTY_BIT_TRANSFORM_FEEDBACK_BINDING:
                 // Nothing to do.
@@ -2299,6 +2321,31 @@ GLint64 ContextVk::getTimestamp()
     return static_cast<GLint64>(timestamp);
 }
 
+angle::Result ContextVk::getGpuProfileTime(const gl::Context *context,
+                                           GLenum pname,
+                                           GLint64 *timeOut)
+{
+    // Pick up the results that have become available since the last submission, without waiting
+    // for the others.
+    ANGLE_TRY(mGpuProfiler.checkCompletedQueries(this));
+
+    switch (pname)
+    {
+        case GL_GPU_PROFILE_RENDER_PASS_TIME_ANGLE:
+            *timeOut = static_cast<GLint64>(
+                mGpuProfiler.getTotalTimeNs(vk::GpuProfileCategory::RenderPass));
+            break;
+        case GL_GPU_PROFILE_INTERNAL_TIME_ANGLE:
+            *timeOut = static_cast<GLint64>(mGpuProfiler.getTotalInternalTimeNs());
+            break;
+        default:
+            UNREACHABLE();
+            break;
+    }
+
+    return angle::Result::Continue;
+}
+
 angle::Result ContextVk::onMakeCurrent(const gl::Context *context)
 {
     ASSERT(mCommandGraph.empty());
@@ -2470,6 +2517,12 @@ void ContextVk::invalidateCurrentTextures()
     }
 }
 
+void ContextVk::invalidateCurrentTextureUnits(const gl::ActiveTextureMask &textureUnits)
+{
+    mDirtyActiveTextureUnits |= textureUnits;
+    invalidateCurrentTextures();
+}
+
 void ContextVk::invalidateCurrentShaderResources()
 {
     ASSERT(mProgram);
@@ -2587,6 +2640,30 @@ vk::DynamicQueryPool *ContextVk::getQueryPool(gl::QueryType queryType)
     return &mQueryPools[queryType];
 }
 
+void ContextVk::recordQueryResultCopies(vk::PrimaryCommandBuffer *primaryCommandBuffer)
+{
+    bool anyResultCopied = false;
+    for (vk::DynamicQueryPool &queryPool : mQueryPools)
+    {
+        if (queryPool.isValid())
+        {
+            anyResultCopied = queryPool.recordResultCopies(primaryCommandBuffer) || anyResultCopied;
+        }
+    }
+
+    if (anyResultCopied)
+    {
+        // Make the copied results visible to the host once the submission has finished.
+        VkMemoryBarrier memoryBarrier = {};
+        memoryBarrier.sType           = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        memoryBarrier.srcAccessMask   = VK_ACCESS_TRANSFER_WRITE_BIT;
+        memoryBarrier.dstAccessMask   = VK_ACCESS_HOST_READ_BIT;
+
+        primaryCommandBuffer->memoryBarrier(VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                            VK_PIPELINE_STAGE_HOST_BIT, &memoryBarrier);
+    }
+}
+
 const VkClearValue &ContextVk::getClearColorValue() const
 {
     return mClearColorValue;
@@ -2801,16 +2878,35 @@ angle::Result ContextVk::updateActiveTextures(const gl::Context *context,
     const gl::State &glState   = mState;
     const gl::Program *program = glState.getProgram();
 
-    uint32_t prevMaxIndex = mActiveTexturesDesc.getMaxIndex();
-    memset(mActiveTextures.data(), 0, sizeof(mActiveTextures[0]) * prevMaxIndex);
-    mActiveTexturesDesc.reset();
-
     const gl::ActiveTexturePointerArray &textures  = glState.getActiveTexturesCache();
     const gl::ActiveTextureMask &activeTextures    = program->getActiveSamplersMask();
     const gl::ActiveTextureTypeArray &textureTypes = program->getActiveSamplerTypes();
 
-    for (size_t textureUnit : activeTextures)
+    gl::ActiveTextureMask dirtyTextureUnits = mDirtyActiveTextureUnits;
+    if (mUpdateAllActiveTextures)
+    {
+        uint32_t prevMaxIndex = mActiveTexturesDesc.getMaxIndex();
+        memset(mActiveTextures.data(), 0, sizeof(mActiveTextures[0]) * prevMaxIndex);
+        mActiveTexturesDesc.reset();
+        dirtyTextureUnits        = activeTextures;
+        mUpdateAllActiveTextures = false;
+    }
+    mDirtyActiveTextureUnits.reset();
+
+    // Only look up the textures and samplers of units that changed. The others keep what was
+    // resolved for them by a previous call.
+    for (size_t textureUnit : dirtyTextureUnits)
     {
+        if (!activeTextures[textureUnit])
+        {
+            mActiveTextures[textureUnit] = {nullptr, nullptr};
+            if (textureUnit < mActiveTexturesDesc.getMaxIndex())
+            {
+                mActiveTexturesDesc.update(textureUnit, kZeroSerial, kZeroSerial);
+            }
+            continue;
+        }
+
         gl::Texture *texture        = textures[textureUnit];
         gl::Sampler *sampler        = mState.getSampler(static_cast<uint32_t>(textureUnit));
         gl::TextureType textureType = textureTypes[textureUnit];
@@ -2821,8 +2917,24 @@ angle::Result ContextVk::updateActiveTextures(const gl::Context *context,
             ANGLE_TRY(getIncompleteTexture(context, textureType, &texture));
         }
 
-        TextureVk *textureVk = vk::GetImpl(texture);
-        SamplerVk *samplerVk = (sampler != nullptr) ? vk::GetImpl(sampler) : nullptr;
+        mActiveTextures[textureUnit].texture = vk::GetImpl(texture);
+        mActiveTextures[textureUnit].sampler =
+            (sampler != nullptr) ? vk::GetImpl(sampler) : nullptr;
+    }
+
+    vk::ImageLayout textureLayout = vk::ImageLayout::AllGraphicsShadersReadOnly;
+    if (program->isCompute())
+    {
+        textureLayout = vk::ImageLayout::ComputeShaderReadOnly;
+    }
+
+    // Every active image still needs its layout and read dependency checked, as this also runs
+    // when a new command buffer is started.
+    for (size_t textureUnit : activeTextures)
+    {
+        TextureVk *textureVk = mActiveTextures[textureUnit].texture;
+        SamplerVk *samplerVk = mActiveTextures[textureUnit].sampler;
+        ASSERT(textureVk != nullptr);
 
         vk::ImageHelper &image = textureVk->getImage();
 
@@ -2830,33 +2942,26 @@ angle::Result ContextVk::updateActiveTextures(const gl::Context *context,
         // lingering staged updates in its staging buffer for unused texture mip levels or
         // layers. Therefore we can't verify it has no staged updates right here.
 
-        vk::ImageLayout textureLayout = vk::ImageLayout::AllGraphicsShadersReadOnly;
-        if (program->isCompute())
-        {
-            textureLayout = vk::ImageLayout::ComputeShaderReadOnly;
-        }
-
         // Ensure the image is in read-only layout
         if (image.isLayoutChangeNecessary(textureLayout))
         {
-            vk::CommandBuffer *srcLayoutChange;
-            ANGLE_TRY(image.recordCommands(this, &srcLayoutChange));
-
-            VkImageAspectFlags aspectFlags = image.getAspectFlags();
-            ASSERT(aspectFlags != 0);
-            image.changeLayout(aspectFlags, textureLayout, srcLayoutChange);
+            ASSERT(image.getAspectFlags() != 0);
+            mLayoutTransitions.changeImageLayout(this, &image, textureLayout);
         }
 
-        image.addReadDependency(this, recorder);
-
-        mActiveTextures[textureUnit].texture = textureVk;
-        mActiveTextures[textureUnit].sampler = samplerVk;
-        // Cache serials from sampler and texture, but re-use texture if no sampler bound
-        ASSERT(textureVk != nullptr);
+        // Cache serials from sampler and texture, but re-use texture if no sampler bound. The
+        // serials are refreshed for every unit since they change when an image is respecified.
         mActiveTexturesDesc.update(textureUnit, textureVk->getSerial(),
                                    (samplerVk != nullptr) ? samplerVk->getSerial() : kZeroSerial);
     }
 
+    // The read dependencies are only added once all the transitions are batched, as a batch can't
+    // take more transitions once the recorder depends on it.
+    for (size_t textureUnit : activeTextures)
+    {
+        mActiveTextures[textureUnit].texture->getImage().addReadDependency(this, recorder);
+    }
+
     return angle::Result::Continue;
 }
 
@@ -2870,6 +2975,12 @@ angle::Result ContextVk::updateActiveImages(const gl::Context *context,
 
     const gl::ActiveTextureMask &activeImages = program->getActiveImagesMask();
 
+    vk::ImageLayout imageLayout = vk::ImageLayout::AllGraphicsShadersWrite;
+    if (program->isCompute())
+    {
+        imageLayout = vk::ImageLayout::ComputeShaderWrite;
+    }
+
     for (size_t imageUnitIndex : activeImages)
     {
         const gl::ImageUnit &imageUnit = glState.getImageUnit(imageUnitIndex);
@@ -2892,27 +3003,25 @@ angle::Result ContextVk::updateActiveImages(const gl::Context *context,
         // http://anglebug.com/3539
         ANGLE_TRY(textureVk->ensureImageInitialized(this));
 
-        vk::ImageLayout imageLayout = vk::ImageLayout::AllGraphicsShadersWrite;
-        if (program->isCompute())
-        {
-            imageLayout = vk::ImageLayout::ComputeShaderWrite;
-        }
-
-        // Ensure the image is in read-only layout
+        // Ensure the image is in writable layout
         if (image->isLayoutChangeNecessary(imageLayout))
         {
-            vk::CommandBuffer *layoutChange;
-            ANGLE_TRY(image->recordCommands(this, &layoutChange));
-
-            VkImageAspectFlags aspectFlags = image->getAspectFlags();
-            image->changeLayout(aspectFlags, imageLayout, layoutChange);
+            mLayoutTransitions.changeImageLayout(this, image, imageLayout);
         }
 
-        image->addWriteDependency(this, recorder);
-
         mActiveImages[imageUnitIndex] = textureVk;
     }
 
+    // As with textures, depend on the images only once all their transitions are batched.
+    for (size_t imageUnitIndex : activeImages)
+    {
+        TextureVk *textureVk = mActiveImages[imageUnitIndex];
+        if (textureVk != nullptr)
+        {
+            textureVk->getImage().addWriteDependency(this, recorder);
+        }
+    }
+
     return angle::Result::Continue;
 }
 
@@ -2931,6 +3040,8 @@ angle::Result ContextVk::flushImpl(const vk::Semaphore *signalSemaphore)
 {
     if (mCommandGraph.empty() && !signalSemaphore && mWaitSemaphores.empty())
     {
+        // Every command of this context is already submitted.
+        releaseSharedPipelines(getLastSubmittedQueueSerial());
         return angle::Result::Continue;
     }
 
@@ -2971,6 +3082,9 @@ angle::Result ContextVk::finishImpl()
 
     clearAllGarbage();
 
+    // The queue is idle, so every profiled scope has its results available.
+    ANGLE_TRY(mGpuProfiler.checkCompletedQueries(this));
+
     if (mGpuEventsEnabled)
     {
         // This loop should in practice execute once since the queue is already idle.
@@ -3032,16 +3146,16 @@ angle::Result ContextVk::finishToSerialOrTimeout(Serial serial, uint64_t timeout
 angle::Result ContextVk::getCompatibleRenderPass(const vk::RenderPassDesc &desc,
                                                  vk::RenderPass **renderPassOut)
 {
-    return mRenderPassCache.getCompatibleRenderPass(this, getCurrentQueueSerial(), desc,
-                                                    renderPassOut);
+    return getRenderPassCache().getCompatibleRenderPass(this, getCurrentQueueSerial(), desc,
+                                                        renderPassOut);
 }
 
 angle::Result ContextVk::getRenderPassWithOps(const vk::RenderPassDesc &desc,
                                               const vk::AttachmentOpsArray &ops,
                                               vk::RenderPass **renderPassOut)
 {
-    return mRenderPassCache.getRenderPassWithOps(this, getCurrentQueueSerial(), desc, ops,
-                                                 renderPassOut);
+    return getRenderPassCache().getRenderPassWithOps(this, getCurrentQueueSerial(), desc, ops,
+                                                     renderPassOut);
 }
 
 angle::Result ContextVk::ensureSubmitFenceInitialized()
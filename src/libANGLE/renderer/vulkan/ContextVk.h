@@ -14,6 +14,7 @@
 
 #include "common/PackedEnums.h"
 #include "libANGLE/renderer/ContextImpl.h"
+#include "libANGLE/renderer/vulkan/GpuProfiler.h"
 #include "libANGLE/renderer/vulkan/OverlayVk.h"
 #include "libANGLE/renderer/vulkan/PersistentCommandPool.h"
 #include "libANGLE/renderer/vulkan/RendererVk.h"
@@ -190,6 +191,11 @@ class ContextVk : public ContextImpl, public vk::Context, public vk::RenderPassO
     GLint getGPUDisjoint() override;
     GLint64 getTimestamp() override;
 
+    // GL_ANGLE_gpu_profile
+    angle::Result getGpuProfileTime(const gl::Context *context,
+                                    GLenum pname,
+                                    GLint64 *timeOut) override;
+
     // Context switching
     angle::Result onMakeCurrent(const gl::Context *context) override;
     angle::Result onUnMakeCurrent(const gl::Context *context) override;
@@ -296,6 +302,9 @@ class ContextVk : public ContextImpl, public vk::Context, public vk::RenderPassO
     void onTransformFeedbackPauseResume();
 
     vk::DynamicQueryPool *getQueryPool(gl::QueryType queryType);
+    // Records the query result copies queued since the last submission at the end of the primary
+    // command buffer.
+    void recordQueryResultCopies(vk::PrimaryCommandBuffer *primaryCommandBuffer);
 
     const VkClearValue &getClearColorValue() const;
     const VkClearValue &getClearDepthStencilValue() const;
@@ -347,6 +356,13 @@ class ContextVk : public ContextImpl, public vk::Context, public vk::RenderPassO
         }
     }
 
+    // Releases a reference to a pipeline of the renderer's SharedGraphicsPipelineCache when this
+    // context next submits, as its commands that use the pipeline may not be submitted yet.
+    void releaseSharedPipelineAfterSubmission(const vk::SharedGraphicsPipelineKey *key)
+    {
+        mSharedPipelinesToRelease.push_back(key);
+    }
+
     // It would be nice if we didn't have to expose this for QueryVk::getResult.
     angle::Result checkCompletedCommands();
 
@@ -370,6 +386,7 @@ class ContextVk : public ContextImpl, public vk::Context, public vk::RenderPassO
 
     vk::ShaderLibrary &getShaderLibrary() { return mShaderLibrary; }
     UtilsVk &getUtils() { return mUtils; }
+    vk::GpuProfiler &getGpuProfiler() { return mGpuProfiler; }
 
     angle::Result getTimestamp(uint64_t *timestampOut);
 
@@ -385,7 +402,7 @@ class ContextVk : public ContextImpl, public vk::Context, public vk::RenderPassO
         return angle::Result::Continue;
     }
 
-    RenderPassCache &getRenderPassCache() { return mRenderPassCache; }
+    RenderPassCache &getRenderPassCache() { return mRenderer->getRenderPassCache(); }
 
     vk::DescriptorSetLayoutDesc getDriverUniformsDescriptorSetDesc(
         VkShaderStageFlags shaderStages) const;
@@ -564,6 +581,7 @@ class ContextVk : public ContextImpl, public vk::Context, public vk::RenderPassO
     }
 
     void invalidateCurrentTextures();
+    void invalidateCurrentTextureUnits(const gl::ActiveTextureMask &textureUnits);
     void invalidateCurrentShaderResources();
     void invalidateGraphicsDriverUniforms();
     void invalidateDriverUniforms();
@@ -637,6 +655,7 @@ class ContextVk : public ContextImpl, public vk::Context, public vk::RenderPassO
     bool shouldEmulateSeamfulCubeMapSampling() const;
     bool shouldUseOldRewriteStructSamplers() const;
     void clearAllGarbage();
+    void releaseSharedPipelines(Serial serial);
     angle::Result ensureSubmitFenceInitialized();
 
     std::array<DirtyBitHandler, DIRTY_BIT_MAX> mGraphicsDirtyBitHandlers;
@@ -676,6 +695,10 @@ class ContextVk : public ContextImpl, public vk::Context, public vk::RenderPassO
     // Graph resource used to record dispatch commands and hold resource dependencies.
     vk::DispatchHelper mDispatcher;
 
+    // Graph resource that batches the layout transitions of the textures and images a draw or
+    // dispatch uses.
+    vk::LayoutTransitionHelper mLayoutTransitions;
+
     // The offset we had the last time we bound the index buffer.
     const GLvoid *mLastIndexBufferOffset;
     gl::DrawElementsType mCurrentDrawElementsType;
@@ -718,6 +741,10 @@ class ContextVk : public ContextImpl, public vk::Context, public vk::RenderPassO
     // index (also in the shader). This info is used in the descriptor update step.
     gl::ActiveTextureArray<vk::TextureUnit> mActiveTextures;
     vk::TextureDescriptorDesc mActiveTexturesDesc;
+    // Units whose texture or sampler must be looked up again. A program change resolves every
+    // active unit; binding changes only resolve the units the front-end reported as changed.
+    gl::ActiveTextureMask mDirtyActiveTextureUnits;
+    bool mUpdateAllActiveTextures;
 
     gl::ActiveTextureArray<TextureVk *> mActiveImages;
 
@@ -731,8 +758,7 @@ class ContextVk : public ContextImpl, public vk::Context, public vk::RenderPassO
 
     CommandQueue mCommandQueue;
     vk::GarbageList mCurrentGarbage;
-
-    RenderPassCache mRenderPassCache;
+    std::vector<const vk::SharedGraphicsPipelineKey *> mSharedPipelinesToRelease;
 
     // mSubmitFence is the fence that's going to be signaled at the next submission.  This is used
     // to support SyncVk objects, which may outlive the context (as EGLSync objects).
@@ -760,6 +786,9 @@ class ContextVk : public ContextImpl, public vk::Context, public vk::RenderPassO
     // A list of gpu events since the last clock sync.
     std::vector<GpuEvent> mGpuEvents;
 
+    // GPU time of render passes and internal operations, independent of the trace events above.
+    vk::GpuProfiler mGpuProfiler;
+
     // Semaphores that must be waited on in the next submission.
     std::vector<VkSemaphore> mWaitSemaphores;
     std::vector<VkPipelineStageFlags> mWaitSemaphoreStageMasks;
@@ -67,6 +67,15 @@ bool HasDstBlitFeature(RendererVk *renderer, RenderTargetVk *dstRenderTarget)
     return renderer->hasImageFormatFeatureBits(dstFormat, VK_FORMAT_FEATURE_BLIT_DST_BIT);
 }
 
+// Returns true if |area| covers the whole render target, so that clearing it overwrites all the
+// previous contents.
+bool IsRenderTargetFullyCovered(RenderTargetVk *renderTarget, const gl::Rectangle &area)
+{
+    const gl::Extents extents = renderTarget->getExtents();
+    return area.x == 0 && area.y == 0 && area.width == extents.width &&
+           area.height == extents.height;
+}
+
 // Returns false if destination has any channel the source doesn't.  This means that channel was
 // emulated and using the Vulkan blit command would overwrite that emulated channel.
 bool areSrcAndDstColorChannelsBlitCompatible(RenderTargetVk *srcRenderTarget,
@@ -1259,6 +1268,19 @@ angle::Result FramebufferVk::clearWithRenderPassOp(
     const VkClearColorValue &clearColorValue,
     const VkClearDepthStencilValue &clearDepthStencilValue)
 {
+    // If a render pass with commands is already open on this framebuffer and covers the clear area
+    // (possibly after growing its render area), clear the attachments from within it.  Restarting
+    // the render pass would store and reload every attachment, which is costly on tiling GPUs.
+    vk::CommandBuffer *renderPassCommandBuffer = nullptr;
+    if (mFramebuffer.valid() && !mFramebuffer.renderPassStartedButEmpty() &&
+        mFramebuffer.appendToStartedRenderPass(contextVk->getCommandGraph(), clearArea,
+                                               &renderPassCommandBuffer))
+    {
+        clearWithClearAttachments(renderPassCommandBuffer, clearArea, clearColorBuffers, clearDepth,
+                                  clearStencil, clearColorValue, clearDepthStencilValue);
+        return angle::Result::Continue;
+    }
+
     // Start a new render pass if:
     //
     // - no render pass has started,
@@ -1293,6 +1315,11 @@ angle::Result FramebufferVk::clearWithRenderPassOp(
             }
 
             mFramebuffer.clearRenderPassColorAttachment(attachmentIndexVk, value);
+
+            if (IsRenderTargetFullyCovered(renderTarget, clearArea))
+            {
+                renderTarget->onRenderPassFullClear(contextVk, VK_IMAGE_ASPECT_COLOR_BIT);
+            }
         }
         ++attachmentIndexVk;
     }
@@ -1301,22 +1328,93 @@ angle::Result FramebufferVk::clearWithRenderPassOp(
     RenderTargetVk *depthStencilRenderTarget = mRenderTargetCache.getDepthStencil();
     if (depthStencilRenderTarget)
     {
+        VkImageAspectFlags clearAspects = 0;
+
         if (clearDepth)
         {
             mFramebuffer.clearRenderPassDepthAttachment(attachmentIndexVk,
                                                         clearDepthStencilValue.depth);
+            clearAspects |= VK_IMAGE_ASPECT_DEPTH_BIT;
         }
 
         if (clearStencil)
         {
             mFramebuffer.clearRenderPassStencilAttachment(attachmentIndexVk,
                                                           clearDepthStencilValue.stencil);
+            clearAspects |= VK_IMAGE_ASPECT_STENCIL_BIT;
+        }
+
+        if (clearAspects != 0 && IsRenderTargetFullyCovered(depthStencilRenderTarget, clearArea))
+        {
+            depthStencilRenderTarget->onRenderPassFullClear(contextVk, clearAspects);
         }
     }
 
     return angle::Result::Continue;
 }
 
+void FramebufferVk::clearWithClearAttachments(
+    vk::CommandBuffer *renderPassCommandBuffer,
+    const gl::Rectangle &clearArea,
+    gl::DrawBufferMask clearColorBuffers,
+    bool clearDepth,
+    bool clearStencil,
+    const VkClearColorValue &clearColorValue,
+    const VkClearDepthStencilValue &clearDepthStencilValue)
+{
+    gl::AttachmentArray<VkClearAttachment> clearAttachments;
+    uint32_t clearAttachmentCount = 0;
+
+    // The color attachment references of the subpass are indexed by the GL draw buffer index, see
+    // InitializeRenderPassFromDesc.
+    for (size_t colorIndexGL : mState.getEnabledDrawBuffers())
+    {
+        if (clearColorBuffers.test(colorIndexGL))
+        {
+            VkClearAttachment &clearAttachment = clearAttachments[clearAttachmentCount++];
+            clearAttachment.aspectMask         = VK_IMAGE_ASPECT_COLOR_BIT;
+            clearAttachment.colorAttachment    = static_cast<uint32_t>(colorIndexGL);
+            clearAttachment.clearValue.color   = clearColorValue;
+
+            // If the render target doesn't have alpha, but its emulated format has it, clear the
+            // alpha to 1.
+            if (mEmulatedAlphaAttachmentMask[colorIndexGL])
+            {
+                RenderTargetVk *renderTarget = getColorDrawRenderTarget(colorIndexGL);
+                SetEmulatedAlphaValue(renderTarget->getImageFormat(),
+                                      &clearAttachment.clearValue.color);
+            }
+        }
+    }
+
+    VkImageAspectFlags depthStencilAspectFlags =
+        (clearDepth ? VK_IMAGE_ASPECT_DEPTH_BIT : 0) |
+        (clearStencil ? VK_IMAGE_ASPECT_STENCIL_BIT : 0);
+    if (mRenderTargetCache.getDepthStencil() && depthStencilAspectFlags != 0)
+    {
+        VkClearAttachment &clearAttachment      = clearAttachments[clearAttachmentCount++];
+        clearAttachment.aspectMask              = depthStencilAspectFlags;
+        clearAttachment.colorAttachment         = 0;
+        clearAttachment.clearValue.depthStencil = clearDepthStencilValue;
+    }
+
+    if (clearAttachmentCount == 0)
+    {
+        return;
+    }
+
+    VkClearRect clearRect        = {};
+    clearRect.rect.offset.x      = clearArea.x;
+    clearRect.rect.offset.y      = clearArea.y;
+    clearRect.rect.extent.width  = static_cast<uint32_t>(clearArea.width);
+    clearRect.rect.extent.height = static_cast<uint32_t>(clearArea.height);
+    clearRect.baseArrayLayer     = 0;
+    clearRect.layerCount         = 1;
+
+    renderPassCommandBuffer->clearAttachments(clearAttachmentCount, clearAttachments.data(), 1,
+                                              &clearRect);
+}
+
 angle::Result FramebufferVk::clearWithDraw(ContextVk *contextVk,
                                            const gl::Rectangle &clearArea,
                                            gl::DrawBufferMask clearColorBuffers,
@@ -1383,8 +1481,10 @@ angle::Result FramebufferVk::startNewRenderPass(ContextVk *contextVk,
     vk::AttachmentOpsArray renderPassAttachmentOps;
     std::vector<VkClearValue> attachmentClearValues;
 
-    vk::CommandBuffer *writeCommands = nullptr;
-    ANGLE_TRY(mFramebuffer.recordCommands(contextVk, &writeCommands));
+    // The attachments' layout transitions are merged into the barrier recorded before the render
+    // pass node's commands.  Start a new node so they can't be reordered before commands that were
+    // already recorded for the framebuffer outside the render pass.
+    mFramebuffer.finishCurrentCommands(contextVk);
 
     // Initialize RenderPass info.
     const auto &colorRenderTargets = mRenderTargetCache.getColors();
@@ -1393,7 +1493,8 @@ angle::Result FramebufferVk::startNewRenderPass(ContextVk *contextVk,
         RenderTargetVk *colorRenderTarget = colorRenderTargets[colorIndexGL];
         ASSERT(colorRenderTarget);
 
-        ANGLE_TRY(colorRenderTarget->onColorDraw(contextVk, &mFramebuffer, writeCommands));
+        ANGLE_TRY(
+            colorRenderTarget->onColorDraw(contextVk, &mFramebuffer, attachmentClearValues.size()));
 
         renderPassAttachmentOps.initWithLoadStore(attachmentClearValues.size(),
                                                   VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
@@ -1404,8 +1505,8 @@ angle::Result FramebufferVk::startNewRenderPass(ContextVk *contextVk,
     RenderTargetVk *depthStencilRenderTarget = mRenderTargetCache.getDepthStencil();
     if (depthStencilRenderTarget)
     {
-        ANGLE_TRY(
-            depthStencilRenderTarget->onDepthStencilDraw(contextVk, &mFramebuffer, writeCommands));
+        ANGLE_TRY(depthStencilRenderTarget->onDepthStencilDraw(contextVk, &mFramebuffer,
+                                                               attachmentClearValues.size()));
 
         renderPassAttachmentOps.initWithLoadStore(attachmentClearValues.size(),
                                                   VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
@@ -1605,9 +1706,13 @@ void FramebufferVk::onScissorChange(ContextVk *contextVk)
     // is too small, we need to start a new one.  The latter can happen if a scissored clear starts
     // a render pass, the scissor is disabled and a draw call is issued to affect the whole
     // framebuffer.
+    //
+    // A render pass that doesn't clear or invalidate any attachment can instead grow its render
+    // area on the next draw call; see CommandGraphResource::appendToStartedRenderPass.
     mFramebuffer.updateCurrentAccessNodes();
     if (mFramebuffer.hasStartedRenderPass() &&
-        !mFramebuffer.getRenderPassRenderArea().encloses(scissoredRenderArea))
+        !mFramebuffer.getRenderPassRenderArea().encloses(scissoredRenderArea) &&
+        !mFramebuffer.canExtendRenderPassRenderArea())
     {
         mFramebuffer.finishCurrentCommands(contextVk);
     }
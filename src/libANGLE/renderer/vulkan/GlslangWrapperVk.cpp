@@ -10,6 +10,7 @@
 
 #include "libANGLE/renderer/glslang_wrapper_utils.h"
 #include "libANGLE/renderer/vulkan/ContextVk.h"
+#include "libANGLE/renderer/vulkan/RendererVk.h"
 #include "libANGLE/renderer/vulkan/vk_cache_utils.h"
 
 namespace rx
@@ -51,8 +52,12 @@ angle::Result GlslangWrapperVk::GetShaderCode(vk::Context *context,
                                               const gl::ShaderMap<std::string> &shaderSources,
                                               gl::ShaderMap<std::vector<uint32_t>> *shaderCodeOut)
 {
+    RendererVk *renderer = context->getRenderer();
+    GlslangSpirvCache *spirvCache =
+        renderer->getFeatures().cacheShaderSpirv.enabled ? &renderer->getSpirvCache() : nullptr;
+
     return GlslangGetShaderSpirvCode(
-        [context](GlslangError error) { return ErrorHandler(context, error); }, glCaps,
+        [context](GlslangError error) { return ErrorHandler(context, error); }, glCaps, spirvCache,
         enableLineRasterEmulation, /* enableXfbEmulation */ true, shaderSources, shaderCodeOut);
 }
 }  // namespace rx
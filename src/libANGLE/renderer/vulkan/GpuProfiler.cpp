@@ -0,0 +1,310 @@
+//
+// Copyright 2020 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// GpuProfiler.cpp:
+//    Implements the class methods for GpuProfiler.
+//
+
+#include "libANGLE/renderer/vulkan/GpuProfiler.h"
+
+#include "libANGLE/Overlay.h"
+#include "libANGLE/renderer/vulkan/ContextVk.h"
+#include "libANGLE/renderer/vulkan/RendererVk.h"
+
+namespace rx
+{
+namespace vk
+{
+namespace
+{
+// Every render pass and internal operation uses two queries, so the pools are larger than the
+// ones used for GL queries.
+constexpr uint32_t kGpuProfilerQueryPoolSize = 256;
+}  // anonymous namespace
+
+GpuProfiler::GpuProfiler()
+    : mEnabled(false), mIsScopeOpen(false), mTimestampPeriodNs(0), mTimestampMask(0)
+{
+    mTotalTimeNs.fill(0);
+}
+
+GpuProfiler::~GpuProfiler() = default;
+
+angle::Result GpuProfiler::init(ContextVk *contextVk)
+{
+    RendererVk *renderer = contextVk->getRenderer();
+
+    // Timestamps are supported if the queue has valid timestamp bits, which is what the disjoint
+    // timer query extension is exposed based on.
+    const GLuint timestampBits = renderer->getNativeExtensions().queryCounterBitsTimestamp;
+    mEnabled                   = renderer->getNativeExtensions().disjointTimerQuery;
+    if (!mEnabled)
+    {
+        return angle::Result::Continue;
+    }
+
+    mTimestampPeriodNs =
+        static_cast<double>(renderer->getPhysicalDeviceProperties().limits.timestampPeriod);
+    mTimestampMask = timestampBits >= 64 ? std::numeric_limits<uint64_t>::max()
+                                         : (uint64_t(1) << timestampBits) - 1;
+
+    return mQueryPool.init(contextVk, VK_QUERY_TYPE_TIMESTAMP, kGpuProfilerQueryPoolSize);
+}
+
+void GpuProfiler::destroy(VkDevice device)
+{
+    if (mEnabled)
+    {
+        mQueryPool.destroy(device);
+    }
+    mInFlightScopes.clear();
+    mQueriesToReset.clear();
+    mIsScopeOpen = false;
+}
+
+uint64_t GpuProfiler::getTotalInternalTimeNs() const
+{
+    uint64_t totalTimeNs = 0;
+    for (GpuProfileCategory category : angle::AllEnums<GpuProfileCategory>())
+    {
+        if (category != GpuProfileCategory::RenderPass)
+        {
+            totalTimeNs += mTotalTimeNs[category];
+        }
+    }
+    return totalTimeNs;
+}
+
+void GpuProfiler::discardOpenScope(ContextVk *contextVk)
+{
+    if (!mIsScopeOpen)
+    {
+        return;
+    }
+
+    // An error between beginScope and endScope leaves the scope open.  Its end timestamp is never
+    // written, so its result would never become available.  The queries stay in mQueriesToReset,
+    // as the begin timestamp is still written.
+    const InFlightScope &scope = mInFlightScopes.back();
+    mQueryPool.freeQuery(contextVk, scope.begin.poolIndex, scope.begin.queryIndex);
+    mQueryPool.freeQuery(contextVk, scope.end.poolIndex, scope.end.queryIndex);
+    mInFlightScopes.pop_back();
+    mIsScopeOpen = false;
+}
+
+angle::Result GpuProfiler::beginScopeImpl(ContextVk *contextVk,
+                                          GpuProfileCategory category,
+                                          Serial serial)
+{
+    discardOpenScope(contextVk);
+
+    InFlightScope scope;
+    scope.category = category;
+    scope.serial   = serial;
+    ANGLE_TRY(
+        mQueryPool.allocateQuery(contextVk, &scope.begin.poolIndex, &scope.begin.queryIndex));
+    ANGLE_TRY(mQueryPool.allocateQuery(contextVk, &scope.end.poolIndex, &scope.end.queryIndex));
+
+    mInFlightScopes.push_back(scope);
+    mIsScopeOpen = true;
+
+    return angle::Result::Continue;
+}
+
+VkQueryPool GpuProfiler::getQueryPoolHandle(const TimestampQuery &query) const
+{
+    return mQueryPool.getQueryPool(query.poolIndex)->getHandle();
+}
+
+angle::Result GpuProfiler::beginRenderPass(ContextVk *contextVk,
+                                           Serial serial,
+                                           PrimaryCommandBuffer *primaryCommandBuffer)
+{
+    if (!mEnabled)
+    {
+        return angle::Result::Continue;
+    }
+
+    ANGLE_TRY(beginScopeImpl(contextVk, GpuProfileCategory::RenderPass, serial));
+
+    // Queries can't be reset inside a render pass, so the end query is reset now too.
+    const InFlightScope &scope = mInFlightScopes.back();
+    primaryCommandBuffer->resetQueryPool(getQueryPoolHandle(scope.begin), scope.begin.queryIndex,
+                                         1);
+    primaryCommandBuffer->resetQueryPool(getQueryPoolHandle(scope.end), scope.end.queryIndex, 1);
+    primaryCommandBuffer->writeTimestamp(VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                                         getQueryPoolHandle(scope.begin), scope.begin.queryIndex);
+
+    return angle::Result::Continue;
+}
+
+void GpuProfiler::endRenderPass(PrimaryCommandBuffer *primaryCommandBuffer)
+{
+    if (!mEnabled)
+    {
+        return;
+    }
+
+    ASSERT(mIsScopeOpen);
+    const InFlightScope &scope = mInFlightScopes.back();
+    ASSERT(scope.category == GpuProfileCategory::RenderPass);
+
+    primaryCommandBuffer->writeTimestamp(VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                                         getQueryPoolHandle(scope.end), scope.end.queryIndex);
+    mIsScopeOpen = false;
+}
+
+angle::Result GpuProfiler::beginScope(ContextVk *contextVk,
+                                      GpuProfileCategory category,
+                                      CommandBuffer *commandBuffer)
+{
+    if (!mEnabled)
+    {
+        return angle::Result::Continue;
+    }
+
+    ASSERT(category != GpuProfileCategory::RenderPass);
+    ANGLE_TRY(beginScopeImpl(contextVk, category, contextVk->getCurrentQueueSerial()));
+
+    const InFlightScope &scope = mInFlightScopes.back();
+    mQueriesToReset.push_back(scope.begin);
+    mQueriesToReset.push_back(scope.end);
+    commandBuffer->writeTimestamp(VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                                  getQueryPoolHandle(scope.begin), scope.begin.queryIndex);
+
+    return angle::Result::Continue;
+}
+
+void GpuProfiler::endScope(CommandBuffer *commandBuffer)
+{
+    if (!mEnabled)
+    {
+        return;
+    }
+
+    ASSERT(mIsScopeOpen);
+    const InFlightScope &scope = mInFlightScopes.back();
+    ASSERT(scope.category != GpuProfileCategory::RenderPass);
+
+    commandBuffer->writeTimestamp(VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                                  getQueryPoolHandle(scope.end), scope.end.queryIndex);
+    mIsScopeOpen = false;
+}
+
+void GpuProfiler::resetScopeQueries(ContextVk *contextVk,
+                                    PrimaryCommandBuffer *primaryCommandBuffer)
+{
+    discardOpenScope(contextVk);
+
+    // Queries are allocated sequentially, so consecutive ones are reset together.
+    size_t rangeStart = 0;
+    for (size_t index = 1; index <= mQueriesToReset.size(); ++index)
+    {
+        const TimestampQuery &first = mQueriesToReset[rangeStart];
+        const uint32_t rangeCount   = static_cast<uint32_t>(index - rangeStart);
+
+        if (index < mQueriesToReset.size())
+        {
+            const TimestampQuery &query = mQueriesToReset[index];
+            if (query.poolIndex == first.poolIndex &&
+                query.queryIndex == first.queryIndex + rangeCount)
+            {
+                continue;
+            }
+        }
+
+        primaryCommandBuffer->resetQueryPool(getQueryPoolHandle(first), first.queryIndex,
+                                             rangeCount);
+        rangeStart = index;
+    }
+
+    mQueriesToReset.clear();
+}
+
+angle::Result GpuProfiler::getTimestampResult(ContextVk *contextVk,
+                                              const TimestampQuery &query,
+                                              uint64_t *timestampOut,
+                                              bool *availableOut)
+{
+    VkResult result = mQueryPool.getQueryPool(query.poolIndex)
+                          ->getResults(contextVk->getDevice(), query.queryIndex, 1,
+                                       sizeof(*timestampOut), timestampOut, sizeof(*timestampOut),
+                                       VK_QUERY_RESULT_64_BIT);
+    *availableOut = result != VK_NOT_READY;
+    if (*availableOut)
+    {
+        ANGLE_VK_TRY(contextVk, result);
+    }
+
+    return angle::Result::Continue;
+}
+
+angle::Result GpuProfiler::checkCompletedQueries(ContextVk *contextVk)
+{
+    if (!mEnabled)
+    {
+        return angle::Result::Continue;
+    }
+
+    const Serial lastCompletedSerial = contextVk->getLastCompletedQueueSerial();
+
+    uint64_t renderPassTimeNs = 0;
+    uint64_t internalTimeNs   = 0;
+    size_t finishedCount      = 0;
+
+    // The open scope, if any, is at the end and belongs to the current serial.
+    for (const InFlightScope &scope : mInFlightScopes)
+    {
+        // Only check the queries if the submission has finished.
+        if (scope.serial > lastCompletedSerial)
+        {
+            break;
+        }
+
+        uint64_t beginTimestamp = 0;
+        uint64_t endTimestamp   = 0;
+        bool beginAvailable     = false;
+        bool endAvailable       = false;
+        ANGLE_TRY(getTimestampResult(contextVk, scope.begin, &beginTimestamp, &beginAvailable));
+        ANGLE_TRY(getTimestampResult(contextVk, scope.end, &endTimestamp, &endAvailable));
+        if (!beginAvailable || !endAvailable)
+        {
+            break;
+        }
+
+        mQueryPool.freeQuery(contextVk, scope.begin.poolIndex, scope.begin.queryIndex);
+        mQueryPool.freeQuery(contextVk, scope.end.poolIndex, scope.end.queryIndex);
+
+        // Timestamps with fewer than 64 valid bits may wrap around between the two queries.
+        const uint64_t elapsedTicks = (endTimestamp - beginTimestamp) & mTimestampMask;
+        const uint64_t elapsedNs =
+            static_cast<uint64_t>(static_cast<double>(elapsedTicks) * mTimestampPeriodNs);
+
+        mTotalTimeNs[scope.category] += elapsedNs;
+        if (scope.category == GpuProfileCategory::RenderPass)
+        {
+            renderPassTimeNs += elapsedNs;
+        }
+        else
+        {
+            internalTimeNs += elapsedNs;
+        }
+
+        ++finishedCount;
+    }
+
+    mInFlightScopes.erase(mInFlightScopes.begin(), mInFlightScopes.begin() + finishedCount);
+
+    // The results arrive a few frames late, and are attributed to the frame they are read back in.
+    const gl::OverlayType *overlay = contextVk->getOverlay();
+    overlay->getRunningGraphWidget(gl::WidgetId::VulkanRenderPassGpuTime)
+        ->add(static_cast<size_t>(renderPassTimeNs / 1000));
+    overlay->getRunningGraphWidget(gl::WidgetId::VulkanInternalGpuTime)
+        ->add(static_cast<size_t>(internalTimeNs / 1000));
+
+    return angle::Result::Continue;
+}
+}  // namespace vk
+}  // namespace rx
@@ -0,0 +1,118 @@
+//
+// Copyright 2020 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// GpuProfiler.h:
+//    Measures the GPU time of render passes and of ANGLE's internal operations with pairs of
+//    timestamp queries.  The results are read back once the GPU is done with them, without
+//    waiting, and are exposed through the overlay and GL_ANGLE_gpu_profile.
+//
+
+#ifndef LIBANGLE_RENDERER_VULKAN_GPUPROFILER_H_
+#define LIBANGLE_RENDERER_VULKAN_GPUPROFILER_H_
+
+#include "common/PackedEnums.h"
+#include "libANGLE/renderer/vulkan/vk_helpers.h"
+
+namespace rx
+{
+class ContextVk;
+
+namespace vk
+{
+enum class GpuProfileCategory
+{
+    // Render passes, including the internal draws recorded in them.
+    RenderPass,
+
+    // Internal operations, mostly implemented by UtilsVk.
+    BufferClear,
+    ConvertIndexBuffer,
+    ConvertVertexBuffer,
+    ImageClear,
+    ImageCopy,
+    BlitResolve,
+    GenerateMipmap,
+    Overlay,
+
+    InvalidEnum,
+    EnumCount = InvalidEnum,
+};
+
+class GpuProfiler final : angle::NonCopyable
+{
+  public:
+    GpuProfiler();
+    ~GpuProfiler();
+
+    // The profiler stays disabled if the queue doesn't support timestamps.
+    angle::Result init(ContextVk *contextVk);
+    void destroy(VkDevice device);
+
+    bool isEnabled() const { return mEnabled; }
+
+    // Writes a timestamp pair around a render pass in the primary command buffer.  Both queries
+    // are reset before the render pass begins.
+    angle::Result beginRenderPass(ContextVk *contextVk,
+                                  Serial serial,
+                                  PrimaryCommandBuffer *primaryCommandBuffer);
+    void endRenderPass(PrimaryCommandBuffer *primaryCommandBuffer);
+
+    // Writes a timestamp pair around an internal operation in a command graph node's command
+    // buffer, which may be inside a render pass.  The queries are reset by resetScopeQueries when
+    // the command graph is executed.  Scopes don't nest.
+    angle::Result beginScope(ContextVk *contextVk,
+                             GpuProfileCategory category,
+                             CommandBuffer *commandBuffer);
+    void endScope(CommandBuffer *commandBuffer);
+
+    // Resets the queries of the scopes recorded since the last submission.  Called at the start
+    // of the primary command buffer, before the command graph nodes are executed.
+    void resetScopeQueries(ContextVk *contextVk, PrimaryCommandBuffer *primaryCommandBuffer);
+
+    // Reads back the results of the finished submissions without waiting for the others.
+    angle::Result checkCompletedQueries(ContextVk *contextVk);
+
+    // The accumulated GPU time of the results read back so far.
+    uint64_t getTotalTimeNs(GpuProfileCategory category) const { return mTotalTimeNs[category]; }
+    uint64_t getTotalInternalTimeNs() const;
+
+  private:
+    struct TimestampQuery
+    {
+        size_t poolIndex;
+        uint32_t queryIndex;
+    };
+
+    struct InFlightScope
+    {
+        GpuProfileCategory category;
+        Serial serial;
+        TimestampQuery begin;
+        TimestampQuery end;
+    };
+
+    angle::Result beginScopeImpl(ContextVk *contextVk, GpuProfileCategory category, Serial serial);
+    void discardOpenScope(ContextVk *contextVk);
+    VkQueryPool getQueryPoolHandle(const TimestampQuery &query) const;
+    angle::Result getTimestampResult(ContextVk *contextVk,
+                                     const TimestampQuery &query,
+                                     uint64_t *timestampOut,
+                                     bool *availableOut);
+
+    bool mEnabled;
+    bool mIsScopeOpen;
+    double mTimestampPeriodNs;
+    uint64_t mTimestampMask;
+
+    DynamicQueryPool mQueryPool;
+    std::vector<InFlightScope> mInFlightScopes;
+    std::vector<TimestampQuery> mQueriesToReset;
+
+    angle::PackedEnumMap<GpuProfileCategory, uint64_t> mTotalTimeNs;
+};
+}  // namespace vk
+}  // namespace rx
+
+#endif  // LIBANGLE_RENDERER_VULKAN_GPUPROFILER_H_
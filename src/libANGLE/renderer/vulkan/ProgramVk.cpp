@@ -289,6 +289,34 @@ void AddTextureDescriptorSetDesc(const gl::ProgramState &programState,
     }
 }
 
+angle::Result CreateDescriptorUpdateTemplate(
+    ContextVk *contextVk,
+    const vk::DescriptorSetLayout &descriptorSetLayout,
+    const std::vector<VkDescriptorUpdateTemplateEntryKHR> &entries,
+    VkDescriptorUpdateTemplateKHR *templateOut)
+{
+    VkDescriptorUpdateTemplateCreateInfoKHR createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO_KHR;
+
+    createInfo.descriptorUpdateEntryCount = static_cast<uint32_t>(entries.size());
+    createInfo.pDescriptorUpdateEntries   = entries.data();
+    createInfo.templateType               = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET_KHR;
+    createInfo.descriptorSetLayout        = descriptorSetLayout.getHandle();
+
+    ANGLE_VK_TRY(contextVk, vkCreateDescriptorUpdateTemplateKHR(contextVk->getDevice(), &createInfo,
+                                                                nullptr, templateOut));
+    return angle::Result::Continue;
+}
+
+void DestroyDescriptorUpdateTemplate(VkDevice device, VkDescriptorUpdateTemplateKHR *updateTemplate)
+{
+    if (*updateTemplate != VK_NULL_HANDLE)
+    {
+        vkDestroyDescriptorUpdateTemplateKHR(device, *updateTemplate, nullptr);
+        *updateTemplate = VK_NULL_HANDLE;
+    }
+}
+
 void WriteBufferDescriptorSetBinding(const gl::OffsetBindingPointer<gl::Buffer> &bufferBinding,
                                      VkDeviceSize maxSize,
                                      VkDescriptorSet descSet,
@@ -415,6 +443,10 @@ void ProgramVk::ShaderInfo::release(ContextVk *contextVk)
 
     for (vk::RefCounted<vk::ShaderAndSerial> &shader : mShaders)
     {
+        if (shader.get().valid())
+        {
+            contextVk->getRenderer()->releaseShaderSerial(shader.get().getSerial());
+        }
         shader.get().destroy(contextVk->getDevice());
     }
 }
@@ -429,7 +461,10 @@ ProgramVk::ProgramVk(const gl::ProgramState &state)
       mDynamicBufferOffsets{},
       mStorageBlockBindingsOffset(0),
       mAtomicCounterBufferBindingsOffset(0),
-      mImageBindingsOffset(0)
+      mImageBindingsOffset(0),
+      mCurrentTextureDescriptorsDesc(nullptr),
+      mDefaultUniformsDescriptorUpdateTemplate(VK_NULL_HANDLE),
+      mTexturesDescriptorUpdateTemplate(VK_NULL_HANDLE)
 {}
 
 ProgramVk::~ProgramVk() = default;
@@ -474,7 +509,16 @@ void ProgramVk::reset(ContextVk *contextVk)
     }
 
     mTextureDescriptorsCache.clear();
+    mCurrentTextureDescriptorsDesc = nullptr;
     mDescriptorBuffersCache.clear();
+
+    // The templates are only used when writing descriptor sets, so they can be destroyed right
+    // away.
+    VkDevice device = contextVk->getDevice();
+    DestroyDescriptorUpdateTemplate(device, &mDefaultUniformsDescriptorUpdateTemplate);
+    DestroyDescriptorUpdateTemplate(device, &mTexturesDescriptorUpdateTemplate);
+    mTextureBindingInfoOffsets.clear();
+    mTextureDescriptorImageInfos.clear();
 }
 
 std::unique_ptr<rx::LinkEvent> ProgramVk::load(const gl::Context *context,
@@ -659,6 +703,11 @@ angle::Result ProgramVk::linkImpl(const gl::Context *glContext, gl::InfoLog &inf
     ANGLE_TRY(renderer->getPipelineLayout(contextVk, pipelineLayoutDesc, mDescriptorSetLayouts,
                                           &mPipelineLayout));
 
+    if (renderer->getFeatures().supportsDescriptorUpdateTemplate.enabled)
+    {
+        ANGLE_TRY(initDescriptorUpdateTemplates(contextVk, texturesSetDesc));
+    }
+
     // Initialize descriptor pools.
     std::array<VkDescriptorPoolSize, 2> uniformAndXfbSetSize = {
         {{VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
@@ -731,6 +780,65 @@ angle::Result ProgramVk::linkImpl(const gl::Context *glContext, gl::InfoLog &inf
     return mEmptyBuffer.init(contextVk, emptyBufferInfo, kMemoryType);
 }
 
+angle::Result ProgramVk::initDescriptorUpdateTemplates(
+    ContextVk *contextVk,
+    const vk::DescriptorSetLayoutDesc &texturesSetDesc)
+{
+    // Default uniforms: one dynamic uniform buffer per shader stage, in stage order.  The
+    // transform feedback bindings of the same set are written separately.
+    std::vector<VkDescriptorUpdateTemplateEntryKHR> entries;
+    const uint32_t shaderStageCount = static_cast<uint32_t>(mState.getLinkedShaderStageCount());
+    for (uint32_t bindingIndex = 0; bindingIndex < shaderStageCount; ++bindingIndex)
+    {
+        VkDescriptorUpdateTemplateEntryKHR entry = {};
+        entry.dstBinding                         = bindingIndex;
+        entry.dstArrayElement                    = 0;
+        entry.descriptorCount                    = 1;
+        entry.descriptorType                     = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+        entry.offset                             = bindingIndex * sizeof(VkDescriptorBufferInfo);
+        entry.stride                             = sizeof(VkDescriptorBufferInfo);
+        entries.push_back(entry);
+    }
+
+    ANGLE_TRY(CreateDescriptorUpdateTemplate(
+        contextVk, mDescriptorSetLayouts[kUniformsAndXfbDescriptorSetIndex].get(), entries,
+        &mDefaultUniformsDescriptorUpdateTemplate));
+
+    // Textures: the elements of all bindings are packed one after the other, so the whole set is
+    // written from mTextureDescriptorImageInfos.
+    vk::DescriptorSetLayoutBindingVector textureBindings;
+    texturesSetDesc.unpackBindings(&textureBindings);
+    if (textureBindings.empty())
+    {
+        return angle::Result::Continue;
+    }
+
+    entries.clear();
+    mTextureBindingInfoOffsets.resize(textureBindings.back().binding + 1, 0);
+
+    uint32_t infoCount = 0;
+    for (const VkDescriptorSetLayoutBinding &binding : textureBindings)
+    {
+        VkDescriptorUpdateTemplateEntryKHR entry = {};
+        entry.dstBinding                         = binding.binding;
+        entry.dstArrayElement                    = 0;
+        entry.descriptorCount                    = binding.descriptorCount;
+        entry.descriptorType                     = binding.descriptorType;
+        entry.offset                             = infoCount * sizeof(VkDescriptorImageInfo);
+        entry.stride                             = sizeof(VkDescriptorImageInfo);
+        entries.push_back(entry);
+
+        mTextureBindingInfoOffsets[binding.binding] = infoCount;
+        infoCount += binding.descriptorCount;
+    }
+
+    mTextureDescriptorImageInfos.resize(infoCount);
+
+    return CreateDescriptorUpdateTemplate(contextVk,
+                                          mDescriptorSetLayouts[kTextureDescriptorSetIndex].get(),
+                                          entries, &mTexturesDescriptorUpdateTemplate);
+}
+
 void ProgramVk::updateBindingOffsets()
 {
     mStorageBlockBindingsOffset = static_cast<uint32_t>(mState.getUniqueUniformBlockCount());
@@ -981,8 +1089,10 @@ void ProgramVk::setUniform1iv(GLint location, GLsizei count, const GLint *v)
     const gl::LinkedUniform &linkedUniform   = mState.getUniforms()[locationInfo.index];
     if (linkedUniform.isSampler())
     {
-        // We could potentially cache some indexing here. For now this is a no-op since the mapping
-        // is handled entirely in ContextVk.
+        // We could potentially cache some indexing here. For now the mapping is handled entirely
+        // in ContextVk. The current descriptor set no longer matches the new mapping, so it can't
+        // be used as a source for partial updates.
+        mCurrentTextureDescriptorsDesc = nullptr;
         return;
     }
 
@@ -1221,7 +1331,6 @@ void ProgramVk::updateDefaultUniformsDescriptorSet(ContextVk *contextVk)
     uint32_t shaderStageCount = static_cast<uint32_t>(mState.getLinkedShaderStageCount());
 
     gl::ShaderVector<VkDescriptorBufferInfo> descriptorBufferInfo(shaderStageCount);
-    gl::ShaderVector<VkWriteDescriptorSet> writeDescriptorInfo(shaderStageCount);
 
     uint32_t bindingIndex = 0;
 
@@ -1232,7 +1341,6 @@ void ProgramVk::updateDefaultUniformsDescriptorSet(ContextVk *contextVk)
     {
         DefaultUniformBlock &uniformBlock  = mDefaultUniformBlocks[shaderType];
         VkDescriptorBufferInfo &bufferInfo = descriptorBufferInfo[bindingIndex];
-        VkWriteDescriptorSet &writeInfo    = writeDescriptorInfo[bindingIndex];
 
         if (!uniformBlock.uniformData.empty())
         {
@@ -1250,25 +1358,40 @@ void ProgramVk::updateDefaultUniformsDescriptorSet(ContextVk *contextVk)
         bufferInfo.offset = 0;
         bufferInfo.range  = VK_WHOLE_SIZE;
 
+        ++bindingIndex;
+    }
+
+    VkDevice device               = contextVk->getDevice();
+    VkDescriptorSet descriptorSet = mDescriptorSets[kUniformsAndXfbDescriptorSetIndex];
+
+    ASSERT(bindingIndex == shaderStageCount);
+    ASSERT(shaderStageCount <= kReservedDefaultUniformBindingCount);
+
+    if (mDefaultUniformsDescriptorUpdateTemplate != VK_NULL_HANDLE)
+    {
+        vkUpdateDescriptorSetWithTemplateKHR(device, descriptorSet,
+                                             mDefaultUniformsDescriptorUpdateTemplate,
+                                             descriptorBufferInfo.data());
+        return;
+    }
+
+    gl::ShaderVector<VkWriteDescriptorSet> writeDescriptorInfo(shaderStageCount);
+    for (bindingIndex = 0; bindingIndex < shaderStageCount; ++bindingIndex)
+    {
+        VkWriteDescriptorSet &writeInfo = writeDescriptorInfo[bindingIndex];
+
         writeInfo.sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
         writeInfo.pNext            = nullptr;
-        writeInfo.dstSet           = mDescriptorSets[kUniformsAndXfbDescriptorSetIndex];
+        writeInfo.dstSet           = descriptorSet;
         writeInfo.dstBinding       = bindingIndex;
         writeInfo.dstArrayElement  = 0;
         writeInfo.descriptorCount  = 1;
         writeInfo.descriptorType   = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
         writeInfo.pImageInfo       = nullptr;
-        writeInfo.pBufferInfo      = &bufferInfo;
+        writeInfo.pBufferInfo      = &descriptorBufferInfo[bindingIndex];
         writeInfo.pTexelBufferView = nullptr;
-
-        ++bindingIndex;
     }
 
-    VkDevice device = contextVk->getDevice();
-
-    ASSERT(bindingIndex == shaderStageCount);
-    ASSERT(shaderStageCount <= kReservedDefaultUniformBindingCount);
-
     vkUpdateDescriptorSets(device, shaderStageCount, writeDescriptorInfo.data(), 0, nullptr);
 }
 
@@ -1579,10 +1702,20 @@ angle::Result ProgramVk::updateTexturesDescriptorSet(ContextVk *contextVk)
     if (iter != mTextureDescriptorsCache.end())
     {
         mDescriptorSets[kTextureDescriptorSetIndex] = iter->second;
+        mCurrentTextureDescriptorsDesc              = &iter->first;
         return angle::Result::Continue;
     }
 
     ASSERT(hasTextures());
+
+    // Units that didn't change since the previous descriptor set are copied from it.
+    const vk::TextureDescriptorDesc *previousTexturesDesc = mCurrentTextureDescriptorsDesc;
+    VkDescriptorSet previousDescriptorSet                 = VK_NULL_HANDLE;
+    if (previousTexturesDesc)
+    {
+        previousDescriptorSet = mDescriptorSets[kTextureDescriptorSetIndex];
+    }
+
     bool newPoolAllocated;
     ANGLE_TRY(
         allocateDescriptorSetAndGetInfo(contextVk, kTextureDescriptorSetIndex, &newPoolAllocated));
@@ -1591,19 +1724,26 @@ angle::Result ProgramVk::updateTexturesDescriptorSet(ContextVk *contextVk)
     if (newPoolAllocated)
     {
         mTextureDescriptorsCache.clear();
+        previousTexturesDesc = nullptr;
     }
 
     VkDescriptorSet descriptorSet = mDescriptorSets[kTextureDescriptorSetIndex];
 
     gl::ActiveTextureArray<VkDescriptorImageInfo> descriptorImageInfo;
     gl::ActiveTextureArray<VkWriteDescriptorSet> writeDescriptorInfo;
+    gl::ActiveTextureArray<VkCopyDescriptorSet> copyDescriptorInfo;
     uint32_t writeCount = 0;
+    uint32_t copyCount  = 0;
 
     const gl::ActiveTextureArray<vk::TextureUnit> &activeTextures = contextVk->getActiveTextures();
 
     bool emulateSeamfulCubeMapSampling = contextVk->emulateSeamfulCubeMapSampling();
     bool useOldRewriteStructSamplers   = contextVk->useOldRewriteStructSamplers();
 
+    // With a template, every descriptor is written in one call, which is cheaper than copying
+    // the unchanged ones.
+    const bool useTemplate = mTexturesDescriptorUpdateTemplate != VK_NULL_HANDLE;
+
     std::unordered_map<std::string, uint32_t> mappedSamplerNameToBindingIndex;
     std::unordered_map<std::string, uint32_t> mappedSamplerNameToArrayOffset;
 
@@ -1641,13 +1781,49 @@ angle::Result ProgramVk::updateTexturesDescriptorSet(ContextVk *contextVk)
 
         for (uint32_t arrayElement = 0; arrayElement < arraySize; ++arrayElement)
         {
-            GLuint textureUnit   = samplerBinding.boundTextureUnits[arrayElement];
+            GLuint textureUnit  = samplerBinding.boundTextureUnits[arrayElement];
+            uint32_t dstElement = arrayOffset + arrayElement;
+
+            if (!useTemplate && previousTexturesDesc &&
+                texturesDesc.isUnitEqual(textureUnit, *previousTexturesDesc))
+            {
+                // Extend the previous copy when it covers the preceding element of this binding.
+                VkCopyDescriptorSet *lastCopy =
+                    copyCount > 0 ? &copyDescriptorInfo[copyCount - 1] : nullptr;
+                if (lastCopy && lastCopy->dstBinding == bindingIndex &&
+                    lastCopy->dstArrayElement + lastCopy->descriptorCount == dstElement)
+                {
+                    lastCopy->descriptorCount++;
+                    continue;
+                }
+
+                VkCopyDescriptorSet &copyInfo = copyDescriptorInfo[copyCount];
+
+                copyInfo.sType           = VK_STRUCTURE_TYPE_COPY_DESCRIPTOR_SET;
+                copyInfo.pNext           = nullptr;
+                copyInfo.srcSet          = previousDescriptorSet;
+                copyInfo.srcBinding      = bindingIndex;
+                copyInfo.srcArrayElement = dstElement;
+                copyInfo.dstSet          = descriptorSet;
+                copyInfo.dstBinding      = bindingIndex;
+                copyInfo.dstArrayElement = dstElement;
+                copyInfo.descriptorCount = 1;
+
+                ++copyCount;
+                continue;
+            }
+
             TextureVk *textureVk = activeTextures[textureUnit].texture;
             SamplerVk *samplerVk = activeTextures[textureUnit].sampler;
 
             vk::ImageHelper &image = textureVk->getImage();
 
-            VkDescriptorImageInfo &imageInfo = descriptorImageInfo[writeCount];
+            // The template reads the elements of every binding from mTextureDescriptorImageInfos.
+            VkDescriptorImageInfo &imageInfo =
+                useTemplate
+                    ? mTextureDescriptorImageInfos[mTextureBindingInfoOffsets[bindingIndex] +
+                                                   dstElement]
+                    : descriptorImageInfo[writeCount];
 
             // Use bound sampler object if one present, otherwise use texture's sampler
             imageInfo.sampler = (samplerVk != nullptr) ? samplerVk->getSampler().getHandle()
@@ -1662,13 +1838,18 @@ angle::Result ProgramVk::updateTexturesDescriptorSet(ContextVk *contextVk)
                 imageInfo.imageView = textureVk->getFetchImageView().getHandle();
             }
 
+            if (useTemplate)
+            {
+                continue;
+            }
+
             VkWriteDescriptorSet &writeInfo = writeDescriptorInfo[writeCount];
 
             writeInfo.sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
             writeInfo.pNext            = nullptr;
             writeInfo.dstSet           = descriptorSet;
             writeInfo.dstBinding       = bindingIndex;
-            writeInfo.dstArrayElement  = arrayOffset + arrayElement;
+            writeInfo.dstArrayElement  = dstElement;
             writeInfo.descriptorCount  = 1;
             writeInfo.descriptorType   = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
             writeInfo.pImageInfo       = &imageInfo;
@@ -1681,11 +1862,22 @@ angle::Result ProgramVk::updateTexturesDescriptorSet(ContextVk *contextVk)
 
     VkDevice device = contextVk->getDevice();
 
-    ASSERT(writeCount > 0);
+    if (useTemplate)
+    {
+        vkUpdateDescriptorSetWithTemplateKHR(device, descriptorSet,
+                                             mTexturesDescriptorUpdateTemplate,
+                                             mTextureDescriptorImageInfos.data());
+    }
+    else
+    {
+        ASSERT(writeCount + copyCount > 0);
 
-    vkUpdateDescriptorSets(device, writeCount, writeDescriptorInfo.data(), 0, nullptr);
+        vkUpdateDescriptorSets(device, writeCount, writeDescriptorInfo.data(), copyCount,
+                               copyDescriptorInfo.data());
+    }
 
-    mTextureDescriptorsCache.emplace(texturesDesc, descriptorSet);
+    auto inserted                  = mTextureDescriptorsCache.emplace(texturesDesc, descriptorSet);
+    mCurrentTextureDescriptorsDesc = &inserted.first->first;
 
     return angle::Result::Continue;
 }
@@ -200,6 +200,8 @@ class ProgramVk : public ProgramImpl
     template <typename T>
     void setUniformImpl(GLint location, GLsizei count, const T *v, GLenum entryPointType);
     angle::Result linkImpl(const gl::Context *glContext, gl::InfoLog &infoLog);
+    angle::Result initDescriptorUpdateTemplates(ContextVk *contextVk,
+                                                const vk::DescriptorSetLayoutDesc &texturesSetDesc);
     void linkResources(const gl::ProgramLinkedResources &resources);
 
     void updateBindingOffsets();
@@ -285,6 +287,18 @@ class ProgramVk : public ProgramImpl
     std::vector<vk::BufferHelper *> mDescriptorBuffersCache;
 
     std::unordered_map<vk::TextureDescriptorDesc, VkDescriptorSet> mTextureDescriptorsCache;
+    // Key of the texture descriptor set currently in mDescriptorSets. Descriptors of units it
+    // shares with a new key are copied over instead of being written again.
+    const vk::TextureDescriptorDesc *mCurrentTextureDescriptorsDesc;
+
+    // With VK_KHR_descriptor_update_template, the default uniforms and textures descriptor sets
+    // are each written with a single call from a tightly packed array of descriptor infos.  The
+    // templates are created at link time from the descriptor set layouts.
+    VkDescriptorUpdateTemplateKHR mDefaultUniformsDescriptorUpdateTemplate;
+    VkDescriptorUpdateTemplateKHR mTexturesDescriptorUpdateTemplate;
+    // Index of the first element of each texture binding in mTextureDescriptorImageInfos.
+    std::vector<uint32_t> mTextureBindingInfoOffsets;
+    std::vector<VkDescriptorImageInfo> mTextureDescriptorImageInfos;
 
     // We keep a reference to the pipeline and descriptor set layouts. This ensures they don't get
     // deleted while this program is in use.
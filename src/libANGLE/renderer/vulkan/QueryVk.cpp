@@ -68,6 +68,8 @@ angle::Result QueryVk::begin(const gl::Context *context)
         }
 
         mQueryHelperTimeElapsedBegin.writeTimestamp(contextVk);
+        ANGLE_TRY(contextVk->getQueryPool(getType())
+                      ->queueResultCopy(contextVk, mQueryHelperTimeElapsedBegin));
     }
     else
     {
@@ -96,13 +98,17 @@ angle::Result QueryVk::end(const gl::Context *context)
         mCachedResultValid = true;
         contextVk->getCommandGraph()->endTransformFeedbackEmulatedQuery();
     }
-    else if (getType() == gl::QueryType::TimeElapsed)
-    {
-        mQueryHelper.writeTimestamp(contextVk);
-    }
     else
     {
-        mQueryHelper.endQuery(contextVk);
+        if (getType() == gl::QueryType::TimeElapsed)
+        {
+            mQueryHelper.writeTimestamp(contextVk);
+        }
+        else
+        {
+            mQueryHelper.endQuery(contextVk);
+        }
+        ANGLE_TRY(contextVk->getQueryPool(getType())->queueResultCopy(contextVk, mQueryHelper));
     }
 
     return angle::Result::Continue;
@@ -122,6 +128,7 @@ angle::Result QueryVk::queryCounter(const gl::Context *context)
     ASSERT(getType() == gl::QueryType::Timestamp);
 
     mQueryHelper.writeTimestamp(contextVk);
+    ANGLE_TRY(contextVk->getQueryPool(getType())->queueResultCopy(contextVk, mQueryHelper));
 
     return angle::Result::Continue;
 }
@@ -148,9 +155,9 @@ angle::Result QueryVk::getResult(const gl::Context *context, bool wait)
         ASSERT(!mQueryHelper.hasPendingWork(contextVk));
     }
 
-    // If the command buffer this query is being written to is still in flight, its reset command
-    // may not have been performed by the GPU yet.  To avoid a race condition in this case, wait
-    // for the batch to finish first before querying (or return not-ready if not waiting).
+    // The submission that wrote this query also copied its result to a host-visible buffer.  Once
+    // that submission has finished, the result is available there (or return not-ready if not
+    // waiting).
     ANGLE_TRY(contextVk->checkCompletedCommands());
     if (contextVk->isSerialInUse(mQueryHelper.getStoredQueueSerial()))
     {
@@ -161,19 +168,8 @@ angle::Result QueryVk::getResult(const gl::Context *context, bool wait)
         ANGLE_TRY(contextVk->finishToSerial(mQueryHelper.getStoredQueueSerial()));
     }
 
-    VkQueryResultFlags flags = (wait ? VK_QUERY_RESULT_WAIT_BIT : 0) | VK_QUERY_RESULT_64_BIT;
-
-    VkResult result = mQueryHelper.getQueryPool()->getResults(
-        contextVk->getDevice(), mQueryHelper.getQuery(), 1, sizeof(mCachedResult), &mCachedResult,
-        sizeof(mCachedResult), flags);
-    // If the results are not ready, do nothing.  mCachedResultValid remains false.
-    if (result == VK_NOT_READY)
-    {
-        // If VK_QUERY_RESULT_WAIT_BIT was given, VK_NOT_READY cannot have been returned.
-        ASSERT(!wait);
-        return angle::Result::Continue;
-    }
-    ANGLE_VK_TRY(contextVk, result);
+    const vk::DynamicQueryPool *queryPool = contextVk->getQueryPool(getType());
+    mCachedResult                         = queryPool->getResult(mQueryHelper);
 
     double timestampPeriod = renderer->getPhysicalDeviceProperties().limits.timestampPeriod;
 
@@ -190,17 +186,11 @@ angle::Result QueryVk::getResult(const gl::Context *context, bool wait)
             break;
         case gl::QueryType::TimeElapsed:
         {
-            uint64_t timeElapsedEnd = mCachedResult;
-
-            result = mQueryHelperTimeElapsedBegin.getQueryPool()->getResults(
-                contextVk->getDevice(), mQueryHelperTimeElapsedBegin.getQuery(), 1,
-                sizeof(mCachedResult), &mCachedResult, sizeof(mCachedResult), flags);
-            // Since the result of the end query of time-elapsed is already available, the
-            // result of begin query must be available too.
-            ASSERT(result != VK_NOT_READY);
-            ANGLE_VK_TRY(contextVk, result);
+            // The begin query was written no later than the end query, so its result is
+            // available too.
+            uint64_t timeElapsedBegin = queryPool->getResult(mQueryHelperTimeElapsedBegin);
 
-            mCachedResult = timeElapsedEnd - mCachedResult;
+            mCachedResult = mCachedResult - timeElapsedBegin;
             mCachedResult = static_cast<uint64_t>(mCachedResult * timestampPeriod);
 
             break;
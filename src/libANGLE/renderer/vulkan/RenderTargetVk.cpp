@@ -27,7 +27,9 @@ RenderTargetVk::RenderTargetVk(RenderTargetVk &&other)
     : mImage(other.mImage),
       mImageView(other.mImageView),
       mLevelIndex(other.mLevelIndex),
-      mLayerIndex(other.mLayerIndex)
+      mLayerIndex(other.mLayerIndex),
+      mLastRenderPass(other.mLastRenderPass),
+      mUnreadPreviousRenderPass(other.mUnreadPreviousRenderPass)
 {}
 
 void RenderTargetVk::init(vk::ImageHelper *image,
@@ -39,6 +41,9 @@ void RenderTargetVk::init(vk::ImageHelper *image,
     mImageView  = imageView;
     mLevelIndex = levelIndex;
     mLayerIndex = layerIndex;
+
+    mLastRenderPass           = {};
+    mUnreadPreviousRenderPass = {};
 }
 
 void RenderTargetVk::reset()
@@ -47,44 +52,114 @@ void RenderTargetVk::reset()
     mImageView  = nullptr;
     mLevelIndex = 0;
     mLayerIndex = 0;
+
+    mLastRenderPass           = {};
+    mUnreadPreviousRenderPass = {};
 }
 
 angle::Result RenderTargetVk::onColorDraw(ContextVk *contextVk,
                                           vk::FramebufferHelper *framebufferVk,
-                                          vk::CommandBuffer *commandBuffer)
+                                          size_t attachmentIndex)
 {
-    ASSERT(commandBuffer->valid());
     ASSERT(!mImage->getFormat().imageFormat().hasDepthOrStencilBits());
 
     // TODO(jmadill): Use automatic layout transition. http://anglebug.com/2361
     mImage->changeLayout(VK_IMAGE_ASPECT_COLOR_BIT, vk::ImageLayout::ColorAttachment,
-                         commandBuffer);
+                         framebufferVk->getPipelineBarrier());
 
     // Set up dependencies between the RT resource and the Framebuffer.
-    mImage->addWriteDependency(contextVk, framebufferVk);
+    addRenderPassWriteDependency(contextVk, framebufferVk, attachmentIndex);
 
     return angle::Result::Continue;
 }
 
 angle::Result RenderTargetVk::onDepthStencilDraw(ContextVk *contextVk,
                                                  vk::FramebufferHelper *framebufferVk,
-                                                 vk::CommandBuffer *commandBuffer)
+                                                 size_t attachmentIndex)
 {
-    ASSERT(commandBuffer->valid());
     ASSERT(mImage->getFormat().imageFormat().hasDepthOrStencilBits());
 
     // TODO(jmadill): Use automatic layout transition. http://anglebug.com/2361
     const angle::Format &format    = mImage->getFormat().imageFormat();
     VkImageAspectFlags aspectFlags = vk::GetDepthStencilAspectFlags(format);
 
-    mImage->changeLayout(aspectFlags, vk::ImageLayout::DepthStencilAttachment, commandBuffer);
+    mImage->changeLayout(aspectFlags, vk::ImageLayout::DepthStencilAttachment,
+                         framebufferVk->getPipelineBarrier());
 
     // Set up dependencies between the RT resource and the Framebuffer.
-    mImage->addWriteDependency(contextVk, framebufferVk);
+    addRenderPassWriteDependency(contextVk, framebufferVk, attachmentIndex);
 
     return angle::Result::Continue;
 }
 
+void RenderTargetVk::onRenderPassFullClear(ContextVk *contextVk, VkImageAspectFlags aspectFlags)
+{
+    dropRenderPassStore(contextVk, mUnreadPreviousRenderPass, aspectFlags);
+}
+
+void RenderTargetVk::onContentsUndefined(ContextVk *contextVk, VkImageAspectFlags aspectFlags)
+{
+    if (mImage->getUnreadWritingNode() == mLastRenderPass.node)
+    {
+        dropRenderPassStore(contextVk, mLastRenderPass, aspectFlags);
+    }
+}
+
+void RenderTargetVk::addRenderPassWriteDependency(ContextVk *contextVk,
+                                                  vk::FramebufferHelper *framebufferVk,
+                                                  size_t attachmentIndex)
+{
+    Serial currentSerial = contextVk->getCurrentQueueSerial();
+
+    // Remember the previous render pass if it's still in the command graph and nothing has read
+    // the image since it drew to it.
+    mUnreadPreviousRenderPass = {};
+    if (mLastRenderPass.serial == currentSerial &&
+        mImage->getUnreadWritingNode() == mLastRenderPass.node)
+    {
+        mUnreadPreviousRenderPass = mLastRenderPass;
+    }
+
+    mImage->addWriteDependency(contextVk, framebufferVk);
+
+    // The framebuffer's render pass node is now the image's writer.
+    mLastRenderPass.node            = mImage->getUnreadWritingNode();
+    mLastRenderPass.attachmentIndex = attachmentIndex;
+    mLastRenderPass.serial          = currentSerial;
+}
+
+void RenderTargetVk::dropRenderPassStore(ContextVk *contextVk,
+                                         const RenderPassAttachment &renderPass,
+                                         VkImageAspectFlags aspectFlags)
+{
+    if (renderPass.node == nullptr || renderPass.serial != contextVk->getCurrentQueueSerial())
+    {
+        return;
+    }
+
+    VkImageAspectFlags droppedAspects =
+        renderPass.node->dropRenderPassAttachmentStore(renderPass.attachmentIndex, aspectFlags);
+
+    const angle::Format &format = mImage->getFormat().imageFormat();
+    size_t bytesPerPixel        = 0;
+    if ((droppedAspects & VK_IMAGE_ASPECT_COLOR_BIT) != 0)
+    {
+        bytesPerPixel += format.pixelBytes;
+    }
+    if ((droppedAspects & VK_IMAGE_ASPECT_DEPTH_BIT) != 0)
+    {
+        bytesPerPixel += format.depthBits / 8;
+    }
+    if ((droppedAspects & VK_IMAGE_ASPECT_STENCIL_BIT) != 0)
+    {
+        bytesPerPixel += format.stencilBits / 8;
+    }
+
+    const gl::Rectangle &renderArea = renderPass.node->getRenderPassRenderArea();
+    contextVk->getCommandGraph()->onRenderPassStoreDropped(
+        bytesPerPixel * renderArea.width * renderArea.height * mImage->getSamples());
+}
+
 vk::ImageHelper &RenderTargetVk::getImage()
 {
     ASSERT(mImage && mImage->valid());
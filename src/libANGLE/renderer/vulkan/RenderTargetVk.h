@@ -24,6 +24,7 @@ struct Format;
 class FramebufferHelper;
 class ImageHelper;
 class ImageView;
+class CommandGraphNode;
 class CommandGraphResource;
 class RenderPassDesc;
 }  // namespace vk
@@ -50,12 +51,24 @@ class RenderTargetVk final : public FramebufferAttachmentRenderTarget
     void reset();
 
     // Note: RenderTargets should be called in order, with the depth/stencil onRender last.
+    // |attachmentIndex| is the index of the render target in the render pass being started.  The
+    // layout transition is added to the barrier of the framebuffer's new render pass node.
     angle::Result onColorDraw(ContextVk *contextVk,
                               vk::FramebufferHelper *framebufferVk,
-                              vk::CommandBuffer *commandBuffer);
+                              size_t attachmentIndex);
     angle::Result onDepthStencilDraw(ContextVk *contextVk,
                                      vk::FramebufferHelper *framebufferVk,
-                                     vk::CommandBuffer *commandBuffer);
+                                     size_t attachmentIndex);
+
+    // Called when the render pass started by the last on*Draw call clears |aspectFlags| of the
+    // whole render target.  If nothing read the render target since the render pass before it, the
+    // previous render pass doesn't need to store those aspects.
+    void onRenderPassFullClear(ContextVk *contextVk, VkImageAspectFlags aspectFlags);
+
+    // Called when |aspectFlags| of the render target become undefined, such as the window's
+    // depth/stencil buffer on swap.  If nothing read the render target since the last render pass
+    // drew to it, that render pass doesn't need to store those aspects.
+    void onContentsUndefined(ContextVk *contextVk, VkImageAspectFlags aspectFlags);
 
     vk::ImageHelper &getImage();
     const vk::ImageHelper &getImage() const;
@@ -83,12 +96,33 @@ class RenderTargetVk final : public FramebufferAttachmentRenderTarget
     angle::Result flushStagedUpdates(ContextVk *contextVk);
 
   private:
+    // A render pass that drew to this render target.  The serial guards against using a node from
+    // a command graph that was submitted since.
+    struct RenderPassAttachment
+    {
+        vk::CommandGraphNode *node = nullptr;
+        size_t attachmentIndex     = 0;
+        Serial serial;
+    };
+
+    void addRenderPassWriteDependency(ContextVk *contextVk,
+                                      vk::FramebufferHelper *framebufferVk,
+                                      size_t attachmentIndex);
+    void dropRenderPassStore(ContextVk *contextVk,
+                             const RenderPassAttachment &renderPass,
+                             VkImageAspectFlags aspectFlags);
+
     vk::ImageHelper *mImage;
     // Note that the draw and read image views are the same, given the requirements of a render
     // target. Note that for cube maps we use 2D array views.
     const vk::ImageView *mImageView;
     uint32_t mLevelIndex;
     uint32_t mLayerIndex;
+
+    // The render pass that last drew to this render target, and the one before it if nothing read
+    // the render target in between.
+    RenderPassAttachment mLastRenderPass;
+    RenderPassAttachment mUnreadPreviousRenderPass;
 };
 
 }  // namespace rx
@@ -17,6 +17,7 @@
 #include "common/debug.h"
 #include "common/platform.h"
 #include "common/system_utils.h"
+#include "common/version.h"
 #include "libANGLE/Context.h"
 #include "libANGLE/Display.h"
 #include "libANGLE/renderer/driver_utils.h"
@@ -42,6 +43,8 @@ constexpr char kMockDeviceName[]                          = "Vulkan Mock Device"
 const uint32_t kSwiftShaderDeviceID                       = 0xC0DE;
 constexpr char kSwiftShaderDeviceName[]                   = "SwiftShader Device";
 constexpr VkFormatFeatureFlags kInvalidFormatFeatureFlags = static_cast<VkFormatFeatureFlags>(-1);
+// Bump this whenever the layout of the format properties blob changes.
+constexpr uint32_t kFormatPropertiesBlobVersion = 1;
 }  // anonymous namespace
 
 namespace rx
@@ -536,7 +539,8 @@ RendererVk::RendererVk()
       mDeviceLost(false),
       mPipelineCacheVkUpdateTimeout(kPipelineCacheVkUpdatePeriod),
       mPipelineCacheDirty(false),
-      mPipelineCacheInitialized(false)
+      mPipelineCacheInitialized(false),
+      mUtilsPipelinesWarmUpStarted(false)
 {
     VkFormatProperties invalid = {0, 0, kInvalidFormatFeatureFlags};
     mFormatProperties.fill(invalid);
@@ -549,11 +553,15 @@ RendererVk::~RendererVk()
 
 void RendererVk::onDestroy(vk::Context *context)
 {
+    mCommandProcessor.stop();
+
     (void)cleanupGarbage(context, true);
     ASSERT(mSharedGarbage.empty());
 
     mFenceRecycler.destroy(mDevice);
 
+    mSharedGraphicsPipelineCache.destroy(mDevice);
+    mRenderPassCache.destroy(mDevice);
     mPipelineLayoutCache.destroy(mDevice);
     mDescriptorSetLayoutCache.destroy(mDevice);
 
@@ -886,8 +894,18 @@ angle::Result RendererVk::initialize(DisplayVk *displayVk,
 
     GlslangInitialize();
 
-    // Initialize the format table.
+    // Initialize the format table.  If a previous initialization on this device left a snapshot
+    // of the queried format properties behind, reuse it instead of probing every format again.
+    // The snapshot depends on the features, so it's not used if the device initialization, and
+    // with it the features, waits for a window surface.
+    bool useFormatPropertiesCache = mFeaturesInitialized;
+    bool formatPropertiesCached =
+        useFormatPropertiesCache && loadFormatPropertiesFromBlobCache(displayVk);
     mFormatTable.initialize(this, &mNativeTextureCaps, &mNativeCaps.compressedTextureFormats);
+    if (useFormatPropertiesCache && !formatPropertiesCached)
+    {
+        storeFormatPropertiesToBlobCache(displayVk);
+    }
 
     return angle::Result::Continue;
 }
@@ -964,6 +982,14 @@ angle::Result RendererVk::initializeDevice(DisplayVk *displayVk, uint32_t queueF
     OverrideFeaturesWithDisplayState(&mFeatures, displayVk->getState());
     mFeaturesInitialized = true;
 
+    // The key includes features that change the queried format properties.
+    initFormatPropertiesBlobKey();
+
+    if (mFeatures.warmUpUtilsPipelines.enabled)
+    {
+        mWorkerThreadPool = angle::WorkerThreadPool::Create(true);
+    }
+
     // Selectively enable KHR_MAINTENANCE1 to support viewport flipping.
     if ((getFeatures().flipViewportY.enabled) &&
         (mPhysicalDeviceProperties.apiVersion < VK_MAKE_VERSION(1, 1, 0)))
@@ -1014,6 +1040,12 @@ angle::Result RendererVk::initializeDevice(DisplayVk *displayVk, uint32_t queueF
         enabledDeviceExtensions.push_back(VK_EXT_SHADER_STENCIL_EXPORT_EXTENSION_NAME);
     }
 
+    if (getFeatures().supportsDescriptorUpdateTemplate.enabled)
+    {
+        enabledDeviceExtensions.push_back(VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME);
+        InitDescriptorUpdateTemplateKHRFunctions(mInstance);
+    }
+
     std::sort(enabledDeviceExtensions.begin(), enabledDeviceExtensions.end(), StrLess);
     ANGLE_VK_TRY(displayVk, VerifyExtensionsPresent(deviceExtensionNames, enabledDeviceExtensions));
 
@@ -1104,6 +1136,11 @@ angle::Result RendererVk::initializeDevice(DisplayVk *displayVk, uint32_t queueF
 
     vkGetDeviceQueue(mDevice, mCurrentQueueFamilyIndex, 0, &mQueue);
 
+    if (mFeatures.asyncCommandQueue.enabled)
+    {
+        mCommandProcessor.start(mQueue, &mQueueMutex);
+    }
+
     // Initialize the vulkan pipeline cache.
     bool success = false;
     ANGLE_TRY(initPipelineCache(displayVk, &mPipelineCache, &success));
@@ -1316,6 +1353,10 @@ void RendererVk::initFeatures(const ExtensionNameList &deviceExtensionNames)
         (&mFeatures), supportsShaderStencilExport,
         ExtensionFound(VK_EXT_SHADER_STENCIL_EXPORT_EXTENSION_NAME, deviceExtensionNames))
 
+    ANGLE_FEATURE_CONDITION(
+        (&mFeatures), supportsDescriptorUpdateTemplate,
+        ExtensionFound(VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME, deviceExtensionNames))
+
     // TODO(syoussefi): when the code path using the extension is implemented, this should be
     // conditioned to the extension not being present as well.  http://anglebug.com/3206
     ANGLE_FEATURE_CONDITION((&mFeatures), emulateTransformFeedback,
@@ -1348,6 +1389,15 @@ void RendererVk::initFeatures(const ExtensionNameList &deviceExtensionNames)
         IsPixel2(mPhysicalDeviceProperties.vendorID, mPhysicalDeviceProperties.deviceID) ||
             IsPixel1XL(mPhysicalDeviceProperties.vendorID, mPhysicalDeviceProperties.deviceID))
 
+    // Off by default until it has been measured on more drivers.
+    ANGLE_FEATURE_CONDITION((&mFeatures), asyncCommandQueue, false)
+
+    // Off by default.  It creates the conversion resources and pipelines before any draw needs
+    // them, which applications that never use them pay for.
+    ANGLE_FEATURE_CONDITION((&mFeatures), warmUpUtilsPipelines, false)
+
+    ANGLE_FEATURE_CONDITION((&mFeatures), cacheShaderSpirv, true)
+
     angle::PlatformMethods *platform = ANGLEPlatformCurrent();
     platform->overrideFeaturesVk(platform, &mFeatures);
 }
@@ -1371,6 +1421,66 @@ void RendererVk::initPipelineCacheVkKey()
                                hashString.length(), mPipelineCacheVkBlobKey.data());
 }
 
+void RendererVk::initFormatPropertiesBlobKey()
+{
+    // The format properties depend on the device and driver, and the ANGLE version determines
+    // which formats are probed and how workarounds are applied.
+    std::ostringstream hashStream("ANGLE Format Properties: ", std::ios_base::ate);
+    hashStream << ANGLE_COMMIT_HASH;
+    hashStream << std::hex << mPhysicalDeviceProperties.vendorID;
+    hashStream << std::hex << mPhysicalDeviceProperties.deviceID;
+    hashStream << std::hex << mPhysicalDeviceProperties.driverVersion;
+    hashStream << std::hex << mPhysicalDeviceProperties.apiVersion;
+    hashStream << mFeatures.forceD16TexFilter.enabled;
+
+    const std::string &hashString = hashStream.str();
+    angle::base::SHA1HashBytes(reinterpret_cast<const unsigned char *>(hashString.c_str()),
+                               hashString.length(), mFormatPropertiesBlobKey.data());
+}
+
+bool RendererVk::loadFormatPropertiesFromBlobCache(DisplayVk *displayVk)
+{
+    egl::BlobCache::Value blob;
+    if (!displayVk->getBlobCache()->get(displayVk->getScratchBuffer(), mFormatPropertiesBlobKey,
+                                        &blob))
+    {
+        return false;
+    }
+
+    constexpr size_t kPropertiesSize = sizeof(VkFormatProperties) * vk::kNumVkFormats;
+    uint32_t version                 = 0;
+    if (blob.size() != sizeof(version) + kPropertiesSize)
+    {
+        return false;
+    }
+
+    memcpy(&version, blob.data(), sizeof(version));
+    if (version != kFormatPropertiesBlobVersion)
+    {
+        return false;
+    }
+
+    memcpy(mFormatProperties.data(), blob.data() + sizeof(version), kPropertiesSize);
+    return true;
+}
+
+void RendererVk::storeFormatPropertiesToBlobCache(DisplayVk *displayVk)
+{
+    constexpr size_t kPropertiesSize = sizeof(VkFormatProperties) * vk::kNumVkFormats;
+
+    angle::MemoryBuffer blob;
+    if (!blob.resize(sizeof(kFormatPropertiesBlobVersion) + kPropertiesSize))
+    {
+        return;
+    }
+
+    memcpy(blob.data(), &kFormatPropertiesBlobVersion, sizeof(kFormatPropertiesBlobVersion));
+    memcpy(blob.data() + sizeof(kFormatPropertiesBlobVersion), mFormatProperties.data(),
+           kPropertiesSize);
+
+    displayVk->getBlobCache()->put(mFormatPropertiesBlobKey, std::move(blob));
+}
+
 angle::Result RendererVk::initPipelineCache(DisplayVk *display,
                                             vk::PipelineCache *pipelineCache,
                                             bool *success)
@@ -1478,6 +1588,10 @@ angle::Result RendererVk::syncPipelineCacheVk(DisplayVk *displayVk)
 
     mPipelineCacheVkUpdateTimeout = kPipelineCacheVkUpdatePeriod;
 
+    // Cleared before the cache data is read, so that pipelines created meanwhile by the warm-up
+    // task mark the cache dirty again.
+    mPipelineCacheDirty = false;
+
     // Get the size of the cache.
     size_t pipelineCacheSize = 0;
     VkResult result          = mPipelineCache.getCacheData(mDevice, &pipelineCacheSize, nullptr);
@@ -1508,14 +1622,45 @@ angle::Result RendererVk::syncPipelineCacheVk(DisplayVk *displayVk)
     }
 
     displayVk->getBlobCache()->putApplication(mPipelineCacheVkBlobKey, *pipelineCacheData);
-    mPipelineCacheDirty = false;
 
     return angle::Result::Continue;
 }
 
-Serial RendererVk::issueShaderSerial()
+Serial RendererVk::getShaderSerial(const uint32_t *shaderCode, size_t shaderCodeSize)
 {
-    return mShaderSerialFactory.generate();
+    egl::BlobCache::Key hash;
+    angle::base::SHA1HashBytes(reinterpret_cast<const unsigned char *>(shaderCode),
+                               shaderCodeSize, hash.data());
+
+    std::lock_guard<decltype(mShaderSerialMutex)> lock(mShaderSerialMutex);
+    auto iter = mShaderSerials.find(hash);
+    if (iter != mShaderSerials.end())
+    {
+        iter->second.moduleCount++;
+        return iter->second.serial;
+    }
+
+    Serial serial = mShaderSerialFactory.generate();
+    mShaderSerials.emplace(hash, ShaderSerial{serial, 1});
+    mShaderSerialHashes.emplace(serial.getValue(), hash);
+    return serial;
+}
+
+void RendererVk::releaseShaderSerial(Serial serial)
+{
+    std::lock_guard<decltype(mShaderSerialMutex)> lock(mShaderSerialMutex);
+    auto hashIter = mShaderSerialHashes.find(serial.getValue());
+    ASSERT(hashIter != mShaderSerialHashes.end());
+
+    auto iter = mShaderSerials.find(hashIter->second);
+    ASSERT(iter != mShaderSerials.end() && iter->second.moduleCount > 0);
+    if (--iter->second.moduleCount == 0)
+    {
+        // Serials are never reused, so a module created later with the same SPIR-V gets a new
+        // one.
+        mShaderSerials.erase(iter);
+        mShaderSerialHashes.erase(hashIter);
+    }
 }
 
 // These functions look at the mandatory format for support, and fallback to querying the device (if
@@ -1547,6 +1692,13 @@ angle::Result RendererVk::queueSubmit(vk::Context *context,
                                       const vk::Fence &fence,
                                       Serial *serialOut)
 {
+    if (mCommandProcessor.isRunning())
+    {
+        // The serial is assigned right away so resources can be tagged with it.  Waiting for the
+        // fence works before the submission thread gets to the submission too.
+        ANGLE_VK_TRY(context, mCommandProcessor.enqueueSubmit(submitInfo, fence.getHandle()));
+    }
+    else
     {
         std::lock_guard<decltype(mQueueMutex)> lock(mQueueMutex);
         ANGLE_VK_TRY(context, vkQueueSubmit(mQueue, 1, &submitInfo, fence.getHandle()));
@@ -1563,6 +1715,11 @@ angle::Result RendererVk::queueSubmit(vk::Context *context,
 
 angle::Result RendererVk::queueWaitIdle(vk::Context *context)
 {
+    if (mCommandProcessor.isRunning())
+    {
+        ANGLE_VK_TRY(context, mCommandProcessor.waitForIdle());
+    }
+
     {
         std::lock_guard<decltype(mQueueMutex)> lock(mQueueMutex);
         ANGLE_VK_TRY(context, vkQueueWaitIdle(mQueue));
@@ -1573,10 +1730,26 @@ angle::Result RendererVk::queueWaitIdle(vk::Context *context)
     return angle::Result::Continue;
 }
 
+angle::Result RendererVk::waitForCommandProcessorIdle(vk::Context *context)
+{
+    if (mCommandProcessor.isRunning())
+    {
+        ANGLE_VK_TRY(context, mCommandProcessor.waitForIdle());
+    }
+
+    return angle::Result::Continue;
+}
+
 VkResult RendererVk::queuePresent(const VkPresentInfoKHR &presentInfo)
 {
     ANGLE_TRACE_EVENT0("gpu.angle", "RendererVk::queuePresent");
 
+    if (mCommandProcessor.isRunning())
+    {
+        // The present has to be ordered after the submissions that signal its wait semaphore.
+        return mCommandProcessor.enqueuePresentAndWait(presentInfo);
+    }
+
     std::lock_guard<decltype(mQueueMutex)> lock(mQueueMutex);
 
     {
@@ -11,6 +11,7 @@
 #define LIBANGLE_RENDERER_VULKAN_RENDERERVK_H_
 
 #include <vulkan/vulkan.h>
+#include <atomic>
 #include <memory>
 #include <mutex>
 
@@ -18,7 +19,10 @@
 #include "common/angleutils.h"
 #include "libANGLE/BlobCache.h"
 #include "libANGLE/Caps.h"
+#include "libANGLE/WorkerThread.h"
+#include "libANGLE/renderer/glslang_wrapper_utils.h"
 #include "libANGLE/renderer/vulkan/CommandGraph.h"
+#include "libANGLE/renderer/vulkan/CommandProcessor.h"
 #include "libANGLE/renderer/vulkan/QueryVk.h"
 #include "libANGLE/renderer/vulkan/UtilsVk.h"
 #include "libANGLE/renderer/vulkan/vk_format_utils.h"
@@ -129,8 +133,22 @@ class RendererVk : angle::NonCopyable
 
     angle::Result syncPipelineCacheVk(DisplayVk *displayVk);
 
-    // Issues a new serial for linked shader modules. Used in the pipeline cache.
-    Serial issueShaderSerial();
+    // Returns the serial of a shader module with the given SPIR-V.  Modules with the same SPIR-V
+    // get the same serial, which lets programs with identical shaders share their pipelines.  The
+    // serial is forgotten once every module it was returned for is released with
+    // releaseShaderSerial.
+    Serial getShaderSerial(const uint32_t *shaderCode, size_t shaderCodeSize);
+    void releaseShaderSerial(Serial serial);
+
+    // Render passes and graphics pipelines are shared by all contexts.
+    RenderPassCache &getRenderPassCache() { return mRenderPassCache; }
+    SharedGraphicsPipelineCache &getSharedGraphicsPipelineCache()
+    {
+        return mSharedGraphicsPipelineCache;
+    }
+
+    // The SPIR-V of the shaders linked so far, shared by all contexts.
+    GlslangSpirvCache &getSpirvCache() { return mSpirvCache; }
 
     const angle::FeaturesVk &getFeatures() const
     {
@@ -155,6 +173,8 @@ class RendererVk : angle::NonCopyable
                               const vk::Fence &fence,
                               Serial *serialOut);
     angle::Result queueWaitIdle(vk::Context *context);
+    // Makes sure previous queueSubmit calls have reached the VkQueue, for consumers outside ANGLE.
+    angle::Result waitForCommandProcessorIdle(vk::Context *context);
     VkResult queuePresent(const VkPresentInfoKHR &presentInfo);
 
     angle::Result newSharedFence(vk::Context *context, vk::Shared<vk::Fence> *sharedFenceOut);
@@ -181,12 +201,42 @@ class RendererVk : angle::NonCopyable
         use->init();
     }
 
+    // Destroys |garbageIn| once the submission with |serial| has completed.  This is for objects
+    // used by several contexts, whose uses are not tracked by any one command graph.
+    template <typename... ArgsT>
+    void collectGarbageAfterSerial(Serial serial, ArgsT... garbageIn)
+    {
+        std::vector<vk::GarbageObject> sharedGarbage;
+        CollectGarbage(&sharedGarbage, garbageIn...);
+        if (sharedGarbage.empty())
+        {
+            return;
+        }
+
+        vk::SharedResourceUse use;
+        use.init();
+        vk::SharedResourceUse submittedUse;
+        submittedUse.set(use);
+        submittedUse.releaseAndUpdateSerial(serial);
+
+        std::lock_guard<decltype(mGarbageMutex)> lock(mGarbageMutex);
+        mSharedGarbage.emplace_back(std::move(use), std::move(sharedGarbage));
+    }
+
     static constexpr size_t kMaxExtensionNames = 200;
     using ExtensionNameList = angle::FixedVector<const char *, kMaxExtensionNames>;
 
     angle::Result getPipelineCache(vk::PipelineCache **pipelineCache);
     void onNewGraphicsPipeline() { mPipelineCacheDirty = true; }
 
+    // The internal utility pipelines are warmed up once per renderer, by the first context created
+    // with the warmUpUtilsPipelines feature.  Returns true for that context only.
+    bool beginUtilsPipelinesWarmUp() { return !mUtilsPipelinesWarmUpStarted.exchange(true); }
+    std::shared_ptr<angle::WorkerThreadPool> getWorkerThreadPool() const
+    {
+        return mWorkerThreadPool;
+    }
+
     void onNewValidationMessage(const std::string &message);
     std::string getAndClearLastValidationMessage(uint32_t *countSinceLastClear);
 
@@ -208,6 +258,9 @@ class RendererVk : angle::NonCopyable
 
     void initFeatures(const ExtensionNameList &extensions);
     void initPipelineCacheVkKey();
+    void initFormatPropertiesBlobKey();
+    bool loadFormatPropertiesFromBlobCache(DisplayVk *displayVk);
+    void storeFormatPropertiesToBlobCache(DisplayVk *displayVk);
     angle::Result initPipelineCache(DisplayVk *display,
                                     vk::PipelineCache *pipelineCache,
                                     bool *success);
@@ -243,6 +296,8 @@ class RendererVk : angle::NonCopyable
     std::vector<VkQueueFamilyProperties> mQueueFamilyProperties;
     std::mutex mQueueMutex;
     VkQueue mQueue;
+    // Runs the queue submissions and presents when the asyncCommandQueue feature is enabled.
+    vk::CommandProcessor mCommandProcessor;
     uint32_t mCurrentQueueFamilyIndex;
     uint32_t mMaxVertexAttribDivisor;
     VkDevice mDevice;
@@ -264,15 +319,23 @@ class RendererVk : angle::NonCopyable
     vk::FormatTable mFormatTable;
 
     // All access to the pipeline cache is done through EGL objects so it is thread safe to not use
-    // a lock.
+    // a lock.  The exception is the utility pipeline warm-up, which creates pipelines with it on
+    // the worker thread pool and marks it dirty from there.
     vk::PipelineCache mPipelineCache;
     egl::BlobCache::Key mPipelineCacheVkBlobKey;
     uint32_t mPipelineCacheVkUpdateTimeout;
-    bool mPipelineCacheDirty;
+    std::atomic<bool> mPipelineCacheDirty;
     bool mPipelineCacheInitialized;
 
-    // A cache of VkFormatProperties as queried from the device over time.
+    // Runs work that isn't tied to a context, such as the utility pipeline warm-up.  Only created
+    // if the warmUpUtilsPipelines feature is enabled.
+    std::shared_ptr<angle::WorkerThreadPool> mWorkerThreadPool;
+    std::atomic<bool> mUtilsPipelinesWarmUpStarted;
+
+    // A cache of VkFormatProperties as queried from the device over time.  A snapshot of it is
+    // kept in the blob cache so that re-initialization on the same device skips the probing.
     std::array<VkFormatProperties, vk::kNumVkFormats> mFormatProperties;
+    egl::BlobCache::Key mFormatPropertiesBlobKey;
 
     // ANGLE uses a PipelineLayout cache to store compatible pipeline layouts.
     std::mutex mPipelineLayoutCacheMutex;
@@ -282,6 +345,24 @@ class RendererVk : angle::NonCopyable
     std::mutex mDescriptorSetLayoutCacheMutex;
     DescriptorSetLayoutCache mDescriptorSetLayoutCache;
 
+    // Render passes and graphics pipelines are looked up from any context, and the caches do their
+    // own locking.
+    RenderPassCache mRenderPassCache;
+    SharedGraphicsPipelineCache mSharedGraphicsPipelineCache;
+
+    // The serials given to shader modules, by the SHA-1 of their SPIR-V, and the number of modules
+    // using each.  The shaders of UtilsVk are never released, but there is a fixed number of them.
+    struct ShaderSerial
+    {
+        Serial serial;
+        uint32_t moduleCount;
+    };
+    std::mutex mShaderSerialMutex;
+    std::unordered_map<egl::BlobCache::Key, ShaderSerial> mShaderSerials;
+    std::unordered_map<uint64_t, egl::BlobCache::Key> mShaderSerialHashes;
+
+    GlslangSpirvCache mSpirvCache;
+
     // Latest validation data for debug overlay.
     std::string mLastValidationMessage;
     uint32_t mValidationMessageCount;
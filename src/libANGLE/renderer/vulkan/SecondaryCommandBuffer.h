@@ -47,6 +47,7 @@ enum class CommandID : uint16_t
     DispatchIndirect,
     Draw,
     DrawIndexed,
+    DrawIndexedBaseVertex,
     DrawIndexedInstanced,
     DrawIndexedInstancedBaseVertexBaseInstance,
     DrawInstanced,
@@ -215,6 +216,13 @@ struct DrawIndexedParams
 };
 VERIFY_4_BYTE_ALIGNMENT(DrawIndexedParams)
 
+struct DrawIndexedBaseVertexParams
+{
+    uint32_t indexCount;
+    uint32_t vertexOffset;
+};
+VERIFY_4_BYTE_ALIGNMENT(DrawIndexedBaseVertexParams)
+
 struct DrawIndexedInstancedParams
 {
     uint32_t indexCount;
@@ -478,6 +486,7 @@ class SecondaryCommandBuffer final : angle::NonCopyable
     void draw(uint32_t vertexCount, uint32_t firstVertex);
 
     void drawIndexed(uint32_t indexCount);
+    void drawIndexedBaseVertex(uint32_t indexCount, uint32_t vertexOffset);
 
     void drawIndexedInstanced(uint32_t indexCount, uint32_t instanceCount);
     void drawIndexedInstancedBaseVertexBaseInstance(uint32_t indexCount,
@@ -597,6 +606,9 @@ class SecondaryCommandBuffer final : angle::NonCopyable
     static bool CanKnowIfEmpty() { return true; }
     bool empty() const { return mCommands.size() == 0 || mCommands[0]->id == CommandID::Invalid; }
 
+    // Number of barrier commands recorded so far.
+    uint32_t getPipelineBarrierCount() const { return mPipelineBarrierCount; }
+
   private:
     template <class StructType>
     ANGLE_INLINE StructType *commonInit(CommandID cmdID, size_t allocationSize)
@@ -677,10 +689,15 @@ class SecondaryCommandBuffer final : angle::NonCopyable
 
     uint8_t *mCurrentWritePointer;
     size_t mCurrentBytesRemaining;
+
+    uint32_t mPipelineBarrierCount;
 };
 
 ANGLE_INLINE SecondaryCommandBuffer::SecondaryCommandBuffer()
-    : mAllocator(nullptr), mCurrentWritePointer(nullptr), mCurrentBytesRemaining(0)
+    : mAllocator(nullptr),
+      mCurrentWritePointer(nullptr),
+      mCurrentBytesRemaining(0),
+      mPipelineBarrierCount(0)
 {}
 ANGLE_INLINE SecondaryCommandBuffer::~SecondaryCommandBuffer() {}
 
@@ -920,6 +937,15 @@ ANGLE_INLINE void SecondaryCommandBuffer::drawIndexed(uint32_t indexCount)
     paramStruct->indexCount        = indexCount;
 }
 
+ANGLE_INLINE void SecondaryCommandBuffer::drawIndexedBaseVertex(uint32_t indexCount,
+                                                                uint32_t vertexOffset)
+{
+    DrawIndexedBaseVertexParams *paramStruct =
+        initCommand<DrawIndexedBaseVertexParams>(CommandID::DrawIndexedBaseVertex);
+    paramStruct->indexCount   = indexCount;
+    paramStruct->vertexOffset = vertexOffset;
+}
+
 ANGLE_INLINE void SecondaryCommandBuffer::drawIndexedInstanced(uint32_t indexCount,
                                                                uint32_t instanceCount)
 {
@@ -1006,6 +1032,7 @@ ANGLE_INLINE void SecondaryCommandBuffer::executionBarrier(VkPipelineStageFlags
     ExecutionBarrierParams *paramStruct =
         initCommand<ExecutionBarrierParams>(CommandID::ExecutionBarrier);
     paramStruct->stageMask = stageMask;
+    ++mPipelineBarrierCount;
 }
 
 ANGLE_INLINE void SecondaryCommandBuffer::fillBuffer(const Buffer &dstBuffer,
@@ -1029,6 +1056,7 @@ ANGLE_INLINE void SecondaryCommandBuffer::imageBarrier(
     paramStruct->srcStageMask       = srcStageMask;
     paramStruct->dstStageMask       = dstStageMask;
     paramStruct->imageMemoryBarrier = *imageMemoryBarrier;
+    ++mPipelineBarrierCount;
 }
 
 ANGLE_INLINE void SecondaryCommandBuffer::memoryBarrier(VkPipelineStageFlags srcStageMask,
@@ -1039,6 +1067,7 @@ ANGLE_INLINE void SecondaryCommandBuffer::memoryBarrier(VkPipelineStageFlags src
     paramStruct->srcStageMask        = srcStageMask;
     paramStruct->dstStageMask        = dstStageMask;
     paramStruct->memoryBarrier       = *memoryBarrier;
+    ++mPipelineBarrierCount;
 }
 
 ANGLE_INLINE void SecondaryCommandBuffer::pipelineBarrier(
@@ -1068,6 +1097,7 @@ ANGLE_INLINE void SecondaryCommandBuffer::pipelineBarrier(
     writePtr = storePointerParameter(writePtr, memoryBarriers, memBarrierSize);
     writePtr = storePointerParameter(writePtr, bufferMemoryBarriers, buffBarrierSize);
     storePointerParameter(writePtr, imageMemoryBarriers, imgBarrierSize);
+    ++mPipelineBarrierCount;
 }
 
 ANGLE_INLINE void SecondaryCommandBuffer::pushConstants(const PipelineLayout &layout,
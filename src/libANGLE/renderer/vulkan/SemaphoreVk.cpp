@@ -78,7 +78,10 @@ angle::Result SemaphoreVk::signal(gl::Context *context,
         UNIMPLEMENTED();
     }
 
-    return contextVk->flushImpl(&mSemaphore);
+    ANGLE_TRY(contextVk->flushImpl(&mSemaphore));
+
+    // The semaphore can be waited on by another API as soon as this returns.
+    return contextVk->getRenderer()->waitForCommandProcessorIdle(contextVk);
 }
 
 angle::Result SemaphoreVk::importOpaqueFd(gl::Context *context, GLint fd)
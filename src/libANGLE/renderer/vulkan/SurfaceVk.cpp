@@ -1076,6 +1076,15 @@ angle::Result WindowSurfaceVk::present(ContextVk *contextVk,
     image.image.changeLayout(VK_IMAGE_ASPECT_COLOR_BIT, vk::ImageLayout::Present,
                              transitionCommands);
 
+    // The contents of the depth/stencil buffer are undefined after swap, so the render pass that
+    // last drew to it doesn't need to store it.
+    if (mDepthStencilImage.valid())
+    {
+        const angle::Format &depthStencilFormat = mDepthStencilImage.getFormat().imageFormat();
+        mDepthStencilRenderTarget.onContentsUndefined(
+            contextVk, vk::GetDepthStencilAspectFlags(depthStencilFormat));
+    }
+
     // Knowing that the kSwapHistorySize'th submission ago has finished, we can know that the
     // (kSwapHistorySize+1)'th present ago of this image is definitely finished and so its wait
     // semaphore can be reused.  See doc/PresentSemaphores.md for details.
@@ -1438,6 +1447,9 @@ angle::Result WindowSurfaceVk::updateAndDrawOverlay(ContextVk *contextVk,
     ANGLE_TRY(overlayVk->onPresent(contextVk, &image->image, &image->imageView));
 
     overlay->getRunningGraphWidget(gl::WidgetId::VulkanCommandGraphSize)->next();
+    overlay->getRunningGraphWidget(gl::WidgetId::VulkanRenderPassStoreBytesSaved)->next();
+    overlay->getRunningGraphWidget(gl::WidgetId::VulkanRenderPassGpuTime)->next();
+    overlay->getRunningGraphWidget(gl::WidgetId::VulkanInternalGpuTime)->next();
 
     return angle::Result::Continue;
 }
@@ -363,18 +363,60 @@ void CalculateResolveOffset(const UtilsVk::BlitResolveParameters &params, int32_
     offset[0] = params.destOffset[0] - params.srcOffset[0] * srcOffsetFactorX;
     offset[1] = params.destOffset[1] - params.srcOffset[1] * srcOffsetFactorY;
 }
+
+// Used by the warm-up task to create graphics pipelines.  A pipeline that fails to be created is
+// created on first use instead, so errors are ignored.
+class WarmUpContext final : public vk::Context
+{
+  public:
+    explicit WarmUpContext(RendererVk *renderer) : vk::Context(renderer) {}
+
+    void handleError(VkResult result,
+                     const char *file,
+                     const char *function,
+                     unsigned int line) override
+    {}
+};
 }  // namespace
 
 UtilsVk::ConvertVertexShaderParams::ConvertVertexShaderParams() = default;
 
 UtilsVk::ImageCopyShaderParams::ImageCopyShaderParams() = default;
 
+// Creates the warm-up pipelines on the renderer's worker thread pool.
+class UtilsVk::WarmUpTask final : public angle::Closure
+{
+  public:
+    WarmUpTask(UtilsVk *utils, RendererVk *renderer, const vk::PipelineCache *pipelineCache)
+        : mUtils(utils), mRenderer(renderer), mPipelineCache(pipelineCache)
+    {}
+
+    void operator()() override { mUtils->createWarmUpPipelines(mRenderer, mPipelineCache); }
+
+  private:
+    UtilsVk *mUtils;
+    RendererVk *mRenderer;
+    const vk::PipelineCache *mPipelineCache;
+};
+
 UtilsVk::UtilsVk() = default;
 
 UtilsVk::~UtilsVk() = default;
 
 void UtilsVk::destroy(VkDevice device)
 {
+    if (mWarmUpEvent)
+    {
+        mWarmUpEvent->wait();
+        mWarmUpEvent.reset();
+    }
+    for (WarmUpPipeline &warmUp : mWarmUpPipelines)
+    {
+        warmUp.pipeline.destroy(device);
+    }
+    mWarmUpPipelines.clear();
+    mWarmUpGraphicsPipelines.clear();
+
     for (Function f : angle::AllEnums<Function>())
     {
         for (auto &descriptorSetLayout : mDescriptorSetLayouts[f])
@@ -427,6 +469,212 @@ void UtilsVk::destroy(VkDevice device)
     mLinearSampler.destroy(device);
 }
 
+angle::Result UtilsVk::warmUpPipelines(ContextVk *contextVk)
+{
+    ASSERT(!mWarmUpEvent && mWarmUpPipelines.empty() && mWarmUpGraphicsPipelines.empty());
+
+    vk::ShaderLibrary &shaderLibrary            = contextVk->getShaderLibrary();
+    vk::RefCounted<vk::ShaderAndSerial> *shader = nullptr;
+
+    // Index conversion, used by draws with GL_UNSIGNED_BYTE indices.
+    ANGLE_TRY(ensureConvertIndexResourcesInitialized(contextVk));
+    const uint32_t kConvertIndexFlags[] = {
+        0, vk::InternalShader::ConvertIndex_comp::kIsPrimitiveRestartEnabled};
+    for (uint32_t flags : kConvertIndexFlags)
+    {
+        ANGLE_TRY(shaderLibrary.getConvertIndex_comp(contextVk, flags, &shader));
+        addWarmUpPipeline(Function::ConvertIndexBuffer, shader, &mConvertIndexPrograms[flags]);
+    }
+
+    // Vertex conversion of the normalized and fixed-point formats, the most common ones to lack
+    // native support.
+    ANGLE_TRY(ensureConvertVertexResourcesInitialized(contextVk));
+    const uint32_t kConvertVertexConversions[] = {ConvertVertex_comp::kUnormToFloat,
+                                                  ConvertVertex_comp::kSnormToFloat,
+                                                  ConvertVertex_comp::kFixedToFloat};
+    for (uint32_t conversion : kConvertVertexConversions)
+    {
+        for (uint32_t flags : {conversion, conversion | ConvertVertex_comp::kIsAligned})
+        {
+            ANGLE_TRY(shaderLibrary.getConvertVertex_comp(contextVk, flags, &shader));
+            addWarmUpPipeline(Function::ConvertVertexBuffer, shader,
+                              &mConvertVertexPrograms[flags]);
+        }
+    }
+
+    // Masked clears, copies, blits and resolves into single-sampled RGBA8 and BGRA8 color
+    // attachments, the formats of window surfaces and most render targets.  The states match those
+    // set by clearFramebuffer, copyImage and blitResolveImpl, except for the viewport and scissor
+    // which depend on each use.
+    ANGLE_TRY(ensureImageClearResourcesInitialized(contextVk));
+    ANGLE_TRY(ensureImageCopyResourcesInitialized(contextVk));
+    ANGLE_TRY(ensureBlitResolveResourcesInitialized(contextVk));
+
+    vk::RefCounted<vk::ShaderAndSerial> *vertexShader = nullptr;
+    ANGLE_TRY(shaderLibrary.getFullScreenQuad_vert(contextVk, 0, &vertexShader));
+
+    constexpr VkColorComponentFlags kAllColorComponents =
+        VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT |
+        VK_COLOR_COMPONENT_A_BIT;
+    const gl::Rectangle kWarmUpArea(0, 0, 1, 1);
+
+    VkViewport viewport;
+    gl_vk::GetViewport(kWarmUpArea, 0.0f, 1.0f, false, kWarmUpArea.height, &viewport);
+
+    const angle::FormatID kColorFormats[] = {angle::FormatID::R8G8B8A8_UNORM,
+                                             angle::FormatID::B8G8R8A8_UNORM};
+    for (angle::FormatID formatID : kColorFormats)
+    {
+        vk::RenderPassDesc renderPassDesc;
+        renderPassDesc.setSamples(1);
+        renderPassDesc.packColorAttachment(0, formatID);
+
+        vk::GraphicsPipelineDesc pipelineDesc;
+        pipelineDesc.initDefaults();
+        pipelineDesc.setCullMode(VK_CULL_MODE_NONE);
+        pipelineDesc.setRenderPassDesc(renderPassDesc);
+        pipelineDesc.setViewport(viewport);
+        pipelineDesc.setScissor(gl_vk::GetRect(kWarmUpArea));
+
+        // Clears that write every channel use a clear command instead.
+        ANGLE_TRY(shaderLibrary.getImageClear_frag(
+            contextVk, GetImageClearFlags(angle::Format::Get(formatID), 0), &shader));
+        vk::GraphicsPipelineDesc clearDesc = pipelineDesc;
+        clearDesc.setColorWriteMask(0, gl::DrawBufferMask());
+        clearDesc.setDepthWriteEnabled(false);
+        for (VkColorComponentFlags colorMask = 1; colorMask < kAllColorComponents; ++colorMask)
+        {
+            clearDesc.setSingleColorWriteMask(0, colorMask);
+            ANGLE_TRY(addWarmUpGraphicsPipeline(contextVk, Function::ImageClear, vertexShader,
+                                                shader, clearDesc));
+        }
+
+        ANGLE_TRY(shaderLibrary.getImageCopy_frag(
+            contextVk, ImageCopy_frag::kSrcIsFloat | ImageCopy_frag::kDestIsFloat, &shader));
+        ANGLE_TRY(addWarmUpGraphicsPipeline(contextVk, Function::ImageCopy, vertexShader, shader,
+                                            pipelineDesc));
+
+        vk::GraphicsPipelineDesc blitResolveDesc = pipelineDesc;
+        blitResolveDesc.setColorWriteMask(kAllColorComponents, gl::DrawBufferMask());
+        blitResolveDesc.setDepthTestEnabled(false);
+        blitResolveDesc.setDepthWriteEnabled(false);
+        blitResolveDesc.setDepthFunc(VK_COMPARE_OP_ALWAYS);
+        const uint32_t kBlitResolveFlags[] = {
+            BlitResolve_frag::kBlitColorFloat,
+            BlitResolve_frag::kBlitColorFloat | BlitResolve_frag::kIsResolve};
+        for (uint32_t flags : kBlitResolveFlags)
+        {
+            ANGLE_TRY(shaderLibrary.getBlitResolve_frag(contextVk, flags, &shader));
+            ANGLE_TRY(addWarmUpGraphicsPipeline(contextVk, Function::BlitResolve, vertexShader,
+                                                shader, blitResolveDesc));
+        }
+    }
+
+    // The pipeline cache is created on this thread, as its initialization isn't thread-safe.
+    // Creating pipelines with it is.
+    RendererVk *renderer             = contextVk->getRenderer();
+    vk::PipelineCache *pipelineCache = nullptr;
+    ANGLE_TRY(renderer->getPipelineCache(&pipelineCache));
+
+    mWarmUpEvent = angle::WorkerThreadPool::PostWorkerTask(
+        renderer->getWorkerThreadPool(),
+        std::make_shared<WarmUpTask>(this, renderer, pipelineCache));
+
+    return angle::Result::Continue;
+}
+
+void UtilsVk::addWarmUpPipeline(Function function,
+                                vk::RefCounted<vk::ShaderAndSerial> *shader,
+                                vk::ShaderProgramHelper *program)
+{
+    ASSERT(function >= Function::ComputeStartIndex);
+
+    WarmUpPipeline warmUp;
+    warmUp.shader         = shader;
+    warmUp.program        = program;
+    warmUp.shaderModule   = shader->get().get().getHandle();
+    warmUp.pipelineLayout = mPipelineLayouts[function].get().getHandle();
+    mWarmUpPipelines.push_back(std::move(warmUp));
+}
+
+angle::Result UtilsVk::addWarmUpGraphicsPipeline(ContextVk *contextVk,
+                                                 Function function,
+                                                 vk::RefCounted<vk::ShaderAndSerial> *vertexShader,
+                                                 vk::RefCounted<vk::ShaderAndSerial> *fragmentShader,
+                                                 const vk::GraphicsPipelineDesc &pipelineDesc)
+{
+    ASSERT(function < Function::ComputeStartIndex);
+
+    WarmUpGraphicsPipeline warmUp;
+    warmUp.pipelineDesc   = pipelineDesc;
+    warmUp.pipelineLayout = &mPipelineLayouts[function].get();
+    warmUp.vertexModule   = &vertexShader->get().get();
+    warmUp.fragmentModule = &fragmentShader->get().get();
+    ANGLE_TRY(contextVk->getCompatibleRenderPass(pipelineDesc.getRenderPassDesc(),
+                                                 &warmUp.compatibleRenderPass));
+    mWarmUpGraphicsPipelines.push_back(warmUp);
+
+    return angle::Result::Continue;
+}
+
+void UtilsVk::createWarmUpPipelines(RendererVk *renderer, const vk::PipelineCache *pipelineCache)
+{
+    VkDevice device = renderer->getDevice();
+
+    for (WarmUpPipeline &warmUp : mWarmUpPipelines)
+    {
+        VkPipelineShaderStageCreateInfo shaderStage = {};
+        VkComputePipelineCreateInfo createInfo      = {};
+
+        shaderStage.sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        shaderStage.stage  = VK_SHADER_STAGE_COMPUTE_BIT;
+        shaderStage.module = warmUp.shaderModule;
+        shaderStage.pName  = "main";
+
+        createInfo.sType  = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+        createInfo.stage  = shaderStage;
+        createInfo.layout = warmUp.pipelineLayout;
+
+        // On failure, the pipeline is left invalid and is created on first use instead.
+        (void)warmUp.pipeline.initCompute(device, createInfo, *pipelineCache);
+    }
+
+    WarmUpContext context(renderer);
+    for (const WarmUpGraphicsPipeline &warmUp : mWarmUpGraphicsPipelines)
+    {
+        vk::Pipeline pipeline;
+        (void)warmUp.pipelineDesc.initializePipeline(
+            &context, *pipelineCache, *warmUp.compatibleRenderPass, *warmUp.pipelineLayout,
+            gl::AttributesMask(), gl::ComponentTypeMask(), warmUp.vertexModule,
+            warmUp.fragmentModule, nullptr, &pipeline);
+        pipeline.destroy(device);
+    }
+
+    // Have the new pipelines stored with the rest of the pipeline cache.
+    renderer->onNewGraphicsPipeline();
+}
+
+void UtilsVk::adoptWarmUpPipelines(VkDevice device)
+{
+    if (!mWarmUpEvent || !mWarmUpEvent->isReady())
+    {
+        return;
+    }
+
+    mWarmUpEvent->wait();
+    mWarmUpEvent.reset();
+    for (WarmUpPipeline &warmUp : mWarmUpPipelines)
+    {
+        if (warmUp.pipeline.valid())
+        {
+            warmUp.program->setShader(gl::ShaderType::Compute, warmUp.shader);
+            warmUp.program->setComputePipeline(device, std::move(warmUp.pipeline));
+        }
+    }
+    mWarmUpPipelines.clear();
+    mWarmUpGraphicsPipelines.clear();
+}
+
 angle::Result UtilsVk::ensureResourcesInitialized(ContextVk *contextVk,
                                                   Function function,
                                                   VkDescriptorPoolSize *setSizes,
@@ -722,6 +970,8 @@ angle::Result UtilsVk::setupProgram(ContextVk *contextVk,
 
     if (isCompute)
     {
+        adoptWarmUpPipelines(contextVk->getDevice());
+
         vk::PipelineAndSerial *pipelineAndSerial;
         program->setShader(gl::ShaderType::Compute, fsCsShader);
         ANGLE_TRY(program->getComputePipeline(contextVk, pipelineLayout.get(), &pipelineAndSerial));
@@ -804,11 +1054,14 @@ angle::Result UtilsVk::clearBuffer(ContextVk *contextVk,
     vk::RefCounted<vk::ShaderAndSerial> *shader = nullptr;
     ANGLE_TRY(contextVk->getShaderLibrary().getBufferUtils_comp(contextVk, flags, &shader));
 
+    ANGLE_TRY(contextVk->getGpuProfiler().beginScope(
+        contextVk, vk::GpuProfileCategory::BufferClear, commandBuffer));
     ANGLE_TRY(setupProgram(contextVk, Function::BufferClear, shader, nullptr,
                            &mBufferUtilsPrograms[flags], nullptr, descriptorSet, &shaderParams,
                            sizeof(shaderParams), commandBuffer));
 
     commandBuffer->dispatch(UnsignedCeilDivide(static_cast<uint32_t>(params.size), 64), 1, 1);
+    contextVk->getGpuProfiler().endScope(commandBuffer);
 
     descriptorPoolBinding.reset();
 
@@ -860,6 +1113,8 @@ angle::Result UtilsVk::convertIndexBuffer(ContextVk *contextVk,
     vk::RefCounted<vk::ShaderAndSerial> *shader = nullptr;
     ANGLE_TRY(contextVk->getShaderLibrary().getConvertIndex_comp(contextVk, flags, &shader));
 
+    ANGLE_TRY(contextVk->getGpuProfiler().beginScope(
+        contextVk, vk::GpuProfileCategory::ConvertIndexBuffer, commandBuffer));
     ANGLE_TRY(setupProgram(contextVk, Function::ConvertIndexBuffer, shader, nullptr,
                            &mConvertIndexPrograms[flags], nullptr, descriptorSet, &shaderParams,
                            sizeof(ConvertIndexShaderParams), commandBuffer));
@@ -870,6 +1125,7 @@ angle::Result UtilsVk::convertIndexBuffer(ContextVk *contextVk,
     const uint32_t kGroupCount =
         UnsignedCeilDivide(kIndexCount * kInvocationsPerIndex, kInvocationsPerGroup);
     commandBuffer->dispatch(kGroupCount, 1, 1);
+    contextVk->getGpuProfiler().endScope(commandBuffer);
 
     descriptorPoolBinding.reset();
 
@@ -925,6 +1181,8 @@ angle::Result UtilsVk::convertIndexIndirectBuffer(ContextVk *contextVk,
     vk::RefCounted<vk::ShaderAndSerial> *shader = nullptr;
     ANGLE_TRY(contextVk->getShaderLibrary().getConvertIndex_comp(contextVk, flags, &shader));
 
+    ANGLE_TRY(contextVk->getGpuProfiler().beginScope(
+        contextVk, vk::GpuProfileCategory::ConvertIndexBuffer, commandBuffer));
     ANGLE_TRY(setupProgram(contextVk, Function::ConvertIndexIndirectBuffer, shader, nullptr,
                            &mConvertIndexPrograms[flags], nullptr, descriptorSet, &shaderParams,
                            sizeof(ConvertIndexIndirectShaderParams), commandBuffer));
@@ -935,6 +1193,7 @@ angle::Result UtilsVk::convertIndexIndirectBuffer(ContextVk *contextVk,
     const uint32_t kGroupCount =
         UnsignedCeilDivide(kIndexCount * kInvocationsPerIndex, kInvocationsPerGroup);
     commandBuffer->dispatch(kGroupCount, 1, 1);
+    contextVk->getGpuProfiler().endScope(commandBuffer);
 
     descriptorPoolBinding.reset();
 
@@ -1001,11 +1260,14 @@ angle::Result UtilsVk::convertLineLoopIndexIndirectBuffer(
     ANGLE_TRY(contextVk->getShaderLibrary().getConvertIndexIndirectLineLoop_comp(contextVk, flags,
                                                                                  &shader));
 
+    ANGLE_TRY(contextVk->getGpuProfiler().beginScope(
+        contextVk, vk::GpuProfileCategory::ConvertIndexBuffer, commandBuffer));
     ANGLE_TRY(setupProgram(contextVk, Function::ConvertIndexIndirectLineLoopBuffer, shader, nullptr,
                            &mConvertIndexPrograms[flags], nullptr, descriptorSet, &shaderParams,
                            sizeof(ConvertIndexIndirectLineLoopShaderParams), commandBuffer));
 
     commandBuffer->dispatch(1, 1, 1);
+    contextVk->getGpuProfiler().endScope(commandBuffer);
 
     descriptorPoolBinding.reset();
 
@@ -1077,11 +1339,14 @@ angle::Result UtilsVk::convertVertexBuffer(ContextVk *contextVk,
     vk::RefCounted<vk::ShaderAndSerial> *shader = nullptr;
     ANGLE_TRY(contextVk->getShaderLibrary().getConvertVertex_comp(contextVk, flags, &shader));
 
+    ANGLE_TRY(contextVk->getGpuProfiler().beginScope(
+        contextVk, vk::GpuProfileCategory::ConvertVertexBuffer, commandBuffer));
     ANGLE_TRY(setupProgram(contextVk, Function::ConvertVertexBuffer, shader, nullptr,
                            &mConvertVertexPrograms[flags], nullptr, descriptorSet, &shaderParams,
                            sizeof(shaderParams), commandBuffer));
 
     commandBuffer->dispatch(UnsignedCeilDivide(shaderParams.outputCount, 64), 1, 1);
+    contextVk->getGpuProfiler().endScope(commandBuffer);
 
     descriptorPoolBinding.reset();
 
@@ -1196,10 +1461,13 @@ angle::Result UtilsVk::clearFramebuffer(ContextVk *contextVk,
         imageClearProgram = &mImageClearProgram[flags];
     }
 
+    ANGLE_TRY(contextVk->getGpuProfiler().beginScope(
+        contextVk, vk::GpuProfileCategory::ImageClear, commandBuffer));
     ANGLE_TRY(setupProgram(contextVk, Function::ImageClear, fragmentShader, vertexShader,
                            imageClearProgram, &pipelineDesc, VK_NULL_HANDLE, &shaderParams,
                            sizeof(shaderParams), commandBuffer));
     commandBuffer->draw(6, 0);
+    contextVk->getGpuProfiler().endScope(commandBuffer);
     return angle::Result::Continue;
 }
 
@@ -1433,10 +1701,13 @@ angle::Result UtilsVk::blitResolveImpl(ContextVk *contextVk,
     ANGLE_TRY(shaderLibrary.getFullScreenQuad_vert(contextVk, 0, &vertexShader));
     ANGLE_TRY(shaderLibrary.getBlitResolve_frag(contextVk, flags, &fragmentShader));
 
+    ANGLE_TRY(contextVk->getGpuProfiler().beginScope(
+        contextVk, vk::GpuProfileCategory::BlitResolve, commandBuffer));
     ANGLE_TRY(setupProgram(contextVk, Function::BlitResolve, fragmentShader, vertexShader,
                            &mBlitResolvePrograms[flags], &pipelineDesc, descriptorSet,
                            &shaderParams, sizeof(shaderParams), commandBuffer));
     commandBuffer->draw(6, 0);
+    contextVk->getGpuProfiler().endScope(commandBuffer);
     descriptorPoolBinding.reset();
 
     return angle::Result::Continue;
@@ -1563,6 +1834,8 @@ angle::Result UtilsVk::stencilBlitResolveNoShaderExport(ContextVk *contextVk,
     ANGLE_TRY(contextVk->getShaderLibrary().getBlitResolveStencilNoExport_comp(contextVk, flags,
                                                                                &shader));
 
+    ANGLE_TRY(contextVk->getGpuProfiler().beginScope(
+        contextVk, vk::GpuProfileCategory::BlitResolve, commandBuffer));
     ANGLE_TRY(setupProgram(contextVk, Function::BlitResolveStencilNoExport, shader, nullptr,
                            &mBlitResolveStencilNoExportPrograms[flags], nullptr, descriptorSet,
                            &shaderParams, sizeof(shaderParams), commandBuffer));
@@ -1607,6 +1880,7 @@ angle::Result UtilsVk::stencilBlitResolveNoShaderExport(ContextVk *contextVk,
     commandBuffer->copyBufferToImage(blitBuffer.get().getBuffer().getHandle(),
                                      depthStencilImage->getImage(),
                                      depthStencilImage->getCurrentLayout(), 1, &region);
+    contextVk->getGpuProfiler().endScope(commandBuffer);
 
     return angle::Result::Continue;
 }
@@ -1728,10 +2002,13 @@ angle::Result UtilsVk::copyImage(ContextVk *contextVk,
     ANGLE_TRY(shaderLibrary.getFullScreenQuad_vert(contextVk, 0, &vertexShader));
     ANGLE_TRY(shaderLibrary.getImageCopy_frag(contextVk, flags, &fragmentShader));
 
+    ANGLE_TRY(contextVk->getGpuProfiler().beginScope(
+        contextVk, vk::GpuProfileCategory::ImageCopy, commandBuffer));
     ANGLE_TRY(setupProgram(contextVk, Function::ImageCopy, fragmentShader, vertexShader,
                            &mImageCopyPrograms[flags], &pipelineDesc, descriptorSet, &shaderParams,
                            sizeof(shaderParams), commandBuffer));
     commandBuffer->draw(6, 0);
+    contextVk->getGpuProfiler().endScope(commandBuffer);
     descriptorPoolBinding.reset();
 
     return angle::Result::Continue;
@@ -1803,10 +2080,13 @@ angle::Result UtilsVk::cullOverlayWidgets(ContextVk *contextVk,
     vk::RefCounted<vk::ShaderAndSerial> *shader = nullptr;
     ANGLE_TRY(contextVk->getShaderLibrary().getOverlayCull_comp(contextVk, flags, &shader));
 
+    ANGLE_TRY(contextVk->getGpuProfiler().beginScope(
+        contextVk, vk::GpuProfileCategory::Overlay, commandBuffer));
     ANGLE_TRY(setupProgram(contextVk, Function::OverlayCull, shader, nullptr,
                            &mOverlayCullPrograms[flags], nullptr, descriptorSet, nullptr, 0,
                            commandBuffer));
     commandBuffer->dispatch(dest->getExtents().width, dest->getExtents().height, 1);
+    contextVk->getGpuProfiler().endScope(commandBuffer);
     descriptorPoolBinding.reset();
 
     dest->changeLayout(VK_IMAGE_ASPECT_COLOR_BIT, vk::ImageLayout::ComputeShaderReadOnly,
@@ -1909,6 +2189,8 @@ angle::Result UtilsVk::drawOverlay(ContextVk *contextVk,
     vk::RefCounted<vk::ShaderAndSerial> *shader = nullptr;
     ANGLE_TRY(contextVk->getShaderLibrary().getOverlayDraw_comp(contextVk, flags, &shader));
 
+    ANGLE_TRY(contextVk->getGpuProfiler().beginScope(
+        contextVk, vk::GpuProfileCategory::Overlay, commandBuffer));
     ANGLE_TRY(setupProgram(contextVk, Function::OverlayDraw, shader, nullptr,
                            &mOverlayDrawPrograms[flags], nullptr, descriptorSet, &shaderParams,
                            sizeof(shaderParams), commandBuffer));
@@ -1917,6 +2199,7 @@ angle::Result UtilsVk::drawOverlay(ContextVk *contextVk,
     // size.
     commandBuffer->dispatch(culledWidgets->getExtents().width, culledWidgets->getExtents().height,
                             1);
+    contextVk->getGpuProfiler().endScope(commandBuffer);
     descriptorPoolBinding.reset();
 
     return angle::Result::Continue;
@@ -26,6 +26,7 @@
 #ifndef LIBANGLE_RENDERER_VULKAN_UTILSVK_H_
 #define LIBANGLE_RENDERER_VULKAN_UTILSVK_H_
 
+#include "libANGLE/WorkerThread.h"
 #include "libANGLE/renderer/vulkan/vk_cache_utils.h"
 #include "libANGLE/renderer/vulkan/vk_helpers.h"
 #include "libANGLE/renderer/vulkan/vk_internal_shaders_autogen.h"
@@ -40,6 +41,12 @@ class UtilsVk : angle::NonCopyable
 
     void destroy(VkDevice device);
 
+    // Compiles the pipelines of the most common internal operations on the renderer's worker
+    // thread pool, so that their first use doesn't wait for the driver.  Used with the
+    // warmUpUtilsPipelines feature, by the first context of the renderer.  Later contexts find the
+    // pipelines in the renderer's pipeline cache.
+    angle::Result warmUpPipelines(ContextVk *contextVk);
+
     struct ClearParameters
     {
         VkClearColorValue clearValue;
@@ -406,6 +413,23 @@ class UtilsVk : angle::NonCopyable
 
     angle::Result ensureSamplersInitialized(ContextVk *context);
 
+    class WarmUpTask;
+
+    // Queues a compute pipeline for warmUpPipelines to create.
+    void addWarmUpPipeline(Function function,
+                           vk::RefCounted<vk::ShaderAndSerial> *shader,
+                           vk::ShaderProgramHelper *program);
+    // Queues a graphics pipeline for warmUpPipelines to create.  These are only created to fill
+    // the pipeline cache, as the viewport and scissor of the pipelines depend on each use.
+    angle::Result addWarmUpGraphicsPipeline(ContextVk *contextVk,
+                                            Function function,
+                                            vk::RefCounted<vk::ShaderAndSerial> *vertexShader,
+                                            vk::RefCounted<vk::ShaderAndSerial> *fragmentShader,
+                                            const vk::GraphicsPipelineDesc &pipelineDesc);
+    void createWarmUpPipelines(RendererVk *renderer, const vk::PipelineCache *pipelineCache);
+    // Hands the pipelines created by the worker task to their programs, once it has finished.
+    void adoptWarmUpPipelines(VkDevice device);
+
     angle::Result startRenderPass(ContextVk *contextVk,
                                   vk::ImageHelper *image,
                                   const vk::ImageView *imageView,
@@ -447,6 +471,29 @@ class UtilsVk : angle::NonCopyable
 
     vk::Sampler mPointSampler;
     vk::Sampler mLinearSampler;
+
+    // The pipelines being created by the warm-up task.  The handles are gathered before the task
+    // starts, and the task only writes the pipelines.
+    struct WarmUpPipeline
+    {
+        vk::RefCounted<vk::ShaderAndSerial> *shader;
+        vk::ShaderProgramHelper *program;
+        VkShaderModule shaderModule;
+        VkPipelineLayout pipelineLayout;
+        vk::Pipeline pipeline;
+    };
+    std::vector<WarmUpPipeline> mWarmUpPipelines;
+
+    struct WarmUpGraphicsPipeline
+    {
+        vk::GraphicsPipelineDesc pipelineDesc;
+        vk::RenderPass *compatibleRenderPass;
+        const vk::PipelineLayout *pipelineLayout;
+        const vk::ShaderModule *vertexModule;
+        const vk::ShaderModule *fragmentModule;
+    };
+    std::vector<WarmUpGraphicsPipeline> mWarmUpGraphicsPipelines;
+    std::shared_ptr<angle::WaitableEvent> mWarmUpEvent;
 };
 
 }  // namespace rx
@@ -171,6 +171,7 @@ angle::Result VertexArrayVk::convertIndexBufferGPU(ContextVk *contextVk,
                                                 nullptr, &mCurrentElementArrayBufferOffset,
                                                 nullptr));
     mCurrentElementArrayBuffer = mTranslatedByteIndexData.getCurrentBuffer();
+    mLineLoopBufferVertexCount.reset();
 
     vk::BufferHelper *dest = mTranslatedByteIndexData.getCurrentBuffer();
     vk::BufferHelper *src  = &bufferVk->getBuffer();
@@ -199,6 +200,7 @@ angle::Result VertexArrayVk::convertIndexBufferIndirectGPU(ContextVk *contextVk,
                                                 nullptr, &mCurrentElementArrayBufferOffset,
                                                 nullptr));
     mCurrentElementArrayBuffer = mTranslatedByteIndexData.getCurrentBuffer();
+    mLineLoopBufferVertexCount.reset();
 
     vk::BufferHelper *dest = mTranslatedByteIndexData.getCurrentBuffer();
     vk::BufferHelper *src  = &indexBufferVk->getBuffer();
@@ -225,6 +227,7 @@ angle::Result VertexArrayVk::handleLineLoopIndirect(ContextVk *contextVk,
         contextVk, glIndexType, mCurrentElementArrayBuffer, &indirectBufferVk->getBuffer(),
         indirectBufferOffset, &mCurrentElementArrayBuffer, &mCurrentElementArrayBufferOffset,
         indirectBufferOut, indirectBufferOffsetOut));
+    mLineLoopBufferVertexCount.reset();
 
     return angle::Result::Continue;
 }
@@ -252,6 +255,7 @@ angle::Result VertexArrayVk::convertIndexBufferCPU(ContextVk *contextVk,
     ANGLE_TRY(mDynamicIndexData.allocate(contextVk, amount, &dst, nullptr,
                                          &mCurrentElementArrayBufferOffset, nullptr));
     mCurrentElementArrayBuffer = mDynamicIndexData.getCurrentBuffer();
+    mLineLoopBufferVertexCount.reset();
     if (indexType == gl::DrawElementsType::UnsignedByte)
     {
         // Unsigned bytes don't have direct support in Vulkan so we have to expand the
@@ -411,16 +415,14 @@ angle::Result VertexArrayVk::syncState(const gl::Context *context,
                     mCurrentElementArrayBuffer = nullptr;
                 }
 
-                mLineLoopBufferFirstIndex.reset();
-                mLineLoopBufferLastIndex.reset();
+                mLineLoopBufferVertexCount.reset();
                 contextVk->setIndexBufferDirty();
                 mDirtyLineLoopTranslation = true;
                 break;
             }
 
             case gl::VertexArray::DIRTY_BIT_ELEMENT_ARRAY_BUFFER_DATA:
-                mLineLoopBufferFirstIndex.reset();
-                mLineLoopBufferLastIndex.reset();
+                mLineLoopBufferVertexCount.reset();
                 contextVk->setIndexBufferDirty();
                 mDirtyLineLoopTranslation = true;
                 break;
@@ -749,25 +751,22 @@ angle::Result VertexArrayVk::handleLineLoop(ContextVk *contextVk,
         // If we've had a drawArrays call with a line loop before, we want to make sure this is
         // invalidated the next time drawArrays is called since we use the same index buffer for
         // both calls.
-        mLineLoopBufferFirstIndex.reset();
-        mLineLoopBufferLastIndex.reset();
+        mLineLoopBufferVertexCount.reset();
         return angle::Result::Continue;
     }
 
     // Note: Vertex indexes can be arbitrarily large.
     uint32_t clampedVertexCount = gl::clampCast<uint32_t>(vertexOrIndexCount);
 
-    // Handle GL_LINE_LOOP drawArrays.
-    size_t lastVertex = static_cast<size_t>(firstVertex + clampedVertexCount);
-    if (!mLineLoopBufferFirstIndex.valid() || !mLineLoopBufferLastIndex.valid() ||
-        mLineLoopBufferFirstIndex != firstVertex || mLineLoopBufferLastIndex != lastVertex)
+    // Handle GL_LINE_LOOP drawArrays.  The indices don't depend on the first vertex, which is
+    // applied as the vertex offset of the draw.
+    if (mLineLoopBufferVertexCount != clampedVertexCount)
     {
-        ANGLE_TRY(mLineLoopHelper.getIndexBufferForDrawArrays(
-            contextVk, clampedVertexCount, firstVertex, &mCurrentElementArrayBuffer,
-            &mCurrentElementArrayBufferOffset));
+        ANGLE_TRY(mLineLoopHelper.getIndexBufferForDrawArrays(contextVk, clampedVertexCount,
+                                                              &mCurrentElementArrayBuffer,
+                                                              &mCurrentElementArrayBufferOffset));
 
-        mLineLoopBufferFirstIndex = firstVertex;
-        mLineLoopBufferLastIndex  = lastVertex;
+        mLineLoopBufferVertexCount = clampedVertexCount;
     }
     *indexCountOut = vertexOrIndexCount + 1;
 
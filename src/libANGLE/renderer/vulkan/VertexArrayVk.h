@@ -140,8 +140,7 @@ class VertexArrayVk : public VertexArrayImpl
     vk::DynamicBuffer mTranslatedByteIndexData;
 
     vk::LineLoopHelper mLineLoopHelper;
-    Optional<GLint> mLineLoopBufferFirstIndex;
-    Optional<size_t> mLineLoopBufferLastIndex;
+    Optional<uint32_t> mLineLoopBufferVertexCount;
     bool mDirtyLineLoopTranslation;
 
     // Vulkan does not allow binding a null vertex buffer. We use a dummy as a placeholder.
@@ -607,7 +607,7 @@ void GraphicsPipelineDesc::initDefaults()
 }
 
 angle::Result GraphicsPipelineDesc::initializePipeline(
-    ContextVk *contextVk,
+    vk::Context *context,
     const vk::PipelineCache &pipelineCacheVk,
     const RenderPass &compatibleRenderPass,
     const PipelineLayout &pipelineLayout,
@@ -698,7 +698,7 @@ angle::Result GraphicsPipelineDesc::initializePipeline(
 
         // Get the corresponding VkFormat for the attrib's format.
         angle::FormatID formatID         = static_cast<angle::FormatID>(packedAttrib.format);
-        const vk::Format &format         = contextVk->getRenderer()->getFormat(formatID);
+        const vk::Format &format         = context->getRenderer()->getFormat(formatID);
         const angle::Format &angleFormat = format.angleFormat();
         VkFormat vkFormat                = format.vkBufferFormat;
 
@@ -871,8 +871,8 @@ angle::Result GraphicsPipelineDesc::initializePipeline(
     createInfo.basePipelineHandle  = VK_NULL_HANDLE;
     createInfo.basePipelineIndex   = 0;
 
-    ANGLE_VK_TRY(contextVk,
-                 pipelineOut->initGraphics(contextVk->getDevice(), createInfo, pipelineCacheVk));
+    ANGLE_VK_TRY(context,
+                 pipelineOut->initGraphics(context->getDevice(), createInfo, pipelineCacheVk));
     return angle::Result::Continue;
 }
 
@@ -1518,6 +1518,37 @@ const PushConstantRangeArray<PackedPushConstantRange> &PipelineLayoutDesc::getPu
     return mPushConstantRanges;
 }
 
+// SharedGraphicsPipelineKey implementation.
+SharedGraphicsPipelineKey::SharedGraphicsPipelineKey(
+    const ShaderAndSerial *vertexShader,
+    const ShaderAndSerial *fragmentShader,
+    const ShaderAndSerial *geometryShader,
+    const PipelineLayout &pipelineLayout,
+    const gl::AttributesMask &activeAttribLocationsMask,
+    const gl::ComponentTypeMask &programAttribsTypeMask,
+    const GraphicsPipelineDesc &desc)
+    : mDesc(desc)
+{
+    mProgramKey.vertexShaderSerial   = vertexShader->getSerial().getValue();
+    mProgramKey.fragmentShaderSerial = fragmentShader ? fragmentShader->getSerial().getValue() : 0;
+    mProgramKey.geometryShaderSerial = geometryShader ? geometryShader->getSerial().getValue() : 0;
+    mProgramKey.pipelineLayout       = pipelineLayout.getHandle();
+    mProgramKey.activeAttribLocationsMask =
+        static_cast<uint32_t>(activeAttribLocationsMask.bits());
+    mProgramKey.programAttribsTypeMask = static_cast<uint32_t>(programAttribsTypeMask.bits());
+}
+
+size_t SharedGraphicsPipelineKey::hash() const
+{
+    return angle::ComputeGenericHash(mProgramKey) ^ mDesc.hash();
+}
+
+bool SharedGraphicsPipelineKey::operator==(const SharedGraphicsPipelineKey &other) const
+{
+    return memcmp(&mProgramKey, &other.mProgramKey, sizeof(ProgramKey)) == 0 &&
+           mDesc == other.mDesc;
+}
+
 // PipelineHelper implementation.
 PipelineHelper::PipelineHelper() = default;
 
@@ -1525,6 +1556,7 @@ PipelineHelper::~PipelineHelper() = default;
 
 void PipelineHelper::destroy(VkDevice device)
 {
+    ASSERT(!isShared());
     mPipeline.destroy(device);
 }
 
@@ -1589,26 +1621,59 @@ RenderPassCache::RenderPassCache() = default;
 
 RenderPassCache::~RenderPassCache()
 {
-    ASSERT(mPayload.empty());
+    ASSERT(getRenderPassCount() == 0);
 }
 
 void RenderPassCache::destroy(VkDevice device)
 {
-    for (auto &outerIt : mPayload)
+    for (Shard &shard : mShards)
     {
-        for (auto &innerIt : outerIt.second)
+        std::lock_guard<decltype(shard.mutex)> lock(shard.mutex);
+        for (auto &outerIt : shard.payload)
         {
-            innerIt.second.get().destroy(device);
+            for (auto &innerIt : outerIt.second)
+            {
+                innerIt.second.get().destroy(device);
+            }
         }
+        shard.payload.clear();
     }
-    mPayload.clear();
 }
 
-angle::Result RenderPassCache::addRenderPass(ContextVk *contextVk,
-                                             Serial serial,
-                                             const vk::RenderPassDesc &desc,
-                                             vk::RenderPass **renderPassOut)
+size_t RenderPassCache::getRenderPassCount() const
 {
+    size_t count = 0;
+    for (const Shard &shard : mShards)
+    {
+        std::lock_guard<decltype(shard.mutex)> lock(shard.mutex);
+        for (const auto &outerIt : shard.payload)
+        {
+            count += outerIt.second.size();
+        }
+    }
+    return count;
+}
+
+angle::Result RenderPassCache::getCompatibleRenderPass(ContextVk *contextVk,
+                                                       Serial serial,
+                                                       const vk::RenderPassDesc &desc,
+                                                       vk::RenderPass **renderPassOut)
+{
+    Shard &shard = getShard(desc);
+    std::lock_guard<decltype(shard.mutex)> lock(shard.mutex);
+
+    auto outerIt = shard.payload.find(desc);
+    if (outerIt != shard.payload.end())
+    {
+        InnerCache &innerCache = outerIt->second;
+        ASSERT(!innerCache.empty());
+
+        // Find the first element and return it.
+        innerCache.begin()->second.updateSerial(serial);
+        *renderPassOut = &innerCache.begin()->second.get();
+        return angle::Result::Continue;
+    }
+
     // Insert some dummy attachment ops.  Note that render passes with different ops are still
     // compatible.
     //
@@ -1635,7 +1700,8 @@ angle::Result RenderPassCache::addRenderPass(ContextVk *contextVk,
                         VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
     }
 
-    return getRenderPassWithOps(contextVk, serial, desc, ops, renderPassOut);
+    return getRenderPassWithOpsLocked(contextVk, serial, desc, ops, &shard.payload,
+                                      renderPassOut);
 }
 
 angle::Result RenderPassCache::getRenderPassWithOps(vk::Context *context,
@@ -1644,8 +1710,22 @@ angle::Result RenderPassCache::getRenderPassWithOps(vk::Context *context,
                                                     const vk::AttachmentOpsArray &attachmentOps,
                                                     vk::RenderPass **renderPassOut)
 {
-    auto outerIt = mPayload.find(desc);
-    if (outerIt != mPayload.end())
+    Shard &shard = getShard(desc);
+    std::lock_guard<decltype(shard.mutex)> lock(shard.mutex);
+    return getRenderPassWithOpsLocked(context, serial, desc, attachmentOps, &shard.payload,
+                                      renderPassOut);
+}
+
+angle::Result RenderPassCache::getRenderPassWithOpsLocked(
+    vk::Context *context,
+    Serial serial,
+    const vk::RenderPassDesc &desc,
+    const vk::AttachmentOpsArray &attachmentOps,
+    OuterCache *payload,
+    vk::RenderPass **renderPassOut)
+{
+    auto outerIt = payload->find(desc);
+    if (outerIt != payload->end())
     {
         InnerCache &innerCache = outerIt->second;
 
@@ -1659,15 +1739,16 @@ angle::Result RenderPassCache::getRenderPassWithOps(vk::Context *context,
             return angle::Result::Continue;
         }
     }
-    else
-    {
-        auto emplaceResult = mPayload.emplace(desc, InnerCache());
-        outerIt            = emplaceResult.first;
-    }
 
     vk::RenderPass newRenderPass;
     ANGLE_TRY(vk::InitializeRenderPassFromDesc(context, desc, attachmentOps, &newRenderPass));
 
+    if (outerIt == payload->end())
+    {
+        auto emplaceResult = payload->emplace(desc, InnerCache());
+        outerIt            = emplaceResult.first;
+    }
+
     vk::RenderPassAndSerial withSerial(std::move(newRenderPass), serial);
 
     InnerCache &innerCache = outerIt->second;
@@ -1678,8 +1759,137 @@ angle::Result RenderPassCache::getRenderPassWithOps(vk::Context *context,
     return angle::Result::Continue;
 }
 
+// SharedGraphicsPipelineCache implementation.
+SharedGraphicsPipelineCache::SharedGraphicsPipelineCache() = default;
+
+SharedGraphicsPipelineCache::~SharedGraphicsPipelineCache()
+{
+    ASSERT(getPipelineCount() == 0);
+}
+
+void SharedGraphicsPipelineCache::destroy(VkDevice device)
+{
+    for (Shard &shard : mShards)
+    {
+        std::lock_guard<decltype(shard.mutex)> lock(shard.mutex);
+        for (auto &item : shard.payload)
+        {
+            // Pipelines of programs that were never released, e.g. on device loss.
+            vk::RefCounted<vk::Pipeline> &pipeline = item.second.pipeline;
+            pipeline.get().destroy(device);
+            while (pipeline.isReferenced())
+            {
+                pipeline.releaseRef();
+            }
+        }
+        shard.payload.clear();
+    }
+}
+
+size_t SharedGraphicsPipelineCache::getPipelineCount() const
+{
+    size_t count = 0;
+    for (const Shard &shard : mShards)
+    {
+        std::lock_guard<decltype(shard.mutex)> lock(shard.mutex);
+        count += shard.payload.size();
+    }
+    return count;
+}
+
+angle::Result SharedGraphicsPipelineCache::getPipeline(
+    ContextVk *contextVk,
+    const vk::PipelineCache &pipelineCacheVk,
+    const vk::RenderPass &compatibleRenderPass,
+    const vk::PipelineLayout &pipelineLayout,
+    const gl::AttributesMask &activeAttribLocationsMask,
+    const gl::ComponentTypeMask &programAttribsTypeMask,
+    const vk::ShaderModule *vertexModule,
+    const vk::ShaderModule *fragmentModule,
+    const vk::ShaderModule *geometryModule,
+    const vk::GraphicsPipelineDesc &desc,
+    const vk::SharedGraphicsPipelineKey &key,
+    const vk::SharedGraphicsPipelineKey **keyOut,
+    vk::RefCounted<vk::Pipeline> **pipelineOut)
+{
+    Shard &shard = getShard(key);
+
+    {
+        std::lock_guard<decltype(shard.mutex)> lock(shard.mutex);
+        auto item = shard.payload.find(key);
+        if (item != shard.payload.end())
+        {
+            item->second.pipeline.addRef();
+            *keyOut      = &item->first;
+            *pipelineOut = &item->second.pipeline;
+            return angle::Result::Continue;
+        }
+    }
+
+    // The pipeline is created without holding the lock, as it can take a while.  Another thread
+    // may create the same pipeline meanwhile, in which case this one is discarded.
+    vk::Pipeline newPipeline;
+    contextVk->getRenderer()->onNewGraphicsPipeline();
+    ANGLE_TRY(desc.initializePipeline(contextVk, pipelineCacheVk, compatibleRenderPass,
+                                      pipelineLayout, activeAttribLocationsMask,
+                                      programAttribsTypeMask, vertexModule, fragmentModule,
+                                      geometryModule, &newPipeline));
+
+    std::lock_guard<decltype(shard.mutex)> lock(shard.mutex);
+    auto insertedItem = shard.payload.emplace(key, SharedPipeline());
+    vk::RefCounted<vk::Pipeline> &pipeline = insertedItem.first->second.pipeline;
+    if (insertedItem.second)
+    {
+        pipeline.get() = std::move(newPipeline);
+    }
+    else
+    {
+        newPipeline.destroy(contextVk->getDevice());
+    }
+
+    pipeline.addRef();
+    *keyOut      = &insertedItem.first->first;
+    *pipelineOut = &pipeline;
+
+    return angle::Result::Continue;
+}
+
+void SharedGraphicsPipelineCache::releasePipeline(RendererVk *renderer,
+                                                  VkDevice device,
+                                                  const vk::SharedGraphicsPipelineKey &key,
+                                                  Serial serial)
+{
+    Shard &shard = getShard(key);
+    std::lock_guard<decltype(shard.mutex)> lock(shard.mutex);
+
+    auto item = shard.payload.find(key);
+    ASSERT(item != shard.payload.end());
+
+    // The contexts that released their references earlier may still have commands in flight that
+    // use the pipeline.
+    SharedPipeline &sharedPipeline = item->second;
+    sharedPipeline.releaseSerial   = std::max(sharedPipeline.releaseSerial, serial);
+
+    vk::RefCounted<vk::Pipeline> &pipeline = sharedPipeline.pipeline;
+    pipeline.releaseRef();
+    if (pipeline.isReferenced())
+    {
+        return;
+    }
+
+    if (renderer)
+    {
+        renderer->collectGarbageAfterSerial(sharedPipeline.releaseSerial, &pipeline.get());
+    }
+    else
+    {
+        pipeline.get().destroy(device);
+    }
+    shard.payload.erase(item);
+}
+
 // GraphicsPipelineCache implementation.
-GraphicsPipelineCache::GraphicsPipelineCache() = default;
+GraphicsPipelineCache::GraphicsPipelineCache() : mSharedPipelines(nullptr) {}
 
 GraphicsPipelineCache::~GraphicsPipelineCache()
 {
@@ -1691,7 +1901,14 @@ void GraphicsPipelineCache::destroy(VkDevice device)
     for (auto &item : mPayload)
     {
         vk::PipelineHelper &pipeline = item.second;
-        pipeline.destroy(device);
+        if (pipeline.isShared())
+        {
+            mSharedPipelines->releasePipeline(nullptr, device, *pipeline.getSharedKey(), Serial());
+        }
+        else
+        {
+            pipeline.destroy(device);
+        }
     }
 
     mPayload.clear();
@@ -1702,7 +1919,16 @@ void GraphicsPipelineCache::release(ContextVk *context)
     for (auto &item : mPayload)
     {
         vk::PipelineHelper &pipeline = item.second;
-        context->addGarbage(&pipeline.getPipeline());
+        if (pipeline.isShared())
+        {
+            // Commands of the context that use the pipeline may not be submitted yet, so the
+            // reference is released when the context next submits.
+            context->releaseSharedPipelineAfterSubmission(pipeline.getSharedKey());
+        }
+        else
+        {
+            context->addGarbage(&pipeline.getPipeline());
+        }
     }
 
     mPayload.clear();
@@ -1715,27 +1941,41 @@ angle::Result GraphicsPipelineCache::insertPipeline(
     const vk::PipelineLayout &pipelineLayout,
     const gl::AttributesMask &activeAttribLocationsMask,
     const gl::ComponentTypeMask &programAttribsTypeMask,
-    const vk::ShaderModule *vertexModule,
-    const vk::ShaderModule *fragmentModule,
-    const vk::ShaderModule *geometryModule,
+    const vk::ShaderAndSerial *vertexShader,
+    const vk::ShaderAndSerial *fragmentShader,
+    const vk::ShaderAndSerial *geometryShader,
     const vk::GraphicsPipelineDesc &desc,
     const vk::GraphicsPipelineDesc **descPtrOut,
     vk::PipelineHelper **pipelineOut)
 {
-    vk::Pipeline newPipeline;
-
     // This "if" is left here for the benefit of VulkanPipelineCachePerfTest.
-    if (contextVk != nullptr)
+    if (contextVk == nullptr)
     {
-        contextVk->getRenderer()->onNewGraphicsPipeline();
-        ANGLE_TRY(desc.initializePipeline(contextVk, pipelineCacheVk, compatibleRenderPass,
-                                          pipelineLayout, activeAttribLocationsMask,
-                                          programAttribsTypeMask, vertexModule, fragmentModule,
-                                          geometryModule, &newPipeline));
+        auto insertedItem = mPayload.emplace(desc, vk::Pipeline());
+        *descPtrOut       = &insertedItem.first->first;
+        *pipelineOut      = &insertedItem.first->second;
+        return angle::Result::Continue;
     }
 
+    // The pipeline may have already been created by another program with the same shaders.
+    mSharedPipelines = &contextVk->getRenderer()->getSharedGraphicsPipelineCache();
+
+    const vk::ShaderModule *vertexModule   = &vertexShader->get();
+    const vk::ShaderModule *fragmentModule = fragmentShader ? &fragmentShader->get() : nullptr;
+    const vk::ShaderModule *geometryModule = geometryShader ? &geometryShader->get() : nullptr;
+
+    vk::SharedGraphicsPipelineKey key(vertexShader, fragmentShader, geometryShader, pipelineLayout,
+                                      activeAttribLocationsMask, programAttribsTypeMask, desc);
+    const vk::SharedGraphicsPipelineKey *sharedKey = nullptr;
+    vk::RefCounted<vk::Pipeline> *sharedPipeline   = nullptr;
+    ANGLE_TRY(mSharedPipelines->getPipeline(
+        contextVk, pipelineCacheVk, compatibleRenderPass, pipelineLayout,
+        activeAttribLocationsMask, programAttribsTypeMask, vertexModule, fragmentModule,
+        geometryModule, desc, key, &sharedKey, &sharedPipeline));
+
     // The Serial will be updated outside of this query.
-    auto insertedItem = mPayload.emplace(desc, std::move(newPipeline));
+    auto insertedItem = mPayload.emplace(std::piecewise_construct, std::forward_as_tuple(desc),
+                                         std::forward_as_tuple(sharedKey, sharedPipeline));
     *descPtrOut       = &insertedItem.first->first;
     *pipelineOut      = &insertedItem.first->second;
 
@@ -11,6 +11,8 @@
 #ifndef LIBANGLE_RENDERER_VULKAN_VK_CACHE_UTILS_H_
 #define LIBANGLE_RENDERER_VULKAN_VK_CACHE_UTILS_H_
 
+#include <mutex>
+
 #include "common/Color.h"
 #include "common/FixedVector.h"
 #include "libANGLE/renderer/vulkan/vk_utils.h"
@@ -354,7 +356,7 @@ class GraphicsPipelineDesc final
         return reinterpret_cast<const T *>(this);
     }
 
-    angle::Result initializePipeline(ContextVk *contextVk,
+    angle::Result initializePipeline(Context *context,
                                      const vk::PipelineCache &pipelineCacheVk,
                                      const RenderPass &compatibleRenderPass,
                                      const PipelineLayout &pipelineLayout,
@@ -588,6 +590,39 @@ static_assert(sizeof(PipelineLayoutDesc) ==
 // Disable warnings about struct padding.
 ANGLE_DISABLE_STRUCT_PADDING_WARNINGS
 
+// Identifies a graphics pipeline independently of the program that creates it, so that programs
+// whose shaders compile to the same SPIR-V share their pipelines.  Shaders with identical SPIR-V
+// are given the same serial by RendererVk::getShaderSerial, and pipeline layouts with identical
+// descriptions are the same object.
+class SharedGraphicsPipelineKey final
+{
+  public:
+    SharedGraphicsPipelineKey(const ShaderAndSerial *vertexShader,
+                              const ShaderAndSerial *fragmentShader,
+                              const ShaderAndSerial *geometryShader,
+                              const PipelineLayout &pipelineLayout,
+                              const gl::AttributesMask &activeAttribLocationsMask,
+                              const gl::ComponentTypeMask &programAttribsTypeMask,
+                              const GraphicsPipelineDesc &desc);
+
+    size_t hash() const;
+    bool operator==(const SharedGraphicsPipelineKey &other) const;
+
+  private:
+    struct ProgramKey
+    {
+        uint64_t vertexShaderSerial;
+        uint64_t fragmentShaderSerial;
+        uint64_t geometryShaderSerial;
+        VkPipelineLayout pipelineLayout;
+        uint32_t activeAttribLocationsMask;
+        uint32_t programAttribsTypeMask;
+    };
+
+    ProgramKey mProgramKey;
+    GraphicsPipelineDesc mDesc;
+};
+
 class PipelineHelper;
 
 struct GraphicsPipelineTransition
@@ -649,13 +684,23 @@ class PipelineHelper final : angle::NonCopyable
     PipelineHelper();
     ~PipelineHelper();
     inline explicit PipelineHelper(Pipeline &&pipeline);
+    // A pipeline owned by the renderer's SharedGraphicsPipelineCache.
+    inline PipelineHelper(const SharedGraphicsPipelineKey *sharedKey,
+                          RefCounted<Pipeline> *sharedPipeline);
 
     void destroy(VkDevice device);
 
     void updateSerial(Serial serial) { mSerial = serial; }
-    bool valid() const { return mPipeline.valid(); }
+    bool valid() const { return getPipeline().valid(); }
     Serial getSerial() const { return mSerial; }
-    Pipeline &getPipeline() { return mPipeline; }
+    Pipeline &getPipeline() { return mSharedPipeline ? mSharedPipeline->get() : mPipeline; }
+    const Pipeline &getPipeline() const
+    {
+        return mSharedPipeline ? mSharedPipeline->get() : mPipeline;
+    }
+
+    bool isShared() const { return mSharedPipeline != nullptr; }
+    const SharedGraphicsPipelineKey *getSharedKey() const { return mSharedKey; }
 
     ANGLE_INLINE bool findTransition(GraphicsPipelineTransitionBits bits,
                                      const GraphicsPipelineDesc &desc,
@@ -682,10 +727,18 @@ class PipelineHelper final : angle::NonCopyable
     std::vector<GraphicsPipelineTransition> mTransitions;
     Serial mSerial;
     Pipeline mPipeline;
+
+    const SharedGraphicsPipelineKey *mSharedKey = nullptr;
+    RefCounted<Pipeline> *mSharedPipeline       = nullptr;
 };
 
 ANGLE_INLINE PipelineHelper::PipelineHelper(Pipeline &&pipeline) : mPipeline(std::move(pipeline)) {}
 
+ANGLE_INLINE PipelineHelper::PipelineHelper(const SharedGraphicsPipelineKey *sharedKey,
+                                            RefCounted<Pipeline> *sharedPipeline)
+    : mSharedKey(sharedKey), mSharedPipeline(sharedPipeline)
+{}
+
 class TextureDescriptorDesc
 {
   public:
@@ -704,6 +757,13 @@ class TextureDescriptorDesc
     // Note: this is an exclusive index. If there is one index it will return "1".
     uint32_t getMaxIndex() const { return mMaxIndex; }
 
+    // Whether both descriptions use the same texture and sampler at |index|.
+    bool isUnitEqual(size_t index, const TextureDescriptorDesc &other) const
+    {
+        return mSerials[index].texture == other.mSerials[index].texture &&
+               mSerials[index].sampler == other.mSerials[index].sampler;
+    }
+
   private:
     uint32_t mMaxIndex;
     struct TexUnitSerials
@@ -737,6 +797,12 @@ struct hash<rx::vk::GraphicsPipelineDesc>
     size_t operator()(const rx::vk::GraphicsPipelineDesc &key) const { return key.hash(); }
 };
 
+template <>
+struct hash<rx::vk::SharedGraphicsPipelineKey>
+{
+    size_t operator()(const rx::vk::SharedGraphicsPipelineKey &key) const { return key.hash(); }
+};
+
 template <>
 struct hash<rx::vk::DescriptorSetLayoutDesc>
 {
@@ -758,6 +824,9 @@ struct hash<rx::vk::TextureDescriptorDesc>
 
 namespace rx
 {
+// Render passes are shared by all the contexts of a renderer, and may be used from several threads.
+// The cache is split in shards, each with its own lock, so that contexts rarely wait for each
+// other.
 // TODO(jmadill): Add cache trimming/eviction.
 class RenderPassCache final : angle::NonCopyable
 {
@@ -767,25 +836,10 @@ class RenderPassCache final : angle::NonCopyable
 
     void destroy(VkDevice device);
 
-    ANGLE_INLINE angle::Result getCompatibleRenderPass(ContextVk *contextVk,
-                                                       Serial serial,
-                                                       const vk::RenderPassDesc &desc,
-                                                       vk::RenderPass **renderPassOut)
-    {
-        auto outerIt = mPayload.find(desc);
-        if (outerIt != mPayload.end())
-        {
-            InnerCache &innerCache = outerIt->second;
-            ASSERT(!innerCache.empty());
-
-            // Find the first element and return it.
-            innerCache.begin()->second.updateSerial(serial);
-            *renderPassOut = &innerCache.begin()->second.get();
-            return angle::Result::Continue;
-        }
-
-        return addRenderPass(contextVk, serial, desc, renderPassOut);
-    }
+    angle::Result getCompatibleRenderPass(ContextVk *contextVk,
+                                          Serial serial,
+                                          const vk::RenderPassDesc &desc,
+                                          vk::RenderPass **renderPassOut);
 
     angle::Result getRenderPassWithOps(vk::Context *context,
                                        Serial serial,
@@ -793,18 +847,98 @@ class RenderPassCache final : angle::NonCopyable
                                        const vk::AttachmentOpsArray &attachmentOps,
                                        vk::RenderPass **renderPassOut);
 
-  private:
-    angle::Result addRenderPass(ContextVk *contextVk,
-                                Serial serial,
-                                const vk::RenderPassDesc &desc,
-                                vk::RenderPass **renderPassOut);
+    size_t getRenderPassCount() const;
 
+  private:
     // Use a two-layer caching scheme. The top level matches the "compatible" RenderPass elements.
     // The second layer caches the attachment load/store ops and initial/final layout.
     using InnerCache = std::unordered_map<vk::AttachmentOpsArray, vk::RenderPassAndSerial>;
     using OuterCache = std::unordered_map<vk::RenderPassDesc, InnerCache>;
 
-    OuterCache mPayload;
+    struct Shard
+    {
+        mutable std::mutex mutex;
+        OuterCache payload;
+    };
+
+    static constexpr size_t kShardCount = 16;
+
+    Shard &getShard(const vk::RenderPassDesc &desc)
+    {
+        return mShards[desc.hash() % kShardCount];
+    }
+
+    angle::Result getRenderPassWithOpsLocked(vk::Context *context,
+                                             Serial serial,
+                                             const vk::RenderPassDesc &desc,
+                                             const vk::AttachmentOpsArray &attachmentOps,
+                                             OuterCache *payload,
+                                             vk::RenderPass **renderPassOut);
+
+    std::array<Shard, kShardCount> mShards;
+};
+
+// Graphics pipelines are shared by the programs of all the contexts of a renderer whose shaders
+// compile to the same SPIR-V.  Each program still has its own GraphicsPipelineCache, which holds a
+// reference to the shared pipelines it uses.  A pipeline is destroyed when the last program using
+// it releases it, and the submissions of every context that released a reference have completed.
+// Like RenderPassCache, the cache is split in shards with their own locks.
+class SharedGraphicsPipelineCache final : angle::NonCopyable
+{
+  public:
+    SharedGraphicsPipelineCache();
+    ~SharedGraphicsPipelineCache();
+
+    void destroy(VkDevice device);
+
+    // Returns a new reference to the pipeline matching |key|, creating it if necessary.
+    angle::Result getPipeline(ContextVk *contextVk,
+                              const vk::PipelineCache &pipelineCacheVk,
+                              const vk::RenderPass &compatibleRenderPass,
+                              const vk::PipelineLayout &pipelineLayout,
+                              const gl::AttributesMask &activeAttribLocationsMask,
+                              const gl::ComponentTypeMask &programAttribsTypeMask,
+                              const vk::ShaderModule *vertexModule,
+                              const vk::ShaderModule *fragmentModule,
+                              const vk::ShaderModule *geometryModule,
+                              const vk::GraphicsPipelineDesc &desc,
+                              const vk::SharedGraphicsPipelineKey &key,
+                              const vk::SharedGraphicsPipelineKey **keyOut,
+                              vk::RefCounted<vk::Pipeline> **pipelineOut);
+
+    // Releases a reference returned by getPipeline.  |serial| is the serial of the last submission
+    // that may use the pipeline through this reference.  The last reference hands the pipeline to
+    // |renderer|'s garbage until the latest of these serials has completed, or destroys it right
+    // away if |renderer| is null.
+    void releasePipeline(RendererVk *renderer,
+                         VkDevice device,
+                         const vk::SharedGraphicsPipelineKey &key,
+                         Serial serial);
+
+    size_t getPipelineCount() const;
+
+  private:
+    struct SharedPipeline
+    {
+        vk::RefCounted<vk::Pipeline> pipeline;
+        Serial releaseSerial;
+    };
+    using Payload = std::unordered_map<vk::SharedGraphicsPipelineKey, SharedPipeline>;
+
+    struct Shard
+    {
+        mutable std::mutex mutex;
+        Payload payload;
+    };
+
+    static constexpr size_t kShardCount = 16;
+
+    Shard &getShard(const vk::SharedGraphicsPipelineKey &key)
+    {
+        return mShards[key.hash() % kShardCount];
+    }
+
+    std::array<Shard, kShardCount> mShards;
 };
 
 // TODO(jmadill): Add cache trimming/eviction.
@@ -825,9 +959,9 @@ class GraphicsPipelineCache final : angle::NonCopyable
                                            const vk::PipelineLayout &pipelineLayout,
                                            const gl::AttributesMask &activeAttribLocationsMask,
                                            const gl::ComponentTypeMask &programAttribsTypeMask,
-                                           const vk::ShaderModule *vertexModule,
-                                           const vk::ShaderModule *fragmentModule,
-                                           const vk::ShaderModule *geometryModule,
+                                           const vk::ShaderAndSerial *vertexShader,
+                                           const vk::ShaderAndSerial *fragmentShader,
+                                           const vk::ShaderAndSerial *geometryShader,
                                            const vk::GraphicsPipelineDesc &desc,
                                            const vk::GraphicsPipelineDesc **descPtrOut,
                                            vk::PipelineHelper **pipelineOut)
@@ -841,8 +975,8 @@ class GraphicsPipelineCache final : angle::NonCopyable
         }
 
         return insertPipeline(contextVk, pipelineCacheVk, compatibleRenderPass, pipelineLayout,
-                              activeAttribLocationsMask, programAttribsTypeMask, vertexModule,
-                              fragmentModule, geometryModule, desc, descPtrOut, pipelineOut);
+                              activeAttribLocationsMask, programAttribsTypeMask, vertexShader,
+                              fragmentShader, geometryShader, desc, descPtrOut, pipelineOut);
     }
 
   private:
@@ -852,14 +986,17 @@ class GraphicsPipelineCache final : angle::NonCopyable
                                  const vk::PipelineLayout &pipelineLayout,
                                  const gl::AttributesMask &activeAttribLocationsMask,
                                  const gl::ComponentTypeMask &programAttribsTypeMask,
-                                 const vk::ShaderModule *vertexModule,
-                                 const vk::ShaderModule *fragmentModule,
-                                 const vk::ShaderModule *geometryModule,
+                                 const vk::ShaderAndSerial *vertexShader,
+                                 const vk::ShaderAndSerial *fragmentShader,
+                                 const vk::ShaderAndSerial *geometryShader,
                                  const vk::GraphicsPipelineDesc &desc,
                                  const vk::GraphicsPipelineDesc **descPtrOut,
                                  vk::PipelineHelper **pipelineOut);
 
     std::unordered_map<vk::GraphicsPipelineDesc, vk::PipelineHelper> mPayload;
+
+    // The renderer's cache the shared pipelines in mPayload are referenced from.
+    SharedGraphicsPipelineCache *mSharedPipelines;
 };
 
 class DescriptorSetLayoutCache final : angle::NonCopyable
@@ -109,6 +109,9 @@ void RendererVk::ensureCapsInitialized() const
     mNativeExtensions.queryCounterBitsTimeElapsed = queueFamilyProperties.timestampValidBits;
     mNativeExtensions.queryCounterBitsTimestamp   = queueFamilyProperties.timestampValidBits;
 
+    // The GPU profiler uses timestamp queries too.
+    mNativeExtensions.gpuProfile = mNativeExtensions.disjointTimerQuery;
+
     mNativeExtensions.textureFilterAnisotropic =
         mPhysicalDeviceFeatures.samplerAnisotropy && limitsVk.maxSamplerAnisotropy > 1.0f;
     mNativeExtensions.maxTextureAnisotropy =
@@ -42,6 +42,11 @@ constexpr VkBufferUsageFlags kLineLoopDynamicIndirectBufferUsage =
     VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT |
     VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
 constexpr int kLineLoopDynamicIndirectBufferInitialSize = sizeof(VkDrawIndirectCommand) * 16;
+// Most line loops are small, so the drawArrays index cache starts small too.  Loops that would
+// take more than a quarter of the largest cache are streamed instead of cached.
+constexpr VkDeviceSize kLineLoopDrawArraysIndexCacheInitialSize = 16 * 1024;
+constexpr VkDeviceSize kLineLoopDrawArraysIndexCacheMaxSize     = 1024 * 1024;
+constexpr VkDeviceSize kLineLoopDrawArraysMaxCachedSize = kLineLoopDrawArraysIndexCacheMaxSize / 4;
 
 // This is an arbitrary max. We can change this later if necessary.
 constexpr uint32_t kDefaultDescriptorPoolMaxSets = 128;
@@ -825,8 +830,8 @@ angle::Result DynamicQueryPool::init(ContextVk *contextVk, VkQueryType type, uin
 {
     ANGLE_TRY(initEntryPool(contextVk, poolSize));
 
+    // The first query pool is created lazily on the first allocation.
     mQueryType = type;
-    ANGLE_TRY(allocateNewPool(contextVk));
 
     return angle::Result::Continue;
 }
@@ -838,6 +843,18 @@ void DynamicQueryPool::destroy(VkDevice device)
         queryPool.destroy(device);
     }
 
+    for (ResultBuffer &resultBuffer : mResultBuffers)
+    {
+        if (resultBuffer.results)
+        {
+            resultBuffer.deviceMemory.unmap(device);
+        }
+        resultBuffer.buffer.destroy(device);
+        resultBuffer.deviceMemory.destroy(device);
+    }
+    mResultBuffers.clear();
+    mPendingResultCopies.clear();
+
     destroyEntryPool();
 }
 
@@ -871,9 +888,9 @@ angle::Result DynamicQueryPool::allocateQuery(ContextVk *contextVk,
                                               size_t *poolIndex,
                                               uint32_t *queryIndex)
 {
-    if (mCurrentFreeEntry >= mPoolSize)
+    if (mPools.empty() || mCurrentFreeEntry >= mPoolSize)
     {
-        // No more queries left in this pool, create another one.
+        // No more queries left in this pool (or none created yet), create another one.
         ANGLE_TRY(allocateNewPool(contextVk));
     }
 
@@ -907,9 +924,97 @@ angle::Result DynamicQueryPool::allocateNewPool(ContextVk *contextVk)
 
     ANGLE_VK_TRY(contextVk, queryPool.init(contextVk->getDevice(), queryPoolInfo));
 
+    mResultBuffers.emplace_back();
     return allocateNewEntryPool(contextVk, std::move(queryPool));
 }
 
+angle::Result DynamicQueryPool::initResultBuffer(ContextVk *contextVk, size_t poolIndex)
+{
+    ResultBuffer &resultBuffer = mResultBuffers[poolIndex];
+    ASSERT(!resultBuffer.buffer.valid());
+
+    VkBufferCreateInfo createInfo    = {};
+    createInfo.sType                 = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    createInfo.flags                 = 0;
+    createInfo.size                  = mPoolSize * sizeof(uint64_t);
+    createInfo.usage                 = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    createInfo.sharingMode           = VK_SHARING_MODE_EXCLUSIVE;
+    createInfo.queueFamilyIndexCount = 0;
+    createInfo.pQueueFamilyIndices   = nullptr;
+
+    VkMemoryPropertyFlags flags =
+        (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+    ANGLE_VK_TRY(contextVk, resultBuffer.buffer.init(contextVk->getDevice(), createInfo));
+    VkMemoryPropertyFlags flagsOut = 0;
+    ANGLE_TRY(AllocateBufferMemory(contextVk, flags, &flagsOut, nullptr, &resultBuffer.buffer,
+                                   &resultBuffer.deviceMemory));
+
+    uint8_t *mappedMemory = nullptr;
+    ANGLE_VK_TRY(contextVk, resultBuffer.deviceMemory.map(contextVk->getDevice(), 0,
+                                                          createInfo.size, 0, &mappedMemory));
+    resultBuffer.results = reinterpret_cast<uint64_t *>(mappedMemory);
+
+    return angle::Result::Continue;
+}
+
+angle::Result DynamicQueryPool::queueResultCopy(ContextVk *contextVk, const QueryHelper &query)
+{
+    ASSERT(query.getQueryPool());
+    size_t poolIndex = query.getQueryPoolIndex();
+
+    if (!mResultBuffers[poolIndex].buffer.valid())
+    {
+        ANGLE_TRY(initResultBuffer(contextVk, poolIndex));
+    }
+
+    mPendingResultCopies.push_back({poolIndex, query.getQuery()});
+    return angle::Result::Continue;
+}
+
+bool DynamicQueryPool::recordResultCopies(PrimaryCommandBuffer *primaryCommandBuffer)
+{
+    if (mPendingResultCopies.empty())
+    {
+        return false;
+    }
+
+    // Queries are mostly allocated sequentially, so consecutive ones are copied together.  The
+    // copies wait for the results, which have been written earlier in the same submission.
+    size_t rangeStart = 0;
+    for (size_t index = 1; index <= mPendingResultCopies.size(); ++index)
+    {
+        const PendingResultCopy &first = mPendingResultCopies[rangeStart];
+        const uint32_t rangeCount      = static_cast<uint32_t>(index - rangeStart);
+
+        if (index < mPendingResultCopies.size())
+        {
+            const PendingResultCopy &copy = mPendingResultCopies[index];
+            if (copy.poolIndex == first.poolIndex &&
+                copy.queryIndex == first.queryIndex + rangeCount)
+            {
+                continue;
+            }
+        }
+
+        primaryCommandBuffer->copyQueryPoolResults(
+            mPools[first.poolIndex].getHandle(), first.queryIndex, rangeCount,
+            mResultBuffers[first.poolIndex].buffer, first.queryIndex * sizeof(uint64_t),
+            sizeof(uint64_t), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+        rangeStart = index;
+    }
+
+    mPendingResultCopies.clear();
+    return true;
+}
+
+uint64_t DynamicQueryPool::getResult(const QueryHelper &query) const
+{
+    const ResultBuffer &resultBuffer = mResultBuffers[query.getQueryPoolIndex()];
+    ASSERT(resultBuffer.results);
+    return resultBuffer.results[query.getQuery()];
+}
+
 // QueryHelper implementation
 QueryHelper::QueryHelper() : mDynamicQueryPool(nullptr), mQueryPoolIndex(0), mQuery(0) {}
 
@@ -986,9 +1091,9 @@ angle::Result DynamicSemaphorePool::allocateSemaphore(ContextVk *contextVk,
 {
     ASSERT(!semaphoreOut->getSemaphore());
 
-    if (mCurrentFreeEntry >= mPoolSize)
+    if (mPools.empty() || mCurrentFreeEntry >= mPoolSize)
     {
-        // No more queries left in this pool, create another one.
+        // No more queries left in this pool (or none created yet), create another one.
         ANGLE_TRY(allocateNewPool(contextVk));
     }
 
@@ -1063,6 +1168,7 @@ void SemaphoreHelper::deinit()
 
 // LineLoopHelper implementation.
 LineLoopHelper::LineLoopHelper(RendererVk *renderer)
+    : mDrawArraysIndexCacheMapping(nullptr), mDrawArraysIndexCacheUsedSize(0)
 {
     // We need to use an alignment of the maximum size we're going to allocate, which is
     // VK_INDEX_TYPE_UINT32. When we switch from a drawElement to a drawArray call, the allocations
@@ -1079,36 +1185,105 @@ LineLoopHelper::~LineLoopHelper() = default;
 
 angle::Result LineLoopHelper::getIndexBufferForDrawArrays(ContextVk *contextVk,
                                                           uint32_t clampedVertexCount,
-                                                          GLint firstVertex,
                                                           vk::BufferHelper **bufferOut,
                                                           VkDeviceSize *offsetOut)
 {
+    auto cachedIndices = mDrawArraysIndexCacheOffsets.find(clampedVertexCount);
+    if (cachedIndices != mDrawArraysIndexCacheOffsets.end())
+    {
+        *bufferOut = &mDrawArraysIndexCache;
+        *offsetOut = cachedIndices->second;
+        return angle::Result::Continue;
+    }
+
     uint32_t *indices    = nullptr;
     size_t allocateBytes = sizeof(uint32_t) * (static_cast<size_t>(clampedVertexCount) + 1);
+    bool cached          = allocateBytes <= kLineLoopDrawArraysMaxCachedSize;
 
-    mDynamicIndexBuffer.releaseInFlightBuffers(contextVk);
-    ANGLE_TRY(mDynamicIndexBuffer.allocate(contextVk, allocateBytes,
-                                           reinterpret_cast<uint8_t **>(&indices), nullptr,
-                                           offsetOut, nullptr));
-    *bufferOut = mDynamicIndexBuffer.getCurrentBuffer();
+    if (cached)
+    {
+        if (!mDrawArraysIndexCache.valid() ||
+            mDrawArraysIndexCacheUsedSize + allocateBytes > mDrawArraysIndexCache.getSize())
+        {
+            // Grow the cache until it reaches its maximum size, then start over with a new one.
+            VkDeviceSize newSize = kLineLoopDrawArraysIndexCacheInitialSize;
+            if (mDrawArraysIndexCache.valid())
+            {
+                newSize = std::min(mDrawArraysIndexCache.getSize() * 2,
+                                   kLineLoopDrawArraysIndexCacheMaxSize);
+            }
+            while (newSize < allocateBytes)
+            {
+                newSize *= 2;
+            }
+            ANGLE_TRY(allocateDrawArraysIndexCache(contextVk, newSize));
+        }
+
+        *bufferOut = &mDrawArraysIndexCache;
+        *offsetOut = mDrawArraysIndexCacheUsedSize;
+        indices    = reinterpret_cast<uint32_t *>(mDrawArraysIndexCacheMapping + *offsetOut);
+
+        mDrawArraysIndexCacheUsedSize += allocateBytes;
+        mDrawArraysIndexCacheOffsets[clampedVertexCount] = *offsetOut;
+    }
+    else
+    {
+        mDynamicIndexBuffer.releaseInFlightBuffers(contextVk);
+        ANGLE_TRY(mDynamicIndexBuffer.allocate(contextVk, allocateBytes,
+                                               reinterpret_cast<uint8_t **>(&indices), nullptr,
+                                               offsetOut, nullptr));
+        *bufferOut = mDynamicIndexBuffer.getCurrentBuffer();
+    }
 
-    // Note: there could be an overflow in this addition.
-    uint32_t unsignedFirstVertex = static_cast<uint32_t>(firstVertex);
-    uint32_t vertexCount         = (clampedVertexCount + unsignedFirstVertex);
-    for (uint32_t vertexIndex = unsignedFirstVertex; vertexIndex < vertexCount; vertexIndex++)
+    for (uint32_t vertexIndex = 0; vertexIndex < clampedVertexCount; vertexIndex++)
     {
         *indices++ = vertexIndex;
     }
-    *indices = unsignedFirstVertex;
+    *indices = 0;
 
     // Since we are not using the VK_MEMORY_PROPERTY_HOST_COHERENT_BIT flag when creating the
     // device memory in the StreamingBuffer, we always need to make sure we flush it after
     // writing.
-    ANGLE_TRY(mDynamicIndexBuffer.flush(contextVk));
+    if (cached)
+    {
+        // The whole buffer is flushed as ranges must be aligned to nonCoherentAtomSize.
+        ANGLE_TRY(mDrawArraysIndexCache.flush(contextVk, 0, mDrawArraysIndexCache.getSize()));
+    }
+    else
+    {
+        ANGLE_TRY(mDynamicIndexBuffer.flush(contextVk));
+    }
 
     return angle::Result::Continue;
 }
 
+angle::Result LineLoopHelper::allocateDrawArraysIndexCache(ContextVk *contextVk,
+                                                           VkDeviceSize size)
+{
+    // Draws that are already recorded may still use the previous buffer, so it's garbage
+    // collected.
+    if (mDrawArraysIndexCache.valid())
+    {
+        mDrawArraysIndexCache.release(contextVk->getRenderer());
+    }
+    mDrawArraysIndexCacheMapping  = nullptr;
+    mDrawArraysIndexCacheUsedSize = 0;
+    mDrawArraysIndexCacheOffsets.clear();
+
+    VkBufferCreateInfo createInfo    = {};
+    createInfo.sType                 = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    createInfo.flags                 = 0;
+    createInfo.size                  = size;
+    createInfo.usage                 = VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
+    createInfo.sharingMode           = VK_SHARING_MODE_EXCLUSIVE;
+    createInfo.queueFamilyIndexCount = 0;
+    createInfo.pQueueFamilyIndices   = nullptr;
+
+    ANGLE_TRY(
+        mDrawArraysIndexCache.init(contextVk, createInfo, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT));
+    return mDrawArraysIndexCache.map(contextVk, &mDrawArraysIndexCacheMapping);
+}
+
 angle::Result LineLoopHelper::getIndexBufferForElementArrayBuffer(ContextVk *contextVk,
                                                                   BufferVk *elementArrayBufferVk,
                                                                   gl::DrawElementsType glIndexType,
@@ -1277,19 +1452,30 @@ void LineLoopHelper::release(ContextVk *contextVk)
 {
     mDynamicIndexBuffer.release(contextVk->getRenderer());
     mDynamicIndirectBuffer.release(contextVk->getRenderer());
+    if (mDrawArraysIndexCache.valid())
+    {
+        mDrawArraysIndexCache.release(contextVk->getRenderer());
+    }
+    mDrawArraysIndexCacheMapping  = nullptr;
+    mDrawArraysIndexCacheUsedSize = 0;
+    mDrawArraysIndexCacheOffsets.clear();
 }
 
 void LineLoopHelper::destroy(VkDevice device)
 {
     mDynamicIndexBuffer.destroy(device);
     mDynamicIndirectBuffer.destroy(device);
+    mDrawArraysIndexCache.destroy(device);
+    mDrawArraysIndexCacheMapping  = nullptr;
+    mDrawArraysIndexCacheUsedSize = 0;
+    mDrawArraysIndexCacheOffsets.clear();
 }
 
 // static
-void LineLoopHelper::Draw(uint32_t count, vk::CommandBuffer *commandBuffer)
+void LineLoopHelper::Draw(uint32_t count, uint32_t baseVertex, vk::CommandBuffer *commandBuffer)
 {
     // Our first index is always 0 because that's how we set it up in createIndexBuffer*.
-    commandBuffer->drawIndexed(count);
+    commandBuffer->drawIndexedBaseVertex(count, baseVertex);
 }
 
 // BufferHelper implementation.
@@ -1811,6 +1997,35 @@ void ImageHelper::changeLayout(VkImageAspectFlags aspectMask,
     forceChangeLayoutAndQueue(aspectMask, newLayout, mCurrentQueueFamilyIndex, commandBuffer);
 }
 
+void ImageHelper::changeLayout(VkImageAspectFlags aspectMask,
+                               ImageLayout newLayout,
+                               PipelineBarrier *barrier)
+{
+    if (!isLayoutChangeNecessary(newLayout))
+    {
+        return;
+    }
+
+    // Same as forceChangeLayoutAndQueue, except for the command buffer the barrier goes to.
+    if (mCurrentLayout == newLayout && mCurrentLayout != ImageLayout::TransferDst)
+    {
+        const ImageMemoryBarrierData &transition = kImageMemoryBarrierData[mCurrentLayout];
+        ASSERT(transition.srcStageMask == transition.dstStageMask);
+
+        barrier->mergeExecutionBarrier(transition.srcStageMask, transition.dstStageMask);
+        return;
+    }
+
+    VkImageMemoryBarrier imageMemoryBarrier;
+    initImageMemoryBarrierStruct(aspectMask, newLayout, mCurrentQueueFamilyIndex,
+                                 &imageMemoryBarrier);
+
+    barrier->mergeImageBarrier(kImageMemoryBarrierData[mCurrentLayout].srcStageMask,
+                               kImageMemoryBarrierData[newLayout].dstStageMask,
+                               imageMemoryBarrier);
+    mCurrentLayout = newLayout;
+}
+
 void ImageHelper::changeLayoutAndQueue(VkImageAspectFlags aspectMask,
                                        ImageLayout newLayout,
                                        uint32_t newQueueFamilyIndex,
@@ -1858,22 +2073,8 @@ void ImageHelper::forceChangeLayoutAndQueue(VkImageAspectFlags aspectMask,
     const ImageMemoryBarrierData &transitionFrom = kImageMemoryBarrierData[mCurrentLayout];
     const ImageMemoryBarrierData &transitionTo   = kImageMemoryBarrierData[newLayout];
 
-    VkImageMemoryBarrier imageMemoryBarrier = {};
-    imageMemoryBarrier.sType                = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-    imageMemoryBarrier.srcAccessMask        = transitionFrom.srcAccessMask;
-    imageMemoryBarrier.dstAccessMask        = transitionTo.dstAccessMask;
-    imageMemoryBarrier.oldLayout            = transitionFrom.layout;
-    imageMemoryBarrier.newLayout            = transitionTo.layout;
-    imageMemoryBarrier.srcQueueFamilyIndex  = mCurrentQueueFamilyIndex;
-    imageMemoryBarrier.dstQueueFamilyIndex  = newQueueFamilyIndex;
-    imageMemoryBarrier.image                = mImage.getHandle();
-
-    // TODO(jmadill): Is this needed for mipped/layer images?
-    imageMemoryBarrier.subresourceRange.aspectMask     = aspectMask;
-    imageMemoryBarrier.subresourceRange.baseMipLevel   = 0;
-    imageMemoryBarrier.subresourceRange.levelCount     = mLevelCount;
-    imageMemoryBarrier.subresourceRange.baseArrayLayer = 0;
-    imageMemoryBarrier.subresourceRange.layerCount     = mLayerCount;
+    VkImageMemoryBarrier imageMemoryBarrier;
+    initImageMemoryBarrierStruct(aspectMask, newLayout, newQueueFamilyIndex, &imageMemoryBarrier);
 
     commandBuffer->imageBarrier(transitionFrom.srcStageMask, transitionTo.dstStageMask,
                                 &imageMemoryBarrier);
@@ -1881,6 +2082,32 @@ void ImageHelper::forceChangeLayoutAndQueue(VkImageAspectFlags aspectMask,
     mCurrentQueueFamilyIndex = newQueueFamilyIndex;
 }
 
+void ImageHelper::initImageMemoryBarrierStruct(VkImageAspectFlags aspectMask,
+                                               ImageLayout newLayout,
+                                               uint32_t newQueueFamilyIndex,
+                                               VkImageMemoryBarrier *imageMemoryBarrier) const
+{
+    const ImageMemoryBarrierData &transitionFrom = kImageMemoryBarrierData[mCurrentLayout];
+    const ImageMemoryBarrierData &transitionTo   = kImageMemoryBarrierData[newLayout];
+
+    *imageMemoryBarrier                     = {};
+    imageMemoryBarrier->sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    imageMemoryBarrier->srcAccessMask       = transitionFrom.srcAccessMask;
+    imageMemoryBarrier->dstAccessMask       = transitionTo.dstAccessMask;
+    imageMemoryBarrier->oldLayout           = transitionFrom.layout;
+    imageMemoryBarrier->newLayout           = transitionTo.layout;
+    imageMemoryBarrier->srcQueueFamilyIndex = mCurrentQueueFamilyIndex;
+    imageMemoryBarrier->dstQueueFamilyIndex = newQueueFamilyIndex;
+    imageMemoryBarrier->image               = mImage.getHandle();
+
+    // TODO(jmadill): Is this needed for mipped/layer images?
+    imageMemoryBarrier->subresourceRange.aspectMask     = aspectMask;
+    imageMemoryBarrier->subresourceRange.baseMipLevel   = 0;
+    imageMemoryBarrier->subresourceRange.levelCount     = mLevelCount;
+    imageMemoryBarrier->subresourceRange.baseArrayLayer = 0;
+    imageMemoryBarrier->subresourceRange.layerCount     = mLayerCount;
+}
+
 void ImageHelper::clearColor(const VkClearColorValue &color,
                              uint32_t baseMipLevel,
                              uint32_t levelCount,
@@ -1993,6 +2220,9 @@ angle::Result ImageHelper::generateMipmapsWithBlit(ContextVk *contextVk, GLuint
     vk::CommandBuffer *commandBuffer = nullptr;
     ANGLE_TRY(recordCommands(contextVk, &commandBuffer));
 
+    ANGLE_TRY(contextVk->getGpuProfiler().beginScope(
+        contextVk, GpuProfileCategory::GenerateMipmap, commandBuffer));
+
     changeLayout(VK_IMAGE_ASPECT_COLOR_BIT, ImageLayout::TransferDst, commandBuffer);
 
     // We are able to use blitImage since the image format we are using supports it. This
@@ -2061,6 +2291,9 @@ angle::Result ImageHelper::generateMipmapsWithBlit(ContextVk *contextVk, GLuint
     // We can do it for all layers at once.
     commandBuffer->imageBarrier(VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
                                 &barrier);
+
+    contextVk->getGpuProfiler().endScope(commandBuffer);
+
     // This is just changing the internal state of the image helper so that the next call
     // to changeLayout will use this layout as the "oldLayout" argument.
     mCurrentLayout = ImageLayout::TransferSrc;
@@ -2866,6 +3099,32 @@ DispatchHelper::DispatchHelper() : CommandGraphResource(CommandGraphResourceType
 
 DispatchHelper::~DispatchHelper() = default;
 
+// LayoutTransitionHelper implementation.
+LayoutTransitionHelper::LayoutTransitionHelper()
+    : CommandGraphResource(CommandGraphResourceType::LayoutTransition)
+{}
+
+LayoutTransitionHelper::~LayoutTransitionHelper() = default;
+
+void LayoutTransitionHelper::changeImageLayout(ContextVk *contextVk,
+                                               ImageHelper *image,
+                                               ImageLayout newLayout)
+{
+    ASSERT(image->isLayoutChangeNecessary(newLayout));
+
+    // A batch that something already depends on may have executed by the time the new transition
+    // is needed, so it can't be added to.
+    updateCurrentAccessNodes();
+    if (!hasChildlessWritingNode())
+    {
+        startNewCommands(contextVk);
+    }
+
+    // The transition happens after everything that used the image in its previous layout.
+    image->addWriteDependency(contextVk, this);
+    image->changeLayout(image->getAspectFlags(), newLayout, getPipelineBarrier());
+}
+
 // ShaderProgramHelper implementation.
 ShaderProgramHelper::ShaderProgramHelper() = default;
 
@@ -2940,5 +3199,16 @@ angle::Result ShaderProgramHelper::getComputePipeline(Context *context,
     return angle::Result::Continue;
 }
 
+void ShaderProgramHelper::setComputePipeline(VkDevice device, Pipeline &&pipeline)
+{
+    if (mComputePipeline.valid())
+    {
+        pipeline.destroy(device);
+        return;
+    }
+
+    mComputePipeline.get() = std::move(pipeline);
+}
+
 }  // namespace vk
 }  // namespace rx
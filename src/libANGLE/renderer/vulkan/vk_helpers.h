@@ -283,11 +283,36 @@ class DynamicQueryPool final : public DynamicallyGrowingPool<QueryPool>
 
     const QueryPool *getQueryPool(size_t index) const { return &mPools[index]; }
 
+    // Queues a copy of the query's result to a host-visible buffer, recorded by
+    // recordResultCopies at the end of the submission that writes the query.  Once that
+    // submission has finished, the result is read with getResult without any Vulkan call.
+    angle::Result queueResultCopy(ContextVk *contextVk, const QueryHelper &query);
+    bool recordResultCopies(PrimaryCommandBuffer *primaryCommandBuffer);
+    uint64_t getResult(const QueryHelper &query) const;
+
   private:
     angle::Result allocateNewPool(ContextVk *contextVk);
+    angle::Result initResultBuffer(ContextVk *contextVk, size_t poolIndex);
 
     // Information required to create new query pools
     VkQueryType mQueryType;
+
+    // A host-visible buffer per query pool with one 64-bit result per query.  They are created
+    // the first time a result is copied from the corresponding pool, and stay mapped.
+    struct ResultBuffer
+    {
+        Buffer buffer;
+        DeviceMemory deviceMemory;
+        uint64_t *results = nullptr;
+    };
+    std::vector<ResultBuffer> mResultBuffers;
+
+    struct PendingResultCopy
+    {
+        size_t poolIndex;
+        uint32_t queryIndex;
+    };
+    std::vector<PendingResultCopy> mPendingResultCopies;
 };
 
 // Queries in vulkan are identified by the query pool and an index for a query within that pool.
@@ -399,9 +424,10 @@ class LineLoopHelper final : angle::NonCopyable
     LineLoopHelper(RendererVk *renderer);
     ~LineLoopHelper();
 
+    // The indices are relative to the first vertex, which is passed to Draw() as the vertex
+    // offset.  This way the indices only depend on the vertex count, and are cached per count.
     angle::Result getIndexBufferForDrawArrays(ContextVk *contextVk,
                                               uint32_t clampedVertexCount,
-                                              GLint firstVertex,
                                               BufferHelper **bufferOut,
                                               VkDeviceSize *offsetOut);
 
@@ -435,11 +461,21 @@ class LineLoopHelper final : angle::NonCopyable
     void release(ContextVk *contextVk);
     void destroy(VkDevice device);
 
-    static void Draw(uint32_t count, CommandBuffer *commandBuffer);
+    static void Draw(uint32_t count, uint32_t baseVertex, CommandBuffer *commandBuffer);
 
   private:
+    angle::Result allocateDrawArraysIndexCache(ContextVk *contextVk, VkDeviceSize size);
+
     DynamicBuffer mDynamicIndexBuffer;
     DynamicBuffer mDynamicIndirectBuffer;
+
+    // Line loop indices for drawArrays are written once per vertex count into this buffer and are
+    // never overwritten while it is alive, so any number of draws can share them.  The buffer
+    // starts small and is replaced by a larger one when it fills up.
+    BufferHelper mDrawArraysIndexCache;
+    uint8_t *mDrawArraysIndexCacheMapping;
+    VkDeviceSize mDrawArraysIndexCacheUsedSize;
+    std::unordered_map<uint32_t, VkDeviceSize> mDrawArraysIndexCacheOffsets;
 };
 
 class FramebufferHelper;
@@ -857,6 +893,12 @@ class ImageHelper final : public CommandGraphResource
                       ImageLayout newLayout,
                       CommandBuffer *commandBuffer);
 
+    // Like changeLayout, but adds the transition to |barrier| so it can be recorded along with
+    // other transitions.  The caller must order the barrier after the image's previous users.
+    void changeLayout(VkImageAspectFlags aspectMask,
+                      ImageLayout newLayout,
+                      PipelineBarrier *barrier);
+
     bool isQueueChangeNeccesary(uint32_t newQueueFamilyIndex) const
     {
         return mCurrentQueueFamilyIndex != newQueueFamilyIndex;
@@ -876,6 +918,12 @@ class ImageHelper final : public CommandGraphResource
                                    uint32_t newQueueFamilyIndex,
                                    CommandBuffer *commandBuffer);
 
+    // Fills in the barrier for a layout change that isn't just an execution barrier.
+    void initImageMemoryBarrierStruct(VkImageAspectFlags aspectMask,
+                                      ImageLayout newLayout,
+                                      uint32_t newQueueFamilyIndex,
+                                      VkImageMemoryBarrier *imageMemoryBarrier) const;
+
     void stageSubresourceClear(const gl::ImageIndex &index,
                                const angle::Format &format,
                                const VkClearColorValue &colorValue,
@@ -1009,6 +1057,21 @@ class DispatchHelper : public CommandGraphResource
     ~DispatchHelper() override;
 };
 
+// A special command graph resource whose nodes only hold image layout transitions.  The images a
+// draw or dispatch uses are made to depend on a single node, so all their transitions are recorded
+// with one pipeline barrier instead of a command buffer and barrier per image.
+class LayoutTransitionHelper : public CommandGraphResource
+{
+  public:
+    LayoutTransitionHelper();
+    ~LayoutTransitionHelper() override;
+
+    // Adds the transition of |image| to the current batch, starting a new batch if something
+    // already depends on the current one.  Callers should add every transition before adding
+    // dependencies on the images, so they all land in the same batch.
+    void changeImageLayout(ContextVk *contextVk, ImageHelper *image, ImageLayout newLayout);
+};
+
 class ShaderProgramHelper : angle::NonCopyable
 {
   public:
@@ -1049,13 +1112,13 @@ class ShaderProgramHelper : angle::NonCopyable
                                                            pipelineDesc.getRenderPassDesc(),
                                                            &compatibleRenderPass));
 
-        ShaderModule *vertexShader   = &mShaders[gl::ShaderType::Vertex].get().get();
-        ShaderModule *fragmentShader = mShaders[gl::ShaderType::Fragment].valid()
-                                           ? &mShaders[gl::ShaderType::Fragment].get().get()
-                                           : nullptr;
-        ShaderModule *geometryShader = mShaders[gl::ShaderType::Geometry].valid()
-                                           ? &mShaders[gl::ShaderType::Geometry].get().get()
-                                           : nullptr;
+        ShaderAndSerial *vertexShader   = &mShaders[gl::ShaderType::Vertex].get();
+        ShaderAndSerial *fragmentShader = mShaders[gl::ShaderType::Fragment].valid()
+                                              ? &mShaders[gl::ShaderType::Fragment].get()
+                                              : nullptr;
+        ShaderAndSerial *geometryShader = mShaders[gl::ShaderType::Geometry].valid()
+                                              ? &mShaders[gl::ShaderType::Geometry].get()
+                                              : nullptr;
 
         return mGraphicsPipelines.getPipeline(
             contextVk, pipelineCache, *compatibleRenderPass, pipelineLayout,
@@ -1067,6 +1130,9 @@ class ShaderProgramHelper : angle::NonCopyable
                                      const PipelineLayout &pipelineLayout,
                                      PipelineAndSerial **pipelineOut);
 
+    // Adopts a compute pipeline created ahead of its first use, unless one was created since.
+    void setComputePipeline(VkDevice device, Pipeline &&pipeline);
+
   private:
     gl::ShaderMap<BindingPointer<ShaderAndSerial>> mShaders;
     GraphicsPipelineCache mGraphicsPipelines;
@@ -424,7 +424,8 @@ angle::Result InitShaderAndSerial(Context *context,
     createInfo.pCode                    = shaderCode;
 
     ANGLE_VK_TRY(context, shaderAndSerial->get().init(context->getDevice(), createInfo));
-    shaderAndSerial->updateSerial(context->getRenderer()->issueShaderSerial());
+    shaderAndSerial->updateSerial(
+        context->getRenderer()->getShaderSerial(shaderCode, shaderCodeSize));
     return angle::Result::Continue;
 }
 
@@ -561,6 +562,11 @@ PFN_vkGetPhysicalDeviceProperties2KHR vkGetPhysicalDeviceProperties2KHR = nullpt
 // VK_KHR_external_semaphore_fd
 PFN_vkImportSemaphoreFdKHR vkImportSemaphoreFdKHR = nullptr;
 
+// VK_KHR_descriptor_update_template
+PFN_vkCreateDescriptorUpdateTemplateKHR vkCreateDescriptorUpdateTemplateKHR   = nullptr;
+PFN_vkDestroyDescriptorUpdateTemplateKHR vkDestroyDescriptorUpdateTemplateKHR = nullptr;
+PFN_vkUpdateDescriptorSetWithTemplateKHR vkUpdateDescriptorSetWithTemplateKHR = nullptr;
+
 #if defined(ANGLE_PLATFORM_FUCHSIA)
 // VK_FUCHSIA_imagepipe_surface
 PFN_vkCreateImagePipeSurfaceFUCHSIA vkCreateImagePipeSurfaceFUCHSIA = nullptr;
@@ -616,6 +622,13 @@ void InitExternalSemaphoreFdFunctions(VkInstance instance)
     GET_FUNC(vkImportSemaphoreFdKHR);
 }
 
+void InitDescriptorUpdateTemplateKHRFunctions(VkInstance instance)
+{
+    GET_FUNC(vkCreateDescriptorUpdateTemplateKHR);
+    GET_FUNC(vkDestroyDescriptorUpdateTemplateKHR);
+    GET_FUNC(vkUpdateDescriptorSetWithTemplateKHR);
+}
+
 #undef GET_FUNC
 
 namespace gl_vk
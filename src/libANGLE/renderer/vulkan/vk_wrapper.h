@@ -172,6 +172,9 @@ class CommandBuffer : public WrappedObject<CommandBuffer, VkCommandBuffer>
     static bool CanKnowIfEmpty() { return false; }
     bool empty() const { return false; }
 
+    // Number of barriers recorded since the command buffer began.
+    uint32_t getPipelineBarrierCount() const { return mPipelineBarrierCount; }
+
     using WrappedObject::operator=;
 
     static bool SupportsQueries(const VkPhysicalDeviceFeatures &features)
@@ -252,6 +255,14 @@ class CommandBuffer : public WrappedObject<CommandBuffer, VkCommandBuffer>
                    uint32_t regionCount,
                    const VkImageCopy *regions);
 
+    void copyQueryPoolResults(VkQueryPool queryPool,
+                              uint32_t firstQuery,
+                              uint32_t queryCount,
+                              const Buffer &dstBuffer,
+                              VkDeviceSize dstOffset,
+                              VkDeviceSize stride,
+                              VkQueryResultFlags flags);
+
     void dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ);
     void dispatchIndirect(const Buffer &buffer, VkDeviceSize offset);
 
@@ -271,6 +282,7 @@ class CommandBuffer : public WrappedObject<CommandBuffer, VkCommandBuffer>
                      int32_t vertexOffset,
                      uint32_t firstInstance);
     void drawIndexed(uint32_t indexCount);
+    void drawIndexedBaseVertex(uint32_t indexCount, uint32_t vertexOffset);
     void drawIndexedInstanced(uint32_t indexCount, uint32_t instanceCount);
     void drawIndexedInstancedBaseVertexBaseInstance(uint32_t indexCount,
                                                     uint32_t instanceCount,
@@ -348,6 +360,9 @@ class CommandBuffer : public WrappedObject<CommandBuffer, VkCommandBuffer>
     void writeTimestamp(VkPipelineStageFlagBits pipelineStage,
                         VkQueryPool queryPool,
                         uint32_t query);
+
+  private:
+    uint32_t mPipelineBarrierCount = 0;
 };
 }  // namespace priv
 
@@ -622,6 +637,7 @@ ANGLE_INLINE void CommandBuffer::blitImage(const Image &srcImage,
 ANGLE_INLINE VkResult CommandBuffer::begin(const VkCommandBufferBeginInfo &info)
 {
     ASSERT(valid());
+    mPipelineBarrierCount = 0;
     return vkBeginCommandBuffer(mHandle, &info);
 }
 
@@ -644,6 +660,7 @@ ANGLE_INLINE void CommandBuffer::memoryBarrier(VkPipelineStageFlags srcStageMask
     ASSERT(valid());
     vkCmdPipelineBarrier(mHandle, srcStageMask, dstStageMask, 0, 1, memoryBarrier, 0, nullptr, 0,
                          nullptr);
+    ++mPipelineBarrierCount;
 }
 
 ANGLE_INLINE void CommandBuffer::pipelineBarrier(VkPipelineStageFlags srcStageMask,
@@ -660,12 +677,14 @@ ANGLE_INLINE void CommandBuffer::pipelineBarrier(VkPipelineStageFlags srcStageMa
     vkCmdPipelineBarrier(mHandle, srcStageMask, dstStageMask, dependencyFlags, memoryBarrierCount,
                          memoryBarriers, bufferMemoryBarrierCount, bufferMemoryBarriers,
                          imageMemoryBarrierCount, imageMemoryBarriers);
+    ++mPipelineBarrierCount;
 }
 
 ANGLE_INLINE void CommandBuffer::executionBarrier(VkPipelineStageFlags stageMask)
 {
     ASSERT(valid());
     vkCmdPipelineBarrier(mHandle, stageMask, stageMask, 0, 0, nullptr, 0, nullptr, 0, nullptr);
+    ++mPipelineBarrierCount;
 }
 
 ANGLE_INLINE void CommandBuffer::imageBarrier(VkPipelineStageFlags srcStageMask,
@@ -675,6 +694,7 @@ ANGLE_INLINE void CommandBuffer::imageBarrier(VkPipelineStageFlags srcStageMask,
     ASSERT(valid());
     vkCmdPipelineBarrier(mHandle, srcStageMask, dstStageMask, 0, 0, nullptr, 0, nullptr, 1,
                          imageMemoryBarrier);
+    ++mPipelineBarrierCount;
 }
 
 ANGLE_INLINE void CommandBuffer::destroy(VkDevice device)
@@ -770,6 +790,19 @@ ANGLE_INLINE void CommandBuffer::copyImage(const Image &srcImage,
                    dstImageLayout, 1, regions);
 }
 
+ANGLE_INLINE void CommandBuffer::copyQueryPoolResults(VkQueryPool queryPool,
+                                                      uint32_t firstQuery,
+                                                      uint32_t queryCount,
+                                                      const Buffer &dstBuffer,
+                                                      VkDeviceSize dstOffset,
+                                                      VkDeviceSize stride,
+                                                      VkQueryResultFlags flags)
+{
+    ASSERT(valid() && dstBuffer.valid());
+    vkCmdCopyQueryPoolResults(mHandle, queryPool, firstQuery, queryCount, dstBuffer.getHandle(),
+                              dstOffset, stride, flags);
+}
+
 ANGLE_INLINE void CommandBuffer::beginRenderPass(const VkRenderPassBeginInfo &beginInfo,
                                                  VkSubpassContents subpassContents)
 {
@@ -958,6 +991,12 @@ ANGLE_INLINE void CommandBuffer::drawIndexed(uint32_t indexCount)
     vkCmdDrawIndexed(mHandle, indexCount, 1, 0, 0, 0);
 }
 
+ANGLE_INLINE void CommandBuffer::drawIndexedBaseVertex(uint32_t indexCount, uint32_t vertexOffset)
+{
+    ASSERT(valid());
+    vkCmdDrawIndexed(mHandle, indexCount, 1, 0, vertexOffset, 0);
+}
+
 ANGLE_INLINE void CommandBuffer::drawIndexedInstanced(uint32_t indexCount, uint32_t instanceCount)
 {
     ASSERT(valid());
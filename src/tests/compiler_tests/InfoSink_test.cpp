@@ -0,0 +1,90 @@
+//
+// Copyright 2020 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// InfoSink_test.cpp:
+//   Tests for the formatting of numbers in TInfoSinkBase, which must match what a string stream
+//   imbued with the classic locale writes.
+
+#include "compiler/translator/InfoSink.h"
+#include "gtest/gtest.h"
+
+#include <limits>
+
+using namespace sh;
+
+namespace
+{
+
+template <typename T>
+std::string ToStreamString(const T &value)
+{
+    std::ostringstream stream = InitializeStream<std::ostringstream>();
+    stream << value;
+    return stream.str();
+}
+
+template <typename T>
+std::string ToSinkString(const T &value)
+{
+    TInfoSinkBase sink;
+    sink << value;
+    return sink.str();
+}
+
+// Test writing signed and unsigned integers, including the limits of their types.
+TEST(InfoSinkTest, Integers)
+{
+    EXPECT_EQ("0", ToSinkString(0));
+    EXPECT_EQ("-1", ToSinkString(-1));
+    EXPECT_EQ("42", ToSinkString(42u));
+    EXPECT_EQ(ToStreamString(std::numeric_limits<int>::min()),
+              ToSinkString(std::numeric_limits<int>::min()));
+    EXPECT_EQ(ToStreamString(std::numeric_limits<int>::max()),
+              ToSinkString(std::numeric_limits<int>::max()));
+    EXPECT_EQ(ToStreamString(std::numeric_limits<unsigned int>::max()),
+              ToSinkString(std::numeric_limits<unsigned int>::max()));
+    EXPECT_EQ(ToStreamString(std::numeric_limits<int64_t>::min()),
+              ToSinkString(std::numeric_limits<int64_t>::min()));
+    EXPECT_EQ(ToStreamString(std::numeric_limits<uint64_t>::max()),
+              ToSinkString(std::numeric_limits<uint64_t>::max()));
+    EXPECT_EQ("-7", ToSinkString(static_cast<short>(-7)));
+    EXPECT_EQ("123", ToSinkString(static_cast<size_t>(123)));
+}
+
+// Test that floats without a fractional part are written with a decimal point.
+TEST(InfoSinkTest, IntegralFloats)
+{
+    EXPECT_EQ("0.0", ToSinkString(0.0f));
+    EXPECT_EQ("-0.0", ToSinkString(-0.0f));
+    EXPECT_EQ("1.0", ToSinkString(1.0f));
+    EXPECT_EQ("-256.0", ToSinkString(-256.0f));
+    EXPECT_EQ("16777216.0", ToSinkString(16777216.0f));
+    EXPECT_EQ("1000000015047466219876688855040.0", ToSinkString(1e30f));
+    EXPECT_EQ("inf", ToSinkString(std::numeric_limits<float>::infinity()));
+    EXPECT_EQ("-inf", ToSinkString(-std::numeric_limits<float>::infinity()));
+}
+
+// Test that other floats are written with 8 significant digits.
+TEST(InfoSinkTest, FractionalFloats)
+{
+    EXPECT_EQ("0.5", ToSinkString(0.5f));
+    EXPECT_EQ("0.1", ToSinkString(0.1f));
+    EXPECT_EQ("0.33333334", ToSinkString(1.0f / 3.0f));
+    EXPECT_EQ("-2.7182817", ToSinkString(-2.7182817f));
+    EXPECT_EQ("1048576.2", ToSinkString(1048576.25f));
+    EXPECT_EQ("1e-30", ToSinkString(1e-30f));
+    EXPECT_EQ("1.4012985e-45", ToSinkString(std::numeric_limits<float>::denorm_min()));
+}
+
+// Test writing a location with and without a line.
+TEST(InfoSinkTest, Location)
+{
+    TInfoSinkBase sink;
+    sink.location(1, 20);
+    sink.location(3, 0);
+    EXPECT_EQ("1:20: 3:? : ", sink.str());
+}
+
+}  // anonymous namespace
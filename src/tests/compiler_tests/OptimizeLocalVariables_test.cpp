@@ -0,0 +1,252 @@
+//
+// Copyright 2020 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// OptimizeLocalVariables_test.cpp:
+//   Tests for propagating constants and copies stored to local variables and removing dead stores
+//   with SH_OPTIMIZE_LOCAL_VARIABLES.
+//
+
+#include "GLSLANG/ShaderLang.h"
+#include "angle_gl.h"
+#include "gtest/gtest.h"
+#include "tests/test_utils/compiler_test.h"
+
+using namespace sh;
+
+namespace
+{
+
+class OptimizeLocalVariablesTest : public MatchOutputCodeTest
+{
+  public:
+    OptimizeLocalVariablesTest()
+        : MatchOutputCodeTest(GL_FRAGMENT_SHADER,
+                              SH_OPTIMIZE_LOCAL_VARIABLES | SH_VALIDATE_AST,
+                              SH_ESSL_OUTPUT)
+    {
+        addOutputType(SH_GLSL_COMPATIBILITY_OUTPUT);
+    }
+};
+
+// Test that a constant stored to a local variable is propagated to where it's read and folded.
+TEST_F(OptimizeLocalVariablesTest, ConstantIsPropagatedAndFolded)
+{
+    const std::string &shaderString =
+        R"(precision mediump float;
+        void main()
+        {
+            float myConstant = 2.0;
+            float myProduct = myConstant * 3.0;
+            gl_FragColor = vec4(myProduct);
+        })";
+    compile(shaderString);
+
+    ASSERT_TRUE(notFoundInCode("myConstant"));
+    ASSERT_TRUE(notFoundInCode("myProduct"));
+    ASSERT_TRUE(foundInCode("6.0"));
+}
+
+// Test that the optimization only runs when it's requested.
+TEST_F(OptimizeLocalVariablesTest, NotOptimizedWithoutCompileOption)
+{
+    const std::string &shaderString =
+        R"(precision mediump float;
+        void main()
+        {
+            float myConstant = 2.0;
+            gl_FragColor = vec4(myConstant);
+        })";
+    compile(shaderString, SH_VALIDATE_AST);
+
+    ASSERT_TRUE(foundInCode("myConstant"));
+}
+
+// Test that a copy of a uniform is replaced by the uniform.
+TEST_F(OptimizeLocalVariablesTest, CopyOfUniformIsPropagated)
+{
+    const std::string &shaderString =
+        R"(precision mediump float;
+        uniform vec4 u;
+        void main()
+        {
+            vec4 myCopy = u;
+            vec4 myCopyOfCopy = myCopy;
+            gl_FragColor = myCopyOfCopy * 2.0;
+        })";
+    compile(shaderString);
+
+    ASSERT_TRUE(notFoundInCode("myCopy"));
+}
+
+// Test that a copy isn't propagated to where its source is hidden by another declaration.
+TEST_F(OptimizeLocalVariablesTest, HiddenCopySourceIsNotPropagated)
+{
+    const std::string &shaderString =
+        R"(precision mediump float;
+        uniform float u;
+        void main()
+        {
+            float myCopy = u;
+            {
+                float u = 2.0;
+                gl_FragColor = vec4(myCopy + u);
+            }
+        })";
+    compile(shaderString);
+
+    ASSERT_TRUE(foundInCode("myCopy"));
+}
+
+// Test that a copy isn't propagated into a statement that assigns its source before the copy is
+// read.
+TEST_F(OptimizeLocalVariablesTest, CopyIsNotPropagatedPastAssignmentOfSource)
+{
+    const std::string &shaderString =
+        R"(precision mediump float;
+        uniform float u;
+        void main()
+        {
+            float mySource = u * 2.0;
+            float myCopy = mySource;
+            float myResult = (mySource = 3.0) + myCopy;
+            gl_FragColor = vec4(myResult);
+        })";
+    compile(shaderString);
+
+    ASSERT_TRUE(foundInCode("+ _umyCopy"));
+}
+
+// Test that a copy isn't propagated into a statement that increments its source.
+TEST_F(OptimizeLocalVariablesTest, CopyIsNotPropagatedPastIncrementOfSource)
+{
+    const std::string &shaderString =
+        R"(precision mediump float;
+        uniform float u;
+        void main()
+        {
+            float mySource = u * 2.0;
+            float myCopy = mySource;
+            gl_FragColor = vec4(myCopy + mySource++);
+        })";
+    compile(shaderString);
+
+    ASSERT_TRUE(foundInCode("(_umyCopy + "));
+}
+
+// Test that a store that is overwritten before it's read is removed.
+TEST_F(OptimizeLocalVariablesTest, OverwrittenStoreIsRemoved)
+{
+    const std::string &shaderString =
+        R"(precision mediump float;
+        uniform float u;
+        void main()
+        {
+            float myVariable = u * 4.0;
+            myVariable = u * 5.0;
+            gl_FragColor = vec4(myVariable);
+        })";
+    compile(shaderString);
+
+    ASSERT_TRUE(notFoundInCode("4.0"));
+    ASSERT_TRUE(foundInCode("5.0"));
+}
+
+// Test that a store to a variable that is never read is removed, but its side effects are kept.
+TEST_F(OptimizeLocalVariablesTest, UnreadStoreWithSideEffectsKeepsSideEffects)
+{
+    const std::string &shaderString =
+        R"(precision mediump float;
+        uniform float u;
+        float sideEffect(float f)
+        {
+            gl_FragColor = vec4(f);
+            return f;
+        }
+        void main()
+        {
+            float myUnread;
+            myUnread = u * 4.0;
+            myUnread = sideEffect(u);
+        })";
+    compile(shaderString);
+
+    ASSERT_TRUE(notFoundInCode("myUnread"));
+    ASSERT_TRUE(notFoundInCode("4.0"));
+    ASSERT_TRUE(foundInCode("sideEffect(", 2));
+}
+
+// Test that a value is not propagated past a loop that writes the variable.
+TEST_F(OptimizeLocalVariablesTest, ValueWrittenInLoopIsNotPropagated)
+{
+    const std::string &shaderString =
+        R"(precision mediump float;
+        uniform float u;
+        void main()
+        {
+            float mySum = 1.0;
+            for (int i = 0; i < 4; ++i)
+            {
+                mySum += u;
+            }
+            gl_FragColor = vec4(mySum);
+        })";
+    compile(shaderString);
+
+    ASSERT_TRUE(foundInCode("vec4(_umySum)"));
+}
+
+// Test that a value is not propagated past a function call that writes the variable as an out
+// parameter.
+TEST_F(OptimizeLocalVariablesTest, OutParameterIsNotPropagated)
+{
+    const std::string &shaderString =
+        R"(precision mediump float;
+        void setOne(out float f)
+        {
+            f = 1.0;
+        }
+        void main()
+        {
+            float myOut = 0.0;
+            setOne(myOut);
+            gl_FragColor = vec4(myOut);
+        })";
+    compile(shaderString);
+
+    ASSERT_TRUE(foundInCode("vec4(_umyOut)"));
+}
+
+// Test that a value stored in one case of a switch is not assumed in the next case that it falls
+// through to, and that the final case is kept valid when its only statement is removed.
+TEST_F(OptimizeLocalVariablesTest, SwitchFallThrough)
+{
+    const std::string &shaderString =
+        R"(#version 300 es
+        precision mediump float;
+        uniform int u;
+        out vec4 color;
+        void main()
+        {
+            float myValue = 2.0;
+            float myUnread = 0.0;
+            switch (u)
+            {
+                case 0:
+                    myValue = 3.0;
+                case 1:
+                    color = vec4(myValue);
+                    break;
+                default:
+                    myUnread = 4.0;
+            }
+        })";
+    compile(shaderString);
+
+    ASSERT_TRUE(foundInCode("vec4(_umyValue)"));
+    ASSERT_TRUE(notFoundInCode("myUnread"));
+    ASSERT_TRUE(notFoundInCode("default"));
+}
+
+}  // anonymous namespace
@@ -0,0 +1,186 @@
+//
+// Copyright 2020 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ParallelFunctionOutput_test.cpp:
+//   Tests that writing the function definitions on several threads with
+//   SH_PARALLEL_FUNCTION_OUTPUT produces the same output as writing them on one thread.
+//
+
+#include "GLSLANG/ShaderLang.h"
+#include "angle_gl.h"
+#include "gtest/gtest.h"
+#include "tests/test_utils/compiler_test.h"
+
+using namespace sh;
+
+namespace
+{
+
+khronos_uint64_t FNV1aTestHash(const char *str, size_t len)
+{
+    khronos_uint64_t hash = 0xcbf29ce484222325ull;
+    for (size_t index = 0; index < len; ++index)
+    {
+        hash = (hash ^ static_cast<unsigned char>(str[index])) * 0x100000001b3ull;
+    }
+    return hash;
+}
+
+class ParallelFunctionOutputTest : public testing::TestWithParam<ShShaderOutput>
+{
+  protected:
+    void SetUp() override { sh::InitBuiltInResources(&mResources); }
+
+    void compileAndCompare(const std::string &shaderString)
+    {
+        std::string serialCode;
+        std::string parallelCode;
+        std::string infoLog;
+
+        ASSERT_TRUE(compileTestShader(GL_FRAGMENT_SHADER, SH_GLES3_SPEC, GetParam(), shaderString,
+                                      &mResources, SH_OBJECT_CODE, &serialCode, &infoLog))
+            << infoLog;
+        ASSERT_TRUE(compileTestShader(GL_FRAGMENT_SHADER, SH_GLES3_SPEC, GetParam(), shaderString,
+                                      &mResources, SH_OBJECT_CODE | SH_PARALLEL_FUNCTION_OUTPUT,
+                                      &parallelCode, &infoLog))
+            << infoLog;
+
+        EXPECT_EQ(serialCode, parallelCode);
+    }
+
+    ShBuiltInResources mResources;
+};
+
+// Test global declarations between function definitions, and structs declared at the global scope,
+// in function prototypes and in function bodies.
+TEST_P(ParallelFunctionOutputTest, GlobalDeclarationsBetweenFunctions)
+{
+    const std::string &shaderString =
+        R"(#version 300 es
+        precision highp float;
+
+        uniform vec4 u;
+        out vec4 my_FragColor;
+
+        struct A
+        {
+            vec4 v;
+        };
+
+        float f(A a);
+
+        vec4 g(A a)
+        {
+            struct Local
+            {
+                float x;
+            } local;
+            local.x = f(a);
+            return a.v * local.x;
+        }
+
+        struct B
+        {
+            A a;
+            float y;
+        };
+        uniform B ub;
+
+        struct C
+        {
+            float z;
+        } h(float z)
+        {
+            return C(z * ub.y);
+        }
+
+        float f(A a)
+        {
+            return a.v.x + h(a.v.y).z;
+        }
+
+        vec4 k(B b)
+        {
+            for (int i = 0; i < 4; ++i)
+            {
+                b.a.v = g(b.a) + u;
+            }
+            return b.a.v;
+        }
+
+        void main()
+        {
+            my_FragColor = k(ub) + g(A(u));
+        }
+        )";
+    compileAndCompare(shaderString);
+}
+
+// Test that names hashed while writing the function definitions on other threads are the same as
+// the names hashed on one thread.
+TEST_P(ParallelFunctionOutputTest, HashedNames)
+{
+    mResources.HashFunction = FNV1aTestHash;
+
+    std::string shaderString =
+        R"(#version 300 es
+        precision highp float;
+
+        uniform vec4 uValues[4];
+        out vec4 my_FragColor;
+        )";
+    for (int function = 0; function < 32; ++function)
+    {
+        std::string index = std::to_string(function);
+        shaderString += "vec4 function" + index + "(vec4 value" + index + ")\n{\n";
+        shaderString += "    vec4 local" + index + " = value" + index + " * uValues[" +
+                        std::to_string(function % 4) + "];\n";
+        shaderString += "    return local" + index + ";\n}\n";
+    }
+    shaderString += "void main()\n{\n    vec4 color = uValues[0];\n";
+    for (int function = 0; function < 32; ++function)
+    {
+        shaderString += "    color = function" + std::to_string(function) + "(color);\n";
+    }
+    shaderString += "    my_FragColor = color;\n}\n";
+
+    compileAndCompare(shaderString);
+}
+
+// Test that the output doesn't depend on the maximum number of threads.
+TEST_P(ParallelFunctionOutputTest, MaxFunctionOutputThreads)
+{
+    std::string shaderString =
+        R"(#version 300 es
+        precision highp float;
+
+        uniform vec4 u;
+        out vec4 my_FragColor;
+        )";
+    for (int function = 0; function < 16; ++function)
+    {
+        std::string index = std::to_string(function);
+        shaderString += "vec4 function" + index + "(vec4 value)\n{\n";
+        shaderString += "    return value * " + std::to_string(function + 1) + ".0;\n}\n";
+    }
+    shaderString += "void main()\n{\n    vec4 color = u;\n";
+    for (int function = 0; function < 16; ++function)
+    {
+        shaderString += "    color = function" + std::to_string(function) + "(color);\n";
+    }
+    shaderString += "    my_FragColor = color;\n}\n";
+
+    for (int maxThreads : {0, 1, 2, 64})
+    {
+        mResources.MaxFunctionOutputThreads = maxThreads;
+        compileAndCompare(shaderString);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(ParallelFunctionOutputTests,
+                         ParallelFunctionOutputTest,
+                         testing::Values(SH_ESSL_OUTPUT, SH_GLSL_450_CORE_OUTPUT));
+
+}  // anonymous namespace
@@ -1156,6 +1156,64 @@ TEST_P(ClearTestES3, MaskedClearBufferBug)
     EXPECT_PIXEL_NEAR(0, 0, 0, 127, 255, 255, 1);
 }
 
+// Test clearing after a draw when only the second draw buffer is enabled.  The Vulkan backend
+// clears inside the render pass opened by the draw, where the unused draw buffer is a gap in the
+// subpass color attachments.
+TEST_P(ClearTestES3, ClearSparseDrawBufferAfterDraw)
+{
+    // TODO(syoussefi): Qualcomm driver crashes in the presence of VK_ATTACHMENT_UNUSED.
+    // http://anglebug.com/3423
+    ANGLE_SKIP_TEST_IF(IsVulkan() && IsAndroid());
+
+    constexpr char kFS[] = R"(#version 300 es
+precision highp float;
+layout(location = 1) out vec4 color;
+void main()
+{
+    color = vec4(0, 1, 0, 1);
+})";
+    ANGLE_GL_PROGRAM(program, essl3_shaders::vs::Simple(), kFS);
+
+    constexpr GLsizei kSize = 16;
+    const std::vector<GLColor> kInitialData(kSize * kSize, GLColor::red);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, mFBOs[0]);
+
+    GLTexture textures[2];
+    for (GLuint index = 0; index < 2; ++index)
+    {
+        glBindTexture(GL_TEXTURE_2D, textures[index]);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, kSize, kSize, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                     kInitialData.data());
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + index, GL_TEXTURE_2D,
+                               textures[index], 0);
+    }
+
+    GLenum drawBuffers[] = {GL_NONE, GL_COLOR_ATTACHMENT1};
+    glDrawBuffers(2, drawBuffers);
+    glViewport(0, 0, kSize, kSize);
+    ASSERT_GL_FRAMEBUFFER_COMPLETE(GL_FRAMEBUFFER);
+
+    drawQuad(program, essl3_shaders::PositionAttrib(), 0.5f);
+
+    // Clear the top half of the second attachment only.
+    glEnable(GL_SCISSOR_TEST);
+    glScissor(0, kSize / 2, kSize, kSize / 2);
+    glClearColor(0.0f, 0.0f, 1.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    glDisable(GL_SCISSOR_TEST);
+    ASSERT_GL_NO_ERROR();
+
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+    EXPECT_PIXEL_COLOR_EQ(0, 0, GLColor::red);
+    EXPECT_PIXEL_COLOR_EQ(0, kSize - 1, GLColor::red);
+
+    glReadBuffer(GL_COLOR_ATTACHMENT1);
+    EXPECT_PIXEL_COLOR_EQ(0, 0, GLColor::green);
+    EXPECT_PIXEL_COLOR_EQ(0, kSize - 1, GLColor::blue);
+    ASSERT_GL_NO_ERROR();
+}
+
 TEST_P(ClearTestES3, BadFBOSerialBug)
 {
     // First make a simple framebuffer, and clear it to green
@@ -191,6 +191,57 @@ TEST_P(DebugTest, InsertMessageMultiple)
     ASSERT_GL_NO_ERROR();
 }
 
+// Test that the message log keeps messages in order when inserting and draining are interleaved,
+// so the log has to wrap around its storage
+TEST_P(DebugTest, InsertMessageInterleavedWithDrain)
+{
+    ANGLE_SKIP_TEST_IF(!mDebugExtensionAvailable);
+
+    const GLenum source       = GL_DEBUG_SOURCE_APPLICATION;
+    const GLenum type         = GL_DEBUG_TYPE_OTHER;
+    const GLenum severity     = GL_DEBUG_SEVERITY_NOTIFICATION;
+    const size_t roundCount   = 64;
+    const size_t messageCount = 8;
+
+    GLuint nextInsertID = 0;
+    GLuint nextReadID   = 0;
+    for (size_t round = 0; round < roundCount; round++)
+    {
+        for (size_t i = 0; i < messageCount; i++, nextInsertID++)
+        {
+            std::string message(nextInsertID % 37 + 1, 'a' + static_cast<char>(nextInsertID % 26));
+            glDebugMessageInsertKHR(source, type, nextInsertID, severity, -1, message.c_str());
+        }
+
+        // Drain fewer messages than were inserted so the log carries some over to the next round,
+        // then drain everything on the last round.
+        size_t drainCount =
+            (round + 1 == roundCount) ? messageCount * roundCount : messageCount - 1;
+        for (size_t i = 0; i < drainCount && nextReadID < nextInsertID; i++, nextReadID++)
+        {
+            std::string expectedMessage(nextReadID % 37 + 1,
+                                        'a' + static_cast<char>(nextReadID % 26));
+
+            GLuint idBuf      = 0;
+            GLsizei lengthBuf = 0;
+            std::vector<char> messageBuf(expectedMessage.length() + 1);
+            GLuint ret =
+                glGetDebugMessageLogKHR(1, static_cast<GLsizei>(messageBuf.size()), nullptr,
+                                        nullptr, &idBuf, nullptr, &lengthBuf, messageBuf.data());
+            EXPECT_EQ(1u, ret);
+            EXPECT_EQ(nextReadID, idBuf);
+            EXPECT_EQ(static_cast<GLsizei>(expectedMessage.length()), lengthBuf);
+            EXPECT_STREQ(expectedMessage.c_str(), messageBuf.data());
+        }
+    }
+
+    GLint numMessages = 0;
+    glGetIntegerv(GL_DEBUG_LOGGED_MESSAGES, &numMessages);
+    EXPECT_EQ(0, numMessages);
+
+    ASSERT_GL_NO_ERROR();
+}
+
 // Test using a debug callback
 TEST_P(DebugTest, DebugCallback)
 {
@@ -0,0 +1,110 @@
+//
+// Copyright 2020 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+
+// GpuProfileTest.cpp : Tests of the GL_ANGLE_gpu_profile extension.
+
+#include "test_utils/ANGLETest.h"
+
+#include "test_utils/gl_raii.h"
+
+namespace angle
+{
+
+class GpuProfileTest : public ANGLETest
+{
+  protected:
+    GpuProfileTest()
+    {
+        setWindowWidth(128);
+        setWindowHeight(128);
+        setConfigRedBits(8);
+        setConfigGreenBits(8);
+        setConfigBlueBits(8);
+        setConfigAlphaBits(8);
+    }
+
+    GLint64 getGpuProfileTime(GLenum pname)
+    {
+        GLint64 result = -1;
+        glGetInteger64v(pname, &result);
+        EXPECT_GL_NO_ERROR();
+        EXPECT_GE(result, 0);
+        return result;
+    }
+};
+
+// Test that the render pass time grows once a draw call has finished executing.
+TEST_P(GpuProfileTest, RenderPassTime)
+{
+    ANGLE_SKIP_TEST_IF(!IsGLExtensionEnabled("GL_ANGLE_gpu_profile"));
+
+    ANGLE_GL_PROGRAM(program, essl1_shaders::vs::Simple(), essl1_shaders::fs::Red());
+
+    glFinish();
+    const GLint64 renderPassTimeBefore = getGpuProfileTime(GL_GPU_PROFILE_RENDER_PASS_TIME_ANGLE);
+
+    drawQuad(program, essl1_shaders::PositionAttrib(), 0.5f);
+    EXPECT_PIXEL_COLOR_EQ(0, 0, GLColor::red);
+
+    // readPixels has waited for the render pass, and the results are read back without waiting.
+    glFinish();
+    const GLint64 renderPassTimeAfter = getGpuProfileTime(GL_GPU_PROFILE_RENDER_PASS_TIME_ANGLE);
+    EXPECT_GT(renderPassTimeAfter, renderPassTimeBefore);
+}
+
+// Test that the internal time grows when a draw call needs its indices to be converted.
+TEST_P(GpuProfileTest, InternalTime)
+{
+    ANGLE_SKIP_TEST_IF(!IsGLExtensionEnabled("GL_ANGLE_gpu_profile"));
+
+    ANGLE_GL_PROGRAM(program, essl1_shaders::vs::Simple(), essl1_shaders::fs::Red());
+    glUseProgram(program);
+
+    const GLfloat positions[] = {-1.0f, -1.0f, 1.0f, -1.0f, 1.0f, 1.0f, -1.0f, 1.0f};
+    GLBuffer vertexBuffer;
+    glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(positions), positions, GL_STATIC_DRAW);
+
+    GLint positionLocation = glGetAttribLocation(program, essl1_shaders::PositionAttrib());
+    ASSERT_NE(-1, positionLocation);
+    glVertexAttribPointer(positionLocation, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+    glEnableVertexAttribArray(positionLocation);
+
+    // Vulkan has no 8-bit indices, so these are converted on the GPU.
+    const GLubyte indices[] = {0, 1, 2, 0, 2, 3};
+    GLBuffer indexBuffer;
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+
+    glFinish();
+    const GLint64 internalTimeBefore = getGpuProfileTime(GL_GPU_PROFILE_INTERNAL_TIME_ANGLE);
+
+    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_BYTE, nullptr);
+    EXPECT_GL_NO_ERROR();
+
+    glFinish();
+    const GLint64 internalTimeAfter = getGpuProfileTime(GL_GPU_PROFILE_INTERNAL_TIME_ANGLE);
+    EXPECT_GT(internalTimeAfter, internalTimeBefore);
+
+    EXPECT_PIXEL_COLOR_EQ(0, 0, GLColor::red);
+}
+
+// Test that the queries are rejected when the extension isn't available.
+TEST_P(GpuProfileTest, InvalidEnumWithoutExtension)
+{
+    ANGLE_SKIP_TEST_IF(IsGLExtensionEnabled("GL_ANGLE_gpu_profile"));
+
+    GLint64 result = 0;
+    glGetInteger64v(GL_GPU_PROFILE_RENDER_PASS_TIME_ANGLE, &result);
+    EXPECT_GL_ERROR(GL_INVALID_ENUM);
+    glGetInteger64v(GL_GPU_PROFILE_INTERNAL_TIME_ANGLE, &result);
+    EXPECT_GL_ERROR(GL_INVALID_ENUM);
+}
+
+// Use this to select which configurations (e.g. which renderer, which GLES major version) these
+// tests should be run against.
+ANGLE_INSTANTIATE_TEST(GpuProfileTest, ES3_D3D11(), ES3_OPENGL(), ES3_OPENGLES(), ES3_VULKAN());
+}  // namespace angle
@@ -186,6 +186,36 @@ TEST_P(LineLoopTest, LineLoopUIntIndexBuffer)
     glDeleteBuffers(1, &buf);
 }
 
+// Tests that a drawArrays line loop after an indexed draw with client-side indices doesn't reuse the
+// converted indices of the indexed draw.
+TEST_P(LineLoopTest, DrawArraysAfterClientIndices)
+{
+    // Disable D3D11 SDK Layers warnings checks, see ANGLE issue 667 for details
+    ignoreD3D11SDKLayersWarnings();
+
+    static const GLfloat loopPositions[] = {-0.5f, -0.5f, -0.5f, 0.5f, 0.5f, 0.5f, 0.5f, -0.5f};
+    static const GLubyte lineIndices[]   = {0, 0, 0, 0, 0};
+
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    glUseProgram(mProgram);
+    glEnableVertexAttribArray(mPositionLocation);
+    glVertexAttribPointer(mPositionLocation, 2, GL_FLOAT, GL_FALSE, 0, loopPositions);
+
+    glUniform4f(mColorLocation, 0.0f, 0.0f, 1.0f, 1.0f);
+    glDrawArrays(GL_LINE_LOOP, 0, 4);
+
+    // Draws nothing visible, but replaces the current index buffer.
+    glUniform4f(mColorLocation, 0.0f, 0.0f, 0.0f, 0.0f);
+    glDrawElements(GL_LINES, 5, GL_UNSIGNED_BYTE, lineIndices);
+
+    // Same vertex count as the first line loop.
+    glUniform4f(mColorLocation, 0.0f, 1.0f, 0.0f, 1.0f);
+    glDrawArrays(GL_LINE_LOOP, 0, 4);
+
+    checkPixels();
+}
+
 // Tests an edge case with a very large line loop element count.
 // Disabled because it is slow and triggers an internal error.
 TEST_P(LineLoopTest, DISABLED_DrawArraysWithLargeCount)
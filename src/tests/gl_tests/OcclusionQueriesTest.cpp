@@ -321,6 +321,52 @@ TEST_P(OcclusionQueriesTest, MultiQueries)
     glDeleteQueriesEXT(5, query);
 }
 
+// Test many queries in flight at once, spanning several query pools and submissions, as used for
+// visibility culling.
+TEST_P(OcclusionQueriesTest, ManyQueriesInFlight)
+{
+    ANGLE_SKIP_TEST_IF(getClientMajorVersion() < 3 &&
+                       !IsGLExtensionEnabled("GL_EXT_occlusion_query_boolean"));
+
+    constexpr size_t kQueryCount = 200;
+
+    glDepthMask(GL_TRUE);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+
+    // draw a quad at depth 0.5, and keep the depth buffer unchanged afterwards
+    glEnable(GL_DEPTH_TEST);
+    drawQuad(mProgram, essl1_shaders::PositionAttrib(), 0.5f);
+    glDepthMask(GL_FALSE);
+
+    std::vector<GLuint> queries(kQueryCount, 0);
+    glGenQueriesEXT(kQueryCount, queries.data());
+
+    // Alternate between quads in front of and behind the first one.
+    for (size_t index = 0; index < kQueryCount; ++index)
+    {
+        glBeginQueryEXT(GL_ANY_SAMPLES_PASSED_EXT, queries[index]);
+        drawQuad(mProgram, essl1_shaders::PositionAttrib(), index % 2 == 0 ? 0.8f : 0.2f, 0.25f);
+        glEndQueryEXT(GL_ANY_SAMPLES_PASSED_EXT);
+
+        if (index % 50 == 49)
+        {
+            glFlush();
+        }
+    }
+    EXPECT_GL_NO_ERROR();
+
+    for (size_t index = 0; index < kQueryCount; ++index)
+    {
+        GLuint result = GL_TRUE;
+        glGetQueryObjectuivEXT(queries[index], GL_QUERY_RESULT_EXT, &result);
+        EXPECT_EQ(index % 2 == 0 ? static_cast<GLuint>(GL_FALSE) : static_cast<GLuint>(GL_TRUE),
+                  result);
+    }
+    EXPECT_GL_NO_ERROR();
+
+    glDeleteQueriesEXT(kQueryCount, queries.data());
+}
+
 TEST_P(OcclusionQueriesTest, Errors)
 {
     ANGLE_SKIP_TEST_IF(getClientMajorVersion() < 3 &&
@@ -751,6 +751,66 @@ TEST_P(RobustResourceInitTest, ReadingPartiallyInitializedTexture)
     EXPECT_GL_NO_ERROR();
 }
 
+// Several partial uploads that together cover the texture should leave all of their data intact.
+TEST_P(RobustResourceInitTest, SubImagesCoveringTexture)
+{
+    ANGLE_SKIP_TEST_IF(!hasGLExtension());
+
+    // http://anglebug.com/2407, but only fails on Nexus devices
+    ANGLE_SKIP_TEST_IF((IsNexus5X() || IsNexus6P()) && IsOpenGLES());
+
+    GLTexture tex;
+    setupTexture(&tex);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, kWidth, kHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+    constexpr int kHalfWidth  = kWidth / 2;
+    constexpr int kHalfHeight = kHeight / 2;
+
+    const GLColor kQuadrantColors[] = {GLColor::red, GLColor::green, GLColor::blue,
+                                       GLColor::yellow};
+
+    std::vector<GLColor> data(kHalfWidth * kHalfHeight);
+    for (int quadrant = 0; quadrant < 4; ++quadrant)
+    {
+        std::fill(data.begin(), data.end(), kQuadrantColors[quadrant]);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, (quadrant % 2) * kHalfWidth, (quadrant / 2) * kHalfHeight,
+                        kHalfWidth, kHalfHeight, GL_RGBA, GL_UNSIGNED_BYTE, data.data());
+    }
+
+    GLFramebuffer fb;
+    glBindFramebuffer(GL_FRAMEBUFFER, fb);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, tex, 0);
+    EXPECT_GLENUM_EQ(GL_FRAMEBUFFER_COMPLETE, glCheckFramebufferStatus(GL_FRAMEBUFFER));
+
+    for (int quadrant = 0; quadrant < 4; ++quadrant)
+    {
+        EXPECT_PIXEL_RECT_EQ((quadrant % 2) * kHalfWidth, (quadrant / 2) * kHalfHeight, kHalfWidth,
+                             kHalfHeight, kQuadrantColors[quadrant]);
+    }
+    EXPECT_GL_NO_ERROR();
+}
+
+// Partial uploads that don't line up with each other should keep each other's data, and the parts
+// of the texture neither of them wrote should read as 0.
+TEST_P(RobustResourceInitTest, AdjacentUnalignedSubImages)
+{
+    ANGLE_SKIP_TEST_IF(!hasGLExtension());
+
+    // http://anglebug.com/2407, but only fails on Nexus devices
+    ANGLE_SKIP_TEST_IF((IsNexus5X() || IsNexus6P()) && IsOpenGLES());
+
+    GLTexture tex;
+    setupTexture(&tex);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, kWidth, kHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+    std::vector<GLColor> data(kWidth * kHeight, GLColor::white);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 3, 7, 37, 21, GL_RGBA, GL_UNSIGNED_BYTE, data.data());
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 40, 7, 53, 21, GL_RGBA, GL_UNSIGNED_BYTE, data.data());
+
+    checkNonZeroPixels(&tex, 3, 7, 90, 21, GLColor::white);
+    EXPECT_GL_NO_ERROR();
+}
+
 // Uninitialized parts of textures initialized via copyTexImage2D should have all bytes set to 0.
 TEST_P(RobustResourceInitTest, UninitializedPartsOfCopied2DTexturesAreBlack)
 {
@@ -834,6 +894,48 @@ TEST_P(RobustResourceInitTestES3, ReadingOutOfBoundsCopiedTextureWithUnpackBuffe
     EXPECT_GL_NO_ERROR();
 }
 
+// Partial uploads from a pixel unpack buffer with non-default unpack state should still zero-fill
+// the tiles around them with client memory. Regression test for the zeroes being read through the
+// bound PIXEL_UNPACK_BUFFER and its row length and skip values.
+TEST_P(RobustResourceInitTestES3, SubImagesWithUnpackBuffer)
+{
+    ANGLE_SKIP_TEST_IF(!hasGLExtension());
+
+    constexpr int kUploadWidth  = 37;
+    constexpr int kUploadHeight = 21;
+    constexpr int kRowLength    = kUploadWidth + 5;
+    constexpr int kSkipRows     = 2;
+    constexpr int kSkipPixels   = 3;
+
+    GLTexture tex;
+    setupTexture(&tex);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, kWidth, kHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+    GLBuffer buffer;
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer);
+    std::vector<GLColor> data(kRowLength * (kUploadHeight + kSkipRows), GLColor::white);
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, data.size() * sizeof(GLColor), data.data(),
+                 GL_STATIC_DRAW);
+    EXPECT_GL_NO_ERROR();
+
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, kRowLength);
+    glPixelStorei(GL_UNPACK_SKIP_ROWS, kSkipRows);
+    glPixelStorei(GL_UNPACK_SKIP_PIXELS, kSkipPixels);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 3, 7, kUploadWidth, kUploadHeight, GL_RGBA,
+                    GL_UNSIGNED_BYTE, nullptr);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 3 + kUploadWidth, 7, kUploadWidth, kUploadHeight, GL_RGBA,
+                    GL_UNSIGNED_BYTE, nullptr);
+    EXPECT_GL_NO_ERROR();
+
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+    glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    checkNonZeroPixels(&tex, 3, 7, kUploadWidth * 2, kUploadHeight, GLColor::white);
+    EXPECT_GL_NO_ERROR();
+}
+
 // Reading an uninitialized portion of a texture (copyTexImage2D with negative x and y) should
 // succeed with all bytes set to 0.
 TEST_P(RobustResourceInitTest, ReadingOutOfBoundsCopiedTexture)
@@ -79,6 +79,52 @@ TEST_P(SamplersTest, InvalidOverTextureSamplerMaxAnisotropyExt)
     validateInvalidAnisotropy(sampler, maxValue);
 }
 
+// Verify that completeness follows the bound sampler object when a texture is drawn with several
+// samplers in turn, and that changing the texture updates it for all of them.
+TEST_P(SamplersTest, CompletenessWithAlternatingSamplers)
+{
+    ANGLE_GL_PROGRAM(program, essl1_shaders::vs::Texture2D(), essl1_shaders::fs::Texture2D());
+
+    // A texture with only its base level is incomplete with a mipmapped min filter.
+    GLTexture texture;
+    glBindTexture(GL_TEXTURE_2D, texture);
+    std::vector<GLColor> textureData(4 * 4, GLColor::green);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 4, 4, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                 textureData.data());
+
+    GLSampler completeSampler;
+    glSamplerParameteri(completeSampler, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glSamplerParameteri(completeSampler, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+    GLSampler incompleteSampler;
+    glSamplerParameteri(incompleteSampler, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+    glSamplerParameteri(incompleteSampler, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+    for (int iteration = 0; iteration < 3; ++iteration)
+    {
+        glBindSampler(0, completeSampler);
+        drawQuad(program, essl1_shaders::PositionAttrib(), 0.5f);
+        EXPECT_PIXEL_COLOR_EQ(0, 0, GLColor::green);
+
+        glBindSampler(0, incompleteSampler);
+        drawQuad(program, essl1_shaders::PositionAttrib(), 0.5f);
+        EXPECT_PIXEL_COLOR_EQ(0, 0, GLColor::black);
+    }
+
+    // Limiting the texture to its base level makes it complete with both samplers.
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+
+    glBindSampler(0, incompleteSampler);
+    drawQuad(program, essl1_shaders::PositionAttrib(), 0.5f);
+    EXPECT_PIXEL_COLOR_EQ(0, 0, GLColor::green);
+
+    glBindSampler(0, completeSampler);
+    drawQuad(program, essl1_shaders::PositionAttrib(), 0.5f);
+    EXPECT_PIXEL_COLOR_EQ(0, 0, GLColor::green);
+
+    ASSERT_GL_NO_ERROR();
+}
+
 // Use this to select which configurations (e.g. which renderer, which GLES major version) these
 // tests should be run against.
 // Samplers are only supported on ES3.
@@ -457,6 +457,56 @@ TEST_P(StateChangeTest, MultiContextVertexAttribute)
     eglDestroyContext(display, context2);
 }
 
+// Tests deleting identical programs in two contexts while one of them still has draws that use the
+// program to submit.  Backends that share the pipelines of identical programs must keep them alive
+// for those draws.
+TEST_P(StateChangeTest, MultiContextDeleteIdenticalPrograms)
+{
+    EGLWindow *window   = getEGLWindow();
+    EGLDisplay display  = window->getDisplay();
+    EGLConfig config    = window->getConfig();
+    EGLSurface surface  = window->getSurface();
+    EGLContext context1 = window->getContext();
+
+    GLuint program1 = CompileProgram(essl1_shaders::vs::Simple(), essl1_shaders::fs::Red());
+    ASSERT_NE(0u, program1);
+    drawQuad(program1, essl1_shaders::PositionAttrib(), 0.5f);
+    glFinish();
+
+    EGLint contextAttributes[] = {
+        EGL_CONTEXT_MAJOR_VERSION_KHR,
+        GetParam().majorVersion,
+        EGL_CONTEXT_MINOR_VERSION_KHR,
+        GetParam().minorVersion,
+        EGL_NONE,
+    };
+    EGLContext context2 = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttributes);
+    ASSERT_NE(context2, EGL_NO_CONTEXT);
+    eglMakeCurrent(display, surface, surface, context2);
+
+    // Draw without submitting, then delete the program.
+    GLuint program2 = CompileProgram(essl1_shaders::vs::Simple(), essl1_shaders::fs::Red());
+    ASSERT_NE(0u, program2);
+    glClearColor(0.0f, 0.0f, 1.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    drawQuad(program2, essl1_shaders::PositionAttrib(), 0.5f);
+    glDeleteProgram(program2);
+
+    // Delete the last program that uses the same shaders, and wait for the primary context.
+    eglMakeCurrent(display, surface, surface, context1);
+    glDeleteProgram(program1);
+    glFinish();
+    ASSERT_GL_NO_ERROR();
+
+    // The draw of the secondary context is submitted last.
+    eglMakeCurrent(display, surface, surface, context2);
+    EXPECT_PIXEL_COLOR_EQ(0, 0, GLColor::red);
+    ASSERT_GL_NO_ERROR();
+
+    eglMakeCurrent(display, surface, surface, context1);
+    eglDestroyContext(display, context2);
+}
+
 // Ensure that CopyTexSubImage3D syncs framebuffer changes.
 TEST_P(StateChangeTestES3, CopyTexSubImage3DSync)
 {
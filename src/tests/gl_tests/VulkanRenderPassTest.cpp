@@ -0,0 +1,296 @@
+//
+// Copyright 2020 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// VulkanRenderPassTest:
+//   Tests that the Vulkan backend keeps draws and clears in as few render passes as possible, and
+//   that render passes don't store attachments that are never read.
+//
+
+#include "test_utils/ANGLETest.h"
+#include "test_utils/angle_test_instantiate.h"
+// 'None' is defined as 'struct None {};' in
+// third_party/googletest/src/googletest/include/gtest/internal/gtest-type-util.h.
+// But 'None' is also defined as a numeric constant 0L in <X11/X.h>.
+// So we need to include ANGLETest.h first to avoid this conflict.
+
+#include "libANGLE/Context.h"
+#include "libANGLE/renderer/vulkan/ContextVk.h"
+#include "test_utils/gl_raii.h"
+#include "util/EGLWindow.h"
+#include "util/shader_utils.h"
+
+using namespace angle;
+
+namespace
+{
+constexpr GLsizei kSize = 16;
+
+class VulkanRenderPassTest : public ANGLETest
+{
+  protected:
+    VulkanRenderPassTest()
+    {
+        setWindowWidth(kSize);
+        setWindowHeight(kSize);
+        setConfigRedBits(8);
+        setConfigGreenBits(8);
+        setConfigBlueBits(8);
+        setConfigAlphaBits(8);
+        setConfigDepthBits(24);
+    }
+
+    void testSetUp() override
+    {
+        mProgram = CompileProgram(essl1_shaders::vs::Simple(), essl1_shaders::fs::UniformColor());
+        ASSERT_NE(0u, mProgram);
+        mColorLocation = glGetUniformLocation(mProgram, essl1_shaders::ColorUniform());
+        ASSERT_NE(-1, mColorLocation);
+    }
+
+    void testTearDown() override { glDeleteProgram(mProgram); }
+
+    rx::ContextVk *hackANGLE() const
+    {
+        // Hack the angle!
+        const gl::Context *context = static_cast<gl::Context *>(getEGLWindow()->getContext());
+        return rx::GetImplAs<rx::ContextVk>(context);
+    }
+
+    // Submits the pending work and returns the number of render passes submitted so far.
+    uint64_t finishAndGetRenderPassCount()
+    {
+        glFinish();
+        return hackANGLE()->getCommandGraph()->getSubmittedRenderPassCountForTesting();
+    }
+
+    // Submits the pending work and returns the number of attachment bytes render passes were
+    // spared from storing so far.
+    uint64_t finishAndGetStoreBytesSaved()
+    {
+        glFinish();
+        return hackANGLE()->getCommandGraph()->getRenderPassStoreBytesSavedForTesting();
+    }
+
+    void setupFramebuffer(GLTexture *texture, GLFramebuffer *framebuffer)
+    {
+        glBindTexture(GL_TEXTURE_2D, *texture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, kSize, kSize, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                     nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glBindFramebuffer(GL_FRAMEBUFFER, *framebuffer);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, *texture, 0);
+        ASSERT_GLENUM_EQ(GL_FRAMEBUFFER_COMPLETE, glCheckFramebufferStatus(GL_FRAMEBUFFER));
+    }
+
+    void setupDepthFramebuffer(GLTexture *texture,
+                               GLRenderbuffer *depth,
+                               GLFramebuffer *framebuffer)
+    {
+        glBindRenderbuffer(GL_RENDERBUFFER, *depth);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT16, kSize, kSize);
+        setupFramebuffer(texture, framebuffer);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, *depth);
+        ASSERT_GLENUM_EQ(GL_FRAMEBUFFER_COMPLETE, glCheckFramebufferStatus(GL_FRAMEBUFFER));
+    }
+
+    // Draws |texture| to |framebuffer|, which ends the render pass that last drew to |texture|.
+    void drawTexture(const GLTexture &texture, const GLFramebuffer &framebuffer)
+    {
+        ANGLE_GL_PROGRAM(textureProgram, essl1_shaders::vs::Texture2D(),
+                         essl1_shaders::fs::Texture2D());
+
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+        glDisable(GL_DEPTH_TEST);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        drawQuad(textureProgram, essl1_shaders::PositionAttrib(), 0.5f);
+        glEnable(GL_DEPTH_TEST);
+    }
+
+    void drawColor(const GLColor &color)
+    {
+        glUseProgram(mProgram);
+        glUniform4fv(mColorLocation, 1, color.toNormalizedVector().data());
+        drawQuad(mProgram, essl1_shaders::PositionAttrib(), 0.5f);
+    }
+
+    GLuint mProgram      = 0;
+    GLint mColorLocation = -1;
+};
+
+// Ping-pongs between two framebuffers without any dependency between them.  Returning to a
+// framebuffer should continue its render pass instead of starting a new one.
+TEST_P(VulkanRenderPassTest, PingPongWithoutDependencyReusesRenderPasses)
+{
+    ASSERT_TRUE(IsVulkan());
+
+    GLTexture textureA, textureB;
+    GLFramebuffer framebufferA, framebufferB;
+    setupFramebuffer(&textureA, &framebufferA);
+    setupFramebuffer(&textureB, &framebufferB);
+
+    uint64_t renderPassCountBefore = finishAndGetRenderPassCount();
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebufferA);
+    glClearColor(1.0f, 0.0f, 0.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    drawColor(GLColor::red);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebufferB);
+    glClearColor(0.0f, 0.0f, 1.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    drawColor(GLColor::blue);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebufferA);
+    drawColor(GLColor::green);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebufferB);
+    drawColor(GLColor::yellow);
+
+    EXPECT_EQ(renderPassCountBefore + 2, finishAndGetRenderPassCount());
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebufferA);
+    EXPECT_PIXEL_RECT_EQ(0, 0, kSize, kSize, GLColor::green);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebufferB);
+    EXPECT_PIXEL_RECT_EQ(0, 0, kSize, kSize, GLColor::yellow);
+    ASSERT_GL_NO_ERROR();
+}
+
+// Draws with a scissor and then without one.  The render pass should grow to cover the second
+// draw instead of being restarted.
+TEST_P(VulkanRenderPassTest, ScissoredDrawThenFullDrawSharesRenderPass)
+{
+    ASSERT_TRUE(IsVulkan());
+
+    GLTexture texture;
+    GLFramebuffer framebuffer;
+    setupFramebuffer(&texture, &framebuffer);
+
+    uint64_t renderPassCountBefore = finishAndGetRenderPassCount();
+
+    glEnable(GL_SCISSOR_TEST);
+    glScissor(0, 0, kSize / 2, kSize / 2);
+    drawColor(GLColor::red);
+
+    glDisable(GL_SCISSOR_TEST);
+    drawColor(GLColor::green);
+
+    EXPECT_EQ(renderPassCountBefore + 1, finishAndGetRenderPassCount());
+
+    EXPECT_PIXEL_RECT_EQ(0, 0, kSize, kSize, GLColor::green);
+    ASSERT_GL_NO_ERROR();
+}
+
+// Clears part of the framebuffer in between draws.  The clear should be recorded inside the open
+// render pass instead of starting a new one.
+TEST_P(VulkanRenderPassTest, ClearBetweenDrawsSharesRenderPass)
+{
+    ASSERT_TRUE(IsVulkan());
+
+    GLTexture texture;
+    GLFramebuffer framebuffer;
+    setupFramebuffer(&texture, &framebuffer);
+
+    uint64_t renderPassCountBefore = finishAndGetRenderPassCount();
+
+    drawColor(GLColor::red);
+
+    glEnable(GL_SCISSOR_TEST);
+    glScissor(0, 0, kSize / 2, kSize);
+    glClearColor(0.0f, 1.0f, 0.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    glDisable(GL_SCISSOR_TEST);
+
+    EXPECT_EQ(renderPassCountBefore + 1, finishAndGetRenderPassCount());
+
+    EXPECT_PIXEL_RECT_EQ(0, 0, kSize / 2, kSize, GLColor::green);
+    EXPECT_PIXEL_RECT_EQ(kSize / 2, 0, kSize / 2, kSize, GLColor::red);
+    ASSERT_GL_NO_ERROR();
+}
+
+// Uses a framebuffer twice with a full depth clear each time.  The depth written by the first
+// render pass is never read, so it shouldn't be stored.
+TEST_P(VulkanRenderPassTest, FullDepthClearDropsUnreadDepthStore)
+{
+    ASSERT_TRUE(IsVulkan());
+
+    GLTexture textureA, textureB;
+    GLRenderbuffer depthA;
+    GLFramebuffer framebufferA, framebufferB;
+    setupDepthFramebuffer(&textureA, &depthA, &framebufferA);
+    setupFramebuffer(&textureB, &framebufferB);
+
+    glEnable(GL_DEPTH_TEST);
+    uint64_t storeBytesSavedBefore = finishAndGetStoreBytesSaved();
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebufferA);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    drawColor(GLColor::red);
+
+    drawTexture(textureA, framebufferB);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebufferA);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    drawColor(GLColor::green);
+
+    EXPECT_LT(storeBytesSavedBefore, finishAndGetStoreBytesSaved());
+
+    EXPECT_PIXEL_RECT_EQ(0, 0, kSize, kSize, GLColor::green);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebufferB);
+    EXPECT_PIXEL_RECT_EQ(0, 0, kSize, kSize, GLColor::red);
+    ASSERT_GL_NO_ERROR();
+}
+
+// Uses a framebuffer twice, with the second render pass depth testing against the depth written
+// by the first.  The depth must be stored.
+TEST_P(VulkanRenderPassTest, LoadedDepthIsStored)
+{
+    ASSERT_TRUE(IsVulkan());
+
+    GLTexture textureA, textureB;
+    GLRenderbuffer depthA;
+    GLFramebuffer framebufferA, framebufferB;
+    setupDepthFramebuffer(&textureA, &depthA, &framebufferA);
+    setupFramebuffer(&textureB, &framebufferB);
+
+    glEnable(GL_DEPTH_TEST);
+    uint64_t storeBytesSavedBefore = finishAndGetStoreBytesSaved();
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebufferA);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    drawColor(GLColor::red);
+
+    drawTexture(textureA, framebufferB);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebufferA);
+    glDepthFunc(GL_EQUAL);
+    drawColor(GLColor::green);
+    glDepthFunc(GL_LESS);
+
+    EXPECT_EQ(storeBytesSavedBefore, finishAndGetStoreBytesSaved());
+
+    EXPECT_PIXEL_RECT_EQ(0, 0, kSize, kSize, GLColor::green);
+    ASSERT_GL_NO_ERROR();
+}
+
+// The window's depth buffer is undefined after swap, so the frame's render pass shouldn't store
+// it.
+TEST_P(VulkanRenderPassTest, SwapDropsWindowDepthStore)
+{
+    ASSERT_TRUE(IsVulkan());
+
+    glEnable(GL_DEPTH_TEST);
+    uint64_t storeBytesSavedBefore = finishAndGetStoreBytesSaved();
+
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    drawColor(GLColor::green);
+    swapBuffers();
+
+    EXPECT_LT(storeBytesSavedBefore, finishAndGetStoreBytesSaved());
+    ASSERT_GL_NO_ERROR();
+}
+
+ANGLE_INSTANTIATE_TEST(VulkanRenderPassTest, ES2_VULKAN());
+
+}  // anonymous namespace
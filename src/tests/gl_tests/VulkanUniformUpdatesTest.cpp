@@ -475,6 +475,68 @@ TEST_P(VulkanUniformUpdatesTest, TextureStagingBufferRecycling)
     }
 }
 
+// Texture updates through a descriptor update template, with a sampler array whose elements are
+// bound to different units between draws.
+TEST_P(VulkanUniformUpdatesTest, TextureUpdatesWithDescriptorUpdateTemplate)
+{
+    ASSERT_TRUE(IsVulkan());
+    ANGLE_SKIP_TEST_IF(
+        !hackANGLE()->getRenderer()->getFeatures().supportsDescriptorUpdateTemplate.enabled);
+
+    constexpr char kFS[] = R"(varying mediump vec2 v_texCoord;
+uniform sampler2D tex;
+uniform sampler2D texArray[2];
+void main()
+{
+    gl_FragColor = texture2D(tex, v_texCoord) + texture2D(texArray[0], v_texCoord) +
+                   texture2D(texArray[1], v_texCoord);
+})";
+
+    ANGLE_GL_PROGRAM(program, essl1_shaders::vs::Texture2D(), kFS);
+    glUseProgram(program);
+
+    GLint texLoc = glGetUniformLocation(program, "tex");
+    ASSERT_NE(-1, texLoc);
+
+    GLint texArrayLoc = glGetUniformLocation(program, "texArray");
+    ASSERT_NE(-1, texArrayLoc);
+
+    const GLColor kColors[] = {GLColor::red, GLColor::green, GLColor::blue,
+                               GLColor::transparentBlack};
+    GLTexture textures[4];
+    for (GLuint unit = 0; unit < 4; ++unit)
+    {
+        glActiveTexture(GL_TEXTURE0 + unit);
+        InitTexture(kColors[unit], &textures[unit]);
+    }
+    ASSERT_GL_NO_ERROR();
+
+    // Red + green.
+    const GLint kUnits1[] = {1, 3};
+    glUniform1i(texLoc, 0);
+    glUniform1iv(texArrayLoc, 2, kUnits1);
+    drawQuad(program, essl1_shaders::PositionAttrib(), 0.5f, 1.0f, true);
+    EXPECT_PIXEL_COLOR_EQ(0, 0, GLColor::yellow);
+
+    // Green + blue.
+    const GLint kUnits2[] = {1, 2};
+    glUniform1i(texLoc, 3);
+    glUniform1iv(texArrayLoc, 2, kUnits2);
+    drawQuad(program, essl1_shaders::PositionAttrib(), 0.5f, 1.0f, true);
+    EXPECT_PIXEL_COLOR_EQ(0, 0, GLColor::cyan);
+
+    // Replace the texture bound to unit 3 and sample it from the array: red + green + blue.
+    glActiveTexture(GL_TEXTURE3);
+    glBindTexture(GL_TEXTURE_2D, textures[1]);
+    const GLint kUnits3[] = {3, 2};
+    glUniform1i(texLoc, 0);
+    glUniform1iv(texArrayLoc, 2, kUnits3);
+    drawQuad(program, essl1_shaders::PositionAttrib(), 0.5f, 1.0f, true);
+    EXPECT_PIXEL_COLOR_EQ(0, 0, GLColor::white);
+
+    ASSERT_GL_NO_ERROR();
+}
+
 ANGLE_INSTANTIATE_TEST(VulkanUniformUpdatesTest, ES2_VULKAN(), ES3_VULKAN());
 
 }  // anonymous namespace
@@ -59,6 +59,29 @@ void OverrideWorkaroundsD3D(angle::PlatformMethods *platform, angle::FeaturesD3D
     angleRenderTest->overrideWorkaroundsD3D(featuresD3D);
 }
 
+void OverrideFeaturesVk(angle::PlatformMethods *platform, angle::FeaturesVk *featuresVulkan)
+{
+    auto *angleRenderTest = static_cast<ANGLERenderTest *>(platform->context);
+    angleRenderTest->overrideFeaturesVk(featuresVulkan);
+}
+
+void OverrideFeaturesGL(angle::PlatformMethods *platform, angle::FeaturesGL *featuresGL)
+{
+    auto *angleRenderTest = static_cast<ANGLERenderTest *>(platform->context);
+    angleRenderTest->overrideFeaturesGL(featuresGL);
+}
+
+void HistogramCustomCounts(angle::PlatformMethods *platform,
+                           const char *name,
+                           int sample,
+                           int min,
+                           int max,
+                           int bucketCount)
+{
+    auto *angleRenderTest = static_cast<ANGLERenderTest *>(platform->context);
+    angleRenderTest->onHistogramCustomCounts(name, sample);
+}
+
 angle::TraceEventHandle AddPerfTraceEvent(angle::PlatformMethods *platform,
                                           char phase,
                                           const unsigned char *categoryEnabledFlag,
@@ -449,6 +472,8 @@ void ANGLERenderTest::SetUp()
     }
 
     mPlatformMethods.overrideWorkaroundsD3D      = OverrideWorkaroundsD3D;
+    mPlatformMethods.overrideFeaturesVk          = OverrideFeaturesVk;
+    mPlatformMethods.overrideFeaturesGL          = OverrideFeaturesGL;
     mPlatformMethods.logError                    = EmptyPlatformMethod;
     mPlatformMethods.logWarning                  = EmptyPlatformMethod;
     mPlatformMethods.logInfo                     = EmptyPlatformMethod;
@@ -456,6 +481,7 @@ void ANGLERenderTest::SetUp()
     mPlatformMethods.getTraceCategoryEnabledFlag = GetPerfTraceCategoryEnabled;
     mPlatformMethods.updateTraceEventDuration    = UpdateTraceEventDuration;
     mPlatformMethods.monotonicallyIncreasingTime = MonotonicallyIncreasingTime;
+    mPlatformMethods.histogramCustomCounts       = HistogramCustomCounts;
     mPlatformMethods.context                     = this;
 
     if (!mOSWindow->initialize(mName, mTestParams.windowWidth, mTestParams.windowHeight))
@@ -635,6 +661,13 @@ OSWindow *ANGLERenderTest::getWindow()
     return mOSWindow;
 }
 
+EGLWindow *ANGLERenderTest::getEGLWindow()
+{
+    return mTestParams.driver == angle::GLESDriverType::AngleEGL
+               ? static_cast<EGLWindow *>(mGLWindow)
+               : nullptr;
+}
+
 bool ANGLERenderTest::areExtensionPrerequisitesFulfilled() const
 {
     for (const char *extension : mExtensionPrerequisites)
@@ -131,9 +131,17 @@ class ANGLERenderTest : public ANGLEPerfTest
 
     OSWindow *getWindow();
 
+    // Returns nullptr unless the test runs on ANGLE's EGL.
+    EGLWindow *getEGLWindow();
+
     std::vector<TraceEvent> &getTraceEventBuffer();
 
     virtual void overrideWorkaroundsD3D(angle::FeaturesD3D *featuresD3D) {}
+    virtual void overrideFeaturesVk(angle::FeaturesVk *featuresVulkan) {}
+    virtual void overrideFeaturesGL(angle::FeaturesGL *featuresGL) {}
+
+    // Lets tests collect the counts the implementation reports, such as barriers per submission.
+    virtual void onHistogramCustomCounts(const char *name, int sample) {}
 
   protected:
     const RenderTestParams &mTestParams;
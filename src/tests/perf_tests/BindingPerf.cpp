@@ -9,9 +9,12 @@
 
 #include "ANGLEPerfTest.h"
 
+#include <condition_variable>
 #include <iostream>
+#include <mutex>
 #include <random>
 #include <sstream>
+#include <thread>
 
 #include "test_utils/angle_test_instantiate.h"
 #include "util/shader_utils.h"
@@ -20,10 +23,19 @@ namespace angle
 {
 constexpr unsigned int kIterationsPerStep = 128;
 
+constexpr size_t kChurnObjectCount = 40000;
+constexpr size_t kChurnBatchSize   = 512;
+
+// Number of worker threads, each with its own context in the test context's share group.
+constexpr size_t kSharedContextWorkerCount = 3;
+
 enum AllocationStyle
 {
     EVERY_ITERATION,
-    AT_INITIALIZATION
+    AT_INITIALIZATION,
+    // A large pool of objects is allocated at initialization, and a rotating batch of them is
+    // deleted, regenerated and bound every iteration, like a streaming or particle system would.
+    CHURN
 };
 
 struct BindingsParams final : public RenderTestParams
@@ -36,14 +48,20 @@ struct BindingsParams final : public RenderTestParams
         windowWidth  = 720;
         windowHeight = 720;
 
-        numObjects        = 100;
-        allocationStyle   = EVERY_ITERATION;
-        iterationsPerStep = kIterationsPerStep;
+        numObjects         = 100;
+        allocationStyle    = EVERY_ITERATION;
+        iterationsPerStep  = kIterationsPerStep;
+        sharedContextCount = 0;
     }
 
     std::string story() const override;
     size_t numObjects;
     AllocationStyle allocationStyle;
+
+    // When non-zero, this many worker threads bind the objects in their own shared contexts,
+    // alongside the test's context.  Every bind takes the share group lock, so this measures how
+    // much the contexts of a share group contend for it.
+    size_t sharedContextCount;
 };
 
 std::ostream &operator<<(std::ostream &os, const BindingsParams &params)
@@ -67,11 +85,19 @@ std::string BindingsParams::story() const
         case AT_INITIALIZATION:
             strstr << "_allocated_at_initialization";
             break;
+        case CHURN:
+            strstr << "_churned";
+            break;
         default:
             strstr << "_err";
             break;
     }
 
+    if (sharedContextCount > 0)
+    {
+        strstr << "_" << sharedContextCount << "_shared_contexts";
+    }
+
     return strstr.str();
 }
 
@@ -86,12 +112,32 @@ class BindingsBenchmark : public ANGLERenderTest,
     void drawBenchmark() override;
 
   private:
+    void initializeSharedContexts();
+    void destroySharedContexts();
+    void sharedContextWorker(size_t workerIndex);
+    void bindBuffers();
+
     // TODO: Test binding perf of more than just buffers
     std::vector<GLuint> mBuffers;
     std::vector<GLenum> mBindingPoints;
+    size_t mChurnOffset;
+
+    std::vector<EGLContext> mSharedContexts;
+    std::vector<EGLSurface> mSharedSurfaces;
+    std::vector<std::thread> mSharedContextWorkers;
+    std::mutex mWorkerMutex;
+    std::condition_variable mWorkerCondition;
+    size_t mWorkerStep;
+    size_t mRunningWorkerCount;
+    bool mWorkersExit;
 };
 
-BindingsBenchmark::BindingsBenchmark() : ANGLERenderTest("Bindings", GetParam())
+BindingsBenchmark::BindingsBenchmark()
+    : ANGLERenderTest("Bindings", GetParam()),
+      mChurnOffset(0),
+      mWorkerStep(0),
+      mRunningWorkerCount(0),
+      mWorkersExit(false)
 {
     // Flaky on Windows Intel OpenGL. http://crbug.com/974083
     if (IsIntel() && GetParam().eglParameters.renderer == EGL_PLATFORM_ANGLE_TYPE_OPENGL_ANGLE)
@@ -105,7 +151,7 @@ void BindingsBenchmark::initializeBenchmark()
     const auto &params = GetParam();
 
     mBuffers.resize(params.numObjects, 0);
-    if (params.allocationStyle == AT_INITIALIZATION)
+    if (params.allocationStyle == AT_INITIALIZATION || params.allocationStyle == CHURN)
     {
         glGenBuffers(static_cast<GLsizei>(mBuffers.size()), mBuffers.data());
         for (size_t bufferIdx = 0; bufferIdx < mBuffers.size(); bufferIdx++)
@@ -133,12 +179,124 @@ void BindingsBenchmark::initializeBenchmark()
         mBindingPoints.push_back(GL_DRAW_INDIRECT_BUFFER);
         mBindingPoints.push_back(GL_DISPATCH_INDIRECT_BUFFER);
     }
+
+    if (params.sharedContextCount > 0)
+    {
+        initializeSharedContexts();
+    }
+}
+
+void BindingsBenchmark::initializeSharedContexts()
+{
+    EGLWindow *window = getEGLWindow();
+    if (window == nullptr)
+    {
+        mSkipTest = true;
+        return;
+    }
+
+    // Each worker needs its own surface, since a surface can only be current on one thread.
+    const EGLint surfaceAttribs[] = {EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE};
+    for (size_t workerIndex = 0; workerIndex < GetParam().sharedContextCount; ++workerIndex)
+    {
+        EGLContext context = window->createContext(window->getContext());
+        EGLSurface surface =
+            eglCreatePbufferSurface(window->getDisplay(), window->getConfig(), surfaceAttribs);
+        ASSERT_NE(EGL_NO_CONTEXT, context);
+        ASSERT_NE(EGL_NO_SURFACE, surface);
+        mSharedContexts.push_back(context);
+        mSharedSurfaces.push_back(surface);
+    }
+
+    for (size_t workerIndex = 0; workerIndex < mSharedContexts.size(); ++workerIndex)
+    {
+        mSharedContextWorkers.emplace_back(&BindingsBenchmark::sharedContextWorker, this,
+                                           workerIndex);
+    }
+}
+
+void BindingsBenchmark::destroySharedContexts()
+{
+    {
+        std::lock_guard<std::mutex> lock(mWorkerMutex);
+        mWorkersExit = true;
+    }
+    mWorkerCondition.notify_all();
+    for (std::thread &worker : mSharedContextWorkers)
+    {
+        worker.join();
+    }
+    mSharedContextWorkers.clear();
+
+    EGLWindow *window = getEGLWindow();
+    for (EGLSurface surface : mSharedSurfaces)
+    {
+        eglDestroySurface(window->getDisplay(), surface);
+    }
+    for (EGLContext context : mSharedContexts)
+    {
+        eglDestroyContext(window->getDisplay(), context);
+    }
+    mSharedSurfaces.clear();
+    mSharedContexts.clear();
+}
+
+void BindingsBenchmark::sharedContextWorker(size_t workerIndex)
+{
+    EGLDisplay display = getEGLWindow()->getDisplay();
+    EGLSurface surface = mSharedSurfaces[workerIndex];
+    eglMakeCurrent(display, surface, surface, mSharedContexts[workerIndex]);
+
+    size_t workerStep = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mWorkerMutex);
+            mWorkerCondition.wait(lock,
+                                  [&]() { return mWorkersExit || mWorkerStep != workerStep; });
+            if (mWorkersExit)
+            {
+                break;
+            }
+            workerStep = mWorkerStep;
+        }
+
+        bindBuffers();
+
+        {
+            std::lock_guard<std::mutex> lock(mWorkerMutex);
+            mRunningWorkerCount--;
+        }
+        mWorkerCondition.notify_all();
+    }
+
+    eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+}
+
+void BindingsBenchmark::bindBuffers()
+{
+    const auto &params = GetParam();
+
+    for (unsigned int it = 0; it < params.iterationsPerStep; ++it)
+    {
+        size_t bindingIndex = it % mBindingPoints.size();
+        for (GLuint buffer : mBuffers)
+        {
+            glBindBuffer(mBindingPoints[bindingIndex], buffer);
+            ++bindingIndex;
+            bindingIndex = (bindingIndex >= mBindingPoints.size()) ? 0 : bindingIndex;
+        }
+    }
 }
 
 void BindingsBenchmark::destroyBenchmark()
 {
     const auto &params = GetParam();
-    if (params.allocationStyle == AT_INITIALIZATION)
+    if (params.sharedContextCount > 0)
+    {
+        destroySharedContexts();
+    }
+    if (params.allocationStyle == AT_INITIALIZATION || params.allocationStyle == CHURN)
     {
         glDeleteBuffers(static_cast<GLsizei>(mBuffers.size()), mBuffers.data());
     }
@@ -148,6 +306,46 @@ void BindingsBenchmark::drawBenchmark()
 {
     const auto &params = GetParam();
 
+    if (params.sharedContextCount > 0)
+    {
+        // Every context in the share group, including this one, does the same work.
+        {
+            std::lock_guard<std::mutex> lock(mWorkerMutex);
+            mRunningWorkerCount = mSharedContextWorkers.size();
+            mWorkerStep++;
+        }
+        mWorkerCondition.notify_all();
+
+        bindBuffers();
+
+        std::unique_lock<std::mutex> lock(mWorkerMutex);
+        mWorkerCondition.wait(lock, [this]() { return mRunningWorkerCount == 0; });
+
+        ASSERT_GL_NO_ERROR();
+        return;
+    }
+
+    if (params.allocationStyle == CHURN)
+    {
+        for (unsigned int it = 0; it < params.iterationsPerStep; ++it)
+        {
+            // Replace a batch of buffers in the middle of the pool and bind the new ones.
+            GLuint *batch = &mBuffers[mChurnOffset];
+            glDeleteBuffers(static_cast<GLsizei>(kChurnBatchSize), batch);
+            glGenBuffers(static_cast<GLsizei>(kChurnBatchSize), batch);
+            for (size_t bufferIdx = 0; bufferIdx < kChurnBatchSize; bufferIdx++)
+            {
+                glBindBuffer(mBindingPoints[bufferIdx % mBindingPoints.size()], batch[bufferIdx]);
+            }
+
+            mChurnOffset += kChurnBatchSize;
+            mChurnOffset = (mChurnOffset + kChurnBatchSize > mBuffers.size()) ? 0 : mChurnOffset;
+        }
+
+        ASSERT_GL_NO_ERROR();
+        return;
+    }
+
     for (unsigned int it = 0; it < params.iterationsPerStep; ++it)
     {
         // Generate a buffer (if needed) and bind it to a "random" binding point
@@ -217,6 +415,18 @@ BindingsParams VulkanParams(AllocationStyle allocationStyle)
     return params;
 }
 
+BindingsParams ChurnParams(BindingsParams params)
+{
+    params.numObjects = kChurnObjectCount;
+    return params;
+}
+
+BindingsParams SharedContextParams(BindingsParams params)
+{
+    params.sharedContextCount = kSharedContextWorkerCount;
+    return params;
+}
+
 TEST_P(BindingsBenchmark, Run)
 {
     run();
@@ -230,6 +440,12 @@ ANGLE_INSTANTIATE_TEST(BindingsBenchmark,
                        OpenGLOrGLESParams(EVERY_ITERATION),
                        OpenGLOrGLESParams(AT_INITIALIZATION),
                        VulkanParams(EVERY_ITERATION),
-                       VulkanParams(AT_INITIALIZATION));
+                       VulkanParams(AT_INITIALIZATION),
+                       ChurnParams(D3D11Params(CHURN)),
+                       ChurnParams(OpenGLOrGLESParams(CHURN)),
+                       ChurnParams(VulkanParams(CHURN)),
+                       SharedContextParams(D3D11Params(AT_INITIALIZATION)),
+                       SharedContextParams(OpenGLOrGLESParams(AT_INITIALIZATION)),
+                       SharedContextParams(VulkanParams(AT_INITIALIZATION)));
 
 }  // namespace angle
@@ -16,6 +16,8 @@
 #include "compiler/translator/InitializeGlobals.h"
 #include "compiler/translator/PoolAlloc.h"
 
+#include <sstream>
+
 namespace
 {
 
@@ -162,6 +164,104 @@ void main()
 
 const char *kTrickyESSL300Id = "TrickyESSL300";
 
+// This shader writes many float and integer constants, which makes the output of numbers a
+// significant part of the translation.
+const char *kConstantsESSL300FragSource = R"(#version 300 es
+precision highp float;
+precision highp int;
+
+uniform int ui;
+
+out vec4 my_FragColor;
+
+const vec4 kWeights[16] = vec4[16](
+    vec4(0.0, 8.41471, 90.929743, 141.120008),
+    vec4(-0.756802, -9.589243, -27.94155, 656.986599),
+    vec4(0.989358, 4.121185, -54.402111, -999.990207),
+    vec4(-0.536573, 4.20167, 99.060736, 650.28784),
+    vec4(-0.287903, -9.613975, -75.098725, 149.87721),
+    vec4(0.912945, 8.366556, -0.885131, -846.220404),
+    vec4(-0.905578, -1.323518, 76.255845, 956.375928),
+    vec4(0.270906, -6.636339, -98.803162, -404.037645),
+    vec4(0.551427, 9.999119, 52.908269, -428.182669),
+    vec4(-0.991779, -6.435381, 29.636858, 963.795386),
+    vec4(0.745113, -1.586227, -91.652155, -831.774743),
+    vec4(0.017702, 8.509035, 90.178835, 123.573123),
+    vec4(-0.768255, -9.537527, -26.237485, 670.229176),
+    vec4(0.986628, 3.959252, -55.878905, -999.755173),
+    vec4(-0.521551, 4.361648, 99.287265, 636.738007),
+    vec4(-0.304811, -9.661178, -73.91807, 167.3557));
+
+const ivec4 kOffsets[4] = ivec4[4](ivec4(0, -1, 2, -3), ivec4(40, -50, 600, -700),
+                                   ivec4(8000, -9000, 10000, -11000),
+                                   ivec4(120000, -130000, 1400000, -15000000));
+
+void main()
+{
+    vec4 color = vec4(0.0);
+    for (int i = 0; i < 16; ++i)
+    {
+        color += kWeights[i] * float(kOffsets[i / 4][i % 4] + ui) * 0.0625;
+    }
+    color += vec4(1.5, -2.25, 1000000.0, 0.001) + vec4(3.14159274, 2.71828175, 1.41421354, 0.5);
+    my_FragColor = color;
+})";
+
+const char *kConstantsESSL300Id = "ConstantsESSL300";
+
+// An uber-shader with many functions, which are all called from main.
+const char *GetManyFunctionsESSL300FragSource()
+{
+    constexpr int kFunctionCount = 256;
+
+    static const std::string source = []() {
+        std::stringstream sourceStream;
+        sourceStream << R"(#version 300 es
+precision highp float;
+
+struct Light
+{
+    vec3 position;
+    vec3 color;
+    float attenuation;
+};
+uniform Light uLights[4];
+uniform vec4 uValues[4];
+
+out vec4 my_FragColor;
+)";
+        for (int function = 0; function < kFunctionCount; ++function)
+        {
+            sourceStream << "\nvec4 shade" << function << "(vec4 value)\n{\n"
+                         << R"(    vec4 result = value;
+    for (int i = 0; i < 4; ++i)
+    {
+        vec3 toLight = uLights[i].position - result.xyz * )"
+                         << (function + 1) << R"(.0;
+        float lightDistance = length(toLight);
+        float lambert = max(dot(normalize(toLight), vec3(0.0, 0.0, 1.0)), 0.0);
+        result.rgb += uLights[i].color * lambert /
+                      (1.0 + uLights[i].attenuation * lightDistance * lightDistance);
+        result = mix(result, uValues[i], 0.125) * vec4(1.01, 0.99, 1.0, 1.0);
+    }
+    return result;
+}
+)";
+        }
+        sourceStream << "\nvoid main()\n{\n    vec4 color = uValues[0];\n";
+        for (int function = 0; function < kFunctionCount; ++function)
+        {
+            sourceStream << "    color = shade" << function << "(color);\n";
+        }
+        sourceStream << "    my_FragColor = color;\n}\n";
+        return sourceStream.str();
+    }();
+
+    return source.c_str();
+}
+
+const char *kManyFunctionsESSL300Id = "ManyFunctionsESSL300";
+
 constexpr int kNumIterationsPerStep = 4;
 
 struct CompilerParameters
@@ -223,15 +323,23 @@ struct CompilerPerfParameters final : public CompilerParameters
 {
     CompilerPerfParameters(ShShaderOutput output,
                            const char *shaderSource,
-                           const char *shaderSourceId)
-        : CompilerParameters(output), shaderSource(shaderSource)
+                           const char *shaderSourceId,
+                           ShCompileOptions extraCompileOptions = 0)
+        : CompilerParameters(output),
+          shaderSource(shaderSource),
+          extraCompileOptions(extraCompileOptions)
     {
         testId = shaderSourceId;
         testId += "_";
         testId += CompilerParameters::str();
+        if ((extraCompileOptions & SH_PARALLEL_FUNCTION_OUTPUT) != 0)
+        {
+            testId += "_parallel_output";
+        }
     }
 
     const char *shaderSource;
+    ShCompileOptions extraCompileOptions;
     std::string testId;
 };
 
@@ -306,6 +414,7 @@ void CompilerPerfTest::step()
 
     ShCompileOptions compileOptions = SH_OBJECT_CODE | SH_VARIABLES |
                                       SH_INITIALIZE_UNINITIALIZED_LOCALS | SH_INIT_OUTPUT_VARIABLES;
+    compileOptions |= GetParam().extraCompileOptions;
 
 #if !defined(NDEBUG)
     // Make sure that compilation succeeds and print the info log if it doesn't in debug mode.
@@ -333,15 +442,37 @@ ANGLE_INSTANTIATE_TEST(
     CompilerPerfParameters(SH_HLSL_4_1_OUTPUT, kSimpleESSL300FragSource, kSimpleESSL300Id),
     CompilerPerfParameters(SH_HLSL_4_1_OUTPUT, kRealWorldESSL100FragSource, kRealWorldESSL100Id),
     CompilerPerfParameters(SH_HLSL_4_1_OUTPUT, kTrickyESSL300FragSource, kTrickyESSL300Id),
+    CompilerPerfParameters(SH_HLSL_4_1_OUTPUT, kConstantsESSL300FragSource, kConstantsESSL300Id),
     CompilerPerfParameters(SH_GLSL_450_CORE_OUTPUT, kSimpleESSL100FragSource, kSimpleESSL100Id),
     CompilerPerfParameters(SH_GLSL_450_CORE_OUTPUT, kSimpleESSL300FragSource, kSimpleESSL300Id),
     CompilerPerfParameters(SH_GLSL_450_CORE_OUTPUT,
                            kRealWorldESSL100FragSource,
                            kRealWorldESSL100Id),
     CompilerPerfParameters(SH_GLSL_450_CORE_OUTPUT, kTrickyESSL300FragSource, kTrickyESSL300Id),
+    CompilerPerfParameters(SH_GLSL_450_CORE_OUTPUT,
+                           kConstantsESSL300FragSource,
+                           kConstantsESSL300Id),
     CompilerPerfParameters(SH_ESSL_OUTPUT, kSimpleESSL100FragSource, kSimpleESSL100Id),
     CompilerPerfParameters(SH_ESSL_OUTPUT, kSimpleESSL300FragSource, kSimpleESSL300Id),
     CompilerPerfParameters(SH_ESSL_OUTPUT, kRealWorldESSL100FragSource, kRealWorldESSL100Id),
-    CompilerPerfParameters(SH_ESSL_OUTPUT, kTrickyESSL300FragSource, kTrickyESSL300Id));
+    CompilerPerfParameters(SH_ESSL_OUTPUT, kTrickyESSL300FragSource, kTrickyESSL300Id),
+    CompilerPerfParameters(SH_ESSL_OUTPUT, kConstantsESSL300FragSource, kConstantsESSL300Id),
+    CompilerPerfParameters(SH_HLSL_4_1_OUTPUT,
+                           GetManyFunctionsESSL300FragSource(),
+                           kManyFunctionsESSL300Id),
+    CompilerPerfParameters(SH_GLSL_450_CORE_OUTPUT,
+                           GetManyFunctionsESSL300FragSource(),
+                           kManyFunctionsESSL300Id),
+    CompilerPerfParameters(SH_GLSL_450_CORE_OUTPUT,
+                           GetManyFunctionsESSL300FragSource(),
+                           kManyFunctionsESSL300Id,
+                           SH_PARALLEL_FUNCTION_OUTPUT),
+    CompilerPerfParameters(SH_ESSL_OUTPUT,
+                           GetManyFunctionsESSL300FragSource(),
+                           kManyFunctionsESSL300Id),
+    CompilerPerfParameters(SH_ESSL_OUTPUT,
+                           GetManyFunctionsESSL300FragSource(),
+                           kManyFunctionsESSL300Id,
+                           SH_PARALLEL_FUNCTION_OUTPUT));
 
 }  // anonymous namespace
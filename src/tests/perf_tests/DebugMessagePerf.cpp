@@ -0,0 +1,213 @@
+//
+// Copyright 2020 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// DebugMessagePerf:
+//   Performance test for emitting GL_KHR_debug messages.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include <sstream>
+#include <vector>
+
+using namespace angle;
+
+namespace
+{
+constexpr unsigned int kIterationsPerStep = 1024;
+constexpr GLuint kMessageId               = 1;
+constexpr char kMessage[] = "Performance warning: draw call triggered a pipeline state recompile.";
+
+enum class DebugOutput
+{
+    // Messages are appended to the message log, which is drained once per step.
+    Log,
+    // Messages are delivered to an application callback.
+    Callback,
+    // Messages are disabled with glDebugMessageControl and dropped.
+    Filtered,
+};
+
+struct DebugMessageParams final : public RenderTestParams
+{
+    DebugMessageParams()
+    {
+        iterationsPerStep = kIterationsPerStep;
+
+        majorVersion = 2;
+        minorVersion = 0;
+        windowWidth  = 16;
+        windowHeight = 16;
+        output       = DebugOutput::Log;
+    }
+
+    std::string story() const override;
+
+    DebugOutput output;
+};
+
+std::ostream &operator<<(std::ostream &os, const DebugMessageParams &params)
+{
+    os << params.backendAndStory().substr(1);
+    return os;
+}
+
+std::string DebugMessageParams::story() const
+{
+    std::stringstream strstr;
+
+    strstr << RenderTestParams::story();
+
+    switch (output)
+    {
+        case DebugOutput::Log:
+            strstr << "_log";
+            break;
+        case DebugOutput::Callback:
+            strstr << "_callback";
+            break;
+        case DebugOutput::Filtered:
+            strstr << "_filtered";
+            break;
+    }
+
+    return strstr.str();
+}
+
+void GL_APIENTRY CountMessagesCallback(GLenum source,
+                                       GLenum type,
+                                       GLuint id,
+                                       GLenum severity,
+                                       GLsizei length,
+                                       const GLchar *message,
+                                       const void *userParam)
+{
+    size_t *messageCount = static_cast<size_t *>(const_cast<void *>(userParam));
+    (*messageCount)++;
+}
+
+class DebugMessageBenchmark : public ANGLERenderTest,
+                              public ::testing::WithParamInterface<DebugMessageParams>
+{
+  public:
+    DebugMessageBenchmark();
+
+    void initializeBenchmark() override;
+    void destroyBenchmark() override;
+    void drawBenchmark() override;
+
+  private:
+    size_t mCallbackMessageCount;
+    std::vector<GLchar> mMessageLog;
+};
+
+DebugMessageBenchmark::DebugMessageBenchmark()
+    : ANGLERenderTest("DebugMessage", GetParam()), mCallbackMessageCount(0)
+{
+    addExtensionPrerequisite("GL_KHR_debug");
+}
+
+void DebugMessageBenchmark::initializeBenchmark()
+{
+    const auto &params = GetParam();
+
+    glEnable(GL_DEBUG_OUTPUT_KHR);
+
+    // Start from an empty log so every step observes the same amount of work.
+    GLint loggedMessages = 0;
+    glGetIntegerv(GL_DEBUG_LOGGED_MESSAGES_KHR, &loggedMessages);
+    GLint maxMessageLength = 0;
+    glGetIntegerv(GL_MAX_DEBUG_MESSAGE_LENGTH_KHR, &maxMessageLength);
+    GLint maxLoggedMessages = 0;
+    glGetIntegerv(GL_MAX_DEBUG_LOGGED_MESSAGES_KHR, &maxLoggedMessages);
+    mMessageLog.resize(static_cast<size_t>(maxMessageLength) * maxLoggedMessages);
+    glGetDebugMessageLogKHR(loggedMessages, static_cast<GLsizei>(mMessageLog.size()), nullptr,
+                            nullptr, nullptr, nullptr, nullptr, mMessageLog.data());
+
+    switch (params.output)
+    {
+        case DebugOutput::Log:
+            break;
+        case DebugOutput::Callback:
+            glDebugMessageCallbackKHR(CountMessagesCallback, &mCallbackMessageCount);
+            break;
+        case DebugOutput::Filtered:
+            glDebugMessageControlKHR(GL_DEBUG_SOURCE_APPLICATION_KHR, GL_DEBUG_TYPE_PERFORMANCE_KHR,
+                                     GL_DONT_CARE, 0, nullptr, GL_FALSE);
+            break;
+    }
+
+    ASSERT_GL_NO_ERROR();
+}
+
+void DebugMessageBenchmark::destroyBenchmark()
+{
+    glDebugMessageCallbackKHR(nullptr, nullptr);
+    glDisable(GL_DEBUG_OUTPUT_KHR);
+}
+
+void DebugMessageBenchmark::drawBenchmark()
+{
+    const auto &params = GetParam();
+
+    for (unsigned int iteration = 0; iteration < params.iterationsPerStep; ++iteration)
+    {
+        glDebugMessageInsertKHR(GL_DEBUG_SOURCE_APPLICATION_KHR, GL_DEBUG_TYPE_PERFORMANCE_KHR,
+                                kMessageId, GL_DEBUG_SEVERITY_MEDIUM_KHR, -1, kMessage);
+    }
+
+    if (params.output == DebugOutput::Log)
+    {
+        // Drain the log like a telemetry client polling once per frame would.
+        GLint loggedMessages = 0;
+        glGetIntegerv(GL_DEBUG_LOGGED_MESSAGES_KHR, &loggedMessages);
+        glGetDebugMessageLogKHR(loggedMessages, static_cast<GLsizei>(mMessageLog.size()), nullptr,
+                                nullptr, nullptr, nullptr, nullptr, mMessageLog.data());
+    }
+
+    ASSERT_GL_NO_ERROR();
+}
+
+DebugMessageParams D3D11Params(DebugOutput output)
+{
+    DebugMessageParams params;
+    params.eglParameters = egl_platform::D3D11_NULL();
+    params.output        = output;
+    return params;
+}
+
+DebugMessageParams OpenGLOrGLESParams(DebugOutput output)
+{
+    DebugMessageParams params;
+    params.eglParameters = egl_platform::OPENGL_OR_GLES_NULL();
+    params.output        = output;
+    return params;
+}
+
+DebugMessageParams VulkanParams(DebugOutput output)
+{
+    DebugMessageParams params;
+    params.eglParameters = egl_platform::VULKAN_NULL();
+    params.output        = output;
+    return params;
+}
+
+}  // anonymous namespace
+
+TEST_P(DebugMessageBenchmark, Run)
+{
+    run();
+}
+
+ANGLE_INSTANTIATE_TEST(DebugMessageBenchmark,
+                       D3D11Params(DebugOutput::Log),
+                       D3D11Params(DebugOutput::Callback),
+                       D3D11Params(DebugOutput::Filtered),
+                       OpenGLOrGLESParams(DebugOutput::Log),
+                       OpenGLOrGLESParams(DebugOutput::Callback),
+                       OpenGLOrGLESParams(DebugOutput::Filtered),
+                       VulkanParams(DebugOutput::Log),
+                       VulkanParams(DebugOutput::Callback),
+                       VulkanParams(DebugOutput::Filtered));
@@ -9,6 +9,7 @@
 
 #include "ANGLEPerfTest.h"
 #include "DrawCallPerfParams.h"
+#include "platform/FeaturesVk.h"
 #include "test_utils/draw_call_perf_utils.h"
 #include "util/shader_utils.h"
 
@@ -21,6 +22,8 @@ enum class StateChange
     VertexBuffer,
     ManyVertexBuffers,
     Texture,
+    // GLES1 only: toggle fixed-function lighting and fog between draws.
+    FixedFunction,
 };
 
 struct DrawArraysPerfParams : public DrawCallPerfParams
@@ -30,6 +33,15 @@ struct DrawArraysPerfParams : public DrawCallPerfParams
     std::string story() const override;
 
     StateChange stateChange = StateChange::NoChange;
+
+    // Draw GL_LINE_LOOPs instead of GL_TRIANGLES.
+    bool lineLoop = false;
+
+    // Vulkan only: submit and present from the CommandQueue's worker thread.
+    bool asyncCommandQueue = false;
+
+    // Draw with the GLES1 fixed-function pipeline.
+    bool gles1 = false;
 };
 
 std::string DrawArraysPerfParams::story() const
@@ -52,10 +64,28 @@ std::string DrawArraysPerfParams::story() const
         case StateChange::Texture:
             strstr << "_tex_change";
             break;
+        case StateChange::FixedFunction:
+            strstr << "_fixed_function_change";
+            break;
         default:
             break;
     }
 
+    if (lineLoop)
+    {
+        strstr << "_line_loop";
+    }
+
+    if (asyncCommandQueue)
+    {
+        strstr << "_async_queue";
+    }
+
+    if (gles1)
+    {
+        strstr << "_gles1";
+    }
+
     return strstr.str();
 }
 
@@ -105,7 +135,11 @@ class DrawCallPerfBenchmark : public ANGLERenderTest,
     void destroyBenchmark() override;
     void drawBenchmark() override;
 
+    void overrideFeaturesVk(angle::FeaturesVk *featuresVulkan) override;
+
   private:
+    void initializeGLES1();
+
     GLuint mProgram    = 0;
     GLuint mBuffer1    = 0;
     GLuint mBuffer2    = 0;
@@ -122,6 +156,12 @@ void DrawCallPerfBenchmark::initializeBenchmark()
 {
     const auto &params = GetParam();
 
+    if (params.gles1)
+    {
+        initializeGLES1();
+        return;
+    }
+
     if (params.stateChange == StateChange::Texture)
     {
         mProgram = SetupSimpleTextureProgram();
@@ -195,8 +235,46 @@ void main()
     ASSERT_GL_NO_ERROR();
 }
 
+void DrawCallPerfBenchmark::initializeGLES1()
+{
+    const auto &params = GetParam();
+
+    // Lighting and fog are computed in the fragment shader of the GLES1 emulation, along with
+    // texturing.
+    glEnable(GL_TEXTURE_2D);
+    glColor4f(0.5f, 0.5f, 1.0f, 1.0f);
+    glFogf(GL_FOG_MODE, GL_LINEAR);
+
+    const GLfloat lightDiffuse[] = {1.0f, 1.0f, 0.0f, 1.0f};
+    glLightfv(GL_LIGHT0, GL_DIFFUSE, lightDiffuse);
+    glEnable(GL_LIGHT0);
+
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+
+    mBuffer1 = Create2DTriangleBuffer(mNumTris, GL_STATIC_DRAW);
+    glVertexPointer(2, GL_FLOAT, 0, nullptr);
+    glEnableClientState(GL_VERTEX_ARRAY);
+
+    glViewport(0, 0, getWindow()->getWidth(), getWindow()->getHeight());
+
+    mTexture1 = CreateSimpleTexture2D();
+    mTexture2 = CreateSimpleTexture2D();
+
+    // The GLES1 emulation draws to the default framebuffer only.
+    ASSERT_FALSE(params.offscreen);
+    ASSERT_GL_NO_ERROR();
+}
+
 void DrawCallPerfBenchmark::destroyBenchmark()
 {
+    if (GetParam().gles1)
+    {
+        glDeleteBuffers(1, &mBuffer1);
+        glDeleteTextures(1, &mTexture1);
+        glDeleteTextures(1, &mTexture2);
+        return;
+    }
+
     glDeleteProgram(mProgram);
     glDeleteBuffers(1, &mBuffer1);
     glDeleteBuffers(1, &mBuffer2);
@@ -206,6 +284,11 @@ void DrawCallPerfBenchmark::destroyBenchmark()
     glDeleteFramebuffers(1, &mFBO);
 }
 
+void DrawCallPerfBenchmark::overrideFeaturesVk(angle::FeaturesVk *featuresVulkan)
+{
+    featuresVulkan->overrideFeatures({"async_command_queue"}, GetParam().asyncCommandQueue);
+}
+
 void ClearThenDraw(unsigned int iterations, GLsizei numElements)
 {
     glClear(GL_COLOR_BUFFER_BIT);
@@ -224,6 +307,17 @@ void JustDraw(unsigned int iterations, GLsizei numElements)
     }
 }
 
+void DrawLineLoops(unsigned int iterations, GLsizei numElements)
+{
+    // Alternate between two vertex counts and two first vertices, like a CAD viewer drawing many
+    // outlines out of one buffer would.
+    for (unsigned int it = 0; it < iterations; it++)
+    {
+        glDrawArrays(GL_LINE_LOOP, 0, numElements);
+        glDrawArrays(GL_LINE_LOOP, 1, numElements - 1);
+    }
+}
+
 template <int kArrayBufferCount>
 void ChangeVertexAttribThenDraw(unsigned int iterations, GLsizei numElements, GLuint buffer)
 {
@@ -282,6 +376,26 @@ void ChangeTextureThenDraw(unsigned int iterations,
     }
 }
 
+void ChangeFixedFunctionThenDraw(unsigned int iterations, GLsizei numElements)
+{
+    // Cycle through the combinations of lighting and fog, like an application drawing lit and
+    // unlit objects would.
+    for (unsigned int it = 0; it < iterations; it++)
+    {
+        glEnable(GL_LIGHTING);
+        glDrawArrays(GL_TRIANGLES, 0, numElements);
+
+        glEnable(GL_FOG);
+        glDrawArrays(GL_TRIANGLES, 0, numElements);
+
+        glDisable(GL_LIGHTING);
+        glDrawArrays(GL_TRIANGLES, 0, numElements);
+
+        glDisable(GL_FOG);
+        glDrawArrays(GL_TRIANGLES, 0, numElements);
+    }
+}
+
 void DrawCallPerfBenchmark::drawBenchmark()
 {
     // This workaround fixes a huge queue of graphics commands accumulating on the GL
@@ -291,6 +405,13 @@ void DrawCallPerfBenchmark::drawBenchmark()
     const auto &params    = GetParam();
     GLsizei numElements   = static_cast<GLsizei>(3 * mNumTris);
 
+    if (params.lineLoop)
+    {
+        DrawLineLoops(params.iterationsPerStep, numElements);
+        ASSERT_GL_NO_ERROR();
+        return;
+    }
+
     switch (params.stateChange)
     {
         case StateChange::VertexAttrib:
@@ -307,6 +428,9 @@ void DrawCallPerfBenchmark::drawBenchmark()
         case StateChange::Texture:
             ChangeTextureThenDraw(params.iterationsPerStep, numElements, mTexture1, mTexture2);
             break;
+        case StateChange::FixedFunction:
+            ChangeFixedFunctionThenDraw(params.iterationsPerStep, numElements);
+            break;
         case StateChange::NoChange:
             if (eglParams.deviceType != EGL_PLATFORM_ANGLE_DEVICE_TYPE_NULL_ANGLE ||
                 (eglParams.renderer != EGL_PLATFORM_ANGLE_TYPE_OPENGL_ANGLE &&
@@ -336,12 +460,36 @@ DrawArraysPerfParams DrawArrays(const DrawCallPerfParams &base, StateChange stat
     return params;
 }
 
+DrawArraysPerfParams LineLoop(const DrawArraysPerfParams &base)
+{
+    DrawArraysPerfParams params(base);
+    params.lineLoop = true;
+    return params;
+}
+
+DrawArraysPerfParams AsyncCommandQueue(const DrawArraysPerfParams &base)
+{
+    DrawArraysPerfParams params(base);
+    params.asyncCommandQueue = true;
+    return params;
+}
+
+DrawArraysPerfParams GLES1(const DrawArraysPerfParams &base)
+{
+    DrawArraysPerfParams params(base);
+    params.majorVersion = 1;
+    params.minorVersion = 1;
+    params.gles1        = true;
+    return params;
+}
+
 using namespace params;
 
 ANGLE_INSTANTIATE_TEST(DrawCallPerfBenchmark,
                        DrawArrays(DrawCallD3D9(), StateChange::NoChange),
                        DrawArrays(NullDevice(DrawCallD3D9()), StateChange::NoChange),
                        DrawArrays(DrawCallD3D11(), StateChange::NoChange),
+                       LineLoop(DrawArrays(DrawCallD3D11(), StateChange::NoChange)),
                        DrawArrays(NullDevice(DrawCallD3D11()), StateChange::NoChange),
                        DrawArrays(NullDevice(Offscreen(DrawCallD3D11())), StateChange::NoChange),
                        DrawArrays(DrawCallD3D11(), StateChange::VertexAttrib),
@@ -352,6 +500,7 @@ ANGLE_INSTANTIATE_TEST(DrawCallPerfBenchmark,
                        DrawArrays(NullDevice(DrawCallD3D11()), StateChange::Texture),
                        DrawArrays(DrawCallOpenGL(), StateChange::NoChange),
                        DrawArrays(NullDevice(DrawCallOpenGL()), StateChange::NoChange),
+                       LineLoop(DrawArrays(DrawCallOpenGL(), StateChange::NoChange)),
                        DrawArrays(NullDevice(Offscreen(DrawCallOpenGL())), StateChange::NoChange),
                        DrawArrays(DrawCallOpenGL(), StateChange::VertexAttrib),
                        DrawArrays(NullDevice(DrawCallOpenGL()), StateChange::VertexAttrib),
@@ -361,10 +510,17 @@ ANGLE_INSTANTIATE_TEST(DrawCallPerfBenchmark,
                        DrawArrays(NullDevice(DrawCallOpenGL()), StateChange::ManyVertexBuffers),
                        DrawArrays(DrawCallOpenGL(), StateChange::Texture),
                        DrawArrays(NullDevice(DrawCallOpenGL()), StateChange::Texture),
+                       GLES1(DrawArrays(DrawCallOpenGL(), StateChange::NoChange)),
+                       GLES1(DrawArrays(DrawCallOpenGL(), StateChange::FixedFunction)),
                        DrawArrays(DrawCallValidation(), StateChange::NoChange),
                        DrawArrays(DrawCallVulkan(), StateChange::NoChange),
                        DrawArrays(Offscreen(DrawCallVulkan()), StateChange::NoChange),
                        DrawArrays(NullDevice(DrawCallVulkan()), StateChange::NoChange),
+                       AsyncCommandQueue(DrawArrays(DrawCallVulkan(), StateChange::NoChange)),
+                       AsyncCommandQueue(DrawArrays(Offscreen(DrawCallVulkan()),
+                                                    StateChange::NoChange)),
+                       LineLoop(DrawArrays(DrawCallVulkan(), StateChange::NoChange)),
+                       LineLoop(DrawArrays(NullDevice(DrawCallVulkan()), StateChange::NoChange)),
                        DrawArrays(DrawCallVulkan(), StateChange::VertexAttrib),
                        DrawArrays(Offscreen(DrawCallVulkan()), StateChange::VertexAttrib),
                        DrawArrays(NullDevice(DrawCallVulkan()), StateChange::VertexAttrib),
@@ -377,6 +533,12 @@ ANGLE_INSTANTIATE_TEST(DrawCallPerfBenchmark,
                        DrawArrays(DrawCallVulkan(), StateChange::Texture),
                        DrawArrays(Offscreen(DrawCallVulkan()), StateChange::Texture),
                        DrawArrays(NullDevice(DrawCallVulkan()), StateChange::Texture),
+                       GLES1(DrawArrays(DrawCallVulkan(), StateChange::NoChange)),
+                       GLES1(DrawArrays(NullDevice(DrawCallVulkan()), StateChange::NoChange)),
+                       GLES1(DrawArrays(DrawCallVulkan(), StateChange::Texture)),
+                       GLES1(DrawArrays(NullDevice(DrawCallVulkan()), StateChange::Texture)),
+                       GLES1(DrawArrays(DrawCallVulkan(), StateChange::FixedFunction)),
+                       GLES1(DrawArrays(NullDevice(DrawCallVulkan()), StateChange::FixedFunction)),
                        DrawArrays(DrawCallWGL(), StateChange::NoChange),
                        DrawArrays(Offscreen(DrawCallWGL()), StateChange::NoChange),
                        DrawArrays(DrawCallWGL(), StateChange::VertexAttrib),
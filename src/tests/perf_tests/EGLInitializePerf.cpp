@@ -5,6 +5,8 @@
 //
 // EGLInitializePerfTest:
 //   Performance test for device creation.
+// EGLCreateContextPerfTest:
+//   Performance test for creating and destroying short-lived contexts on an initialized display.
 //
 
 #include "ANGLEPerfTest.h"
@@ -72,13 +74,17 @@ class EGLInitializePerfTest : public ANGLEPerfTest,
     OSWindow *mOSWindow;
     EGLDisplay mDisplay;
     Captures mCaptures;
+
+    // The first initialization is cold; later ones can reuse the Vulkan format properties that the
+    // first one left in the blob cache.
+    Timer mInitTimer;
+    double mColdInitSeconds;
+    double mWarmInitSeconds;
+    unsigned int mWarmInitCount;
 };
 
-EGLInitializePerfTest::EGLInitializePerfTest()
-    : ANGLEPerfTest("EGLInitialize", "", "_run", 1), mOSWindow(nullptr), mDisplay(EGL_NO_DISPLAY)
+EGLDisplay GetPlatformDisplay(OSWindow *osWindow, const EGLPlatformParameters &platform)
 {
-    auto platform = GetParam().eglParameters;
-
     std::vector<EGLint> displayAttributes;
     displayAttributes.push_back(EGL_PLATFORM_ANGLE_TYPE_ANGLE);
     displayAttributes.push_back(platform.renderer);
@@ -95,20 +101,31 @@ EGLInitializePerfTest::EGLInitializePerfTest()
     }
     displayAttributes.push_back(EGL_NONE);
 
-    mOSWindow = OSWindow::New();
-    mOSWindow->initialize("EGLInitialize Test", 64, 64);
-
     auto eglGetPlatformDisplayEXT = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
         eglGetProcAddress("eglGetPlatformDisplayEXT"));
     if (eglGetPlatformDisplayEXT == nullptr)
     {
         std::cerr << "Error getting platform display!" << std::endl;
-        return;
+        return EGL_NO_DISPLAY;
     }
 
-    mDisplay = eglGetPlatformDisplayEXT(EGL_PLATFORM_ANGLE_ANGLE,
-                                        reinterpret_cast<void *>(mOSWindow->getNativeDisplay()),
-                                        &displayAttributes[0]);
+    return eglGetPlatformDisplayEXT(EGL_PLATFORM_ANGLE_ANGLE,
+                                    reinterpret_cast<void *>(osWindow->getNativeDisplay()),
+                                    &displayAttributes[0]);
+}
+
+EGLInitializePerfTest::EGLInitializePerfTest()
+    : ANGLEPerfTest("EGLInitialize", "", "_run", 1),
+      mOSWindow(nullptr),
+      mDisplay(EGL_NO_DISPLAY),
+      mColdInitSeconds(0),
+      mWarmInitSeconds(0),
+      mWarmInitCount(0)
+{
+    mOSWindow = OSWindow::New();
+    mOSWindow->initialize("EGLInitialize Test", 64, 64);
+
+    mDisplay = GetPlatformDisplay(mOSWindow, GetParam().eglParameters);
 }
 
 void EGLInitializePerfTest::SetUp()
@@ -125,6 +142,8 @@ void EGLInitializePerfTest::SetUp()
     mReporter->RegisterImportantMetric(".LoadDLLs", "ms");
     mReporter->RegisterImportantMetric(".D3D11CreateDevice", "ms");
     mReporter->RegisterImportantMetric(".InitResources", "ms");
+    mReporter->RegisterImportantMetric(".ColdInitialize", "ms");
+    mReporter->RegisterImportantMetric(".WarmInitialize", "ms");
 }
 
 EGLInitializePerfTest::~EGLInitializePerfTest()
@@ -137,9 +156,21 @@ void EGLInitializePerfTest::step()
     ASSERT_NE(EGL_NO_DISPLAY, mDisplay);
 
     EGLint majorVersion, minorVersion;
+    mInitTimer.start();
     ASSERT_EQ(static_cast<EGLBoolean>(EGL_TRUE),
               eglInitialize(mDisplay, &majorVersion, &minorVersion));
+    mInitTimer.stop();
     ASSERT_EQ(static_cast<EGLBoolean>(EGL_TRUE), eglTerminate(mDisplay));
+
+    if (mColdInitSeconds == 0)
+    {
+        mColdInitSeconds = mInitTimer.getElapsedTime();
+    }
+    else
+    {
+        mWarmInitSeconds += mInitTimer.getElapsedTime();
+        mWarmInitCount++;
+    }
 }
 
 void EGLInitializePerfTest::TearDown()
@@ -148,6 +179,11 @@ void EGLInitializePerfTest::TearDown()
     mReporter->AddResult(".LoadDLLs", normalizedTime(mCaptures.loadDLLsMS));
     mReporter->AddResult(".D3D11CreateDevice", normalizedTime(mCaptures.createDeviceMS));
     mReporter->AddResult(".InitResources", normalizedTime(mCaptures.initResourcesMS));
+    mReporter->AddResult(".ColdInitialize", mColdInitSeconds * 1000.0);
+    if (mWarmInitCount > 0)
+    {
+        mReporter->AddResult(".WarmInitialize", mWarmInitSeconds * 1000.0 / mWarmInitCount);
+    }
 
     ANGLEResetDisplayPlatform(mDisplay);
 }
@@ -159,4 +195,99 @@ TEST_P(EGLInitializePerfTest, Run)
 
 ANGLE_INSTANTIATE_TEST(EGLInitializePerfTest, angle::ES2_D3D11(), angle::ES2_VULKAN());
 
+constexpr unsigned int kContextCreateIterations = 10;
+
+class EGLCreateContextPerfTest : public ANGLEPerfTest,
+                                 public WithParamInterface<angle::PlatformParameters>
+{
+  public:
+    EGLCreateContextPerfTest();
+    ~EGLCreateContextPerfTest();
+
+    void step() override;
+    void SetUp() override;
+    void TearDown() override;
+
+  private:
+    OSWindow *mOSWindow;
+    EGLDisplay mDisplay;
+    EGLConfig mConfig;
+    EGLSurface mSurface;
+};
+
+EGLCreateContextPerfTest::EGLCreateContextPerfTest()
+    : ANGLEPerfTest("EGLCreateContext", "", "_run", kContextCreateIterations),
+      mOSWindow(nullptr),
+      mDisplay(EGL_NO_DISPLAY),
+      mConfig(nullptr),
+      mSurface(EGL_NO_SURFACE)
+{
+    mOSWindow = OSWindow::New();
+    mOSWindow->initialize("EGLCreateContext Test", 64, 64);
+
+    mDisplay = GetPlatformDisplay(mOSWindow, GetParam().eglParameters);
+}
+
+EGLCreateContextPerfTest::~EGLCreateContextPerfTest()
+{
+    OSWindow::Delete(&mOSWindow);
+}
+
+void EGLCreateContextPerfTest::SetUp()
+{
+    ANGLEPerfTest::SetUp();
+
+    ASSERT_NE(EGL_NO_DISPLAY, mDisplay);
+    EGLint majorVersion, minorVersion;
+    ASSERT_EQ(static_cast<EGLBoolean>(EGL_TRUE),
+              eglInitialize(mDisplay, &majorVersion, &minorVersion));
+
+    EGLint numConfigs;
+    EGLint configAttrs[] = {EGL_RED_SIZE,        8,
+                            EGL_GREEN_SIZE,      8,
+                            EGL_BLUE_SIZE,       8,
+                            EGL_RENDERABLE_TYPE, EGL_OPENGL_ES2_BIT,
+                            EGL_SURFACE_TYPE,    EGL_PBUFFER_BIT,
+                            EGL_NONE};
+    ASSERT_EQ(static_cast<EGLBoolean>(EGL_TRUE),
+              eglChooseConfig(mDisplay, configAttrs, &mConfig, 1, &numConfigs));
+    ASSERT_EQ(1, numConfigs);
+
+    EGLint surfaceAttribs[] = {EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE};
+    mSurface                = eglCreatePbufferSurface(mDisplay, mConfig, surfaceAttribs);
+    ASSERT_NE(EGL_NO_SURFACE, mSurface);
+}
+
+void EGLCreateContextPerfTest::step()
+{
+    EGLint contextAttribs[] = {EGL_CONTEXT_CLIENT_VERSION, 2, EGL_NONE};
+
+    // Mimic a service that spins up a context per job: create it, bind it and tear it down again.
+    for (unsigned int iteration = 0; iteration < kContextCreateIterations; ++iteration)
+    {
+        EGLContext context = eglCreateContext(mDisplay, mConfig, EGL_NO_CONTEXT, contextAttribs);
+        ASSERT_NE(EGL_NO_CONTEXT, context);
+        ASSERT_EQ(static_cast<EGLBoolean>(EGL_TRUE),
+                  eglMakeCurrent(mDisplay, mSurface, mSurface, context));
+        ASSERT_EQ(static_cast<EGLBoolean>(EGL_TRUE),
+                  eglMakeCurrent(mDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT));
+        ASSERT_EQ(static_cast<EGLBoolean>(EGL_TRUE), eglDestroyContext(mDisplay, context));
+    }
+}
+
+void EGLCreateContextPerfTest::TearDown()
+{
+    ANGLEPerfTest::TearDown();
+
+    eglDestroySurface(mDisplay, mSurface);
+    eglTerminate(mDisplay);
+}
+
+TEST_P(EGLCreateContextPerfTest, Run)
+{
+    run();
+}
+
+ANGLE_INSTANTIATE_TEST(EGLCreateContextPerfTest, angle::ES2_D3D11(), angle::ES2_VULKAN());
+
 }  // namespace
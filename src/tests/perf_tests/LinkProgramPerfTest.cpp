@@ -10,8 +10,11 @@
 #include "ANGLEPerfTest.h"
 
 #include <array>
+#include <sstream>
 
 #include "common/vector_utils.h"
+#include "platform/FeaturesGL.h"
+#include "platform/FeaturesVk.h"
 #include "util/shader_utils.h"
 
 using namespace angle;
@@ -19,6 +22,8 @@ using namespace angle;
 namespace
 {
 
+constexpr int kLocalVariableShaderStages = 64;
+
 enum class TaskOption
 {
     CompileOnly,
@@ -47,6 +52,11 @@ struct LinkProgramParams final : public RenderTestParams
         windowHeight = 256;
         taskOption   = taskOptionIn;
         threadOption = threadOptionIn;
+
+        cacheShaderSpirv = true;
+
+        localVariableShaders         = false;
+        optimizeShaderLocalVariables = false;
     }
 
     std::string story() const override
@@ -77,11 +87,37 @@ struct LinkProgramParams final : public RenderTestParams
             strstr << "_null";
         }
 
+        if (!cacheShaderSpirv)
+        {
+            strstr << "_no_spirv_cache";
+        }
+
+        if (localVariableShaders)
+        {
+            strstr << "_local_variables";
+        }
+
+        if (optimizeShaderLocalVariables)
+        {
+            strstr << "_optimized";
+        }
+
         return strstr.str();
     }
 
     TaskOption taskOption;
     ThreadOption threadOption;
+
+    // Vulkan only: every step links the same shaders, so all but the first reuse the SPIR-V
+    // generated by glslang when it is cached.
+    bool cacheShaderSpirv;
+
+    // Compile a fragment shader with many local variables, like generated shaders have.
+    bool localVariableShaders;
+
+    // OpenGL only: the translator propagates constants and copies of local variables and removes
+    // dead stores before the driver compiles the shaders.
+    bool optimizeShaderLocalVariables;
 };
 
 std::ostream &operator<<(std::ostream &os, const LinkProgramParams &params)
@@ -100,11 +136,45 @@ class LinkProgramBenchmark : public ANGLERenderTest,
     void destroyBenchmark() override;
     void drawBenchmark() override;
 
+    void overrideFeaturesVk(angle::FeaturesVk *featuresVulkan) override;
+    void overrideFeaturesGL(angle::FeaturesGL *featuresGL) override;
+
   protected:
     GLuint mVertexBuffer = 0;
+
+    // Size of the translated shaders, if the translated source can be queried.
+    bool mHasTranslatedShaderSource = false;
+    GLint mTranslatedShaderSize     = 0;
 };
 
-LinkProgramBenchmark::LinkProgramBenchmark() : ANGLERenderTest("LinkProgram", GetParam()) {}
+// Every stage copies its input and initializes its parameters with constants, and some compute
+// values that end up unused.
+std::string GetLocalVariableFragmentShader()
+{
+    std::stringstream shader;
+    shader << "precision mediump float;\n"
+              "uniform vec4 uColor;\n"
+              "uniform float uScale;\n"
+              "void main() {\n"
+              "    vec4 value0 = uColor;\n";
+    for (int stage = 1; stage <= kLocalVariableShaderStages; ++stage)
+    {
+        shader << "    vec4 input" << stage << " = value" << stage - 1 << ";\n"
+               << "    float scale" << stage << " = 1.0;\n"
+               << "    float bias" << stage << " = 0.0;\n"
+               << "    float unused" << stage << " = uScale * " << stage << ".0;\n"
+               << "    vec4 value" << stage << " = input" << stage << " * (scale" << stage
+               << " * uScale) + bias" << stage << ";\n";
+    }
+    shader << "    gl_FragColor = value" << kLocalVariableShaderStages << ";\n"
+           << "}";
+    return shader.str();
+}
+
+LinkProgramBenchmark::LinkProgramBenchmark() : ANGLERenderTest("LinkProgram", GetParam())
+{
+    mReporter->RegisterFyiMetric(".translated_shader_size", "bytes");
+}
 
 void LinkProgramBenchmark::initializeBenchmark()
 {
@@ -113,6 +183,10 @@ void LinkProgramBenchmark::initializeBenchmark()
         glMaxShaderCompilerThreadsKHR(0);
     }
 
+    mHasTranslatedShaderSource =
+        CheckExtensionExists(reinterpret_cast<const char *>(glGetString(GL_EXTENSIONS)),
+                             "GL_ANGLE_translated_shader_source");
+
     std::array<Vector3, 6> vertices = {{Vector3(-1.0f, 1.0f, 0.5f), Vector3(-1.0f, -1.0f, 0.5f),
                                         Vector3(1.0f, -1.0f, 0.5f), Vector3(-1.0f, 1.0f, 0.5f),
                                         Vector3(1.0f, -1.0f, 0.5f), Vector3(1.0f, 1.0f, 0.5f)}};
@@ -126,6 +200,22 @@ void LinkProgramBenchmark::initializeBenchmark()
 void LinkProgramBenchmark::destroyBenchmark()
 {
     glDeleteBuffers(1, &mVertexBuffer);
+
+    if (mTranslatedShaderSize > 0)
+    {
+        mReporter->AddResult(".translated_shader_size", static_cast<size_t>(mTranslatedShaderSize));
+    }
+}
+
+void LinkProgramBenchmark::overrideFeaturesVk(angle::FeaturesVk *featuresVulkan)
+{
+    featuresVulkan->overrideFeatures({"cache_shader_spirv"}, GetParam().cacheShaderSpirv);
+}
+
+void LinkProgramBenchmark::overrideFeaturesGL(angle::FeaturesGL *featuresGL)
+{
+    featuresGL->overrideFeatures({"optimize_shader_local_variables"},
+                                 GetParam().optimizeShaderLocalVariables);
 }
 
 void LinkProgramBenchmark::drawBenchmark()
@@ -140,11 +230,26 @@ void LinkProgramBenchmark::drawBenchmark()
         "void main() {\n"
         "    gl_FragColor = vec4(1, 0, 0, 1);\n"
         "}";
+    static const std::string localVariableFragmentShader = GetLocalVariableFragmentShader();
+
     GLuint vs = CompileShader(GL_VERTEX_SHADER, vertexShader);
-    GLuint fs = CompileShader(GL_FRAGMENT_SHADER, fragmentShader);
+    GLuint fs = CompileShader(GL_FRAGMENT_SHADER, GetParam().localVariableShaders
+                                                      ? localVariableFragmentShader.c_str()
+                                                      : fragmentShader);
 
     ASSERT_NE(0u, vs);
     ASSERT_NE(0u, fs);
+
+    // Every step translates the same shaders, so the size only needs to be queried once.
+    if (mHasTranslatedShaderSource && mTranslatedShaderSize == 0)
+    {
+        GLint vsSize = 0;
+        GLint fsSize = 0;
+        glGetShaderiv(vs, GL_TRANSLATED_SHADER_SOURCE_LENGTH_ANGLE, &vsSize);
+        glGetShaderiv(fs, GL_TRANSLATED_SHADER_SOURCE_LENGTH_ANGLE, &fsSize);
+        mTranslatedShaderSize = vsSize + fsSize;
+    }
+
     if (GetParam().taskOption == TaskOption::CompileOnly)
     {
         glDeleteShader(vs);
@@ -195,6 +300,16 @@ LinkProgramParams LinkProgramOpenGLOrGLESParams(TaskOption taskOption, ThreadOpt
     return params;
 }
 
+LinkProgramParams LinkProgramOpenGLOrGLESLocalVariablesParams(TaskOption taskOption,
+                                                             ThreadOption threadOption,
+                                                             bool optimizeShaderLocalVariables)
+{
+    LinkProgramParams params = LinkProgramOpenGLOrGLESParams(taskOption, threadOption);
+    params.localVariableShaders         = true;
+    params.optimizeShaderLocalVariables = optimizeShaderLocalVariables;
+    return params;
+}
+
 LinkProgramParams LinkProgramVulkanParams(TaskOption taskOption, ThreadOption threadOption)
 {
     LinkProgramParams params(taskOption, threadOption);
@@ -202,6 +317,14 @@ LinkProgramParams LinkProgramVulkanParams(TaskOption taskOption, ThreadOption th
     return params;
 }
 
+LinkProgramParams LinkProgramVulkanNoSpirvCacheParams(TaskOption taskOption,
+                                                     ThreadOption threadOption)
+{
+    LinkProgramParams params = LinkProgramVulkanParams(taskOption, threadOption);
+    params.cacheShaderSpirv  = false;
+    return params;
+}
+
 TEST_P(LinkProgramBenchmark, Run)
 {
     run();
@@ -224,6 +347,13 @@ ANGLE_INSTANTIATE_TEST(
     LinkProgramD3D11Params(TaskOption::CompileAndLink, ThreadOption::SingleThread),
     LinkProgramD3D9Params(TaskOption::CompileAndLink, ThreadOption::SingleThread),
     LinkProgramOpenGLOrGLESParams(TaskOption::CompileAndLink, ThreadOption::SingleThread),
-    LinkProgramVulkanParams(TaskOption::CompileAndLink, ThreadOption::SingleThread));
+    LinkProgramVulkanParams(TaskOption::CompileAndLink, ThreadOption::SingleThread),
+    LinkProgramVulkanNoSpirvCacheParams(TaskOption::CompileAndLink, ThreadOption::SingleThread),
+    LinkProgramOpenGLOrGLESLocalVariablesParams(TaskOption::CompileAndLink,
+                                                ThreadOption::SingleThread,
+                                                false),
+    LinkProgramOpenGLOrGLESLocalVariablesParams(TaskOption::CompileAndLink,
+                                                ThreadOption::SingleThread,
+                                                true));
 
 }  // anonymous namespace
@@ -0,0 +1,231 @@
+//
+// Copyright 2020 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// ObjectChurnPerf:
+//   Performance test for creating and deleting many objects at once, like a level load does.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include <sstream>
+#include <vector>
+
+using namespace angle;
+
+namespace
+{
+constexpr unsigned int kIterationsPerStep = 4;
+constexpr size_t kObjectsPerIteration     = 1024;
+
+enum class ChurnObjectType
+{
+    Buffer,
+    Texture,
+};
+
+struct ObjectChurnParams final : public RenderTestParams
+{
+    ObjectChurnParams()
+    {
+        iterationsPerStep = kIterationsPerStep;
+
+        majorVersion = 2;
+        minorVersion = 0;
+        windowWidth  = 16;
+        windowHeight = 16;
+
+        objectType       = ChurnObjectType::Texture;
+        boundObjectCount = 0;
+    }
+
+    std::string story() const override;
+
+    ChurnObjectType objectType;
+
+    // Number of the created objects that are still bound when they are deleted.
+    size_t boundObjectCount;
+};
+
+std::ostream &operator<<(std::ostream &os, const ObjectChurnParams &params)
+{
+    os << params.backendAndStory().substr(1);
+    return os;
+}
+
+std::string ObjectChurnParams::story() const
+{
+    std::stringstream strstr;
+
+    strstr << RenderTestParams::story();
+
+    switch (objectType)
+    {
+        case ChurnObjectType::Buffer:
+            strstr << "_buffers";
+            break;
+        case ChurnObjectType::Texture:
+            strstr << "_textures";
+            break;
+    }
+
+    if (boundObjectCount > 0)
+    {
+        strstr << "_" << boundObjectCount << "_bound";
+    }
+
+    return strstr.str();
+}
+
+class ObjectChurnBenchmark : public ANGLERenderTest,
+                             public ::testing::WithParamInterface<ObjectChurnParams>
+{
+  public:
+    ObjectChurnBenchmark();
+
+    void initializeBenchmark() override;
+    void destroyBenchmark() override;
+    void drawBenchmark() override;
+
+  private:
+    void churnBuffers();
+    void churnTextures();
+
+    std::vector<GLuint> mObjects;
+};
+
+ObjectChurnBenchmark::ObjectChurnBenchmark() : ANGLERenderTest("ObjectChurn", GetParam()) {}
+
+void ObjectChurnBenchmark::initializeBenchmark()
+{
+    const auto &params = GetParam();
+
+    GLint maxTextureUnits = 0;
+    glGetIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &maxTextureUnits);
+    if (params.objectType == ChurnObjectType::Texture &&
+        params.boundObjectCount > static_cast<size_t>(maxTextureUnits))
+    {
+        FAIL() << "Bound texture count (" << params.boundObjectCount << ")"
+               << " exceeds maximum texture unit count: " << maxTextureUnits << std::endl;
+    }
+
+    mObjects.resize(kObjectsPerIteration, 0);
+
+    ASSERT_GL_NO_ERROR();
+}
+
+void ObjectChurnBenchmark::destroyBenchmark() {}
+
+void ObjectChurnBenchmark::drawBenchmark()
+{
+    const auto &params = GetParam();
+
+    for (unsigned int iteration = 0; iteration < params.iterationsPerStep; ++iteration)
+    {
+        switch (params.objectType)
+        {
+            case ChurnObjectType::Buffer:
+                churnBuffers();
+                break;
+            case ChurnObjectType::Texture:
+                churnTextures();
+                break;
+        }
+    }
+
+    ASSERT_GL_NO_ERROR();
+}
+
+void ObjectChurnBenchmark::churnBuffers()
+{
+    const auto &params = GetParam();
+
+    constexpr GLubyte kData[16] = {};
+
+    glGenBuffers(static_cast<GLsizei>(mObjects.size()), mObjects.data());
+    for (GLuint buffer : mObjects)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, buffer);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(kData), kData, GL_STATIC_DRAW);
+    }
+
+    // Point the vertex attributes at the last buffers, so deleting them has to update bindings.
+    GLuint boundAttribs = static_cast<GLuint>(params.boundObjectCount);
+    for (GLuint attrib = 0; attrib < boundAttribs; ++attrib)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, mObjects[mObjects.size() - 1 - attrib]);
+        glVertexAttribPointer(attrib, 4, GL_UNSIGNED_BYTE, GL_FALSE, 0, nullptr);
+    }
+
+    glDeleteBuffers(static_cast<GLsizei>(mObjects.size()), mObjects.data());
+}
+
+void ObjectChurnBenchmark::churnTextures()
+{
+    const auto &params = GetParam();
+
+    constexpr GLubyte kData[4] = {};
+
+    glGenTextures(static_cast<GLsizei>(mObjects.size()), mObjects.data());
+    for (GLuint texture : mObjects)
+    {
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, kData);
+    }
+
+    // Bind the last textures to the texture units, so deleting them has to update bindings.
+    for (size_t unit = 0; unit < params.boundObjectCount; ++unit)
+    {
+        glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + unit));
+        glBindTexture(GL_TEXTURE_2D, mObjects[mObjects.size() - 1 - unit]);
+    }
+    glActiveTexture(GL_TEXTURE0);
+
+    glDeleteTextures(static_cast<GLsizei>(mObjects.size()), mObjects.data());
+}
+
+ObjectChurnParams D3D11Params(ChurnObjectType objectType, size_t boundObjectCount)
+{
+    ObjectChurnParams params;
+    params.eglParameters    = egl_platform::D3D11_NULL();
+    params.objectType       = objectType;
+    params.boundObjectCount = boundObjectCount;
+    return params;
+}
+
+ObjectChurnParams OpenGLOrGLESParams(ChurnObjectType objectType, size_t boundObjectCount)
+{
+    ObjectChurnParams params;
+    params.eglParameters    = egl_platform::OPENGL_OR_GLES_NULL();
+    params.objectType       = objectType;
+    params.boundObjectCount = boundObjectCount;
+    return params;
+}
+
+ObjectChurnParams VulkanParams(ChurnObjectType objectType, size_t boundObjectCount)
+{
+    ObjectChurnParams params;
+    params.eglParameters    = egl_platform::VULKAN_NULL();
+    params.objectType       = objectType;
+    params.boundObjectCount = boundObjectCount;
+    return params;
+}
+
+}  // anonymous namespace
+
+TEST_P(ObjectChurnBenchmark, Run)
+{
+    run();
+}
+
+ANGLE_INSTANTIATE_TEST(ObjectChurnBenchmark,
+                       D3D11Params(ChurnObjectType::Buffer, 0),
+                       D3D11Params(ChurnObjectType::Texture, 0),
+                       D3D11Params(ChurnObjectType::Texture, 8),
+                       OpenGLOrGLESParams(ChurnObjectType::Buffer, 0),
+                       OpenGLOrGLESParams(ChurnObjectType::Texture, 0),
+                       OpenGLOrGLESParams(ChurnObjectType::Texture, 8),
+                       VulkanParams(ChurnObjectType::Buffer, 0),
+                       VulkanParams(ChurnObjectType::Texture, 0),
+                       VulkanParams(ChurnObjectType::Texture, 8));
@@ -13,6 +13,7 @@
 #include <random>
 #include <sstream>
 
+#include "platform/FeaturesVk.h"
 #include "util/shader_utils.h"
 
 namespace angle
@@ -36,7 +37,10 @@ struct TexturesParams final : public RenderTestParams
         textureStateUpdateFrequency = 3;
         textureMipCount             = 8;
 
-        webgl = false;
+        webgl             = false;
+        alternateSamplers           = false;
+        changeSingleUnit            = false;
+        useDescriptorUpdateTemplate = true;
     }
 
     std::string story() const override;
@@ -46,6 +50,16 @@ struct TexturesParams final : public RenderTestParams
     size_t textureMipCount;
 
     bool webgl;
+
+    // Bind one of two ES3 sampler objects with different filtering to every unit each draw.
+    bool alternateSamplers;
+
+    // Bind a different texture to exactly one unit each draw, leaving the other units untouched.
+    bool changeSingleUnit;
+
+    // Vulkan only: when false, descriptor sets are written with vkUpdateDescriptorSets even if
+    // VK_KHR_descriptor_update_template is supported.
+    bool useDescriptorUpdateTemplate;
 };
 
 std::ostream &operator<<(std::ostream &os, const TexturesParams &params)
@@ -69,6 +83,21 @@ std::string TexturesParams::story() const
         strstr << "_webgl";
     }
 
+    if (alternateSamplers)
+    {
+        strstr << "_alternating_samplers";
+    }
+
+    if (changeSingleUnit)
+    {
+        strstr << "_single_unit_change";
+    }
+
+    if (!useDescriptorUpdateTemplate)
+    {
+        strstr << "_no_descriptor_update_template";
+    }
+
     return strstr.str();
 }
 
@@ -82,17 +111,22 @@ class TexturesBenchmark : public ANGLERenderTest,
     void destroyBenchmark() override;
     void drawBenchmark() override;
 
+    void overrideFeaturesVk(angle::FeaturesVk *featuresVulkan) override;
+
   private:
     void initShaders();
     void initTextures();
 
     std::vector<GLuint> mTextures;
+    std::vector<GLuint> mSamplers;
+    GLuint mSpareTexture;
 
     GLuint mProgram;
     std::vector<GLuint> mUniformLocations;
 };
 
-TexturesBenchmark::TexturesBenchmark() : ANGLERenderTest("Textures", GetParam()), mProgram(0u)
+TexturesBenchmark::TexturesBenchmark()
+    : ANGLERenderTest("Textures", GetParam()), mSpareTexture(0u), mProgram(0u)
 {
     setWebGLCompatibilityEnabled(GetParam().webgl);
     setRobustResourceInit(GetParam().webgl);
@@ -196,13 +230,50 @@ void TexturesBenchmark::initTextures()
 
         glUniform1i(mUniformLocations[texIndex], static_cast<GLint>(texIndex));
     }
+
+    if (params.changeSingleUnit)
+    {
+        // Swapped into one unit per draw. Each swap leaves the displaced texture as the new spare.
+        glGenTextures(1, &mSpareTexture);
+        glBindTexture(GL_TEXTURE_2D, mSpareTexture);
+        for (size_t mip = 0; mip < params.textureMipCount; mip++)
+        {
+            GLsizei levelSize = static_cast<GLsizei>(textureSize >> mip);
+            glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(mip), GL_RGBA, levelSize, levelSize, 0,
+                         GL_RGBA, GL_UNSIGNED_BYTE, textureData.data());
+        }
+    }
+
+    if (params.alternateSamplers)
+    {
+        // A trilinear and a bilinear sampler, so completeness has to be checked for both the
+        // mipmapped and the non-mipmapped case.
+        mSamplers.resize(2, 0);
+        glGenSamplers(static_cast<GLsizei>(mSamplers.size()), mSamplers.data());
+        glSamplerParameteri(mSamplers[0], GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glSamplerParameteri(mSamplers[0], GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glSamplerParameteri(mSamplers[1], GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glSamplerParameteri(mSamplers[1], GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    }
 }
 
 void TexturesBenchmark::destroyBenchmark()
 {
+    if (!mSamplers.empty())
+    {
+        glDeleteSamplers(static_cast<GLsizei>(mSamplers.size()), mSamplers.data());
+    }
     glDeleteProgram(mProgram);
 }
 
+void TexturesBenchmark::overrideFeaturesVk(angle::FeaturesVk *featuresVulkan)
+{
+    if (!GetParam().useDescriptorUpdateTemplate)
+    {
+        featuresVulkan->overrideFeatures({"supports_descriptor_update_template"}, false);
+    }
+}
+
 void TexturesBenchmark::drawBenchmark()
 {
     const auto &params = GetParam();
@@ -267,6 +338,23 @@ void TexturesBenchmark::drawBenchmark()
             }
         }
 
+        if (params.alternateSamplers)
+        {
+            GLuint sampler = mSamplers[it % mSamplers.size()];
+            for (size_t unit = 0; unit < params.numTextures; ++unit)
+            {
+                glBindSampler(static_cast<GLuint>(unit), sampler);
+            }
+        }
+
+        if (params.changeSingleUnit)
+        {
+            size_t unit = it % params.numTextures;
+            glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + unit));
+            glBindTexture(GL_TEXTURE_2D, mSpareTexture);
+            std::swap(mTextures[unit], mSpareTexture);
+        }
+
         glDrawArrays(GL_TRIANGLES, 0, 3);
     }
 
@@ -297,6 +385,48 @@ TexturesParams OpenGLOrGLESParams(bool webglCompat)
     return params;
 }
 
+TexturesParams VulkanParams(bool webglCompat)
+{
+    TexturesParams params;
+    params.eglParameters = egl_platform::VULKAN_NULL();
+    params.webgl         = webglCompat;
+    return params;
+}
+
+TexturesParams AlternatingSamplersParams(TexturesParams params)
+{
+    params.majorVersion      = 3;
+    params.alternateSamplers = true;
+
+    // Keep the texture state fixed so only the sampler changes between draws.
+    params.textureRebindFrequency      = kIterationsPerStep;
+    params.textureStateUpdateFrequency = kIterationsPerStep;
+    return params;
+}
+
+TexturesParams SingleUnitChangeParams(TexturesParams params)
+{
+    params.changeSingleUnit = true;
+    params.numTextures      = 16;
+
+    // Only the per-draw single unit rebind should change texture state.
+    params.textureRebindFrequency      = kIterationsPerStep;
+    params.textureStateUpdateFrequency = kIterationsPerStep;
+    return params;
+}
+
+TexturesParams DescriptorUpdateParams(TexturesParams params, bool useDescriptorUpdateTemplate)
+{
+    params.numTextures                 = 16;
+    params.useDescriptorUpdateTemplate = useDescriptorUpdateTemplate;
+
+    // Changing the state of a texture changes its serial, so every draw has to write a new
+    // texture descriptor set.  Most of its descriptors are unchanged from the previous draw.
+    params.textureRebindFrequency      = kIterationsPerStep;
+    params.textureStateUpdateFrequency = 1;
+    return params;
+}
+
 TEST_P(TexturesBenchmark, Run)
 {
     run();
@@ -307,5 +437,13 @@ ANGLE_INSTANTIATE_TEST(TexturesBenchmark,
                        D3D11Params(true),
                        D3D9Params(true),
                        OpenGLOrGLESParams(false),
-                       OpenGLOrGLESParams(true));
+                       OpenGLOrGLESParams(true),
+                       AlternatingSamplersParams(D3D11Params(false)),
+                       AlternatingSamplersParams(OpenGLOrGLESParams(false)),
+                       AlternatingSamplersParams(VulkanParams(false)),
+                       SingleUnitChangeParams(D3D11Params(false)),
+                       SingleUnitChangeParams(OpenGLOrGLESParams(false)),
+                       SingleUnitChangeParams(VulkanParams(false)),
+                       DescriptorUpdateParams(VulkanParams(false), true),
+                       DescriptorUpdateParams(VulkanParams(false), false));
 }  // namespace angle
@@ -0,0 +1,389 @@
+//
+// Copyright 2020 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// UtilsFirstUsePerf:
+//   Performance test for the first use of an internal operation on a new display, such as index
+//   conversion or a masked clear.  On Vulkan, these are implemented with pipelines that are
+//   otherwise compiled the first time they are needed.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include <sstream>
+
+#include "test_utils/gl_raii.h"
+#include "util/EGLWindow.h"
+#include "util/Timer.h"
+#include "util/shader_utils.h"
+
+using namespace angle;
+
+namespace
+{
+// Corresponds to the UtilsVk functions exercised by each operation.
+enum class UtilsFunction
+{
+    ConvertIndexBuffer,
+    ConvertVertexBuffer,
+    ImageClear,
+    ImageCopy,
+    BlitResolve,
+};
+
+constexpr GLsizei kSize = 16;
+
+// The feature toggled by the test, given to the test's display as an override.
+const char *kWarmUpUtilsPipelinesFeature[] = {"warm_up_utils_pipelines", nullptr};
+
+// Blob cache callbacks that never return anything, so that the pipeline cache is empty every time
+// the display is initialized.
+void SetBlob(const void *key, EGLsizeiANDROID keySize, const void *value, EGLsizeiANDROID valueSize)
+{}
+
+EGLsizeiANDROID GetBlob(const void *key,
+                        EGLsizeiANDROID keySize,
+                        void *value,
+                        EGLsizeiANDROID valueSize)
+{
+    return 0;
+}
+
+struct UtilsFirstUseParams final : public RenderTestParams
+{
+    UtilsFirstUseParams()
+    {
+        majorVersion      = 3;
+        iterationsPerStep = 1;
+    }
+
+    std::string story() const override;
+
+    UtilsFunction function    = UtilsFunction::ConvertIndexBuffer;
+    bool warmUpUtilsPipelines = false;
+};
+
+std::ostream &operator<<(std::ostream &os, const UtilsFirstUseParams &params)
+{
+    os << params.backendAndStory().substr(1);
+    return os;
+}
+
+std::string UtilsFirstUseParams::story() const
+{
+    std::stringstream strstr;
+
+    strstr << RenderTestParams::story();
+
+    switch (function)
+    {
+        case UtilsFunction::ConvertIndexBuffer:
+            strstr << "_convert_index_buffer";
+            break;
+        case UtilsFunction::ConvertVertexBuffer:
+            strstr << "_convert_vertex_buffer";
+            break;
+        case UtilsFunction::ImageClear:
+            strstr << "_image_clear";
+            break;
+        case UtilsFunction::ImageCopy:
+            strstr << "_image_copy";
+            break;
+        case UtilsFunction::BlitResolve:
+            strstr << "_blit_resolve";
+            break;
+    }
+
+    if (warmUpUtilsPipelines)
+    {
+        strstr << "_warm_up";
+    }
+
+    return strstr.str();
+}
+
+class UtilsFirstUseBenchmark : public ANGLERenderTest,
+                               public ::testing::WithParamInterface<UtilsFirstUseParams>
+{
+  public:
+    UtilsFirstUseBenchmark();
+
+    void initializeBenchmark() override;
+    void destroyBenchmark() override;
+    void drawBenchmark() override;
+
+  private:
+    bool initializeDisplay();
+    void initializeResources();
+    void destroyResources();
+    void runOperation(GLuint program);
+
+    // Every step initializes and terminates this display, separate from the window's, so that the
+    // operation always runs on a fresh renderer.  Contexts of the window's display would share
+    // its renderer, and so its pipeline cache, with every step after the first.
+    EGLDisplay mDisplay = EGL_NO_DISPLAY;
+    EGLConfig mConfig   = nullptr;
+
+    Timer mFirstUseTimer;
+    double mFirstUseSeconds     = 0;
+    unsigned int mFirstUseCount = 0;
+
+    // Created in the context of every step.
+    GLuint mVertexBuffer        = 0;
+    GLuint mFixedVertexBuffer   = 0;
+    GLuint mIndexBuffer         = 0;
+    GLuint mCopyTexture         = 0;
+    GLuint mResolveRenderbuffer = 0;
+};
+
+UtilsFirstUseBenchmark::UtilsFirstUseBenchmark() : ANGLERenderTest("UtilsFirstUse", GetParam())
+{
+    mReporter->RegisterImportantMetric(".FirstUse", "ms");
+}
+
+void UtilsFirstUseBenchmark::initializeBenchmark()
+{
+    EGLWindow *window = getEGLWindow();
+    if (window == nullptr)
+    {
+        mSkipTest = true;
+        return;
+    }
+
+    const UtilsFirstUseParams &params = GetParam();
+    const EGLAttrib displayAttributes[] = {
+        EGL_PLATFORM_ANGLE_TYPE_ANGLE,
+        params.getRenderer(),
+        EGL_PLATFORM_ANGLE_DEVICE_TYPE_ANGLE,
+        params.eglParameters.deviceType,
+        params.warmUpUtilsPipelines ? EGL_FEATURE_OVERRIDES_ENABLED_ANGLE
+                                    : EGL_FEATURE_OVERRIDES_DISABLED_ANGLE,
+        reinterpret_cast<EGLAttrib>(kWarmUpUtilsPipelinesFeature),
+        EGL_NONE};
+    mDisplay = eglGetPlatformDisplay(EGL_PLATFORM_ANGLE_ANGLE,
+                                     reinterpret_cast<void *>(EGL_DEFAULT_DISPLAY),
+                                     displayAttributes);
+
+    // Displays are looked up by native display, so on platforms where the window uses the default
+    // display, there's no way to get a separate renderer.
+    if (mDisplay == EGL_NO_DISPLAY || mDisplay == window->getDisplay() || !initializeDisplay())
+    {
+        mDisplay  = EGL_NO_DISPLAY;
+        mSkipTest = true;
+        return;
+    }
+
+    const EGLint configAttributes[] = {EGL_RED_SIZE,        8,
+                                       EGL_GREEN_SIZE,      8,
+                                       EGL_BLUE_SIZE,       8,
+                                       EGL_ALPHA_SIZE,      8,
+                                       EGL_RENDERABLE_TYPE, EGL_OPENGL_ES3_BIT,
+                                       EGL_SURFACE_TYPE,    EGL_PBUFFER_BIT,
+                                       EGL_NONE};
+    EGLint configCount = 0;
+    if (eglChooseConfig(mDisplay, configAttributes, &mConfig, 1, &configCount) != EGL_TRUE ||
+        configCount == 0)
+    {
+        mSkipTest = true;
+    }
+
+    eglTerminate(mDisplay);
+}
+
+void UtilsFirstUseBenchmark::destroyBenchmark()
+{
+    if (mFirstUseCount > 0)
+    {
+        mReporter->AddResult(".FirstUse", mFirstUseSeconds * 1000.0 / mFirstUseCount);
+    }
+}
+
+bool UtilsFirstUseBenchmark::initializeDisplay()
+{
+    if (eglInitialize(mDisplay, nullptr, nullptr) != EGL_TRUE)
+    {
+        return false;
+    }
+
+    // Termination drops the blob cache callbacks, so they are set again every time.  Without
+    // them, the display would keep the pipeline cache from the previous step in memory.
+    eglSetBlobCacheFuncsANDROID(mDisplay, SetBlob, GetBlob);
+    return true;
+}
+
+void UtilsFirstUseBenchmark::initializeResources()
+{
+    const GLfloat positions[] = {-1.0f, -1.0f, 1.0f, -1.0f, 1.0f, 1.0f,
+                                 -1.0f, -1.0f, 1.0f, 1.0f,  -1.0f, 1.0f};
+    glGenBuffers(1, &mVertexBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffer);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(positions), positions, GL_STATIC_DRAW);
+
+    constexpr GLfixed kOne         = 1 << 16;
+    const GLfixed fixedPositions[] = {-kOne, -kOne, kOne, -kOne, kOne,  kOne,
+                                      -kOne, -kOne, kOne, kOne,  -kOne, kOne};
+    glGenBuffers(1, &mFixedVertexBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, mFixedVertexBuffer);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(fixedPositions), fixedPositions, GL_STATIC_DRAW);
+
+    const GLubyte indices[] = {0, 1, 2, 3, 4, 5};
+    glGenBuffers(1, &mIndexBuffer);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIndexBuffer);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+
+    glGenTextures(1, &mCopyTexture);
+    glBindTexture(GL_TEXTURE_2D, mCopyTexture);
+    glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, kSize, kSize);
+
+    glGenRenderbuffers(1, &mResolveRenderbuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, mResolveRenderbuffer);
+    glRenderbufferStorageMultisample(GL_RENDERBUFFER, 4, GL_RGBA8, kSize, kSize);
+
+    ASSERT_GL_NO_ERROR();
+}
+
+void UtilsFirstUseBenchmark::destroyResources()
+{
+    glDeleteBuffers(1, &mVertexBuffer);
+    glDeleteBuffers(1, &mFixedVertexBuffer);
+    glDeleteBuffers(1, &mIndexBuffer);
+    glDeleteTextures(1, &mCopyTexture);
+    glDeleteRenderbuffers(1, &mResolveRenderbuffer);
+}
+
+void UtilsFirstUseBenchmark::runOperation(GLuint program)
+{
+    GLint positionLocation = glGetAttribLocation(program, essl1_shaders::PositionAttrib());
+    glUseProgram(program);
+
+    switch (GetParam().function)
+    {
+        case UtilsFunction::ConvertIndexBuffer:
+        {
+            // Vulkan has no 8-bit indices.
+            glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffer);
+            glVertexAttribPointer(positionLocation, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+            glEnableVertexAttribArray(positionLocation);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIndexBuffer);
+            glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_BYTE, nullptr);
+            break;
+        }
+        case UtilsFunction::ConvertVertexBuffer:
+        {
+            glBindBuffer(GL_ARRAY_BUFFER, mFixedVertexBuffer);
+            glVertexAttribPointer(positionLocation, 2, GL_FIXED, GL_FALSE, 0, nullptr);
+            glEnableVertexAttribArray(positionLocation);
+            glDrawArrays(GL_TRIANGLES, 0, 6);
+            break;
+        }
+        case UtilsFunction::ImageClear:
+        {
+            // A masked clear can't be done with a clear command.
+            glColorMask(GL_TRUE, GL_FALSE, GL_TRUE, GL_TRUE);
+            glClear(GL_COLOR_BUFFER_BIT);
+            glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+            break;
+        }
+        case UtilsFunction::ImageCopy:
+        {
+            // The default framebuffer is flipped, so the copy is done with a draw.
+            glBindTexture(GL_TEXTURE_2D, mCopyTexture);
+            glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 0, 0, kSize, kSize);
+            break;
+        }
+        case UtilsFunction::BlitResolve:
+        {
+            // Likewise, resolving into the default framebuffer is done with a draw.
+            GLFramebuffer framebuffer;
+            glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+            glFramebufferRenderbuffer(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER,
+                                      mResolveRenderbuffer);
+            glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+            glBlitFramebuffer(0, 0, kSize, kSize, 0, 0, kSize, kSize, GL_COLOR_BUFFER_BIT,
+                              GL_NEAREST);
+            glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+            break;
+        }
+    }
+}
+
+void UtilsFirstUseBenchmark::drawBenchmark()
+{
+    ASSERT_TRUE(initializeDisplay());
+
+    const EGLint surfaceAttributes[] = {EGL_WIDTH, kSize, EGL_HEIGHT, kSize, EGL_NONE};
+    EGLSurface surface = eglCreatePbufferSurface(mDisplay, mConfig, surfaceAttributes);
+    ASSERT_NE(EGL_NO_SURFACE, surface);
+
+    const EGLint contextAttributes[] = {EGL_CONTEXT_MAJOR_VERSION, GetParam().majorVersion,
+                                        EGL_NONE};
+    EGLContext context = eglCreateContext(mDisplay, mConfig, EGL_NO_CONTEXT, contextAttributes);
+    ASSERT_NE(EGL_NO_CONTEXT, context);
+    eglMakeCurrent(mDisplay, surface, surface, context);
+
+    initializeResources();
+
+    {
+        // Like an application would, compile a program between creating the context and the
+        // first draw.
+        ANGLE_GL_PROGRAM(program, essl1_shaders::vs::Simple(), essl1_shaders::fs::Red());
+
+        mFirstUseTimer.start();
+        runOperation(program);
+        glFinish();
+        mFirstUseTimer.stop();
+        ASSERT_GL_NO_ERROR();
+
+        mFirstUseSeconds += mFirstUseTimer.getElapsedTime();
+        mFirstUseCount++;
+    }
+
+    destroyResources();
+
+    eglMakeCurrent(mDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    eglDestroyContext(mDisplay, context);
+    eglDestroySurface(mDisplay, surface);
+    eglTerminate(mDisplay);
+
+    EGLWindow *window = getEGLWindow();
+    eglMakeCurrent(window->getDisplay(), window->getSurface(), window->getSurface(),
+                   window->getContext());
+}
+
+UtilsFirstUseParams VulkanParams(UtilsFunction function, bool warmUpUtilsPipelines)
+{
+    UtilsFirstUseParams params;
+    params.eglParameters        = egl_platform::VULKAN();
+    params.function             = function;
+    params.warmUpUtilsPipelines = warmUpUtilsPipelines;
+    return params;
+}
+
+UtilsFirstUseParams OpenGLOrGLESParams(UtilsFunction function)
+{
+    UtilsFirstUseParams params;
+    params.eglParameters = egl_platform::OPENGL_OR_GLES();
+    params.function      = function;
+    return params;
+}
+
+}  // anonymous namespace
+
+TEST_P(UtilsFirstUseBenchmark, Run)
+{
+    run();
+}
+
+ANGLE_INSTANTIATE_TEST(UtilsFirstUseBenchmark,
+                       VulkanParams(UtilsFunction::ConvertIndexBuffer, false),
+                       VulkanParams(UtilsFunction::ConvertIndexBuffer, true),
+                       VulkanParams(UtilsFunction::ConvertVertexBuffer, false),
+                       VulkanParams(UtilsFunction::ConvertVertexBuffer, true),
+                       VulkanParams(UtilsFunction::ImageClear, false),
+                       VulkanParams(UtilsFunction::ImageClear, true),
+                       VulkanParams(UtilsFunction::ImageCopy, false),
+                       VulkanParams(UtilsFunction::ImageCopy, true),
+                       VulkanParams(UtilsFunction::BlitResolve, false),
+                       VulkanParams(UtilsFunction::BlitResolve, true),
+                       OpenGLOrGLESParams(UtilsFunction::ConvertIndexBuffer));
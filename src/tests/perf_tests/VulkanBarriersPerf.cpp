@@ -7,6 +7,7 @@
 //   Performance tests for ANGLE's Vulkan backend w.r.t barrier efficiency.
 //
 
+#include <string.h>
 #include <sstream>
 
 #include "ANGLEPerfTest.h"
@@ -19,9 +20,15 @@ namespace
 {
 constexpr unsigned int kIterationsPerStep = 10;
 
+// Number of textures updated on every iteration by the texture update variant, so they all need a
+// layout transition before the draw samples them.
+constexpr GLint kUpdatedTextureCount = 7;
+
+constexpr char kBarriersHistogram[] = "GPU.ANGLE.VulkanPipelineBarriersPerSubmit";
+
 struct VulkanBarriersPerfParams final : public RenderTestParams
 {
-    VulkanBarriersPerfParams(bool largeTransfers, bool slowFS)
+    VulkanBarriersPerfParams(bool largeTransfers, bool slowFS, bool textureUpdates = false)
     {
         iterationsPerStep = kIterationsPerStep;
 
@@ -35,6 +42,7 @@ struct VulkanBarriersPerfParams final : public RenderTestParams
 
         doLargeTransfers      = largeTransfers;
         doSlowFragmentShaders = slowFS;
+        doTextureUpdates      = textureUpdates;
     }
 
     std::string story() const override;
@@ -44,6 +52,7 @@ struct VulkanBarriersPerfParams final : public RenderTestParams
 
     bool doLargeTransfers;
     bool doSlowFragmentShaders;
+    bool doTextureUpdates;
 };
 
 constexpr int VulkanBarriersPerfParams::kImageSizes[];
@@ -64,6 +73,8 @@ class VulkanBarriersPerfBenchmark : public ANGLERenderTest,
     void destroyBenchmark() override;
     void drawBenchmark() override;
 
+    void onHistogramCustomCounts(const char *name, int sample) override;
+
   private:
     void createTexture(uint32_t textureIndex, uint32_t sizeIndex, bool compressed);
     void createFramebuffer(uint32_t fboIndex, uint32_t textureIndex, uint32_t sizeIndex);
@@ -81,6 +92,7 @@ class VulkanBarriersPerfBenchmark : public ANGLERenderTest,
 
     // Texture handles
     GLTexture mTextures[4];
+    GLTexture mUpdatedTextures[kUpdatedTextureCount];
 
     // Framebuffer handles
     GLFramebuffer mFbos[2];
@@ -100,6 +112,10 @@ class VulkanBarriersPerfBenchmark : public ANGLERenderTest,
     static constexpr size_t kSmallSizeIndex = 0;
     static constexpr size_t kLargeSizeIndex = 1;
     static constexpr size_t kHugeSizeIndex  = 2;
+
+    // Pipeline barriers the backend reported and frames drawn, to report barriers per frame.
+    uint64_t mBarrierCount;
+    uint64_t mFrameCount;
 };
 
 std::string VulkanBarriersPerfParams::story() const
@@ -116,6 +132,10 @@ std::string VulkanBarriersPerfParams::story() const
     {
         sout << "_slowfs";
     }
+    if (doTextureUpdates)
+    {
+        sout << "_texture_updates";
+    }
 
     return sout.str();
 }
@@ -124,8 +144,12 @@ VulkanBarriersPerfBenchmark::VulkanBarriersPerfBenchmark()
     : ANGLERenderTest("VulkanBarriersPerf", GetParam()),
       mPositionLoc(-1),
       mTexCoordLoc(-1),
-      mSamplerLoc(-1)
-{}
+      mSamplerLoc(-1),
+      mBarrierCount(0),
+      mFrameCount(0)
+{
+    mReporter->RegisterImportantMetric(".barriers_per_frame", "count");
+}
 
 constexpr char kVS[] = R"(attribute vec4 a_position;
 attribute vec2 a_texCoord;
@@ -144,6 +168,22 @@ void main()
     gl_FragColor = texture2D(s_texture, v_texCoord);
 })";
 
+// Samples the framebuffer texture along with the textures that are updated every iteration.
+// UPDATED_TEXTURE_COUNT is defined to kUpdatedTextureCount when the program is built.
+constexpr char kTextureUpdatesFS[] = R"(precision mediump float;
+varying vec2 v_texCoord;
+uniform sampler2D s_texture;
+uniform sampler2D s_updatedTextures[UPDATED_TEXTURE_COUNT];
+void main()
+{
+    vec4 outColor = texture2D(s_texture, v_texCoord);
+    for (int i = 0; i < UPDATED_TEXTURE_COUNT; ++i)
+    {
+        outColor += texture2D(s_updatedTextures[i], v_texCoord);
+    }
+    gl_FragColor = outColor;
+})";
+
 constexpr char kSlowFS[] = R"(precision mediump float;
 varying vec2 v_texCoord;
 uniform sampler2D s_texture;
@@ -193,7 +233,15 @@ void VulkanBarriersPerfBenchmark::createResources()
 {
     const auto &params = GetParam();
 
-    mProgram.makeRaster(kVS, params.doSlowFragmentShaders ? kSlowFS : kShortFS);
+    const char *fs = params.doSlowFragmentShaders ? kSlowFS : kShortFS;
+    std::string textureUpdatesFS;
+    if (params.doTextureUpdates)
+    {
+        textureUpdatesFS = "#define UPDATED_TEXTURE_COUNT " +
+                           std::to_string(kUpdatedTextureCount) + "\n" + kTextureUpdatesFS;
+        fs = textureUpdatesFS.c_str();
+    }
+    mProgram.makeRaster(kVS, fs);
     ASSERT_TRUE(mProgram.valid());
 
     // Get the attribute locations
@@ -235,6 +283,25 @@ void VulkanBarriersPerfBenchmark::createResources()
         createTexture(kTransferTexture1Index, kHugeSizeIndex, true);
         createTexture(kTransferTexture2Index, kHugeSizeIndex, true);
     }
+
+    if (params.doTextureUpdates)
+    {
+        GLint units[kUpdatedTextureCount];
+        for (GLint textureIndex = 0; textureIndex < kUpdatedTextureCount; ++textureIndex)
+        {
+            glBindTexture(GL_TEXTURE_2D, mUpdatedTextures[textureIndex]);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+            // Unit 0 is used by the framebuffer texture.
+            units[textureIndex] = textureIndex + 1;
+        }
+
+        glUseProgram(mProgram);
+        glUniform1iv(glGetUniformLocation(mProgram, "s_updatedTextures"), kUpdatedTextureCount,
+                     units);
+    }
 }
 
 void VulkanBarriersPerfBenchmark::initializeBenchmark()
@@ -246,7 +313,23 @@ void VulkanBarriersPerfBenchmark::initializeBenchmark()
     ASSERT_GL_NO_ERROR();
 }
 
-void VulkanBarriersPerfBenchmark::destroyBenchmark() {}
+void VulkanBarriersPerfBenchmark::destroyBenchmark()
+{
+    // The CPU time spent recording the barriers is part of the wall time.
+    if (mFrameCount > 0)
+    {
+        mReporter->AddResult(".barriers_per_frame",
+                             static_cast<double>(mBarrierCount) / static_cast<double>(mFrameCount));
+    }
+}
+
+void VulkanBarriersPerfBenchmark::onHistogramCustomCounts(const char *name, int sample)
+{
+    if (strcmp(name, kBarriersHistogram) == 0)
+    {
+        mBarrierCount += sample;
+    }
+}
 
 void VulkanBarriersPerfBenchmark::drawBenchmark()
 {
@@ -338,12 +421,27 @@ void VulkanBarriersPerfBenchmark::drawBenchmark()
         glActiveTexture(GL_TEXTURE0);
         glBindTexture(GL_TEXTURE_2D, mTextures[fboTexSrcIndex]);
 
+        // Update the other textures, so each needs a layout transition before it's sampled.
+        if (params.doTextureUpdates)
+        {
+            const GLubyte pixel[4] = {static_cast<GLubyte>(iteration), 0, 0, 255};
+            for (GLint textureIndex = 0; textureIndex < kUpdatedTextureCount; ++textureIndex)
+            {
+                glActiveTexture(static_cast<GLenum>(GL_TEXTURE1 + textureIndex));
+                glBindTexture(GL_TEXTURE_2D, mUpdatedTextures[textureIndex]);
+                glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixel);
+            }
+            glActiveTexture(GL_TEXTURE0);
+        }
+
         ASSERT_GL_NO_ERROR();
 
         glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, 0);
     }
     stopGpuTimer();
 
+    ++mFrameCount;
+
     ASSERT_GL_NO_ERROR();
 }
 
@@ -357,4 +455,5 @@ TEST_P(VulkanBarriersPerfBenchmark, Run)
 ANGLE_INSTANTIATE_TEST(VulkanBarriersPerfBenchmark,
                        VulkanBarriersPerfParams(false, false),
                        VulkanBarriersPerfParams(true, false),
-                       VulkanBarriersPerfParams(true, true));
+                       VulkanBarriersPerfParams(true, true),
+                       VulkanBarriersPerfParams(false, false, true));
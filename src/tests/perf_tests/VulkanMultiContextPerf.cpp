@@ -0,0 +1,201 @@
+//
+// Copyright 2020 The ANGLE Project Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// VulkanMultiContextPerf:
+//   Stress test for the Vulkan caches shared by all contexts.  Several contexts that share nothing
+//   draw on their own threads, each with its own programs made of the same shaders.  Reports the
+//   number of render passes and graphics pipelines the renderer ends up with, which doesn't grow
+//   with the number of contexts and programs.
+//
+
+#include "ANGLEPerfTest.h"
+
+#include <array>
+#include <thread>
+
+#include "libANGLE/Context.h"
+#include "libANGLE/renderer/vulkan/ContextVk.h"
+#include "libANGLE/renderer/vulkan/RendererVk.h"
+#include "util/EGLWindow.h"
+#include "util/shader_utils.h"
+
+using namespace angle;
+
+namespace
+{
+constexpr size_t kContextCount       = 4;
+constexpr size_t kProgramsPerContext = 8;
+constexpr GLsizei kSize              = 32;
+
+struct VulkanMultiContextParams final : public RenderTestParams
+{
+    VulkanMultiContextParams()
+    {
+        iterationsPerStep = 1;
+        eglParameters     = egl_platform::VULKAN();
+    }
+};
+
+std::ostream &operator<<(std::ostream &os, const VulkanMultiContextParams &params)
+{
+    os << params.backendAndStory().substr(1);
+    return os;
+}
+
+class VulkanMultiContextBenchmark : public ANGLERenderTest,
+                                    public ::testing::WithParamInterface<VulkanMultiContextParams>
+{
+  public:
+    VulkanMultiContextBenchmark();
+
+    void initializeBenchmark() override;
+    void destroyBenchmark() override;
+    void drawBenchmark() override;
+
+  private:
+    struct ContextResources
+    {
+        EGLContext context = EGL_NO_CONTEXT;
+        GLuint texture     = 0;
+        GLuint framebuffer = 0;
+        std::array<GLuint, kProgramsPerContext> programs;
+    };
+
+    void makeCurrent(EGLContext context);
+    void drawWithContext(const ContextResources &resources);
+
+    std::array<ContextResources, kContextCount> mContexts;
+};
+
+VulkanMultiContextBenchmark::VulkanMultiContextBenchmark()
+    : ANGLERenderTest("VulkanMultiContext", GetParam())
+{
+    mReporter->RegisterFyiMetric(".render_passes", "count");
+    mReporter->RegisterFyiMetric(".graphics_pipelines", "count");
+}
+
+void VulkanMultiContextBenchmark::makeCurrent(EGLContext context)
+{
+    EGLDisplay display = getEGLWindow()->getDisplay();
+    eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context);
+}
+
+void VulkanMultiContextBenchmark::initializeBenchmark()
+{
+    EGLWindow *window = getEGLWindow();
+    if (window == nullptr ||
+        !CheckExtensionExists(eglQueryString(window->getDisplay(), EGL_EXTENSIONS),
+                              "EGL_KHR_surfaceless_context"))
+    {
+        mSkipTest = true;
+        return;
+    }
+
+    for (ContextResources &resources : mContexts)
+    {
+        resources.context = window->createContext(EGL_NO_CONTEXT);
+        ASSERT_NE(EGL_NO_CONTEXT, resources.context);
+        makeCurrent(resources.context);
+
+        // Every program is linked separately from the same sources.
+        for (GLuint &program : resources.programs)
+        {
+            program = CompileProgram(essl1_shaders::vs::Simple(), essl1_shaders::fs::Red());
+            ASSERT_NE(0u, program);
+        }
+
+        glGenTextures(1, &resources.texture);
+        glBindTexture(GL_TEXTURE_2D, resources.texture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, kSize, kSize, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                     nullptr);
+
+        glGenFramebuffers(1, &resources.framebuffer);
+        glBindFramebuffer(GL_FRAMEBUFFER, resources.framebuffer);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
+                               resources.texture, 0);
+        ASSERT_GLENUM_EQ(GL_FRAMEBUFFER_COMPLETE, glCheckFramebufferStatus(GL_FRAMEBUFFER));
+        glViewport(0, 0, kSize, kSize);
+
+        ASSERT_GL_NO_ERROR();
+    }
+
+    eglMakeCurrent(window->getDisplay(), window->getSurface(), window->getSurface(),
+                   window->getContext());
+}
+
+void VulkanMultiContextBenchmark::destroyBenchmark()
+{
+    if (mSkipTest)
+    {
+        return;
+    }
+
+    EGLWindow *window = getEGLWindow();
+
+    // Nothing is evicted while the programs are alive, so the counts cover the whole run.
+    const gl::Context *context = static_cast<gl::Context *>(window->getContext());
+    rx::RendererVk *renderer   = rx::GetImplAs<rx::ContextVk>(context)->getRenderer();
+    mReporter->AddResult(".render_passes", renderer->getRenderPassCache().getRenderPassCount());
+    mReporter->AddResult(".graphics_pipelines",
+                         renderer->getSharedGraphicsPipelineCache().getPipelineCount());
+
+    for (ContextResources &resources : mContexts)
+    {
+        makeCurrent(resources.context);
+        for (GLuint program : resources.programs)
+        {
+            glDeleteProgram(program);
+        }
+        glDeleteFramebuffers(1, &resources.framebuffer);
+        glDeleteTextures(1, &resources.texture);
+        makeCurrent(EGL_NO_CONTEXT);
+        eglDestroyContext(window->getDisplay(), resources.context);
+    }
+
+    eglMakeCurrent(window->getDisplay(), window->getSurface(), window->getSurface(),
+                   window->getContext());
+}
+
+void VulkanMultiContextBenchmark::drawWithContext(const ContextResources &resources)
+{
+    makeCurrent(resources.context);
+
+    for (GLuint program : resources.programs)
+    {
+        glUseProgram(program);
+
+        // A couple of pipelines per program.
+        glDisable(GL_BLEND);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        glEnable(GL_BLEND);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+    }
+
+    glFinish();
+    makeCurrent(EGL_NO_CONTEXT);
+}
+
+void VulkanMultiContextBenchmark::drawBenchmark()
+{
+    std::array<std::thread, kContextCount> threads;
+    for (size_t contextIndex = 0; contextIndex < kContextCount; ++contextIndex)
+    {
+        threads[contextIndex] = std::thread(&VulkanMultiContextBenchmark::drawWithContext, this,
+                                            std::cref(mContexts[contextIndex]));
+    }
+
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+}
+}  // anonymous namespace
+
+TEST_P(VulkanMultiContextBenchmark, Run)
+{
+    run();
+}
+
+ANGLE_INSTANTIATE_TEST(VulkanMultiContextBenchmark, VulkanMultiContextParams());
@@ -82,7 +82,7 @@ void VulkanPipelineCachePerfTest::step()
     vk::RenderPass rp;
     vk::PipelineLayout pl;
     vk::PipelineCache pc;
-    vk::ShaderModule sm;
+    vk::ShaderAndSerial sm;
     const vk::GraphicsPipelineDesc *desc = nullptr;
     vk::PipelineHelper *result           = nullptr;
     gl::AttributesMask am;